@@ -29,6 +29,35 @@ void membench_free(void *ptr, size_t size);
  */
 size_t membench_page_size(void);
 
+/* ── Placement policy (job files) ─────────────────────────────────────────── */
+
+typedef enum {
+    MEMBENCH_PAGES_DEFAULT = 0,  /* whatever the OS gives */
+    MEMBENCH_PAGES_HUGE          /* ask for transparent huge pages (Linux) */
+} membench_page_policy_t;
+
+typedef enum {
+    MEMBENCH_NUMA_DEFAULT = 0,   /* local allocation */
+    MEMBENCH_NUMA_INTERLEAVE,    /* round-robin over every node */
+    MEMBENCH_NUMA_BIND,          /* only the given node */
+    MEMBENCH_NUMA_PREFERRED      /* the given node first, others on overflow */
+} membench_numa_policy_t;
+
+/**
+ * Page policy for later membench_alloc() calls, process-wide. Meant to be
+ * set between runs, not while probes are allocating. Returns the previous
+ * policy. A no-op outside Linux.
+ */
+membench_page_policy_t membench_alloc_set_pages(membench_page_policy_t policy);
+
+/**
+ * NUMA policy of the calling thread for memory it touches from now on.
+ * `node` is the node for BIND and PREFERRED, and the number of nodes
+ * (sysinfo numa_nodes) for INTERLEAVE. Returns 0 on success, -1 where
+ * unsupported (non-Linux, or a node that does not exist).
+ */
+int membench_numa_set_policy(membench_numa_policy_t policy, int node);
+
 #ifdef __cplusplus
 }
 #endif
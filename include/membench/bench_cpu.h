@@ -6,6 +6,8 @@
 #ifndef MEMBENCH_BENCH_CPU_H
 #define MEMBENCH_BENCH_CPU_H
 
+#include "health.h"
+
 #include <stddef.h>
 #include <stdint.h>
 
@@ -19,6 +21,7 @@ typedef struct {
     size_t   buffer_size;    /* bytes */
     double   avg_latency_ns; /* average per-access latency */
     uint64_t accesses;       /* total accesses performed */
+    const char *kernel;      /* loop variant that ran, e.g. "chase-x32"; NULL = plain loop */
 } membench_latency_result_t;
 
 typedef struct {
@@ -26,6 +29,7 @@ typedef struct {
     double bandwidth_gbps;   /* GB/s */
     double avg_latency_ns;   /* per-element average (informational) */
     uint64_t bytes_moved;    /* total bytes read or written */
+    const char *kernel;      /* loop variant that ran, e.g. "stream-v128x16"; NULL = plain loop */
 } membench_bandwidth_result_t;
 
 typedef struct {
@@ -37,6 +41,322 @@ typedef struct {
     double   *sample_latencies; /* Corresponding latencies in ns */
 } membench_cache_info_t;
 
+/* ── Hash table probe benchmark ───────────────────────────────────────────── */
+
+typedef enum {
+    MEMBENCH_HASH_LINEAR = 0,    /* linear probing                         */
+    MEMBENCH_HASH_QUADRATIC,     /* triangular-number quadratic probing    */
+    MEMBENCH_HASH_ROBIN_HOOD,    /* linear probing with Robin Hood swaps   */
+    MEMBENCH_HASH_BUCKETIZED,    /* 16-way tag groups, Swiss-table style   */
+    MEMBENCH_HASH_NUM_SCHEMES
+} membench_hash_scheme_t;
+
+typedef struct {
+    membench_hash_scheme_t scheme;
+    size_t   table_bytes;        /* bytes of slot (+ control) storage */
+    size_t   capacity;           /* slots */
+    double   load_factor;        /* achieved entries / capacity */
+    double   hit_latency_ns;     /* dependent lookups, key present */
+    double   miss_latency_ns;    /* dependent lookups, key absent */
+    double   hit_mops;           /* independent lookups, million/s */
+    double   miss_mops;
+    double   avg_probes_hit;     /* slots (or groups) touched per hit */
+    uint64_t lookups;            /* lookups per timed phase */
+} membench_hash_result_t;
+
+/* ── Search layout benchmark ──────────────────────────────────────────────── */
+
+typedef enum {
+    MEMBENCH_SEARCH_BRANCHY = 0, /* sorted array, branchy binary search    */
+    MEMBENCH_SEARCH_BRANCHLESS,  /* sorted array, cmov binary search       */
+    MEMBENCH_SEARCH_EYTZINGER,   /* BFS layout with descendant prefetch    */
+    MEMBENCH_SEARCH_STREE,       /* implicit B-tree, 16-key line nodes     */
+    MEMBENCH_SEARCH_BPLUS,       /* static B+tree, 16-key line nodes       */
+    MEMBENCH_SEARCH_NUM_LAYOUTS
+} membench_search_layout_t;
+
+typedef struct {
+    membench_search_layout_t layout;
+    size_t   array_bytes;        /* bytes of sorted 32-bit keys */
+    size_t   layout_bytes;       /* bytes of the searched structure */
+    size_t   num_keys;
+    double   latency_ns;         /* dependent lookups */
+    double   mops;               /* independent lookups, million/s */
+    uint64_t lookups;
+} membench_search_result_t;
+
+/* ── B+tree node-size sweep ───────────────────────────────────────────────── */
+
+typedef struct {
+    size_t   node_bytes;         /* 64 .. 16384, power of two */
+    size_t   tree_bytes;         /* bytes of all nodes */
+    size_t   num_keys;
+    int      height;             /* levels including leaves */
+    double   lookup_ns;          /* dependent point lookups */
+    double   scan_ns_per_key;    /* range scans of 256 keys */
+    uint64_t lookups;
+} membench_btree_result_t;
+
+#define MEMBENCH_BTREE_MAX_TIERS 4
+
+typedef struct {
+    const char *name;            /* "L1", "L2", "L3", "DRAM" */
+    size_t   tree_bytes;         /* working set used for this tier */
+    size_t   best_lookup_node;   /* 0 until a result is recorded */
+    double   best_lookup_ns;
+    size_t   best_scan_node;
+    double   best_scan_ns_per_key;
+} membench_btree_tier_t;
+
+/* ── Record layout (AoS / SoA / AoSoA) ────────────────────────────────────── */
+
+#define MEMBENCH_RECORD_MAX_FIELDS 64
+
+typedef enum {
+    MEMBENCH_RECORD_AOS = 0,     /* array of structures                    */
+    MEMBENCH_RECORD_SOA,         /* structure of arrays                    */
+    MEMBENCH_RECORD_AOSOA,       /* one cache line of each field per block */
+    MEMBENCH_RECORD_NUM_LAYOUTS
+} membench_record_layout_t;
+
+typedef enum {
+    MEMBENCH_KERNEL_SCALAR = 0,
+    MEMBENCH_KERNEL_SIMD,        /* 128-bit SSE2 / NEON */
+    MEMBENCH_NUM_SCAN_KERNELS
+} membench_scan_kernel_t;
+
+typedef struct {
+    membench_record_layout_t layout;
+    membench_scan_kernel_t   kernel;
+    size_t   working_set;        /* bytes of all records */
+    size_t   num_records;
+    size_t   num_fields;         /* n */
+    size_t   field_bytes;        /* 4 or 8 */
+    size_t   scan_fields;        /* k fields summed per record */
+    double   ns_per_record;
+    double   bandwidth_gbps;     /* useful bytes: k fields per record */
+    uint64_t passes;
+} membench_record_result_t;
+
+/* ── Linked-structure traversal ───────────────────────────────────────────── */
+
+typedef enum {
+    MEMBENCH_LINKED_LIST = 0,    /* singly linked, cyclic */
+    MEMBENCH_LINKED_TREE,        /* balanced BST, preorder walk */
+    MEMBENCH_LINKED_NUM_KINDS
+} membench_linked_kind_t;
+
+typedef enum {
+    MEMBENCH_ALLOC_POOL = 0,     /* arena, packed in traversal order */
+    MEMBENCH_ALLOC_MALLOC,       /* one malloc() per node, traversal order */
+    MEMBENCH_ALLOC_SCATTERED,    /* arena, random slot per node */
+    MEMBENCH_ALLOC_NUM_ORDERS
+} membench_alloc_order_t;
+
+typedef struct {
+    membench_linked_kind_t kind;
+    membench_alloc_order_t order;
+    size_t   node_bytes;
+    size_t   num_nodes;
+    size_t   working_set;        /* num_nodes * node_bytes */
+    double   ns_per_node;
+    double   mnodes_per_s;       /* traversal throughput */
+    double   vs_pool;            /* ns_per_node / pool ns_per_node */
+    uint64_t passes;
+} membench_linked_result_t;
+
+/* ── Skewed access latency ────────────────────────────────────────────────── */
+
+typedef enum {
+    MEMBENCH_SKEW_ZIPF = 0,      /* P(rank r) ∝ 1/(r+1)^s */
+    MEMBENCH_SKEW_HOTCOLD        /* hot_prob of accesses to hot_fraction of lines */
+} membench_skew_kind_t;
+
+typedef struct {
+    membench_skew_kind_t kind;
+    double   zipf_s;             /* zipf: exponent, 0 = uniform */
+    double   hot_fraction;       /* hot/cold: fraction of lines that are hot */
+    double   hot_prob;           /* hot/cold: fraction of accesses that hit them */
+} membench_skew_t;
+
+typedef struct {
+    membench_skew_t skew;
+    size_t   buffer_size;        /* W */
+    size_t   hot90_bytes;        /* hottest lines covering 90% of accesses */
+    double   avg_latency_ns;
+    double   p50_ns;             /* percentiles over 16-access groups */
+    double   p90_ns;
+    double   p99_ns;
+    double   p999_ns;
+    uint64_t accesses;
+} membench_skew_result_t;
+
+/* ── Trace replay ─────────────────────────────────────────────────────────── */
+
+typedef enum {
+    MEMBENCH_REPLAY_DEPENDENT = 0,   /* each access waits for the previous load */
+    MEMBENCH_REPLAY_INDEPENDENT,     /* accesses overlap freely */
+    MEMBENCH_REPLAY_NUM_MODES
+} membench_replay_mode_t;
+
+typedef struct {
+    uint64_t records;
+    uint64_t reads;
+    uint64_t writes;
+    uint64_t bytes_read;         /* widened to whole 8-byte words */
+    uint64_t bytes_written;
+    double   elapsed_ns;
+    double   bandwidth_gbps;     /* (bytes_read + bytes_written) / elapsed */
+    double   ns_per_access;      /* latency when dependent */
+} membench_replay_phase_t;
+
+typedef struct {
+    membench_replay_mode_t mode;
+    size_t   buffer_size;        /* trace span, page-rounded */
+    membench_replay_phase_t  total;
+    membench_replay_phase_t *phases;
+    size_t   num_phases;
+} membench_replay_result_t;
+
+/* ── Roofline ─────────────────────────────────────────────────────────────── */
+
+typedef enum {
+    MEMBENCH_ROOF_L1 = 0,
+    MEMBENCH_ROOF_L2,
+    MEMBENCH_ROOF_L3,
+    MEMBENCH_ROOF_DRAM,
+    MEMBENCH_ROOF_NUM_LEVELS
+} membench_roof_level_t;
+
+/* Second index of the per-core-count arrays below */
+#define MEMBENCH_ROOF_ONE_CORE  0
+#define MEMBENCH_ROOF_ALL_CORES 1
+
+typedef struct {
+    const char *simd_isa;        /* "avx2-fma", "sse2", "neon" or "scalar" */
+    int      threads;            /* thread count of the all-core runs */
+    double   peak_scalar_gflops[2];
+    double   peak_simd_gflops[2];
+    size_t   level_bytes[MEMBENCH_ROOF_NUM_LEVELS];  /* 0 = not measured */
+    double   bw_gbps[MEMBENCH_ROOF_NUM_LEVELS][2];   /* GB/s, see membench_gbps() */
+} membench_roofline_t;
+
+typedef struct {
+    int      fma_per_element;    /* 0 = one add per element */
+    int      threads;
+    size_t   working_set;
+    double   flops_per_byte;
+    double   gflops;
+    double   gbps;
+} membench_roofline_point_t;
+
+/* ── Cache-blocking tile search ───────────────────────────────────────────── */
+
+typedef enum {
+    MEMBENCH_TILE_TRANSPOSE = 0,     /* B = A^T */
+    MEMBENCH_TILE_MATMUL,            /* C += A * B */
+    MEMBENCH_TILE_NUM_KERNELS
+} membench_tile_kernel_t;
+
+typedef struct {
+    membench_tile_kernel_t kernel;
+    size_t   n;                  /* matrices are n x n doubles */
+    size_t   tile;               /* 0 = unblocked baseline */
+    size_t   tile_bytes;         /* footprint of one step's blocks */
+    double   elapsed_ns;         /* per repetition */
+    double   gbps;               /* transpose: bytes read + written */
+    double   gflops;             /* matmul: 2 n^3 per repetition */
+} membench_tile_result_t;
+
+#define MEMBENCH_TILE_MAX_LEVELS     3
+#define MEMBENCH_TILE_MAX_CANDIDATES 8
+
+typedef struct {
+    const char *name;            /* "L1", "L2", "L3" */
+    size_t   level_bytes;
+    size_t   tiles[MEMBENCH_TILE_MAX_CANDIDATES];
+    size_t   num_tiles;
+    membench_tile_result_t best; /* best.tile == 0 until a result is recorded */
+} membench_tile_level_t;
+
+/* ── Instruction-side detection ───────────────────────────────────────────── */
+
+typedef enum {
+    MEMBENCH_ICACHE_LINES = 0,       /* one jump per 64 B line: L1i, L2 */
+    MEMBENCH_ICACHE_UOPS,            /* lines packed with nops: uop cache */
+    MEMBENCH_ICACHE_PAGES,           /* one jump per 4 KB page: iTLB */
+    MEMBENCH_ICACHE_NUM_SWEEPS
+} membench_icache_sweep_t;
+
+typedef struct {
+    membench_icache_sweep_t sweep;
+    size_t   stride;             /* bytes from one block to the next */
+    size_t   block_instrs;       /* instructions executed per block */
+    /* Code footprint (blocks x stride) vs ns per block; l1..l3_size_bytes
+     * are the footprints of the first three steps */
+    membench_cache_info_t curve;
+} membench_icache_result_t;
+
+/* ── Vector frequency license ─────────────────────────────────────────────── */
+
+#define MEMBENCH_LICENSE_MAX_WIDTHS 3
+#define MEMBENCH_LICENSE_SLOTS      20
+
+typedef struct {
+    int      width_bits;         /* 128, 256 or 512 */
+    const char *isa;             /* "sse2", "avx2-fma", "avx512f" or "neon" */
+    double   burst_gbps;         /* vector read bandwidth during the bursts */
+    double   base_ghz;           /* scalar probe before the burst */
+    double   base_chase_ns;      /* L1 chase step before the burst */
+    double   during_ghz;         /* probes between vector passes, second half */
+    double   during_chase_ns;
+    double   after_ghz;          /* first slot after the burst */
+    double   after_chase_ns;
+    double   drop_pct;           /* 100 * (1 - during / base) */
+    double   recovery_us;        /* burst end until back to base, -1 = not in window */
+    /* Recovery timeline: slot i covers [i, i+1) * window / SLOTS after the
+     * burst; medians over all repeats, 0 = no sample */
+    double   slot_ghz[MEMBENCH_LICENSE_SLOTS];
+    double   slot_chase_ns[MEMBENCH_LICENSE_SLOTS];
+} membench_license_width_t;
+
+typedef struct {
+    size_t   buffer_bytes;       /* vector burst working set */
+    double   burst_ms;
+    double   window_ms;          /* recovery window after each burst */
+    int      repeats;
+    size_t   num_widths;         /* widths the CPU supports */
+    membench_license_width_t widths[MEMBENCH_LICENSE_MAX_WIDTHS];
+} membench_license_t;
+
+/* ── Data-memory-dependent prefetch ───────────────────────────────────────── */
+
+typedef enum {
+    MEMBENCH_DMP_L1 = 0,
+    MEMBENCH_DMP_L2,
+    MEMBENCH_DMP_L3,
+    MEMBENCH_DMP_DRAM,
+    MEMBENCH_DMP_NUM_LEVELS
+} membench_dmp_level_t;
+
+typedef struct {
+    size_t   bytes;              /* target working set, 0 = not measured */
+    double   scan_ptr_ns;        /* per slot: array of valid pointers */
+    double   scan_masked_ns;     /* same scan, slots XOR-masked */
+    double   chase_ptr_ns;       /* per step: chain of raw pointers */
+    double   chase_masked_ns;    /* same chain, links XOR-masked */
+    double   scan_gain_pct;      /* 100 * (masked / ptr - 1) */
+    double   chase_gain_pct;
+} membench_dmp_row_t;
+
+typedef struct {
+    int      active;             /* a level past L1 gained >= threshold */
+    double   threshold_pct;
+    uint64_t accesses;           /* per timed run */
+    int      repeats;            /* medians over this many runs of each */
+    membench_dmp_row_t levels[MEMBENCH_DMP_NUM_LEVELS];
+} membench_dmp_t;
+
 /* ── Benchmark functions ──────────────────────────────────────────────────── */
 
 /**
@@ -64,17 +384,246 @@ int membench_cpu_read_bandwidth(size_t buffer_size, uint64_t iterations,
 int membench_cpu_write_bandwidth(size_t buffer_size, uint64_t iterations,
                                  membench_bandwidth_result_t *result);
 
+/**
+ * Same as membench_cpu_write_bandwidth() with non-temporal (streaming)
+ * stores that bypass the caches. Returns -1 where the ISA has none.
+ */
+int membench_cpu_nt_write_bandwidth(size_t buffer_size, uint64_t iterations,
+                                    membench_bandwidth_result_t *result);
+
+/** Upper end of the full cache-detect sweep. */
+#define MEMBENCH_DETECT_MAX_BYTES ((size_t)512 * 1024 * 1024)
+
 /**
  * Auto-detect cache hierarchy by sweeping buffer sizes.
  * Caller must call membench_cache_info_free() on the result.
  */
 int membench_cpu_detect_cache(membench_cache_info_t *info);
 
+/**
+ * Shorter detection sweep: sizes up to `max_bytes` only, and about
+ * `visits` pointer-chase steps per size (0 = the default 100 million).
+ */
+int membench_cpu_detect_cache_range(size_t max_bytes, uint64_t visits,
+                                    membench_cache_info_t *info);
+
 /**
  * Free arrays inside a cache_info_t.
  */
 void membench_cache_info_free(membench_cache_info_t *info);
 
+/**
+ * Logarithmic size sweep from `min_bytes` to `max_bytes` with
+ * `steps_per_octave` points per doubling (the cache-detect sweep).
+ * Returns the number of sizes; caller frees *out_sizes with free().
+ */
+size_t membench_cpu_generate_sizes(size_t min_bytes, size_t max_bytes,
+                                   int steps_per_octave, size_t **out_sizes);
+
+/**
+ * Build an open-addressing table of ~`table_bytes` using `scheme`, fill it to
+ * `load_factor` (0 < lf < 1) and time `lookups` hit and miss lookups, both
+ * as a dependent chain (latency) and independently (throughput).
+ */
+int membench_cpu_hash_probe(membench_hash_scheme_t scheme, size_t table_bytes,
+                            double load_factor, uint64_t lookups,
+                            membench_hash_result_t *result);
+
+/** Short name of a hash scheme ("linear", "quadratic", ...). */
+const char *membench_hash_scheme_name(membench_hash_scheme_t scheme);
+
+/**
+ * Lay out `array_bytes` of sorted 32-bit keys as `layout` and time
+ * `lookups` lower-bound searches, dependent (latency) and independent
+ * (throughput).
+ */
+int membench_cpu_search_layout(membench_search_layout_t layout,
+                               size_t array_bytes, uint64_t lookups,
+                               membench_search_result_t *result);
+
+/** Short name of a search layout ("branchy", "eytzinger", ...). */
+const char *membench_search_layout_name(membench_search_layout_t layout);
+
+/**
+ * Bulk-load a B+tree of ~`tree_bytes` with `node_bytes` nodes and time
+ * `lookups` dependent point lookups plus lookups/16 range scans.
+ */
+int membench_cpu_btree(size_t node_bytes, size_t tree_bytes, uint64_t lookups,
+                       membench_btree_result_t *result);
+
+/**
+ * Derive one working-set tier per detected cache level plus DRAM from a
+ * membench_cpu_detect_cache() result. Returns the number of tiers.
+ */
+size_t membench_cpu_btree_tiers(const membench_cache_info_t *cache,
+                                membench_btree_tier_t tiers[MEMBENCH_BTREE_MAX_TIERS]);
+
+/** Fold one sweep result into a tier's best-node recommendation. */
+void membench_btree_tier_update(membench_btree_tier_t *tier,
+                                const membench_btree_result_t *r);
+
+/**
+ * Lay out ~`working_set` bytes of records with `num_fields` fields of
+ * `field_bytes` (4 or 8) as `layout` and time `passes` scans summing
+ * `scan_fields` of them per record with the given kernel.  The SIMD kernel
+ * is unavailable (returns -1) on architectures without SSE2 or NEON.
+ */
+int membench_cpu_record_layout(membench_record_layout_t layout,
+                               membench_scan_kernel_t kernel,
+                               size_t num_fields, size_t field_bytes,
+                               size_t scan_fields, size_t working_set,
+                               uint64_t passes,
+                               membench_record_result_t *result);
+
+/** Short name of a record layout ("aos", "soa", "aosoa"). */
+const char *membench_record_layout_name(membench_record_layout_t layout);
+
+/** Short name of a scan kernel ("scalar", "simd"). */
+const char *membench_scan_kernel_name(membench_scan_kernel_t kernel);
+
+/**
+ * Build a `kind` structure of `working_set / node_bytes` nodes once per
+ * allocation order and time `passes` full traversals of each.  Fills one
+ * result per membench_alloc_order_t, each with its slowdown versus pool.
+ */
+int membench_cpu_linked(membench_linked_kind_t kind, size_t node_bytes,
+                        size_t working_set, uint64_t passes,
+                        membench_linked_result_t results[MEMBENCH_ALLOC_NUM_ORDERS]);
+
+/**
+ * Automatic pass count for membench_cpu_linked(): about 4M node visits,
+ * at least 1.  Working sets smaller than one node count as one node.
+ */
+uint64_t membench_cpu_linked_auto_passes(size_t node_bytes, size_t working_set);
+
+/** Short name of a linked structure ("list", "tree"). */
+const char *membench_linked_kind_name(membench_linked_kind_t kind);
+
+/** Short name of an allocation order ("pool", "malloc", "scattered"). */
+const char *membench_alloc_order_name(membench_alloc_order_t order);
+
+/**
+ * Dependent-load latency over a `buffer_size` buffer with cache-line
+ * indices drawn from `skew` instead of uniformly.  Times `accesses`
+ * loads for the average, then the same number again in small groups
+ * for the percentiles.
+ */
+int membench_cpu_skewed_latency(const membench_skew_t *skew, size_t buffer_size,
+                                uint64_t accesses, membench_skew_result_t *result);
+
+/**
+ * Replay the trace at `path` (membench/trace.h format) over a buffer the
+ * size of its address span, refusing spans above `max_buffer` (0 = no
+ * limit). Caller must call membench_replay_result_free() on success.
+ */
+int membench_cpu_replay(const char *path, membench_replay_mode_t mode,
+                        size_t max_buffer, membench_replay_result_t *result);
+
+/** Free the phase array inside a replay result. */
+void membench_replay_result_free(membench_replay_result_t *result);
+
+/**
+ * Run `kernel` on n x n matrices `reps` times, blocked in `tile` x `tile`
+ * tiles (0, or >= n, for the unblocked loop). The output is checked.
+ */
+int membench_cpu_tile(membench_tile_kernel_t kernel, size_t n, size_t tile,
+                      uint64_t reps, membench_tile_result_t *result);
+
+/** Bytes of matrix data one tile step keeps live (2 or 3 blocks). */
+size_t membench_tile_footprint(membench_tile_kernel_t kernel, size_t tile);
+
+/**
+ * Seed tile candidates for each detected cache level: the tile whose
+ * footprint is half the level, and neighbours up to 2x either side, all
+ * below n. Returns the number of levels filled.
+ */
+size_t membench_cpu_tile_levels(const membench_cache_info_t *cache,
+                                membench_tile_kernel_t kernel, size_t n,
+                                membench_tile_level_t levels[MEMBENCH_TILE_MAX_LEVELS]);
+
+/** Keep `r` as the level's best tile if it beats the current one. */
+void membench_tile_level_update(membench_tile_level_t *level,
+                                const membench_tile_result_t *r);
+
+const char *membench_tile_kernel_name(membench_tile_kernel_t kernel);
+
+/**
+ * Roofline ceilings: peak scalar and SIMD FLOP/s (independent multiply-add
+ * chains in registers) and read bandwidth with the working set sized for
+ * each level in `level_bytes` (0 = skip), on one core and on `threads`
+ * cores.  L1/L2 sizes are per thread; L3 and DRAM are split across threads.
+ */
+int membench_cpu_roofline(const size_t level_bytes[MEMBENCH_ROOF_NUM_LEVELS],
+                          int threads, membench_roofline_t *result);
+
+/**
+ * Stream `working_set` bytes (split across `threads`) doing
+ * `fma_per_element` dependent multiply-adds on every double loaded, i.e.
+ * an arithmetic intensity of 2*fma/8 FLOP/byte (1/8 when fma is 0).
+ */
+int membench_cpu_roofline_kernel(size_t working_set, int fma_per_element,
+                                 int threads, membench_roofline_point_t *result);
+
+/**
+ * Instruction-side detection: generate a chain of jump blocks `stride`
+ * bytes apart, linked in random order and run as code, for code
+ * footprints up to `max_footprint`; time about `visits` blocks per
+ * footprint (0 = default).  x86-64 and ARM64 only; returns -2 elsewhere,
+ * or where the OS refuses executable memory, and -1 on allocation failure
+ * or cancellation.  Free with membench_cache_info_free(&result->curve).
+ */
+int membench_cpu_icache_sweep(membench_icache_sweep_t sweep, size_t max_footprint,
+                              uint64_t visits, membench_icache_result_t *result);
+
+/**
+ * Frequency license impact of wide vector code.  For each vector width the
+ * CPU supports, time a scalar probe (dependent integer multiply-adds for
+ * the effective clock, an L1-resident chase for latency) before, during
+ * and for `window_ms` after `burst_ms` of vector multiply-adds streaming
+ * `buffer_bytes`.  Takes about 5 x (burst + 2 x window) per width.
+ */
+int membench_cpu_vector_license(size_t buffer_bytes, double burst_ms, double window_ms,
+                                membench_license_t *result);
+
+/**
+ * Data-memory-dependent prefetch check.  For each level in `level_bytes`
+ * (0 = skip), time a scan of a slot array that gathers random lines of a
+ * working set, and a chase through the same lines, once with the slots
+ * and links stored as valid pointers and once XOR-masked so they do not
+ * look like pointers.  The code is identical; only memory contents differ,
+ * so a speed-up of the pointer runs is the prefetcher reading them.
+ * `accesses` per timed run, 0 = default.
+ */
+int membench_cpu_dmp(const size_t level_bytes[MEMBENCH_DMP_NUM_LEVELS], uint64_t accesses,
+                     membench_dmp_t *result);
+
+/**
+ * Register the read/write latency and bandwidth tests with the benchmark
+ * registry (see registry.h) as "read-latency", "write-latency", "read-bw"
+ * and "write-bw". Returns 0 on success.
+ */
+int membench_cpu_register_builtins(void);
+
+/**
+ * Automatic iteration count for a latency (chase) or bandwidth (stream)
+ * run over `buffer_size` bytes: ~20M dependent accesses or ~5M elements,
+ * at least 2 passes.
+ */
+uint64_t membench_cpu_auto_iterations(size_t buffer_size, int is_latency);
+
+/**
+ * Loop variant the built-in test `bench` ("read-latency", "read-bw") runs
+ * for `buffer_size` bytes, e.g. "chase-x32"; NULL for tests with one loop.
+ */
+const char *membench_cpu_kernel_name(const char *bench, size_t buffer_size);
+
+/**
+ * Quick health-check probes.  The caller sets the probe sizes (l1_bytes
+ * .. dram_bytes; l3_bytes may be 0) and `threads`; the rest is filled in.
+ * Takes a few seconds.  Returns 0 on success.
+ */
+int membench_cpu_quick_probe(membench_quick_probe_t *probe);
+
 #ifdef __cplusplus
 }
 #endif
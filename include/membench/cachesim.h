@@ -0,0 +1,118 @@
+/**
+ * membench/cachesim.h — Offline multi-level cache simulator.
+ *
+ * Replays addresses (typically a membench trace, see trace.h) through a
+ * model of a host's data-cache hierarchy and estimates the average access
+ * latency from that host's measured per-level latencies, so miss rates can
+ * be predicted without running the workload on the host.
+ *
+ * The hierarchy is described by a cache profile: line size, then per level
+ * size, associativity and load-to-use latency, plus memory latency.  A
+ * profile is built from a cache-detect result and sysinfo, and can be
+ * saved to and loaded from a small "key = value" text file.
+ */
+#ifndef MEMBENCH_CACHESIM_H
+#define MEMBENCH_CACHESIM_H
+
+#include "bench_cpu.h"
+#include "sysinfo.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define MEMBENCH_SIM_MAX_LEVELS 4
+#define MEMBENCH_SIM_MAX_WAYS   64
+
+typedef enum {
+    MEMBENCH_SIM_LRU = 0,        /* true LRU per set */
+    MEMBENCH_SIM_PLRU,           /* bit-PLRU: one MRU bit per way */
+    MEMBENCH_SIM_NUM_POLICIES
+} membench_sim_policy_t;
+
+typedef struct {
+    size_t   size_bytes;
+    int      ways;
+    double   latency_ns;         /* load-to-use latency of a hit here */
+} membench_sim_level_cfg_t;
+
+typedef struct {
+    size_t   line_bytes;
+    size_t   num_levels;
+    membench_sim_level_cfg_t level[MEMBENCH_SIM_MAX_LEVELS];
+    double   memory_latency_ns;
+} membench_cache_profile_t;
+
+typedef struct {
+    uint64_t accesses;           /* line accesses that reached this level */
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t writebacks;         /* dirty lines evicted from this level */
+} membench_sim_level_stats_t;
+
+typedef struct {
+    membench_sim_policy_t policy;
+    size_t   num_levels;
+    membench_sim_level_stats_t level[MEMBENCH_SIM_MAX_LEVELS];
+    uint64_t accesses;           /* line accesses issued */
+    uint64_t memory_reads;       /* misses in every level */
+    uint64_t memory_writes;      /* dirty evictions from the last level */
+    double   est_avg_latency_ns; /* per line access, serialised */
+    double   est_total_ns;
+} membench_sim_result_t;
+
+/* ── Profiles ─────────────────────────────────────────────────────────────── */
+
+/**
+ * Build a profile from a membench_cpu_detect_cache() result: level sizes
+ * from `info` (falling back to `si`), associativity and line size from
+ * `si` (falling back to typical values), and each level's latency from
+ * the plateau of the measured latency curve. Returns 0 on success.
+ */
+int membench_cache_profile_from_info(const membench_cache_info_t *info,
+                                     const membench_sysinfo_t *si,
+                                     membench_cache_profile_t *profile);
+
+/** Write a profile as "key = value" lines. Returns 0 on success. */
+int membench_cache_profile_save(const char *path,
+                                const membench_cache_profile_t *profile);
+
+/** Read a profile written by membench_cache_profile_save(). */
+int membench_cache_profile_load(const char *path,
+                                membench_cache_profile_t *profile);
+
+/* ── Simulator ────────────────────────────────────────────────────────────── */
+
+typedef struct membench_cachesim membench_cachesim_t;
+
+/** Returns NULL if the profile is inconsistent or allocation fails. */
+membench_cachesim_t *membench_cachesim_create(const membench_cache_profile_t *profile,
+                                              membench_sim_policy_t policy);
+
+/** Simulate one access of `size` bytes; every line it touches is counted. */
+void membench_cachesim_access(membench_cachesim_t *sim, uint64_t addr,
+                              uint32_t size, int is_write);
+
+/** Counters so far plus the latency estimate. */
+void membench_cachesim_result(const membench_cachesim_t *sim,
+                              membench_sim_result_t *result);
+
+void membench_cachesim_destroy(membench_cachesim_t *sim);
+
+/** Short name of a replacement policy ("lru", "plru"). */
+const char *membench_sim_policy_name(membench_sim_policy_t policy);
+
+/** Simulate every access of the trace at `path`. Returns 0 on success. */
+int membench_cachesim_run_trace(const char *path,
+                                const membench_cache_profile_t *profile,
+                                membench_sim_policy_t policy,
+                                membench_sim_result_t *result);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MEMBENCH_CACHESIM_H */
@@ -0,0 +1,75 @@
+/**
+ * membench/checkpoint.h — Cancellation and checkpoint / resume.
+ *
+ * Cancellation: membench_cancel_install() routes SIGINT, SIGTERM and (on
+ * POSIX) SIGHUP to a flag.  Long loops poll membench_cancel_requested()
+ * between measurement points and unwind normally, so buffers are freed
+ * and results already printed stay flushed.  A second signal falls back
+ * to the default action and ends the process at once.
+ *
+ * Checkpoint: a text file with one line per finished point,
+ *
+ *     <key> <n> <v1> ... <vn>
+ *
+ * after a header that records the command line it belongs to.  Lines are
+ * flushed as they are written; a torn last line is ignored on load, so
+ * the file is valid after any kind of interruption.
+ */
+#ifndef MEMBENCH_CHECKPOINT_H
+#define MEMBENCH_CHECKPOINT_H
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define MEMBENCH_CHECKPOINT_KEY_LEN  128
+
+/** Install the signal handlers. Returns 0 on success. */
+int membench_cancel_install(void);
+
+/** Signal number that requested cancellation, 0 if none. */
+int membench_cancel_requested(void);
+
+/** Request cancellation programmatically (as if `sig` had arrived). */
+void membench_cancel_request(int sig);
+
+void membench_cancel_reset(void);
+
+typedef struct membench_checkpoint membench_checkpoint_t;
+
+/**
+ * Open a checkpoint for the run described by `config` (an opaque string,
+ * normally the command line).  With `resume` set, points already in
+ * `path` are loaded and new ones appended; a missing file starts empty.
+ * Without it the file is truncated.  Returns NULL with `err` set when the
+ * file cannot be written or belongs to a different `config`.
+ */
+membench_checkpoint_t *membench_checkpoint_open(const char *path, const char *config,
+                                                int resume, char *err, size_t err_len);
+
+void membench_checkpoint_close(membench_checkpoint_t *cp);
+
+/**
+ * Values stored for `key`, or NULL (also when `cp` is NULL).  `*n` gets
+ * the value count.  The pointer stays valid until close.
+ */
+const double *membench_checkpoint_find(const membench_checkpoint_t *cp, const char *key,
+                                       size_t *n);
+
+/** Append a finished point and flush it to disk. Returns 0 on success. */
+int membench_checkpoint_record(membench_checkpoint_t *cp, const char *key,
+                               const double *vals, size_t n);
+
+/** Points loaded from the file when it was opened. */
+size_t membench_checkpoint_loaded(const membench_checkpoint_t *cp);
+
+/** Points known to the checkpoint: loaded plus recorded. */
+size_t membench_checkpoint_count(const membench_checkpoint_t *cp);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MEMBENCH_CHECKPOINT_H */
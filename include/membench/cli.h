@@ -22,7 +22,23 @@ typedef enum {
     MEMBENCH_TEST_LATENCY     = (1 << 0),
     MEMBENCH_TEST_BANDWIDTH   = (1 << 1),
     MEMBENCH_TEST_CACHE_DETECT = (1 << 2),
-    MEMBENCH_TEST_ALL         = 0x7
+    MEMBENCH_TEST_ALL         = 0x7,
+    /* Extended tests: opt-in only, not part of "all" */
+    MEMBENCH_TEST_HASH_PROBE  = (1 << 3),
+    MEMBENCH_TEST_SEARCH      = (1 << 4),
+    MEMBENCH_TEST_BTREE       = (1 << 5),
+    MEMBENCH_TEST_RECORD_LAYOUT = (1 << 6),
+    MEMBENCH_TEST_LINKED      = (1 << 7),
+    MEMBENCH_TEST_SKEWED      = (1 << 8),
+    MEMBENCH_TEST_REPLAY      = (1 << 9),
+    MEMBENCH_TEST_CACHE_SIM   = (1 << 10),
+    MEMBENCH_TEST_ROOFLINE    = (1 << 11),
+    MEMBENCH_TEST_TILE_TUNE   = (1 << 12),
+    MEMBENCH_TEST_TUNING      = (1 << 13),
+    MEMBENCH_TEST_QUICK       = (1 << 14),
+    MEMBENCH_TEST_LICENSE     = (1 << 15),
+    MEMBENCH_TEST_ICACHE      = (1 << 16),
+    MEMBENCH_TEST_DMP         = (1 << 17)
 } membench_test_flags_t;
 
 typedef enum {
@@ -38,6 +54,28 @@ typedef struct {
     size_t                buffer_size;  /* 0 = use defaults */
     uint64_t              iterations;   /* 0 = auto */
     int                   gpu_device;   /* -1 = auto-detect first */
+    size_t                record_fields; /* record-layout: fields per record */
+    size_t                field_bytes;  /* record-layout: 4 or 8 */
+    size_t                scan_fields;  /* record-layout: fields read per record */
+    double                zipf_s;       /* skewed: single Zipf exponent, <0 = sweep */
+    const char           *trace_path;   /* replay: trace file, NULL = none */
+    int                   replay_order; /* replay: -1 both, 0 dependent, 1 independent */
+    const char           *profile_path; /* cache-sim: load this profile, NULL = detect */
+    const char           *save_profile; /* cache-sim: write the profile here */
+    int                   sim_policy;   /* cache-sim: -1 both, 0 lru, 1 plru */
+    int                   threads;      /* roofline: all-core thread count, 0 = auto */
+    double                intensity;    /* roofline: one kernel FLOP/byte, <0 = sweep */
+    const char           *svg_path;     /* roofline: write an SVG chart here */
+    double                license_ms;   /* license: recovery window after a burst, 0 = default */
+    const char           *tuning_path;  /* tuning: write <path>.h and <path>.json */
+    const char           *plugin_path;  /* shared object with extra benchmarks */
+    int                   repeat;       /* registry runs per size, 0 = auto */
+    const char           *job_path;     /* suite: INI job file, NULL = none */
+    const char           *checkpoint_path; /* record finished points here */
+    bool                  resume;       /* skip points already in checkpoint_path */
+    const char           *timeline_path; /* Chrome trace-event JSON, NULL = off */
+    bool                  energy;       /* RAPL energy around latency/bandwidth points */
+    double                monitor_pct;  /* clock monitor throttle threshold %, 0 = off */
     bool                  verbose;
     bool                  show_help;
 } membench_options_t;
@@ -47,6 +85,11 @@ typedef struct {
  */
 int membench_cli_parse(int argc, char **argv, membench_options_t *opts);
 
+/**
+ * Parse a size string like "1K", "32M", "1G" into bytes; 0 if invalid.
+ */
+size_t membench_parse_size(const char *str);
+
 /**
  * Print usage information.
  */
@@ -0,0 +1,86 @@
+/**
+ * membench/context.h — Reentrant library API for embedding probes.
+ *
+ * A context holds everything a probe needs between calls: the RNG that
+ * lays out pointer chains, the cache line size, the timer resolution, an
+ * optional cap on buffer sizes, and the last error message.  Calls on a
+ * context never print and never touch process-wide mutable state, so
+ * each thread can drive its own context concurrently.  A single context
+ * must not be used from two threads at once.
+ *
+ * Results are plain structs owned by the caller; nothing needs freeing
+ * except the context itself.
+ */
+#ifndef MEMBENCH_CONTEXT_H
+#define MEMBENCH_CONTEXT_H
+
+#include "bench_cpu.h"
+#include "sysinfo.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define MEMBENCH_CTX_MAX_SAMPLES 128
+
+typedef struct membench_ctx membench_ctx_t;
+
+typedef struct {
+    uint64_t seed;               /* pointer-chain RNG seed, 0 = 42 like the CLI */
+    size_t   max_buffer_bytes;   /* refuse larger buffers, 0 = no limit */
+} membench_ctx_config_t;
+
+/** Cache detection result with caller-owned sample storage. */
+typedef struct {
+    size_t l1_size_bytes;        /* 0 if not detected */
+    size_t l2_size_bytes;
+    size_t l3_size_bytes;
+    size_t num_samples;
+    size_t sample_sizes[MEMBENCH_CTX_MAX_SAMPLES];
+    double sample_latencies[MEMBENCH_CTX_MAX_SAMPLES];
+} membench_ctx_cache_t;
+
+/** Create a context; `cfg` may be NULL for defaults. NULL on failure. */
+membench_ctx_t *membench_ctx_create(const membench_ctx_config_t *cfg);
+
+void membench_ctx_destroy(membench_ctx_t *ctx);
+
+/** Message for the last failed call on `ctx`, "" if none. */
+const char *membench_ctx_error(const membench_ctx_t *ctx);
+
+double membench_ctx_timer_resolution_ns(const membench_ctx_t *ctx);
+
+/** Same as membench_sysinfo_get(), for symmetry. Returns 0 on success. */
+int membench_ctx_sysinfo(membench_ctx_t *ctx, membench_sysinfo_t *info);
+
+/*
+ * Probes.  `iterations` = 0 picks the CLI's automatic count.  Each chase
+ * draws a fresh seed from the context's RNG, so two contexts created with
+ * the same seed make the same sequence of chains.  Return 0 on success,
+ * -1 with membench_ctx_error() set.
+ */
+int membench_ctx_read_latency(membench_ctx_t *ctx, size_t buffer_size,
+                              uint64_t iterations, membench_latency_result_t *result);
+int membench_ctx_write_latency(membench_ctx_t *ctx, size_t buffer_size,
+                               uint64_t iterations, membench_latency_result_t *result);
+int membench_ctx_read_bandwidth(membench_ctx_t *ctx, size_t buffer_size,
+                                uint64_t iterations, membench_bandwidth_result_t *result);
+int membench_ctx_write_bandwidth(membench_ctx_t *ctx, size_t buffer_size,
+                                 uint64_t iterations, membench_bandwidth_result_t *result);
+
+/**
+ * Cache detection up to `max_bytes` (0 = MEMBENCH_DETECT_MAX_BYTES) with
+ * about `visits` chase steps per size (0 = default). The sweep is pinned
+ * to the CPU the calling thread is on, not to core 0.
+ */
+int membench_ctx_detect_cache(membench_ctx_t *ctx, size_t max_bytes, uint64_t visits,
+                              membench_ctx_cache_t *result);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MEMBENCH_CONTEXT_H */
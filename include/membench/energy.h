@@ -0,0 +1,82 @@
+/**
+ * membench/energy.h — Energy counters (Linux powercap / RAPL).
+ *
+ * RAPL keeps a running energy count per package and, on most server
+ * parts, per DRAM controller.  Linux exposes them under
+ * /sys/class/powercap as intel-rapl:N (package-N) and intel-rapl:N:M
+ * (dram, core, uncore).  Sampling both before and after a benchmark gives
+ * the joules it drew; package and DRAM domains are summed over sockets.
+ *
+ * The counters wrap at max_energy_range_uj and update about once a
+ * millisecond.  Since Linux 5.10 energy_uj is readable by root only;
+ * membench_energy_open() then fails and callers carry on without energy.
+ */
+#ifndef MEMBENCH_ENERGY_H
+#define MEMBENCH_ENERGY_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define MEMBENCH_ENERGY_MAX_DOMAINS 16
+#define MEMBENCH_ENERGY_PATH_LEN    256
+
+typedef enum {
+    MEMBENCH_ENERGY_PACKAGE = 0,
+    MEMBENCH_ENERGY_DRAM
+} membench_energy_domain_t;
+
+typedef struct {
+    size_t num_domains;
+    struct {
+        membench_energy_domain_t kind;
+        char     path[MEMBENCH_ENERGY_PATH_LEN];   /* .../energy_uj */
+        uint64_t max_range_uj;                     /* wrap point, 0 = unknown */
+    } domains[MEMBENCH_ENERGY_MAX_DOMAINS];
+} membench_energy_t;
+
+typedef struct {
+    uint64_t t_ns;
+    uint64_t uj[MEMBENCH_ENERGY_MAX_DOMAINS];
+} membench_energy_sample_t;
+
+typedef struct {
+    double seconds;              /* wall time between the samples */
+    double package_j;
+    double dram_j;               /* 0 without a DRAM domain */
+    int    has_dram;
+    double watts;                /* (package + DRAM) / seconds */
+    double timed_j;              /* watts x the timed part of the interval */
+    double nj_per_byte;          /* timed_j / bytes, 0 if no bytes */
+    double nj_per_op;            /* timed_j / ops, 0 if no ops */
+} membench_energy_result_t;
+
+/**
+ * Find readable package and DRAM domains under `root` (NULL =
+ * /sys/class/powercap).  Returns 0 if at least one package domain can be
+ * read; otherwise -1 with the reason in `err`.
+ */
+int membench_energy_open(membench_energy_t *e, const char *root, char *err, size_t err_len);
+
+/** Read every domain's counter. */
+void membench_energy_sample(const membench_energy_t *e, membench_energy_sample_t *s);
+
+/**
+ * Energy between samples `a` and `b`, handling counter wrap.  Setup and
+ * warm-up run between the samples too, so the per-byte and per-op figures
+ * charge the average power only over `timed_ns` of measurement.  Returns
+ * -1, with `r` zeroed, if a counter went backwards and its wrap point is
+ * unknown.
+ */
+int membench_energy_diff(const membench_energy_t *e, const membench_energy_sample_t *a,
+                         const membench_energy_sample_t *b, uint64_t timed_ns,
+                         uint64_t bytes, uint64_t ops, membench_energy_result_t *r);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MEMBENCH_ENERGY_H */
@@ -0,0 +1,92 @@
+/**
+ * membench/health.h — Quick health check: probe results against expected
+ * ranges.
+ *
+ * The probes (membench_cpu_quick_probe in bench_cpu.h) take a handful of
+ * measurements in a few seconds: one latency point inside each cache
+ * level and in DRAM, single- and all-core DRAM read bandwidth, and the
+ * L2 latency seen by every core.  This module compares them with ranges
+ * for the detected CPU family and grades each check pass / warn / fail.
+ *
+ * The ranges are deliberately wide.  They are meant to catch a DIMM
+ * running at a fraction of its speed, a BIOS that disabled a cache or a
+ * memory channel, or one core much slower than its siblings, not to rank
+ * healthy machines.
+ */
+#ifndef MEMBENCH_HEALTH_H
+#define MEMBENCH_HEALTH_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define MEMBENCH_QUICK_MAX_CORES   256
+#define MEMBENCH_HEALTH_MAX_CHECKS 16
+
+/** Raw measurements; 0 means "not measured". */
+typedef struct {
+    size_t   l1_bytes, l2_bytes, l3_bytes, dram_bytes;   /* probe buffer sizes */
+    double   l1_ns, l2_ns, l3_ns, dram_ns;
+    double   bw_1core_gbps;
+    double   bw_allcore_gbps;
+    int      threads;                                    /* all-core thread count */
+    int      num_cores;                                  /* per-core samples below */
+    double   core_l2_ns[MEMBENCH_QUICK_MAX_CORES];
+    uint64_t elapsed_ns;
+} membench_quick_probe_t;
+
+/** Pass range per measurement; outside it by up to `warn_factor` is a warning. */
+typedef struct {
+    const char *family;          /* matched against the CPU model string */
+    double l1_ns[2];             /* [lo, hi] */
+    double l2_ns[2];
+    double l3_ns[2];
+    double dram_ns[2];
+    double bw_1core_gbps;        /* minimum */
+    double allcore_scaling;      /* minimum all-core / 1-core bandwidth */
+    double core_spread;          /* maximum slowest-core / median L2 latency */
+    double warn_factor;
+} membench_health_expect_t;
+
+typedef enum {
+    MEMBENCH_HEALTH_PASS = 0,
+    MEMBENCH_HEALTH_WARN,
+    MEMBENCH_HEALTH_FAIL,
+    MEMBENCH_HEALTH_SKIP
+} membench_health_status_t;
+
+typedef struct {
+    const char *name;            /* e.g. "dram-latency" */
+    const char *unit;
+    double      value;
+    double      lo, hi;          /* pass range; lo or hi 0 = unbounded */
+    membench_health_status_t status;
+    char        note[96];
+} membench_health_check_t;
+
+typedef struct {
+    const char *family;
+    size_t      num_checks;
+    membench_health_check_t checks[MEMBENCH_HEALTH_MAX_CHECKS];
+    membench_health_status_t overall;      /* worst non-skip status */
+    uint64_t    elapsed_ns;
+} membench_health_report_t;
+
+/** Expected ranges for `cpu_model` (falls back to a generic entry). */
+const membench_health_expect_t *membench_health_expect_for(const char *cpu_model);
+
+/** Grade `probe` against `expect`. */
+void membench_health_evaluate(const membench_quick_probe_t *probe,
+                              const membench_health_expect_t *expect,
+                              membench_health_report_t *report);
+
+const char *membench_health_status_name(membench_health_status_t status);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MEMBENCH_HEALTH_H */
@@ -0,0 +1,22 @@
+/**
+ * membench/membench.h — Umbrella header for the membench library.
+ *
+ * Embedders link libmembench (static or shared) and include this header.
+ * Start with context.h: it is the reentrant, print-free entry point.
+ */
+#ifndef MEMBENCH_MEMBENCH_H
+#define MEMBENCH_MEMBENCH_H
+
+#include "platform.h"
+#include "timer.h"
+#include "alloc.h"
+#include "sysinfo.h"
+#include "bench_cpu.h"
+#include "registry.h"
+#include "context.h"
+
+#define MEMBENCH_VERSION_MAJOR 0
+#define MEMBENCH_VERSION_MINOR 1
+#define MEMBENCH_VERSION_PATCH 0
+
+#endif /* MEMBENCH_MEMBENCH_H */
@@ -0,0 +1,78 @@
+/**
+ * membench/monitor.h — Clock and temperature monitor for long runs.
+ *
+ * A background thread samples the CPU clock and temperature every few
+ * milliseconds while benchmarks run.  Each measurement opens a window;
+ * when it closes, the window reports the lowest and highest clock and
+ * temperature seen, and whether the clock fell more than the throttle
+ * threshold below the window's peak.  A result averaged over throttled
+ * and unthrottled time is then marked rather than silently accepted.
+ * It takes two low samples to mark a window: a single one is more often
+ * a preempted probe than a throttled core.
+ *
+ * Clock source, in order of preference (Linux):
+ *   - cpufreq: the highest scaling_cur_freq over all CPUs in each sample,
+ *     i.e. the clock of the busiest core, since idle cores clock down
+ *   - probe: a 20 us dependent multiply-add chain timed on the monitor
+ *     thread, reported as MHz assuming 4 cycles per step; the scale is
+ *     approximate, but drops are real
+ * Temperature: the hottest /sys/class/thermal zone, when there is one.
+ *
+ * Process-wide, like the timeline recorder.  Windows must not overlap.
+ * Other platforms: membench_monitor_start() fails.
+ */
+#ifndef MEMBENCH_MONITOR_H
+#define MEMBENCH_MONITOR_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define MEMBENCH_MONITOR_INTERVAL_MS    50
+#define MEMBENCH_MONITOR_THRESHOLD_PCT  10.0
+
+typedef enum {
+    MEMBENCH_MONITOR_NONE = 0,
+    MEMBENCH_MONITOR_CPUFREQ,
+    MEMBENCH_MONITOR_PROBE
+} membench_monitor_source_t;
+
+typedef struct {
+    uint32_t samples;
+    double   freq_min_mhz;
+    double   freq_max_mhz;
+    double   temp_min_c;         /* 0 when no thermal zone */
+    double   temp_max_c;
+    double   drop_pct;           /* (max - min) / max, % */
+    int      throttled;          /* at least two samples below the threshold */
+} membench_monitor_stats_t;
+
+/**
+ * Start sampling every `interval_ms` (0 = MEMBENCH_MONITOR_INTERVAL_MS);
+ * windows whose clock drops more than `threshold_pct` are marked
+ * throttled.  Returns 0 on success, -1 with the reason in `err`.
+ */
+int membench_monitor_start(unsigned interval_ms, double threshold_pct,
+                           char *err, size_t err_len);
+
+void membench_monitor_stop(void);
+
+/** Clock source in use, NONE when stopped. */
+membench_monitor_source_t membench_monitor_source(void);
+
+const char *membench_monitor_source_name(membench_monitor_source_t source);
+
+/** Open a measurement window (takes one sample straight away). */
+void membench_monitor_begin(void);
+
+/** Close the window (one more sample) and report it. */
+void membench_monitor_end(membench_monitor_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MEMBENCH_MONITOR_H */
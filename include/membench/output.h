@@ -7,6 +7,15 @@
 #include "membench/bench_cpu.h"
 #include "membench/bench_gpu.h"
 #include "membench/cli.h"
+#include "membench/cachesim.h"
+#include "membench/tuning.h"
+#include "membench/registry.h"
+#include "membench/suite.h"
+#include "membench/sysinfo.h"
+#include "membench/profile.h"
+#include "membench/health.h"
+#include "membench/energy.h"
+#include "membench/monitor.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -21,6 +30,121 @@ void membench_print_bandwidth(const membench_bandwidth_result_t *r,
 void membench_print_cache_info(const membench_cache_info_t *info,
                                membench_output_fmt_t fmt);
 
+void membench_print_hash_probe(const membench_hash_result_t *r,
+                               const char *label, membench_output_fmt_t fmt);
+
+void membench_print_search(const membench_search_result_t *r,
+                           const char *label, membench_output_fmt_t fmt);
+
+void membench_print_btree(const membench_btree_result_t *r,
+                          const char *label, membench_output_fmt_t fmt);
+
+void membench_print_btree_tier(const membench_btree_tier_t *tier,
+                               membench_output_fmt_t fmt);
+
+void membench_print_record_layout(const membench_record_result_t *r,
+                                  const char *layout, const char *kernel,
+                                  membench_output_fmt_t fmt);
+
+void membench_print_linked(const membench_linked_result_t *r,
+                           const char *kind, const char *order,
+                           membench_output_fmt_t fmt);
+
+void membench_print_skewed(const membench_skew_result_t *r,
+                           membench_output_fmt_t fmt);
+
+void membench_print_cache_profile(const membench_cache_profile_t *p,
+                                  membench_output_fmt_t fmt);
+
+/** Per-level lines followed by the memory and latency-estimate summary. */
+void membench_print_cachesim(const membench_sim_result_t *r,
+                             const membench_cache_profile_t *p,
+                             membench_output_fmt_t fmt);
+
+/** Per-phase lines followed by the whole-trace total. */
+void membench_print_replay(const membench_replay_result_t *r,
+                           const char *mode, membench_output_fmt_t fmt);
+
+void membench_print_tile(const membench_tile_result_t *r, const char *kernel,
+                         const char *level, membench_output_fmt_t fmt);
+
+/** Best tile for one cache level and its speed-up over the unblocked loop. */
+void membench_print_tile_best(const membench_tile_level_t *level,
+                              const membench_tile_result_t *baseline,
+                              const char *kernel, membench_output_fmt_t fmt);
+
+/** Compute and per-level bandwidth ceilings, one and all cores. */
+void membench_print_roofline(const membench_roofline_t *r, membench_output_fmt_t fmt);
+
+void membench_print_roofline_point(const membench_roofline_point_t *pt,
+                                   membench_output_fmt_t fmt);
+
+/** Log-log ASCII chart of the all-core roofline and the kernel points. */
+void membench_print_roofline_chart(const membench_roofline_t *r,
+                                   const membench_roofline_point_t *pts, size_t n);
+
+/** Same chart as SVG, with the one-core roofline dashed. Returns 0 on success. */
+int membench_write_roofline_svg(const char *path, const membench_roofline_t *r,
+                                const membench_roofline_point_t *pts, size_t n);
+
+/** Derived tuning parameters, one per line (table) or one record. */
+void membench_print_tuning(const membench_tuning_t *t, membench_output_fmt_t fmt);
+
+/** Registry benchmark result: median with the min..max over repetitions. */
+void membench_print_bench(const membench_bench_t *b, const membench_bench_result_t *r,
+                          membench_output_fmt_t fmt);
+
+/** One suite point as it completes (table, CSV or one JSON object). */
+void membench_print_suite_row(const membench_suite_t *suite, const membench_suite_row_t *row,
+                              membench_output_fmt_t fmt);
+
+/**
+ * The whole suite as a single JSON document: system, jobs as parsed, and
+ * every result row.
+ */
+void membench_print_suite_json(const membench_suite_t *suite, const membench_suite_row_t *rows,
+                               size_t num_rows, const membench_sysinfo_t *si);
+
+/**
+ * Harness phase breakdown against `total_ns` of wall time, with
+ * efficiency = measure / total.
+ */
+void membench_print_profile(const membench_phase_totals_t *p, uint64_t total_ns,
+                            membench_output_fmt_t fmt);
+
+/**
+ * Environment record for CSV (env,key,value lines, unknown = -100) and
+ * JSON; table output shows it with the system information instead.
+ */
+void membench_print_environment(const membench_sysinfo_t *si, membench_output_fmt_t fmt);
+
+/**
+ * Energy of one benchmark point, printed under its result row (--energy).
+ * nJ per byte for bandwidth points, per access for latency points.
+ */
+void membench_print_energy(const char *label, size_t buffer_size,
+                           const membench_energy_result_t *r, membench_output_fmt_t fmt);
+
+/**
+ * Clock and temperature range over one benchmark point (--monitor),
+ * printed under its result row and flagged when the clock dropped.
+ */
+void membench_print_monitor(const char *label, size_t buffer_size,
+                            const membench_monitor_stats_t *m,
+                            membench_monitor_source_t source, membench_output_fmt_t fmt);
+
+/** Quick health check: one row per check with its range and verdict. */
+void membench_print_health(const membench_health_report_t *r, membench_output_fmt_t fmt);
+
+/** Instruction-side sweep: the steps found, with their usual reading, and the curve. */
+void membench_print_icache(const membench_icache_result_t *r, membench_output_fmt_t fmt);
+
+/** Vector license: one row per width, then the recovery timeline. */
+void membench_print_license(const membench_license_t *r, membench_output_fmt_t fmt);
+
+/** Pointer-content prefetch: pointer vs masked timings per level, then the verdict. */
+void membench_print_dmp(const membench_dmp_t *r, membench_output_fmt_t fmt);
+
 void membench_print_gpu_latency(const membench_gpu_latency_result_t *r,
                                 const char *label, membench_output_fmt_t fmt);
 
@@ -4,7 +4,7 @@
  * Defines:
  *   MEMBENCH_PLATFORM_WINDOWS / LINUX / MACOS
  *   MEMBENCH_ARCH_X86_64 / ARM64
- *   MEMBENCH_INLINE, MEMBENCH_NOINLINE, MEMBENCH_ALIGN(n)
+ *   MEMBENCH_INLINE, MEMBENCH_NOINLINE, MEMBENCH_ALIGN(n), MEMBENCH_THREAD_LOCAL
  */
 #ifndef MEMBENCH_PLATFORM_H
 #define MEMBENCH_PLATFORM_H
@@ -34,10 +34,12 @@
     #define MEMBENCH_INLINE       __forceinline
     #define MEMBENCH_NOINLINE     __declspec(noinline)
     #define MEMBENCH_ALIGN(n)     __declspec(align(n))
+    #define MEMBENCH_THREAD_LOCAL __declspec(thread)
 #else
     #define MEMBENCH_INLINE       static inline __attribute__((always_inline))
     #define MEMBENCH_NOINLINE     __attribute__((noinline))
     #define MEMBENCH_ALIGN(n)     __attribute__((aligned(n)))
+    #define MEMBENCH_THREAD_LOCAL _Thread_local
 #endif
 
 #endif /* MEMBENCH_PLATFORM_H */
@@ -0,0 +1,66 @@
+/**
+ * membench/profile.h — Where the harness's own time goes.
+ *
+ * The kernels charge each step to a phase: allocation (including the
+ * page-touching memset in membench_alloc), building the access pattern,
+ * the warm-up pass, the timed region, freeing, and result analysis.
+ * Comparing the phases with total wall time shows how much of a run is
+ * measurement and how much is overhead.
+ *
+ * Totals are per thread, so concurrent library callers do not share
+ * state; the CLI reports the main thread, which runs every single-threaded
+ * kernel.  When the timeline recorder is on, each timed phase is also
+ * recorded there as a span.
+ */
+#ifndef MEMBENCH_PROFILE_H
+#define MEMBENCH_PROFILE_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    MEMBENCH_PHASE_ALLOC = 0,    /* membench_alloc, incl. faulting pages in */
+    MEMBENCH_PHASE_BUILD,        /* filling buffers, shuffling pointer chains */
+    MEMBENCH_PHASE_WARMUP,       /* untimed warm-up passes */
+    MEMBENCH_PHASE_MEASURE,      /* timed regions */
+    MEMBENCH_PHASE_FREE,
+    MEMBENCH_PHASE_ANALYZE,      /* e.g. cache boundary detection */
+    MEMBENCH_PHASE_COUNT
+} membench_phase_t;
+
+typedef struct {
+    uint64_t ns[MEMBENCH_PHASE_COUNT];
+    uint64_t calls[MEMBENCH_PHASE_COUNT];
+} membench_phase_totals_t;
+
+/** Charge `ns` to `phase`. */
+void membench_phase_add(membench_phase_t phase, uint64_t ns);
+
+/** Charge `t0_ns`..`t1_ns` (membench_timer_ns values) to `phase`. */
+void membench_phase_span(membench_phase_t phase, uint64_t t0_ns, uint64_t t1_ns);
+
+/**
+ * Charge the time since `since` (a membench_timer_ns() value) to `phase`
+ * and return the current time, so consecutive steps chain:
+ *
+ *     uint64_t t = membench_timer_ns();
+ *     buf = membench_alloc(n);
+ *     t = membench_phase_mark(MEMBENCH_PHASE_ALLOC, t);
+ */
+uint64_t membench_phase_mark(membench_phase_t phase, uint64_t since);
+
+/** Calling thread's totals since start or the last reset. */
+void membench_phase_get(membench_phase_totals_t *out);
+
+void membench_phase_reset(void);
+
+const char *membench_phase_name(membench_phase_t phase);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MEMBENCH_PROFILE_H */
@@ -0,0 +1,115 @@
+/**
+ * membench/registry.h — Benchmark registry and plugin interface.
+ *
+ * A benchmark is a set of callbacks: setup() builds the state for one
+ * buffer size, run() performs `iterations` passes and reports the work it
+ * did, teardown() frees the state.  The harness (membench_bench_run) owns
+ * everything around that: the warm-up pass, pinning the thread to one CPU,
+ * repetitions and the min / median / max over them.  Sizes, iteration
+ * counts and output come from the caller, the same as for built-in tests.
+ *
+ * Built-in kernels register themselves at start-up; external ones live in
+ * shared objects loaded with --plugin.  A plugin exports
+ *
+ *     int membench_plugin_init(int abi, membench_registry_add_fn add);
+ *
+ * returning 0 after calling add() once per benchmark, or -1 when `abi` is
+ * not MEMBENCH_PLUGIN_ABI.  Benchmark descriptors must stay valid for the
+ * life of the process (static storage in the plugin is the usual choice).
+ */
+#ifndef MEMBENCH_REGISTRY_H
+#define MEMBENCH_REGISTRY_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define MEMBENCH_PLUGIN_ABI       1
+#define MEMBENCH_REGISTRY_MAX     64
+#define MEMBENCH_PLUGIN_ENTRY     "membench_plugin_init"
+
+typedef enum {
+    MEMBENCH_BENCH_LATENCY = 0,  /* reported as ns per operation */
+    MEMBENCH_BENCH_BANDWIDTH     /* reported as GB/s */
+} membench_bench_kind_t;
+
+/* run() times itself (and warms up); the harness skips its own warm-up */
+#define MEMBENCH_BENCH_SELF_TIMED  (1u << 0)
+
+typedef struct {
+    uint64_t ops;                /* operations performed (accesses, elements) */
+    uint64_t bytes;              /* bytes moved */
+    uint64_t elapsed_ns;         /* 0 = let the harness time the call */
+} membench_bench_metrics_t;
+
+typedef struct {
+    const char *name;            /* unique, e.g. "read-latency" */
+    const char *label;           /* shown in results, e.g. "Read Latency" */
+    membench_bench_kind_t kind;
+    unsigned    flags;           /* MEMBENCH_BENCH_* */
+    /* Allocate state for `buffer_size` bytes. NULL = no state. 0 on success. */
+    int  (*setup)(size_t buffer_size, void **state);
+    /* Do `iterations` passes and fill `m`. 0 on success. */
+    int  (*run)(void *state, uint64_t iterations, membench_bench_metrics_t *m);
+    /* Free the state from setup(). NULL = nothing to free. */
+    void (*teardown)(void *state);
+} membench_bench_t;
+
+typedef struct {
+    size_t   buffer_size;
+    uint64_t iterations;
+    int      reps;
+    uint64_t ops;                /* per repetition */
+    uint64_t bytes;
+    double   ns_per_op;          /* median over repetitions */
+    double   ns_per_op_min;
+    double   ns_per_op_max;
+    double   bandwidth_gbps;     /* median, membench_gbps() like the built-in tests */
+} membench_bench_result_t;
+
+typedef int (*membench_registry_add_fn)(const membench_bench_t *bench);
+
+/* ── Registry ─────────────────────────────────────────────────────────────── */
+
+/** Register a benchmark. Returns -1 if the name is taken or the table is full. */
+int membench_registry_add(const membench_bench_t *bench);
+
+const membench_bench_t *membench_registry_find(const char *name);
+
+size_t membench_registry_count(void);
+
+/** i-th benchmark in registration order, NULL when out of range. */
+const membench_bench_t *membench_registry_get(size_t i);
+
+/**
+ * Load a plugin and let it register its benchmarks. Returns the number
+ * registered, or -1 with a message on stderr. The library stays loaded.
+ */
+int membench_plugin_load(const char *path);
+
+/* ── Harness ──────────────────────────────────────────────────────────────── */
+
+/**
+ * Setup, warm up, run `reps` timed repetitions of `iterations` passes,
+ * tear down. Returns 0 on success, -1 on failure or when cancellation was
+ * requested between repetitions.
+ */
+int membench_bench_run(const membench_bench_t *bench, size_t buffer_size,
+                       uint64_t iterations, int reps, membench_bench_result_t *result);
+
+/* Flat form of a result, e.g. for a checkpoint line */
+#define MEMBENCH_BENCH_RESULT_VALUES 9
+
+void membench_bench_result_pack(const membench_bench_result_t *r,
+                                double v[MEMBENCH_BENCH_RESULT_VALUES]);
+void membench_bench_result_unpack(const double v[MEMBENCH_BENCH_RESULT_VALUES],
+                                  membench_bench_result_t *r);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MEMBENCH_REGISTRY_H */
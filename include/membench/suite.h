@@ -0,0 +1,110 @@
+/**
+ * membench/suite.h — Job files and the suite runner.
+ *
+ * A job file is INI-style.  Each [section] is one job; [global] sets
+ * defaults for the jobs that follow it (fio-style):
+ *
+ *     [global]
+ *     iterations = auto         ; or a count per timed run
+ *     repeat     = 3
+ *
+ *     [dram-latency]
+ *     bench   = read-latency    ; any registry name, incl. plugins
+ *     size    = 4K:1G:x2        ; start:end:xFACTOR, start:end:+STEP, lists
+ *     threads = 1,2,4
+ *     pages   = huge            ; default | huge (transparent huge pages)
+ *     numa    = interleave      ; default | interleave | bind:N | preferred:N
+ *
+ * The runner expands every job into sizes x thread counts and runs each
+ * point through the registry harness, one copy of the benchmark per thread.
+ */
+#ifndef MEMBENCH_SUITE_H
+#define MEMBENCH_SUITE_H
+
+#include "alloc.h"
+#include "checkpoint.h"
+#include "registry.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define MEMBENCH_SUITE_MAX_JOBS     64
+#define MEMBENCH_SUITE_MAX_SIZES    64
+#define MEMBENCH_SUITE_MAX_THREADS  16
+#define MEMBENCH_SUITE_NAME_LEN     64
+
+typedef struct {
+    char     name[MEMBENCH_SUITE_NAME_LEN];
+    char     bench[MEMBENCH_SUITE_NAME_LEN];
+    size_t   num_sizes;
+    size_t   sizes[MEMBENCH_SUITE_MAX_SIZES];
+    size_t   num_threads;
+    int      threads[MEMBENCH_SUITE_MAX_THREADS];
+    uint64_t iterations;                 /* 0 = automatic */
+    int      repeat;                     /* timed runs per point, >= 1 */
+    membench_page_policy_t pages;
+    membench_numa_policy_t numa;
+    int      numa_node;                  /* BIND / PREFERRED */
+} membench_job_t;
+
+typedef struct {
+    size_t        num_jobs;
+    membench_job_t jobs[MEMBENCH_SUITE_MAX_JOBS];
+} membench_suite_t;
+
+typedef struct {
+    size_t   job;                        /* index into membench_suite_t.jobs */
+    int      threads;
+    int      status;                     /* 0 = ok, -1 = failed */
+    membench_bench_kind_t kind;          /* how the bench reports its result */
+    /* Bandwidth and ops/bytes summed over threads; ns/op averaged, with
+     * min and max taken over every thread's repetitions */
+    membench_bench_result_t result;
+} membench_suite_row_t;
+
+/**
+ * Parse a size list: comma-separated sizes ("64K") and ranges
+ * "start:end:xF" (geometric, default x2) or "start:end:+S" (linear).
+ * Returns the number of values written to `out`, or -1 if malformed or
+ * longer than `max`.
+ */
+int membench_parse_size_list(const char *spec, size_t *out, size_t max);
+
+/**
+ * Parse job-file text. On error returns -1 and writes "line N: reason"
+ * into `err`.
+ */
+int membench_suite_parse(const char *text, membench_suite_t *suite,
+                         char *err, size_t err_len);
+
+/** Read and parse a job file. Returns 0 on success. */
+int membench_suite_load(const char *path, membench_suite_t *suite,
+                        char *err, size_t err_len);
+
+const char *membench_numa_policy_name(membench_numa_policy_t policy);
+
+/** Called after each point, e.g. to print progress. */
+typedef void (*membench_suite_row_fn)(const membench_suite_t *suite,
+                                      const membench_suite_row_t *row, void *user);
+
+/**
+ * Run every job. Returns a malloc'd array of `*num_rows` rows (free())
+ * or NULL on allocation failure; points that fail are kept with status -1.
+ * Points already in `cp` are taken from it instead of run, and finished
+ * points are recorded there; `cp` and `on_row` may be NULL.  On
+ * cancellation the run stops and only finished points are returned.
+ */
+membench_suite_row_t *membench_suite_run(const membench_suite_t *suite,
+                                         membench_checkpoint_t *cp,
+                                         membench_suite_row_fn on_row, void *user,
+                                         size_t *num_rows);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MEMBENCH_SUITE_H */
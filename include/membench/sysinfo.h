@@ -1,17 +1,48 @@
 /**
  * membench/sysinfo.h — System information detection.
  *
- * CPU model, cache sizes, RAM info, etc.
+ * CPU model, cache sizes, RAM info, etc., plus the settings that make the
+ * same machine give different numbers from one run to the next (see
+ * membench_env_t).
  */
 #ifndef MEMBENCH_SYSINFO_H
 #define MEMBENCH_SYSINFO_H
 
 #include <stddef.h>
+#include <stdint.h>
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+#define MEMBENCH_ENV_UNKNOWN  (-100)    /* int fields of membench_env_t */
+#define MEMBENCH_ENV_MSG_LEN  160
+
+/**
+ * Benchmark environment: sources of run-to-run noise.  Read from /sys and
+ * /proc on Linux; elsewhere most fields stay unknown (MEMBENCH_ENV_UNKNOWN,
+ * "" or a negative double).  The noise_* fields are filled by
+ * membench_env_measure_noise() only.
+ */
+typedef struct {
+    char   governor[32];         /* cpufreq scaling governor of cpu0 */
+    int    turbo;                /* 1 = turbo/boost enabled, 0 = disabled */
+    int    smt;                  /* 1 = SMT siblings online, 0 = off */
+    char   thp[16];              /* transparent huge pages: always | madvise | never */
+    int    perf_paranoid;        /* kernel.perf_event_paranoid */
+    int    numa_balancing;       /* kernel.numa_balancing (automatic page migration) */
+    int    virtualized;          /* 1 = running under a hypervisor */
+    double loadavg;              /* 1-minute load average at start */
+    size_t swap_total;           /* bytes */
+    size_t swap_used;
+
+    /* Timer noise: a fixed busy loop timed back to back */
+    uint32_t noise_samples;
+    double   noise_median_ns;    /* per sample */
+    double   noise_p99_ratio;    /* 99th percentile / median */
+    double   noise_outlier_pct;  /* samples above 1.5x the median, % */
+} membench_env_t;
+
 typedef struct {
     char   cpu_model[256];
     int    num_cores_physical;
@@ -19,7 +50,13 @@ typedef struct {
     size_t l1_data_cache;    /* bytes, 0 if unknown */
     size_t l2_cache;
     size_t l3_cache;
+    int    l1_ways;          /* associativity, 0 if unknown */
+    int    l2_ways;
+    int    l3_ways;
+    size_t cache_line;       /* bytes, 0 if unknown */
+    int    numa_nodes;       /* memory nodes, 1 if unknown */
     size_t total_ram;        /* bytes */
+    membench_env_t env;
 } membench_sysinfo_t;
 
 /**
@@ -28,10 +65,26 @@ typedef struct {
 int membench_sysinfo_get(membench_sysinfo_t *info);
 
 /**
- * Print system info to stdout.
+ * Print system info to stdout, with the environment and any warnings
+ * about it.
  */
 void membench_sysinfo_print(const membench_sysinfo_t *info);
 
+/**
+ * Time a short busy loop back to back for about `duration_ns` (0 = 100 ms)
+ * and record how often and how far samples stray from the median:
+ * interrupts, other tasks and clock changes all show up here.  Returns 0
+ * on success.
+ */
+int membench_env_measure_noise(membench_env_t *env, uint64_t duration_ns);
+
+/**
+ * Settings in `info->env` likely to skew results, one message each.
+ * Returns the number written to `msgs` (at most `max`).
+ */
+size_t membench_env_warnings(const membench_sysinfo_t *info,
+                             char msgs[][MEMBENCH_ENV_MSG_LEN], size_t max);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,73 @@
+/**
+ * membench/timeline.h — Execution timeline in Chrome trace-event format.
+ *
+ * When enabled, every harness phase (see profile.h), registry repetition,
+ * worker start barrier and suite point is recorded as a complete event
+ * on the thread that ran it.  Each thread appends to its own buffer
+ * without locks; the timestamps are the ones the harness already takes,
+ * so nothing is added inside a timed region.  membench_timeline_write()
+ * produces JSON that chrome://tracing and ui.perfetto.dev open directly.
+ *
+ * Names must be string literals or otherwise outlive the recorder.
+ */
+#ifndef MEMBENCH_TIMELINE_H
+#define MEMBENCH_TIMELINE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define MEMBENCH_TIMELINE_MAX_THREADS      1024
+#define MEMBENCH_TIMELINE_DEFAULT_EVENTS   (1u << 20)
+
+/**
+ * Start recording, keeping at most `events_per_thread` events per thread
+ * (0 = MEMBENCH_TIMELINE_DEFAULT_EVENTS); later ones are counted as
+ * dropped.  Call before starting worker threads. Returns 0 on success.
+ */
+int membench_timeline_enable(size_t events_per_thread);
+
+int membench_timeline_enabled(void);
+
+/** Stop recording and free every buffer. No thread may be recording. */
+void membench_timeline_disable(void);
+
+/**
+ * Label the calling thread's track (copied).  A thread that has not
+ * recorded yet takes over a released track with the same name if there is
+ * one, so short-lived workers reuse their predecessors' slots.
+ */
+void membench_timeline_thread_name(const char *name);
+
+/**
+ * Release the calling thread's track before the thread exits; its events
+ * stay.  Threads that never call this keep their slot until disable.
+ */
+void membench_timeline_thread_exit(void);
+
+/** Record `name` on the calling thread from `t0_ns` to `t1_ns` (membench_timer_ns). */
+void membench_timeline_span(const char *name, uint64_t t0_ns, uint64_t t1_ns, uint64_t arg);
+
+/** Record a point-in-time marker. */
+void membench_timeline_instant(const char *name, uint64_t arg);
+
+/** Events lost to full buffers or too many threads. */
+size_t membench_timeline_dropped(void);
+
+/** Threads that recorded nothing because all MEMBENCH_TIMELINE_MAX_THREADS slots were held. */
+size_t membench_timeline_lost_threads(void);
+
+/**
+ * Write everything recorded so far as Chrome trace-event JSON. Call when
+ * no other thread is recording. Returns 0 on success.
+ */
+int membench_timeline_write(const char *path);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MEMBENCH_TIMELINE_H */
@@ -30,6 +30,17 @@ uint64_t membench_timer_ns(void);
  */
 double membench_timer_resolution_ns(void);
 
+/**
+ * Bytes in the "GB" of every GB/s membench reports: 2^30, as the built-in
+ * bandwidth tests have always used.
+ */
+#define MEMBENCH_GB_BYTES (1024.0 * 1024.0 * 1024.0)
+
+/** `bytes` moved in `ns` nanoseconds, in GB/s (MEMBENCH_GB_BYTES); 0 if `ns` is 0. */
+MEMBENCH_INLINE double membench_gbps(double bytes, double ns) {
+    return ns > 0.0 ? bytes / MEMBENCH_GB_BYTES / (ns / 1e9) : 0.0;
+}
+
 #ifdef __cplusplus
 }
 #endif
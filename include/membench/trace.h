@@ -0,0 +1,112 @@
+/**
+ * membench/trace.h — Compact binary memory-access trace format.
+ *
+ * A trace file is a 32-byte header followed by 8-byte records, both
+ * little-endian.  Each record packs one access:
+ *
+ *   bits  0..47   byte offset into the replay buffer
+ *   bits 48..61   access size - 1 (1 .. 16384 bytes)
+ *   bit  62       1 = write, 0 = read
+ *   bit  63       1 = this access starts a new phase
+ *
+ * Records are fixed-size and the header never has to be revisited, so
+ * producers can stream a trace out and the reader walks it through a
+ * sliding memory-mapped window — multi-GB traces are never loaded whole.
+ */
+#ifndef MEMBENCH_TRACE_H
+#define MEMBENCH_TRACE_H
+
+#include "platform.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define MEMBENCH_TRACE_MAGIC        "MBTRACE1"
+#define MEMBENCH_TRACE_VERSION      1
+#define MEMBENCH_TRACE_MAX_OFFSET   ((1ULL << 48) - 1)
+#define MEMBENCH_TRACE_MAX_SIZE     16384
+
+typedef struct {
+    char     magic[8];           /* MEMBENCH_TRACE_MAGIC, not NUL-terminated */
+    uint32_t version;
+    uint32_t header_bytes;       /* records start at this file offset */
+    uint64_t num_records;        /* 0 = unknown, read to end of file */
+    uint64_t span_bytes;         /* max(offset + size); 0 = unknown */
+} membench_trace_header_t;
+
+/* ── Record encoding ──────────────────────────────────────────────────────── */
+
+MEMBENCH_INLINE uint64_t membench_trace_encode(uint64_t offset, uint32_t size,
+                                               int is_write, int new_phase) {
+    return (offset & MEMBENCH_TRACE_MAX_OFFSET)
+         | ((uint64_t)((size - 1) & 0x3FFF) << 48)
+         | ((uint64_t)(is_write != 0) << 62)
+         | ((uint64_t)(new_phase != 0) << 63);
+}
+
+MEMBENCH_INLINE uint64_t membench_trace_offset(uint64_t rec) {
+    return rec & MEMBENCH_TRACE_MAX_OFFSET;
+}
+
+MEMBENCH_INLINE uint32_t membench_trace_size(uint64_t rec) {
+    return (uint32_t)((rec >> 48) & 0x3FFF) + 1;
+}
+
+MEMBENCH_INLINE int membench_trace_is_write(uint64_t rec) {
+    return (int)((rec >> 62) & 1);
+}
+
+MEMBENCH_INLINE int membench_trace_new_phase(uint64_t rec) {
+    return (int)(rec >> 63);
+}
+
+/* ── Writer ───────────────────────────────────────────────────────────────── */
+
+typedef struct membench_trace_writer membench_trace_writer_t;
+
+/** Create (truncate) a trace file. Returns NULL on error. */
+membench_trace_writer_t *membench_trace_create(const char *path);
+
+/** Append one access. Returns 0 on success, -1 on error or bad size. */
+int membench_trace_append(membench_trace_writer_t *w, uint64_t offset,
+                          uint32_t size, int is_write, int new_phase);
+
+/**
+ * Fill in the header's record count and span and close the file.
+ * Returns 0 on success, -1 on error. `w` is freed either way.
+ */
+int membench_trace_finish(membench_trace_writer_t *w);
+
+/* ── Reader ───────────────────────────────────────────────────────────────── */
+
+typedef struct membench_trace_reader membench_trace_reader_t;
+
+/**
+ * Open a trace for streaming. Validates the header; num_records is filled
+ * in from the file size when the producer left it 0. Returns NULL on error.
+ */
+membench_trace_reader_t *membench_trace_open(const char *path);
+
+/** Header of an open trace. */
+const membench_trace_header_t *membench_trace_info(const membench_trace_reader_t *r);
+
+/**
+ * Next batch of packed records, valid until the following call.
+ * Returns the number of records in *recs, or 0 at end of trace.
+ */
+size_t membench_trace_next(membench_trace_reader_t *r, const uint64_t **recs);
+
+/** Restart from the first record. Returns 0 on success, -1 on error. */
+int membench_trace_rewind(membench_trace_reader_t *r);
+
+void membench_trace_close(membench_trace_reader_t *r);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MEMBENCH_TRACE_H */
@@ -0,0 +1,69 @@
+/**
+ * membench/tuning.h — Machine-specific tuning parameters.
+ *
+ * Turns a handful of quick measurements (detected cache sizes, DRAM
+ * latency, bandwidth vs. thread count, normal vs. non-temporal store
+ * bandwidth) into concrete constants an application can compile against:
+ * padding, block sizes, prefetch distance, thread count, NUMA policy and
+ * the size above which non-temporal stores pay off.
+ *
+ * The measurements are collected by the caller; this module only derives
+ * the parameters and writes them out as a C header and as JSON.
+ */
+#ifndef MEMBENCH_TUNING_H
+#define MEMBENCH_TUNING_H
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define MEMBENCH_TUNE_MAX_POINTS 16
+
+typedef struct {
+    /* ── Measured inputs ── */
+    char     cpu_model[256];
+    size_t   cache_line;            /* bytes */
+    size_t   l1_bytes;              /* detected data-cache sizes, 0 = unknown */
+    size_t   l2_bytes;
+    size_t   l3_bytes;
+    double   dram_latency_ns;       /* dependent-load latency, 0 = unknown */
+    int      numa_nodes;
+
+    size_t   num_thread_points;     /* bandwidth vs. thread count */
+    int      bw_threads[MEMBENCH_TUNE_MAX_POINTS];
+    double   bw_gbps[MEMBENCH_TUNE_MAX_POINTS];
+
+    size_t   num_store_points;      /* store bandwidth vs. buffer size */
+    size_t   store_bytes[MEMBENCH_TUNE_MAX_POINTS];   /* ascending */
+    double   store_gbps[MEMBENCH_TUNE_MAX_POINTS];
+    double   nt_store_gbps[MEMBENCH_TUNE_MAX_POINTS]; /* 0 = unsupported */
+
+    /* ── Derived by membench_tuning_derive() ── */
+    size_t   pad_bytes;             /* false-sharing padding */
+    size_t   l1_block_bytes;        /* working-set block that stays in L1 */
+    size_t   l2_block_bytes;
+    unsigned prefetch_distance;     /* cache lines ahead of a streaming loop */
+    int      bw_max_threads;        /* fewest threads within 90% of peak */
+    const char *numa_policy;        /* "none" or "interleave" */
+    size_t   nt_store_threshold;    /* bytes, 0 = never use NT stores */
+} membench_tuning_t;
+
+/**
+ * Fill the derived fields from the measured ones. Missing inputs give
+ * conservative values (one line of padding, no NT stores, and so on).
+ */
+void membench_tuning_derive(membench_tuning_t *t);
+
+/** Write the parameters as a C header of MEMBENCH_TUNE_* macros. Returns 0 on success. */
+int membench_tuning_write_header(const char *path, const membench_tuning_t *t);
+
+/** Write the parameters and the measurements as JSON. Returns 0 on success. */
+int membench_tuning_write_json(const char *path, const membench_tuning_t *t);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MEMBENCH_TUNING_H */
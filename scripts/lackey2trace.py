@@ -0,0 +1,85 @@
+#!/usr/bin/env python3
+"""
+lackey2trace.py — Convert a valgrind lackey log into a membench trace.
+
+    valgrind --tool=lackey --trace-mem=yes --log-file=app.lackey ./app
+    python3 scripts/lackey2trace.py app.lackey app.mbt
+    membench --test replay --trace app.mbt
+
+Lackey reports virtual addresses, which are spread over a huge range
+(heap, stack and libraries sit terabytes apart).  Addresses are compacted
+by mapping every touched 64 KB region, in address order, onto a dense
+range, so locality within and between neighbouring regions is preserved
+and the replay buffer is only as large as the memory actually touched.
+
+Instruction fetches ("I") are dropped; "M" (modify) becomes a read then a
+write.  Pass --phase-every N to start a new phase every N accesses.
+
+The format is described in include/membench/trace.h.
+"""
+import argparse
+import struct
+import sys
+
+MAGIC = b"MBTRACE1"
+VERSION = 1
+HEADER = struct.Struct("<8sIIQQ")
+REGION_SHIFT = 16
+MAX_SIZE = 16384
+
+
+def parse(path):
+    """Yield (address, size, op) for every data access in a lackey log."""
+    with open(path, "r", errors="replace") as f:
+        for line in f:
+            if len(line) < 4 or line[0] != " " or line[1] not in "LSM":
+                continue
+            try:
+                addr, size = line[3:].split(",")
+                yield int(addr, 16), int(size), line[1]
+            except ValueError:
+                continue
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__,
+                                 formatter_class=argparse.RawDescriptionHelpFormatter)
+    ap.add_argument("lackey_log")
+    ap.add_argument("output")
+    ap.add_argument("--phase-every", type=int, default=0,
+                    help="start a new phase every N accesses (default: one phase)")
+    args = ap.parse_args()
+
+    # Pass 1: the set of touched regions
+    regions = set()
+    for addr, size, _ in parse(args.lackey_log):
+        regions.add(addr >> REGION_SHIFT)
+        regions.add((addr + size - 1) >> REGION_SHIFT)
+    if not regions:
+        sys.exit("no data accesses found in %s" % args.lackey_log)
+    dense = {r: i for i, r in enumerate(sorted(regions))}
+
+    # Pass 2: stream records out
+    count = 0
+    span = 0
+    mask = (1 << REGION_SHIFT) - 1
+    with open(args.output, "wb") as out:
+        out.write(HEADER.pack(MAGIC, VERSION, HEADER.size, 0, 0))
+        for addr, size, op in parse(args.lackey_log):
+            off = (dense[addr >> REGION_SHIFT] << REGION_SHIFT) | (addr & mask)
+            size = max(1, min(size, MAX_SIZE))
+            for write in ((0, 1) if op == "M" else ((1,) if op == "S" else (0,))):
+                phase = 1 if args.phase_every and count and count % args.phase_every == 0 else 0
+                rec = off | ((size - 1) << 48) | (write << 62) | (phase << 63)
+                out.write(struct.pack("<Q", rec))
+                count += 1
+                span = max(span, off + size)
+        out.seek(0)
+        out.write(HEADER.pack(MAGIC, VERSION, HEADER.size, count, span))
+
+    print("%s: %d accesses, %d regions, span %d bytes" %
+          (args.output, count, len(regions), span))
+
+
+if __name__ == "__main__":
+    main()
@@ -12,8 +12,21 @@
 #else
     #include <sys/mman.h>
     #include <unistd.h>
+    #if defined(MEMBENCH_PLATFORM_LINUX)
+        #include <sys/syscall.h>
+    #endif
 #endif
 
+/* Linux <numaif.h> values; set_mempolicy is called directly so libnuma is
+ * not a dependency */
+#define MPOL_DEFAULT_    0
+#define MPOL_PREFERRED_  1
+#define MPOL_BIND_       2
+#define MPOL_INTERLEAVE_ 3
+#define NUMA_MAX_NODES   1024
+
+static volatile membench_page_policy_t g_page_policy = MEMBENCH_PAGES_DEFAULT;
+
 void *membench_alloc(size_t size) {
     if (size == 0) return NULL;
 
@@ -23,6 +36,11 @@ void *membench_alloc(size_t size) {
     void *ptr = mmap(NULL, size, PROT_READ | PROT_WRITE,
                      MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
     if (ptr == MAP_FAILED) ptr = NULL;
+  #if defined(MEMBENCH_PLATFORM_LINUX) && defined(MADV_HUGEPAGE)
+    /* Before the first touch, so the pages are faulted in huge */
+    if (ptr && g_page_policy == MEMBENCH_PAGES_HUGE)
+        madvise(ptr, size, MADV_HUGEPAGE);
+  #endif
 #endif
 
     /* Touch every page to ensure physical backing (avoid lazy allocation noise) */
@@ -52,3 +70,41 @@ size_t membench_page_size(void) {
     return (size_t)sysconf(_SC_PAGESIZE);
 #endif
 }
+
+membench_page_policy_t membench_alloc_set_pages(membench_page_policy_t policy) {
+    membench_page_policy_t old = g_page_policy;
+    g_page_policy = policy;
+    return old;
+}
+
+int membench_numa_set_policy(membench_numa_policy_t policy, int node) {
+#if defined(MEMBENCH_PLATFORM_LINUX) && defined(SYS_set_mempolicy)
+    unsigned long mask[NUMA_MAX_NODES / (8 * sizeof(unsigned long))];
+    memset(mask, 0, sizeof(mask));
+    const size_t bits = 8 * sizeof(unsigned long);
+    int mode;
+
+    switch (policy) {
+    case MEMBENCH_NUMA_DEFAULT:
+        return syscall(SYS_set_mempolicy, MPOL_DEFAULT_, NULL, 0UL) == 0 ? 0 : -1;
+    case MEMBENCH_NUMA_INTERLEAVE:
+        if (node < 1 || node > NUMA_MAX_NODES) return -1;
+        for (size_t n = 0; n < (size_t)node; n++) mask[n / bits] |= 1UL << (n % bits);
+        mode = MPOL_INTERLEAVE_;
+        break;
+    case MEMBENCH_NUMA_BIND:
+    case MEMBENCH_NUMA_PREFERRED:
+        if (node < 0 || node >= NUMA_MAX_NODES) return -1;
+        mask[(size_t)node / bits] = 1UL << ((size_t)node % bits);
+        mode = policy == MEMBENCH_NUMA_BIND ? MPOL_BIND_ : MPOL_PREFERRED_;
+        break;
+    default:
+        return -1;
+    }
+    return syscall(SYS_set_mempolicy, mode, mask, (unsigned long)NUMA_MAX_NODES + 1) == 0
+           ? 0 : -1;
+#else
+    (void)node;
+    return policy == MEMBENCH_NUMA_DEFAULT ? 0 : -1;
+#endif
+}
@@ -0,0 +1,374 @@
+/**
+ * cachesim.c — Offline multi-level cache simulator.
+ *
+ * Model: physically indexed by line address modulo the set count,
+ * write-back, write-allocate.  A miss is filled into every level it missed
+ * in (from the deepest up), so the hierarchy behaves inclusively for clean
+ * lines without enforcing back-invalidation.  A dirty victim marks its
+ * copy in the next level dirty, or counts as a memory write if the next
+ * level no longer holds it.
+ *
+ * The latency estimate charges every line access the load-to-use latency
+ * of the level it hit in (or memory), i.e. it assumes no overlap between
+ * accesses — the same assumption as the dependent replay mode.
+ */
+#include "membench/cachesim.h"
+#include "membench/trace.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Used when sysinfo cannot report associativity or line size */
+static const int DEFAULT_WAYS[3] = { 8, 16, 16 };
+#define DEFAULT_LINE 64
+
+/* ── Profiles ─────────────────────────────────────────────────────────────── */
+
+static int cmp_double(const void *a, const void *b) {
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * Median latency of the samples in (lo, hi]; falls back to the largest
+ * sample at or below hi, then to the first sample.
+ */
+static double plateau(const membench_cache_info_t *info, size_t lo, size_t hi) {
+    double *v = (double *)malloc(info->num_samples * sizeof(double));
+    if (!v) return 0.0;
+    size_t n = 0;
+    for (size_t i = 0; i < info->num_samples; i++) {
+        if (info->sample_sizes[i] > lo && info->sample_sizes[i] <= hi)
+            v[n++] = info->sample_latencies[i];
+    }
+    double lat;
+    if (n > 0) {
+        qsort(v, n, sizeof(double), cmp_double);
+        lat = v[n / 2];
+    } else {
+        lat = info->sample_latencies[0];
+        for (size_t i = 0; i < info->num_samples; i++)
+            if (info->sample_sizes[i] <= hi) lat = info->sample_latencies[i];
+    }
+    free(v);
+    return lat;
+}
+
+int membench_cache_profile_from_info(const membench_cache_info_t *info,
+                                     const membench_sysinfo_t *si,
+                                     membench_cache_profile_t *p) {
+    if (!info || !p || info->num_samples == 0) return -1;
+    memset(p, 0, sizeof(*p));
+
+    size_t sizes[3] = { info->l1_size_bytes, info->l2_size_bytes, info->l3_size_bytes };
+    int ways[3] = { 0, 0, 0 };
+    if (si) {
+        if (!sizes[0]) sizes[0] = si->l1_data_cache;
+        if (!sizes[1]) sizes[1] = si->l2_cache;
+        if (!sizes[2]) sizes[2] = si->l3_cache;
+        ways[0] = si->l1_ways;
+        ways[1] = si->l2_ways;
+        ways[2] = si->l3_ways;
+        p->line_bytes = si->cache_line;
+    }
+    if (!p->line_bytes) p->line_bytes = DEFAULT_LINE;
+
+    /* A level's plateau: from twice the previous level (clear of the
+     * transition) up to 3/4 of its own size (clear of the next one). */
+    size_t prev = 0;
+    for (int i = 0; i < 3; i++) {
+        if (sizes[i] == 0 || sizes[i] <= prev) continue;
+        membench_sim_level_cfg_t *lv = &p->level[p->num_levels++];
+        lv->size_bytes = sizes[i];
+        lv->ways = ways[i] > 0 && ways[i] <= MEMBENCH_SIM_MAX_WAYS ? ways[i] : DEFAULT_WAYS[i];
+        lv->latency_ns = plateau(info, prev * 2, sizes[i] * 3 / 4);
+        prev = sizes[i];
+    }
+    if (p->num_levels == 0) return -1;
+
+    p->memory_latency_ns = plateau(info, prev * 4, (size_t)-1);
+    return 0;
+}
+
+int membench_cache_profile_save(const char *path, const membench_cache_profile_t *p) {
+    if (!path || !p) return -1;
+    FILE *f = fopen(path, "w");
+    if (!f) return -1;
+
+    fprintf(f, "# membench cache profile\n");
+    fprintf(f, "line_bytes = %zu\n", p->line_bytes);
+    fprintf(f, "levels = %zu\n", p->num_levels);
+    for (size_t i = 0; i < p->num_levels; i++) {
+        fprintf(f, "l%zu.size = %zu\n", i + 1, p->level[i].size_bytes);
+        fprintf(f, "l%zu.ways = %d\n", i + 1, p->level[i].ways);
+        fprintf(f, "l%zu.latency_ns = %.3f\n", i + 1, p->level[i].latency_ns);
+    }
+    fprintf(f, "memory.latency_ns = %.3f\n", p->memory_latency_ns);
+
+    return fclose(f) == 0 ? 0 : -1;
+}
+
+int membench_cache_profile_load(const char *path, membench_cache_profile_t *p) {
+    if (!path || !p) return -1;
+    FILE *f = fopen(path, "r");
+    if (!f) return -1;
+    memset(p, 0, sizeof(*p));
+
+    char line[256];
+    int rc = 0;
+    while (fgets(line, sizeof(line), f)) {
+        char key[64];
+        double val;
+        unsigned lvl;
+        if (line[0] == '#' || line[0] == '\n') continue;
+        if (sscanf(line, " %63[^= ] = %lf", key, &val) != 2) { rc = -1; break; }
+
+        if (strcmp(key, "line_bytes") == 0) {
+            p->line_bytes = (size_t)val;
+        } else if (strcmp(key, "levels") == 0) {
+            p->num_levels = (size_t)val;
+        } else if (strcmp(key, "memory.latency_ns") == 0) {
+            p->memory_latency_ns = val;
+        } else if (sscanf(key, "l%u.", &lvl) == 1 && lvl >= 1 &&
+                   lvl <= MEMBENCH_SIM_MAX_LEVELS) {
+            membench_sim_level_cfg_t *lv = &p->level[lvl - 1];
+            const char *dot = strchr(key, '.');    /* "l1" alone also matches */
+            if (!dot) { rc = -1; break; }
+            const char *field = dot + 1;
+            if (strcmp(field, "size") == 0)            lv->size_bytes = (size_t)val;
+            else if (strcmp(field, "ways") == 0)       lv->ways = (int)val;
+            else if (strcmp(field, "latency_ns") == 0) lv->latency_ns = val;
+            else { rc = -1; break; }
+        } else {
+            rc = -1;
+            break;
+        }
+    }
+    fclose(f);
+
+    if (p->num_levels == 0 || p->num_levels > MEMBENCH_SIM_MAX_LEVELS ||
+        p->line_bytes == 0)
+        rc = -1;
+    return rc;
+}
+
+/* ── Simulator ────────────────────────────────────────────────────────────── */
+
+typedef struct {
+    uint64_t *tags;             /* sets * ways; line address + 1, 0 = empty */
+    uint64_t *stamps;           /* LRU: last-use tick per way */
+    uint64_t *mru;              /* PLRU: MRU bit per way, one word per set */
+    uint64_t *dirty;            /* dirty bit per way, one word per set */
+    size_t    sets;
+    int       ways;
+    membench_sim_level_stats_t stats;
+} sim_level_t;
+
+struct membench_cachesim {
+    membench_cache_profile_t profile;
+    membench_sim_policy_t    policy;
+    sim_level_t level[MEMBENCH_SIM_MAX_LEVELS];
+    uint64_t tick;
+    uint64_t accesses;
+    uint64_t memory_reads;
+    uint64_t memory_writes;
+};
+
+static int find_way(const sim_level_t *lv, size_t set, uint64_t tag) {
+    const uint64_t *t = lv->tags + set * (size_t)lv->ways;
+    for (int w = 0; w < lv->ways; w++)
+        if (t[w] == tag) return w;
+    return -1;
+}
+
+static void touch(membench_cachesim_t *s, sim_level_t *lv, size_t set, int w) {
+    if (s->policy == MEMBENCH_SIM_LRU) {
+        lv->stamps[set * (size_t)lv->ways + (size_t)w] = ++s->tick;
+    } else {
+        uint64_t all = lv->ways == 64 ? ~0ULL : (1ULL << lv->ways) - 1;
+        lv->mru[set] |= 1ULL << w;
+        if (lv->mru[set] == all) lv->mru[set] = 1ULL << w;
+    }
+}
+
+static int victim(const membench_cachesim_t *s, const sim_level_t *lv, size_t set) {
+    const uint64_t *t = lv->tags + set * (size_t)lv->ways;
+    for (int w = 0; w < lv->ways; w++)
+        if (t[w] == 0) return w;
+
+    if (s->policy == MEMBENCH_SIM_LRU) {
+        const uint64_t *st = lv->stamps + set * (size_t)lv->ways;
+        int best = 0;
+        for (int w = 1; w < lv->ways; w++)
+            if (st[w] < st[best]) best = w;
+        return best;
+    }
+    for (int w = 0; w < lv->ways; w++)
+        if (!(lv->mru[set] & (1ULL << w))) return w;
+    return 0;
+}
+
+/** Install `tag` in level i, handling a dirty victim. */
+static void fill(membench_cachesim_t *s, size_t i, uint64_t tag, int dirty) {
+    sim_level_t *lv = &s->level[i];
+    size_t set = (size_t)((tag - 1) % lv->sets);
+    int w = victim(s, lv, set);
+    uint64_t *slot = &lv->tags[set * (size_t)lv->ways + (size_t)w];
+
+    if (*slot && (lv->dirty[set] & (1ULL << w))) {
+        lv->stats.writebacks++;
+        int absorbed = 0;
+        if (i + 1 < s->profile.num_levels) {
+            sim_level_t *nx = &s->level[i + 1];
+            size_t nset = (size_t)((*slot - 1) % nx->sets);
+            int nw = find_way(nx, nset, *slot);
+            if (nw >= 0) {
+                nx->dirty[nset] |= 1ULL << nw;
+                absorbed = 1;
+            }
+        }
+        if (!absorbed) s->memory_writes++;
+    }
+
+    *slot = tag;
+    if (dirty) lv->dirty[set] |= 1ULL << w;
+    else       lv->dirty[set] &= ~(1ULL << w);
+    touch(s, lv, set, w);
+}
+
+static void access_line(membench_cachesim_t *s, uint64_t line, int is_write) {
+    uint64_t tag = line + 1;
+    size_t n = s->profile.num_levels;
+    size_t hit_level = n;
+
+    s->accesses++;
+    for (size_t i = 0; i < n; i++) {
+        sim_level_t *lv = &s->level[i];
+        size_t set = (size_t)(line % lv->sets);
+        lv->stats.accesses++;
+        int w = find_way(lv, set, tag);
+        if (w >= 0) {
+            lv->stats.hits++;
+            touch(s, lv, set, w);
+            if (is_write && i == 0) lv->dirty[set] |= 1ULL << w;
+            hit_level = i;
+            break;
+        }
+        lv->stats.misses++;
+    }
+    if (hit_level == n) s->memory_reads++;
+
+    /* Fill the levels that missed, deepest first; only L1 holds the write */
+    for (size_t i = hit_level; i-- > 0; )
+        fill(s, i, tag, is_write && i == 0);
+}
+
+membench_cachesim_t *membench_cachesim_create(const membench_cache_profile_t *p,
+                                              membench_sim_policy_t policy) {
+    if (!p || p->line_bytes == 0 || p->num_levels == 0 ||
+        p->num_levels > MEMBENCH_SIM_MAX_LEVELS ||
+        (unsigned)policy >= MEMBENCH_SIM_NUM_POLICIES)
+        return NULL;
+
+    membench_cachesim_t *s = (membench_cachesim_t *)calloc(1, sizeof(*s));
+    if (!s) return NULL;
+    s->profile = *p;
+    s->policy = policy;
+
+    for (size_t i = 0; i < p->num_levels; i++) {
+        sim_level_t *lv = &s->level[i];
+        int ways = p->level[i].ways;
+        if (ways < 1 || ways > MEMBENCH_SIM_MAX_WAYS) goto fail;
+        lv->ways = ways;
+        lv->sets = p->level[i].size_bytes / (p->line_bytes * (size_t)ways);
+        if (lv->sets == 0) goto fail;
+
+        size_t slots = lv->sets * (size_t)ways;
+        lv->tags = (uint64_t *)calloc(slots, sizeof(uint64_t));
+        lv->dirty = (uint64_t *)calloc(lv->sets, sizeof(uint64_t));
+        if (policy == MEMBENCH_SIM_LRU)
+            lv->stamps = (uint64_t *)calloc(slots, sizeof(uint64_t));
+        else
+            lv->mru = (uint64_t *)calloc(lv->sets, sizeof(uint64_t));
+        if (!lv->tags || !lv->dirty || (!lv->stamps && !lv->mru)) goto fail;
+    }
+    return s;
+
+fail:
+    membench_cachesim_destroy(s);
+    return NULL;
+}
+
+void membench_cachesim_access(membench_cachesim_t *s, uint64_t addr,
+                              uint32_t size, int is_write) {
+    if (!s || size == 0) return;
+    uint64_t first = addr / s->profile.line_bytes;
+    uint64_t last = (addr + size - 1) / s->profile.line_bytes;
+    for (uint64_t line = first; line <= last; line++)
+        access_line(s, line, is_write);
+}
+
+void membench_cachesim_result(const membench_cachesim_t *s, membench_sim_result_t *r) {
+    if (!s || !r) return;
+    memset(r, 0, sizeof(*r));
+    r->policy = s->policy;
+    r->num_levels = s->profile.num_levels;
+    r->accesses = s->accesses;
+    r->memory_reads = s->memory_reads;
+    r->memory_writes = s->memory_writes;
+
+    double total = (double)s->memory_reads * s->profile.memory_latency_ns;
+    for (size_t i = 0; i < r->num_levels; i++) {
+        r->level[i] = s->level[i].stats;
+        total += (double)s->level[i].stats.hits * s->profile.level[i].latency_ns;
+    }
+    r->est_total_ns = total;
+    r->est_avg_latency_ns = s->accesses ? total / (double)s->accesses : 0.0;
+}
+
+void membench_cachesim_destroy(membench_cachesim_t *s) {
+    if (!s) return;
+    for (size_t i = 0; i < MEMBENCH_SIM_MAX_LEVELS; i++) {
+        free(s->level[i].tags);
+        free(s->level[i].stamps);
+        free(s->level[i].mru);
+        free(s->level[i].dirty);
+    }
+    free(s);
+}
+
+int membench_cachesim_run_trace(const char *path, const membench_cache_profile_t *p,
+                                membench_sim_policy_t policy,
+                                membench_sim_result_t *result) {
+    if (!path || !result) return -1;
+    membench_trace_reader_t *tr = membench_trace_open(path);
+    if (!tr) return -1;
+    membench_cachesim_t *s = membench_cachesim_create(p, policy);
+    if (!s) {
+        membench_trace_close(tr);
+        return -1;
+    }
+
+    const uint64_t *recs;
+    size_t n;
+    while ((n = membench_trace_next(tr, &recs)) > 0) {
+        for (size_t i = 0; i < n; i++)
+            membench_cachesim_access(s, membench_trace_offset(recs[i]),
+                                     membench_trace_size(recs[i]),
+                                     membench_trace_is_write(recs[i]));
+    }
+
+    membench_cachesim_result(s, result);
+    membench_cachesim_destroy(s);
+    membench_trace_close(tr);
+    return 0;
+}
+
+const char *membench_sim_policy_name(membench_sim_policy_t policy) {
+    switch (policy) {
+    case MEMBENCH_SIM_LRU:  return "lru";
+    case MEMBENCH_SIM_PLRU: return "plru";
+    default:                return "unknown";
+    }
+}
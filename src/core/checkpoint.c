@@ -0,0 +1,245 @@
+/**
+ * checkpoint.c — Signal-driven cancellation and the checkpoint file.
+ *
+ * The handler only stores the signal number; everything else (stopping
+ * loops, freeing, printing) happens in normal context once the running
+ * point returns.
+ */
+#include "membench/checkpoint.h"
+#include "membench/platform.h"
+
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define CHECKPOINT_MAGIC    "membench-checkpoint 1"
+#define CHECKPOINT_LINE_MAX 65536
+
+/* ── Cancellation ─────────────────────────────────────────────────────────── */
+
+static volatile sig_atomic_t g_cancel_sig;
+
+static void on_signal(int sig) {
+    if (g_cancel_sig) {
+        /* Second signal: the user wants out now */
+        signal(sig, SIG_DFL);
+        raise(sig);
+        return;
+    }
+    g_cancel_sig = sig;
+#if defined(MEMBENCH_PLATFORM_WINDOWS)
+    signal(sig, on_signal);  /* the CRT resets the handler before calling it */
+#endif
+}
+
+int membench_cancel_install(void) {
+#if defined(MEMBENCH_PLATFORM_WINDOWS)
+    if (signal(SIGINT, on_signal) == SIG_ERR) return -1;
+    if (signal(SIGTERM, on_signal) == SIG_ERR) return -1;
+#else
+    struct sigaction sa;
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = on_signal;
+    sigemptyset(&sa.sa_mask);
+    const int sigs[] = { SIGINT, SIGTERM, SIGHUP };
+    for (size_t i = 0; i < sizeof(sigs) / sizeof(sigs[0]); i++)
+        if (sigaction(sigs[i], &sa, NULL) != 0) return -1;
+#endif
+    return 0;
+}
+
+int membench_cancel_requested(void) {
+    return (int)g_cancel_sig;
+}
+
+void membench_cancel_request(int sig) {
+    g_cancel_sig = sig ? sig : SIGINT;
+}
+
+void membench_cancel_reset(void) {
+    g_cancel_sig = 0;
+}
+
+/* ── Checkpoint file ──────────────────────────────────────────────────────── */
+
+typedef struct {
+    char    key[MEMBENCH_CHECKPOINT_KEY_LEN];
+    size_t  n;
+    double *vals;
+} cp_entry_t;
+
+struct membench_checkpoint {
+    FILE       *f;
+    cp_entry_t *entries;
+    size_t      count, cap, loaded;
+};
+
+static int cp_error(char *err, size_t err_len, const char *fmt, const char *arg) {
+    if (err && err_len) snprintf(err, err_len, fmt, arg);
+    return -1;
+}
+
+/* Store `key`, replacing an earlier entry so a re-measured point wins */
+static int cp_set(membench_checkpoint_t *cp, const char *key, const double *vals, size_t n) {
+    double *copy = (double *)malloc((n ? n : 1) * sizeof(double));
+    if (!copy) return -1;
+    if (n) memcpy(copy, vals, n * sizeof(double));
+
+    cp_entry_t *e = NULL;
+    for (size_t i = 0; i < cp->count && !e; i++)
+        if (strcmp(cp->entries[i].key, key) == 0) e = &cp->entries[i];
+    if (e) {
+        free(e->vals);
+    } else {
+        if (cp->count == cp->cap) {
+            size_t cap = cp->cap ? cp->cap * 2 : 64;
+            cp_entry_t *grown = (cp_entry_t *)realloc(cp->entries, cap * sizeof(*grown));
+            if (!grown) { free(copy); return -1; }
+            cp->entries = grown;
+            cp->cap = cap;
+        }
+        e = &cp->entries[cp->count++];
+        snprintf(e->key, sizeof(e->key), "%s", key);
+    }
+    e->vals = copy;
+    e->n = n;
+    return 0;
+}
+
+/* "<key> <n> v1 .. vn"; anything malformed (e.g. a torn last line) is skipped */
+static void cp_parse_line(membench_checkpoint_t *cp, char *line) {
+    size_t klen = strcspn(line, " \t");
+    if (klen == 0 || klen >= MEMBENCH_CHECKPOINT_KEY_LEN || line[klen] == '\0') return;
+    line[klen] = '\0';
+
+    char *p = line + klen + 1, *end = NULL;
+    unsigned long n = strtoul(p, &end, 10);
+    if (end == p || n > CHECKPOINT_LINE_MAX / 2) return;
+
+    double *vals = (double *)malloc((n ? n : 1) * sizeof(double));
+    if (!vals) return;
+    size_t got = 0;
+    for (p = end; got < n; got++) {
+        vals[got] = strtod(p, &end);
+        if (end == p) break;
+        p = end;
+    }
+    while (*p == ' ' || *p == '\t' || *p == '\r') p++;
+    if (got == n && *p == '\0') cp_set(cp, line, vals, n);
+    free(vals);
+}
+
+/* Returns 1 when the file ends in a torn line, 0 when clean, -1 on error */
+static int cp_load(membench_checkpoint_t *cp, FILE *f, const char *config,
+                   char *err, size_t err_len) {
+    char *line = (char *)malloc(CHECKPOINT_LINE_MAX);
+    if (!line) return -1;
+    int rc = 0, lineno = 0, complete = 1;
+    while (fgets(line, CHECKPOINT_LINE_MAX, f)) {
+        size_t len = strlen(line);
+        complete = len > 0 && line[len - 1] == '\n';
+        if (complete) line[--len] = '\0';
+        lineno++;
+
+        if (lineno == 1) {
+            if (strcmp(line, CHECKPOINT_MAGIC) != 0) {
+                rc = cp_error(err, err_len, "%s", "not a membench checkpoint file");
+                break;
+            }
+        } else if (lineno == 2) {
+            if (strncmp(line, "config ", 7) != 0 || strcmp(line + 7, config) != 0) {
+                rc = cp_error(err, err_len, "checkpoint was written by a different "
+                              "command line: %s", strncmp(line, "config ", 7) == 0
+                              ? line + 7 : "(none)");
+                break;
+            }
+        } else if (complete) {
+            cp_parse_line(cp, line);
+        }
+    }
+    free(line);
+    return rc != 0 ? rc : !complete;
+}
+
+membench_checkpoint_t *membench_checkpoint_open(const char *path, const char *config,
+                                                int resume, char *err, size_t err_len) {
+    if (!path || !config || strchr(config, '\n')) {
+        cp_error(err, err_len, "%s", "invalid checkpoint arguments");
+        return NULL;
+    }
+    membench_checkpoint_t *cp = (membench_checkpoint_t *)calloc(1, sizeof(*cp));
+    if (!cp) return NULL;
+
+    int fresh = 1, torn = 0;
+    if (resume) {
+        FILE *in = fopen(path, "r");
+        int c = in ? fgetc(in) : EOF;
+        if (c != EOF) {    /* an empty file is the same as a missing one */
+            ungetc(c, in);
+            torn = cp_load(cp, in, config, err, err_len);
+            if (torn < 0) {
+                fclose(in);
+                membench_checkpoint_close(cp);
+                return NULL;
+            }
+            fresh = 0;
+        }
+        if (in) fclose(in);
+    }
+    cp->loaded = cp->count;
+
+    cp->f = fopen(path, fresh ? "w" : "a");
+    if (!cp->f) {
+        cp_error(err, err_len, "cannot write '%s'", path);
+        membench_checkpoint_close(cp);
+        return NULL;
+    }
+    if (fresh)
+        fprintf(cp->f, "%s\nconfig %s\n", CHECKPOINT_MAGIC, config);
+    else if (torn)
+        fputc('\n', cp->f);    /* keep new points off the torn line */
+    fflush(cp->f);
+    return cp;
+}
+
+void membench_checkpoint_close(membench_checkpoint_t *cp) {
+    if (!cp) return;
+    if (cp->f) fclose(cp->f);
+    for (size_t i = 0; i < cp->count; i++) free(cp->entries[i].vals);
+    free(cp->entries);
+    free(cp);
+}
+
+const double *membench_checkpoint_find(const membench_checkpoint_t *cp, const char *key,
+                                       size_t *n) {
+    if (!cp || !key) return NULL;
+    for (size_t i = 0; i < cp->count; i++) {
+        if (strcmp(cp->entries[i].key, key) == 0) {
+            if (n) *n = cp->entries[i].n;
+            return cp->entries[i].vals;
+        }
+    }
+    return NULL;
+}
+
+int membench_checkpoint_record(membench_checkpoint_t *cp, const char *key,
+                               const double *vals, size_t n) {
+    if (!cp || !key || !*key || strlen(key) >= MEMBENCH_CHECKPOINT_KEY_LEN ||
+        strpbrk(key, " \t\n") || (n && !vals))
+        return -1;
+    if (cp_set(cp, key, vals, n) != 0) return -1;
+
+    fprintf(cp->f, "%s %zu", key, n);
+    for (size_t i = 0; i < n; i++) fprintf(cp->f, " %.17g", vals[i]);
+    fputc('\n', cp->f);
+    return fflush(cp->f) == 0 ? 0 : -1;
+}
+
+size_t membench_checkpoint_loaded(const membench_checkpoint_t *cp) {
+    return cp ? cp->loaded : 0;
+}
+
+size_t membench_checkpoint_count(const membench_checkpoint_t *cp) {
+    return cp ? cp->count : 0;
+}
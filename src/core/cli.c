@@ -4,6 +4,7 @@
  * Zero-dependency CLI parser for membench options.
  */
 #include "membench/cli.h"
+#include "membench/monitor.h"
 
 #include <stdio.h>
 #include <string.h>
@@ -16,9 +17,43 @@ void membench_cli_usage(const char *progname) {
     printf("  --target <cpu|gpu|all>   Target device (default: cpu)\n");
     printf("  --test <tests>           Comma-separated: latency,bandwidth,cache-detect,all\n");
     printf("                           (default: all)\n");
+    printf("                           Extended (not in 'all'): hash-probe,\n");
+    printf("                           search-layout, btree-sweep, record-layout,\n");
+    printf("                           linked, skewed, replay, cache-sim, roofline,\n");
+    printf("                           tile-tune, tuning, quick, license, icache, dmp\n");
     printf("  --size <bytes>           Buffer size for single-size tests (e.g. 1M, 64K, 1G)\n");
     printf("                           (default: auto-selected per test)\n");
     printf("  --iterations <n>         Number of iterations (default: auto)\n");
+    printf("  --fields <n>             record-layout: fields per record (default: 16)\n");
+    printf("  --field-width <4|8>      record-layout: bytes per field (default: 4)\n");
+    printf("  --scan-fields <k>        record-layout: fields read per record (default: 2)\n");
+    printf("  --zipf <s>               skewed: one Zipf exponent (default: sweep)\n");
+    printf("  --trace <file>           replay: binary access trace to replay\n");
+    printf("  --replay-order <dependent|independent>\n");
+    printf("                           replay: access ordering (default: both)\n");
+    printf("  --profile <file>         cache-sim: cache profile to simulate (default: detect)\n");
+    printf("  --save-profile <file>    cache-sim: save the detected profile\n");
+    printf("  --sim-policy <lru|plru>  cache-sim: replacement policy (default: both)\n");
+    printf("  --threads <n>            roofline: threads for all-core runs (default: cores)\n");
+    printf("  --intensity <f>          roofline: one kernel at f FLOP/byte (default: sweep)\n");
+    printf("  --svg <file>             roofline: write the chart as SVG\n");
+    printf("  --license-window <ms>    license: time watched after each burst (default: 10)\n");
+    printf("  --emit-tuning <base>     Measure tuning parameters, write <base>.h and\n");
+    printf("                           <base>.json (runs only 'tuning' unless --test)\n");
+    printf("  --quick                  Health check in a few seconds: pass/warn/fail per\n");
+    printf("                           cache level, DRAM and cores (only 'quick' unless --test)\n");
+    printf("  --plugin <lib>           Load benchmarks from a shared object and run them\n");
+    printf("                           (runs only the plugin's unless --test)\n");
+    printf("  --repeat <n>             Plugin/registry runs per size (default: 5 plugin, 1 built-in)\n");
+    printf("  --job <file>             Run the benchmark matrix in an INI job file\n");
+    printf("                           (runs only the suite unless --test)\n");
+    printf("  --checkpoint <file>      Record finished points so an interrupted run can resume\n");
+    printf("  --resume <file>          Continue the run recorded in <file>, skipping finished points\n");
+    printf("  --timeline <file>        Write a Chrome/Perfetto trace of what each thread did\n");
+    printf("  --energy                 Energy per point from RAPL (Linux powercap): J, W, nJ/byte\n");
+    printf("  --monitor                Sample clock and temperature during each point; flag\n");
+    printf("                           points whose clock fell more than 10%%\n");
+    printf("  --throttle-threshold <pct> --monitor with a different threshold\n");
     printf("  --gpu-device <id>        GPU device index (default: 0)\n");
     printf("  --format <table|csv|json> Output format (default: table)\n");
     printf("  --verbose                Enable verbose output\n");
@@ -29,10 +64,7 @@ void membench_cli_usage(const char *progname) {
     printf("  %s --test latency --size 32K     # Latency at 32 KB\n", progname);
 }
 
-/**
- * Parse a size string like "1K", "32M", "1G" into bytes.
- */
-static size_t parse_size(const char *str) {
+size_t membench_parse_size(const char *str) {
     char *end = NULL;
     double val = strtod(str, &end);
     if (end && *end) {
@@ -60,8 +92,38 @@ static int parse_tests(const char *str, membench_test_flags_t *flags) {
             *flags |= MEMBENCH_TEST_BANDWIDTH;
         else if (strcmp(tok, "cache-detect") == 0)
             *flags |= MEMBENCH_TEST_CACHE_DETECT;
+        else if (strcmp(tok, "hash-probe") == 0)
+            *flags |= MEMBENCH_TEST_HASH_PROBE;
+        else if (strcmp(tok, "search-layout") == 0)
+            *flags |= MEMBENCH_TEST_SEARCH;
+        else if (strcmp(tok, "btree-sweep") == 0)
+            *flags |= MEMBENCH_TEST_BTREE;
+        else if (strcmp(tok, "record-layout") == 0)
+            *flags |= MEMBENCH_TEST_RECORD_LAYOUT;
+        else if (strcmp(tok, "linked") == 0)
+            *flags |= MEMBENCH_TEST_LINKED;
+        else if (strcmp(tok, "skewed") == 0)
+            *flags |= MEMBENCH_TEST_SKEWED;
+        else if (strcmp(tok, "replay") == 0)
+            *flags |= MEMBENCH_TEST_REPLAY;
+        else if (strcmp(tok, "cache-sim") == 0)
+            *flags |= MEMBENCH_TEST_CACHE_SIM;
+        else if (strcmp(tok, "roofline") == 0)
+            *flags |= MEMBENCH_TEST_ROOFLINE;
+        else if (strcmp(tok, "tile-tune") == 0)
+            *flags |= MEMBENCH_TEST_TILE_TUNE;
+        else if (strcmp(tok, "tuning") == 0)
+            *flags |= MEMBENCH_TEST_TUNING;
+        else if (strcmp(tok, "quick") == 0)
+            *flags |= MEMBENCH_TEST_QUICK;
+        else if (strcmp(tok, "license") == 0)
+            *flags |= MEMBENCH_TEST_LICENSE;
+        else if (strcmp(tok, "icache") == 0)
+            *flags |= MEMBENCH_TEST_ICACHE;
+        else if (strcmp(tok, "dmp") == 0)
+            *flags |= MEMBENCH_TEST_DMP;
         else if (strcmp(tok, "all") == 0)
-            *flags = MEMBENCH_TEST_ALL;
+            *flags |= MEMBENCH_TEST_ALL;
         else {
             fprintf(stderr, "Unknown test: '%s'\n", tok);
             return -1;
@@ -81,8 +143,32 @@ int membench_cli_parse(int argc, char **argv, membench_options_t *opts) {
     opts->buffer_size = 0;
     opts->iterations = 0;
     opts->gpu_device = 0;
+    opts->record_fields = 16;
+    opts->field_bytes = 4;
+    opts->scan_fields = 2;
+    opts->zipf_s = -1.0;
+    opts->trace_path = NULL;
+    opts->replay_order = -1;
+    opts->profile_path = NULL;
+    opts->save_profile = NULL;
+    opts->sim_policy = -1;
+    opts->threads = 0;
+    opts->intensity = -1.0;
+    opts->svg_path = NULL;
+    opts->license_ms = 0.0;
+    opts->tuning_path = NULL;
+    opts->plugin_path = NULL;
+    opts->repeat = 0;
+    opts->job_path = NULL;
+    opts->checkpoint_path = NULL;
+    opts->resume = false;
+    opts->timeline_path = NULL;
+    opts->energy = false;
+    opts->monitor_pct = 0.0;
     opts->verbose = false;
     opts->show_help = false;
+    bool tests_given = false;
+    bool quick = false;
 
     for (int i = 1; i < argc; i++) {
         if (strcmp(argv[i], "--help") == 0 || strcmp(argv[i], "-h") == 0) {
@@ -102,10 +188,11 @@ int membench_cli_parse(int argc, char **argv, membench_options_t *opts) {
         else if (strcmp(argv[i], "--test") == 0 && i + 1 < argc) {
             i++;
             if (parse_tests(argv[i], &opts->tests) != 0) return -1;
+            tests_given = true;
         }
         else if (strcmp(argv[i], "--size") == 0 && i + 1 < argc) {
             i++;
-            opts->buffer_size = parse_size(argv[i]);
+            opts->buffer_size = membench_parse_size(argv[i]);
             if (opts->buffer_size == 0) {
                 fprintf(stderr, "Invalid size: '%s'\n", argv[i]);
                 return -1;
@@ -115,6 +202,147 @@ int membench_cli_parse(int argc, char **argv, membench_options_t *opts) {
             i++;
             opts->iterations = (uint64_t)strtoull(argv[i], NULL, 10);
         }
+        else if (strcmp(argv[i], "--fields") == 0 && i + 1 < argc) {
+            i++;
+            opts->record_fields = (size_t)strtoull(argv[i], NULL, 10);
+            if (opts->record_fields == 0 || opts->record_fields > 64) {
+                fprintf(stderr, "Invalid field count: '%s' (1..64)\n", argv[i]);
+                return -1;
+            }
+        }
+        else if (strcmp(argv[i], "--field-width") == 0 && i + 1 < argc) {
+            i++;
+            opts->field_bytes = (size_t)strtoull(argv[i], NULL, 10);
+            if (opts->field_bytes != 4 && opts->field_bytes != 8) {
+                fprintf(stderr, "Invalid field width: '%s' (4 or 8)\n", argv[i]);
+                return -1;
+            }
+        }
+        else if (strcmp(argv[i], "--scan-fields") == 0 && i + 1 < argc) {
+            i++;
+            opts->scan_fields = (size_t)strtoull(argv[i], NULL, 10);
+            if (opts->scan_fields == 0) {
+                fprintf(stderr, "Invalid scan field count: '%s'\n", argv[i]);
+                return -1;
+            }
+        }
+        else if (strcmp(argv[i], "--zipf") == 0 && i + 1 < argc) {
+            i++;
+            char *end = NULL;
+            opts->zipf_s = strtod(argv[i], &end);
+            if (end == argv[i] || *end || opts->zipf_s < 0.0) {
+                fprintf(stderr, "Invalid Zipf exponent: '%s'\n", argv[i]);
+                return -1;
+            }
+        }
+        else if (strcmp(argv[i], "--trace") == 0 && i + 1 < argc) {
+            i++;
+            opts->trace_path = argv[i];
+        }
+        else if (strcmp(argv[i], "--replay-order") == 0 && i + 1 < argc) {
+            i++;
+            if (strcmp(argv[i], "dependent") == 0)        opts->replay_order = 0;
+            else if (strcmp(argv[i], "independent") == 0) opts->replay_order = 1;
+            else {
+                fprintf(stderr, "Unknown replay order: '%s'\n", argv[i]);
+                return -1;
+            }
+        }
+        else if (strcmp(argv[i], "--profile") == 0 && i + 1 < argc) {
+            i++;
+            opts->profile_path = argv[i];
+        }
+        else if (strcmp(argv[i], "--save-profile") == 0 && i + 1 < argc) {
+            i++;
+            opts->save_profile = argv[i];
+        }
+        else if (strcmp(argv[i], "--sim-policy") == 0 && i + 1 < argc) {
+            i++;
+            if (strcmp(argv[i], "lru") == 0)       opts->sim_policy = 0;
+            else if (strcmp(argv[i], "plru") == 0) opts->sim_policy = 1;
+            else {
+                fprintf(stderr, "Unknown policy: '%s'\n", argv[i]);
+                return -1;
+            }
+        }
+        else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            i++;
+            opts->threads = (int)strtol(argv[i], NULL, 10);
+            if (opts->threads < 1) {
+                fprintf(stderr, "Invalid thread count: '%s'\n", argv[i]);
+                return -1;
+            }
+        }
+        else if (strcmp(argv[i], "--intensity") == 0 && i + 1 < argc) {
+            i++;
+            char *end = NULL;
+            opts->intensity = strtod(argv[i], &end);
+            if (end == argv[i] || *end || opts->intensity <= 0.0) {
+                fprintf(stderr, "Invalid arithmetic intensity: '%s'\n", argv[i]);
+                return -1;
+            }
+        }
+        else if (strcmp(argv[i], "--svg") == 0 && i + 1 < argc) {
+            i++;
+            opts->svg_path = argv[i];
+        }
+        else if (strcmp(argv[i], "--license-window") == 0 && i + 1 < argc) {
+            i++;
+            char *end = NULL;
+            opts->license_ms = strtod(argv[i], &end);
+            if (end == argv[i] || *end || opts->license_ms <= 0.0 || opts->license_ms > 1000.0) {
+                fprintf(stderr, "Invalid license window: '%s' (ms, up to 1000)\n", argv[i]);
+                return -1;
+            }
+        }
+        else if (strcmp(argv[i], "--emit-tuning") == 0 && i + 1 < argc) {
+            i++;
+            opts->tuning_path = argv[i];
+        }
+        else if (strcmp(argv[i], "--quick") == 0) {
+            quick = true;
+        }
+        else if (strcmp(argv[i], "--plugin") == 0 && i + 1 < argc) {
+            i++;
+            opts->plugin_path = argv[i];
+        }
+        else if (strcmp(argv[i], "--job") == 0 && i + 1 < argc) {
+            i++;
+            opts->job_path = argv[i];
+        }
+        else if ((strcmp(argv[i], "--checkpoint") == 0 || strcmp(argv[i], "--resume") == 0) &&
+                 i + 1 < argc) {
+            opts->resume = strcmp(argv[i], "--resume") == 0;
+            i++;
+            opts->checkpoint_path = argv[i];
+        }
+        else if (strcmp(argv[i], "--timeline") == 0 && i + 1 < argc) {
+            i++;
+            opts->timeline_path = argv[i];
+        }
+        else if (strcmp(argv[i], "--energy") == 0) {
+            opts->energy = true;
+        }
+        else if (strcmp(argv[i], "--monitor") == 0) {
+            if (opts->monitor_pct == 0.0) opts->monitor_pct = MEMBENCH_MONITOR_THRESHOLD_PCT;
+        }
+        else if (strcmp(argv[i], "--throttle-threshold") == 0 && i + 1 < argc) {
+            i++;
+            char *end = NULL;
+            opts->monitor_pct = strtod(argv[i], &end);
+            if (end == argv[i] || *end || opts->monitor_pct <= 0.0 || opts->monitor_pct >= 100.0) {
+                fprintf(stderr, "Invalid throttle threshold: '%s'\n", argv[i]);
+                return -1;
+            }
+        }
+        else if (strcmp(argv[i], "--repeat") == 0 && i + 1 < argc) {
+            i++;
+            opts->repeat = (int)strtol(argv[i], NULL, 10);
+            if (opts->repeat < 1) {
+                fprintf(stderr, "Invalid repeat count: '%s'\n", argv[i]);
+                return -1;
+            }
+        }
         else if (strcmp(argv[i], "--gpu-device") == 0 && i + 1 < argc) {
             i++;
             opts->gpu_device = (int)strtol(argv[i], NULL, 10);
@@ -138,5 +366,35 @@ int membench_cli_parse(int argc, char **argv, membench_options_t *opts) {
         }
     }
 
+    if ((opts->plugin_path || opts->job_path) && !tests_given && !opts->tuning_path)
+        opts->tests = 0;
+
+    if (opts->tuning_path) {
+        if (tests_given) opts->tests |= MEMBENCH_TEST_TUNING;
+        else             opts->tests = MEMBENCH_TEST_TUNING;
+    }
+
+    if (quick) {
+        if (tests_given || opts->tuning_path) opts->tests |= MEMBENCH_TEST_QUICK;
+        else                                   opts->tests = MEMBENCH_TEST_QUICK;
+    }
+
+    if ((opts->tests & MEMBENCH_TEST_REPLAY) && !opts->trace_path) {
+        fprintf(stderr, "--test replay requires --trace <file>\n");
+        return -1;
+    }
+
+    if ((opts->tests & MEMBENCH_TEST_CACHE_SIM) && !opts->trace_path &&
+        !opts->save_profile) {
+        fprintf(stderr, "--test cache-sim requires --trace <file> or --save-profile <file>\n");
+        return -1;
+    }
+
+    if (opts->scan_fields > opts->record_fields) {
+        fprintf(stderr, "--scan-fields (%zu) exceeds --fields (%zu)\n",
+                opts->scan_fields, opts->record_fields);
+        return -1;
+    }
+
     return 0;
 }
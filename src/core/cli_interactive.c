@@ -313,6 +313,28 @@ int membench_cli_interactive(membench_options_t *opts) {
     opts->buffer_size = 0;
     opts->iterations = 0;
     opts->gpu_device = 0;
+    opts->record_fields = 16;
+    opts->field_bytes = 4;
+    opts->scan_fields = 2;
+    opts->zipf_s = -1.0;
+    opts->trace_path = NULL;
+    opts->replay_order = -1;
+    opts->profile_path = NULL;
+    opts->save_profile = NULL;
+    opts->sim_policy = -1;
+    opts->threads = 0;
+    opts->intensity = -1.0;
+    opts->svg_path = NULL;
+    opts->license_ms = 0.0;
+    opts->tuning_path = NULL;
+    opts->plugin_path = NULL;
+    opts->repeat = 0;
+    opts->job_path = NULL;
+    opts->checkpoint_path = NULL;
+    opts->resume = false;
+    opts->timeline_path = NULL;
+    opts->energy = false;
+    opts->monitor_pct = 0.0;
     opts->verbose = false;
     opts->show_help = false;
 
@@ -0,0 +1,155 @@
+/**
+ * energy.c — RAPL energy counters through Linux powercap.
+ */
+#include "membench/energy.h"
+#include "membench/platform.h"
+#include "membench/timer.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(MEMBENCH_PLATFORM_LINUX)
+    #include <dirent.h>
+#endif
+
+#define POWERCAP_ROOT "/sys/class/powercap"
+
+static void set_err(char *err, size_t len, const char *msg) {
+    if (err && len) snprintf(err, len, "%s", msg);
+}
+
+#if defined(MEMBENCH_PLATFORM_LINUX)
+static int read_u64(const char *path, uint64_t *v) {
+    FILE *f = fopen(path, "r");
+    if (!f) return -1;
+    unsigned long long x = 0;
+    int ok = fscanf(f, "%llu", &x) == 1;
+    fclose(f);
+    if (!ok) return -1;
+    *v = (uint64_t)x;
+    return 0;
+}
+
+/* root/zone/file, or -1 if it does not fit */
+static int zone_path(char *buf, size_t len, const char *root, const char *zone,
+                     const char *file) {
+    int n = snprintf(buf, len, "%s/%s/%s", root, zone, file);
+    return n < 0 || (size_t)n >= len ? -1 : 0;
+}
+
+static int cmp_domain_path(const void *a, const void *b) {
+    return strcmp((const char *)a, (const char *)b);
+}
+#endif
+
+int membench_energy_open(membench_energy_t *e, const char *root, char *err, size_t err_len) {
+    if (!e) return -1;
+    memset(e, 0, sizeof(*e));
+#if defined(MEMBENCH_PLATFORM_LINUX)
+    if (!root) root = POWERCAP_ROOT;
+    DIR *d = opendir(root);
+    if (!d) {
+        set_err(err, err_len, "no powercap interface (" POWERCAP_ROOT ")");
+        return -1;
+    }
+
+    /* Zones are flat entries "intel-rapl:N" and "intel-rapl:N:M"; sort so
+     * domain order is stable across runs */
+    char names[MEMBENCH_ENERGY_MAX_DOMAINS * 4][64];
+    size_t num_names = 0;
+    struct dirent *de;
+    while ((de = readdir(d)) != NULL && num_names < sizeof(names) / sizeof(names[0])) {
+        if (strncmp(de->d_name, "intel-rapl:", 11) != 0 ||
+            strlen(de->d_name) >= sizeof(names[0]))
+            continue;
+        memcpy(names[num_names++], de->d_name, strlen(de->d_name) + 1);
+    }
+    closedir(d);
+    qsort(names, num_names, sizeof(names[0]), cmp_domain_path);
+
+    int found = 0, unreadable = 0;
+    for (size_t i = 0; i < num_names && e->num_domains < MEMBENCH_ENERGY_MAX_DOMAINS; i++) {
+        char path[MEMBENCH_ENERGY_PATH_LEN], kind[32] = "";
+        FILE *f = zone_path(path, sizeof(path), root, names[i], "name") == 0
+                  ? fopen(path, "r") : NULL;
+        if (!f) continue;
+        if (!fgets(kind, sizeof(kind), f)) kind[0] = '\0';
+        fclose(f);
+        kind[strcspn(kind, "\n")] = '\0';
+
+        membench_energy_domain_t k;
+        if (strncmp(kind, "package-", 8) == 0)  k = MEMBENCH_ENERGY_PACKAGE;
+        else if (strcmp(kind, "dram") == 0)     k = MEMBENCH_ENERGY_DRAM;
+        else continue;                          /* core, uncore, psys overlap */
+        found = 1;
+
+        uint64_t v;
+        if (zone_path(path, sizeof(path), root, names[i], "energy_uj") != 0 ||
+            read_u64(path, &v) != 0) {
+            unreadable = 1;
+            continue;
+        }
+        size_t n = e->num_domains++;
+        e->domains[n].kind = k;
+        memcpy(e->domains[n].path, path, sizeof(path));
+        if (zone_path(path, sizeof(path), root, names[i], "max_energy_range_uj") != 0 ||
+            read_u64(path, &e->domains[n].max_range_uj) != 0)
+            e->domains[n].max_range_uj = 0;
+    }
+
+    int have_package = 0;
+    for (size_t i = 0; i < e->num_domains; i++)
+        if (e->domains[i].kind == MEMBENCH_ENERGY_PACKAGE) have_package = 1;
+    if (have_package) return 0;
+
+    set_err(err, err_len, !found ? "no RAPL package domain under " POWERCAP_ROOT
+                        : unreadable ? "RAPL energy_uj is not readable (root only since Linux 5.10)"
+                        : "no readable RAPL package domain");
+    e->num_domains = 0;
+    return -1;
+#else
+    (void)root;
+    set_err(err, err_len, "energy counters need Linux powercap");
+    return -1;
+#endif
+}
+
+void membench_energy_sample(const membench_energy_t *e, membench_energy_sample_t *s) {
+    memset(s, 0, sizeof(*s));
+#if defined(MEMBENCH_PLATFORM_LINUX)
+    for (size_t i = 0; i < e->num_domains; i++)
+        if (read_u64(e->domains[i].path, &s->uj[i]) != 0) s->uj[i] = 0;
+#else
+    (void)e;
+#endif
+    s->t_ns = membench_timer_ns();
+}
+
+int membench_energy_diff(const membench_energy_t *e, const membench_energy_sample_t *a,
+                         const membench_energy_sample_t *b, uint64_t timed_ns,
+                         uint64_t bytes, uint64_t ops, membench_energy_result_t *r) {
+    memset(r, 0, sizeof(*r));
+    r->seconds = (double)(b->t_ns - a->t_ns) / 1e9;
+    for (size_t i = 0; i < e->num_domains; i++) {
+        uint64_t max = e->domains[i].max_range_uj;
+        if (b->uj[i] < a->uj[i] && (max == 0 || a->uj[i] > max)) {
+            memset(r, 0, sizeof(*r));
+            return -1;
+        }
+        uint64_t d = b->uj[i] >= a->uj[i] ? b->uj[i] - a->uj[i]
+                   : b->uj[i] + max - a->uj[i];                          /* wrapped once */
+        double j = (double)d / 1e6;
+        if (e->domains[i].kind == MEMBENCH_ENERGY_DRAM) {
+            r->dram_j += j;
+            r->has_dram = 1;
+        } else {
+            r->package_j += j;
+        }
+    }
+    if (r->seconds > 0.0) r->watts = (r->package_j + r->dram_j) / r->seconds;
+    r->timed_j = r->watts * (double)timed_ns / 1e9;
+    if (bytes) r->nj_per_byte = r->timed_j * 1e9 / (double)bytes;
+    if (ops)   r->nj_per_op = r->timed_j * 1e9 / (double)ops;
+    return 0;
+}
@@ -0,0 +1,163 @@
+/**
+ * health.c — Expected ranges and grading for the quick health check.
+ *
+ * Ranges come from published measurements for each family with generous
+ * margins either side: the check should only trip on hardware or
+ * firmware that is clearly wrong.  Families are matched in table order,
+ * so more specific names come first.
+ */
+#include "membench/health.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static const membench_health_expect_t EXPECT[] = {
+    /* family      L1 ns        L2 ns        L3 ns          DRAM ns         1c GB/s  scale  spread  warn */
+    { "Apple M",   { 0.3, 1.5 }, { 1.5, 8.0 }, { 0.0,  0.0 }, { 60.0, 150.0 }, 30.0,    1.5,   1.25,   1.5 },
+    { "EPYC",      { 0.5, 2.5 }, { 1.5, 6.0 }, { 5.0, 25.0 }, { 70.0, 180.0 },  5.0,    1.5,   1.25,   1.5 },
+    { "Ryzen",     { 0.5, 2.0 }, { 1.5, 5.0 }, { 5.0, 20.0 }, { 55.0, 120.0 }, 10.0,    1.5,   1.25,   1.5 },
+    { "Xeon",      { 0.5, 2.5 }, { 1.5, 8.0 }, { 8.0, 40.0 }, { 70.0, 200.0 },  4.0,    1.5,   1.25,   1.5 },
+    { "Core(TM)",  { 0.5, 2.0 }, { 1.5, 6.0 }, { 5.0, 25.0 }, { 55.0, 130.0 }, 10.0,    1.5,   1.25,   1.5 },
+    { "Neoverse",  { 0.5, 2.5 }, { 1.5, 8.0 }, { 5.0, 40.0 }, { 70.0, 200.0 },  8.0,    1.5,   1.25,   1.5 },
+    { "generic",   { 0.3, 3.0 }, { 1.0, 10.0 }, { 3.0, 50.0 }, { 40.0, 250.0 },  3.0,    1.3,   1.25,   1.5 },
+};
+#define NUM_EXPECT (sizeof(EXPECT) / sizeof(EXPECT[0]))
+
+/* Cores of one part should match closely: the spread warns past the
+ * limit and fails 20% beyond it (1.25x / 1.5x) */
+#define SPREAD_WARN_FACTOR 1.2
+
+const membench_health_expect_t *membench_health_expect_for(const char *cpu_model) {
+    for (size_t i = 0; cpu_model && i + 1 < NUM_EXPECT; i++)
+        if (strstr(cpu_model, EXPECT[i].family)) return &EXPECT[i];
+    return &EXPECT[NUM_EXPECT - 1];
+}
+
+const char *membench_health_status_name(membench_health_status_t status) {
+    switch (status) {
+    case MEMBENCH_HEALTH_PASS: return "pass";
+    case MEMBENCH_HEALTH_WARN: return "warn";
+    case MEMBENCH_HEALTH_FAIL: return "fail";
+    default:                   return "skip";
+    }
+}
+
+static membench_health_check_t *add_check(membench_health_report_t *r, const char *name,
+                                          const char *unit, double value,
+                                          double lo, double hi) {
+    if (r->num_checks >= MEMBENCH_HEALTH_MAX_CHECKS) {
+        static membench_health_check_t scratch;
+        return &scratch;
+    }
+    membench_health_check_t *c = &r->checks[r->num_checks++];
+    memset(c, 0, sizeof(*c));
+    c->name = name;
+    c->unit = unit;
+    c->value = value;
+    c->lo = lo;
+    c->hi = hi;
+    return c;
+}
+
+/* In [lo, hi] passes, within warn_factor of it warns, beyond fails */
+static void grade(membench_health_check_t *c, double warn_factor) {
+    if (c->value <= 0.0) {
+        c->status = MEMBENCH_HEALTH_SKIP;
+        snprintf(c->note, sizeof(c->note), "not measured");
+        return;
+    }
+    double below = c->lo > 0.0 && c->value < c->lo ? c->lo / c->value : 1.0;
+    double above = c->hi > 0.0 && c->value > c->hi ? c->value / c->hi : 1.0;
+    double off = below > above ? below : above;
+    if (off <= 1.0)             c->status = MEMBENCH_HEALTH_PASS;
+    else if (off <= warn_factor) c->status = MEMBENCH_HEALTH_WARN;
+    else                         c->status = MEMBENCH_HEALTH_FAIL;
+    if (off > 1.0)
+        snprintf(c->note, sizeof(c->note), "%.2fx %s the expected range", off,
+                 below > above ? "below" : "above");
+}
+
+static void latency_check(membench_health_report_t *r, const char *name, double ns,
+                          const double range[2], double warn_factor) {
+    if (range[1] <= 0.0) {
+        membench_health_check_t *c = add_check(r, name, "ns", ns, 0.0, 0.0);
+        c->status = MEMBENCH_HEALTH_SKIP;
+        snprintf(c->note, sizeof(c->note), "level not present on this family");
+        return;
+    }
+    grade(add_check(r, name, "ns", ns, range[0], range[1]), warn_factor);
+}
+
+static int cmp_double(const void *a, const void *b) {
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+void membench_health_evaluate(const membench_quick_probe_t *p,
+                              const membench_health_expect_t *e,
+                              membench_health_report_t *r) {
+    memset(r, 0, sizeof(*r));
+    r->family = e->family;
+    r->elapsed_ns = p->elapsed_ns;
+
+    latency_check(r, "l1-latency", p->l1_ns, e->l1_ns, e->warn_factor);
+    latency_check(r, "l2-latency", p->l2_ns, e->l2_ns, e->warn_factor);
+    latency_check(r, "l3-latency", p->l3_bytes ? p->l3_ns : 0.0, e->l3_ns, e->warn_factor);
+    latency_check(r, "dram-latency", p->dram_ns, e->dram_ns, e->warn_factor);
+
+    /* Each level must be slower than the one inside it, or the probe
+     * sizes (i.e. the reported cache sizes) are wrong */
+    const double lv[] = { p->l1_ns, p->l2_ns, p->l3_bytes ? p->l3_ns : 0.0, p->dram_ns };
+    double prev = 0.0;
+    int ordered = 1;
+    for (size_t i = 0; i < 4; i++) {
+        if (lv[i] <= 0.0) continue;
+        if (lv[i] < prev) ordered = 0;
+        prev = lv[i];
+    }
+    membench_health_check_t *c = add_check(r, "hierarchy", "", ordered, 0.0, 0.0);
+    c->status = ordered ? MEMBENCH_HEALTH_PASS : MEMBENCH_HEALTH_WARN;
+    if (!ordered)
+        snprintf(c->note, sizeof(c->note), "latency does not grow level by level");
+
+    grade(add_check(r, "dram-bw-1core", "GB/s", p->bw_1core_gbps, e->bw_1core_gbps, 0.0),
+          e->warn_factor);
+
+    c = add_check(r, "dram-bw-scaling", "x",
+                  p->bw_1core_gbps > 0.0 ? p->bw_allcore_gbps / p->bw_1core_gbps : 0.0,
+                  e->allcore_scaling, 0.0);
+    if (p->threads < 2) {
+        c->status = MEMBENCH_HEALTH_SKIP;
+        snprintf(c->note, sizeof(c->note), "single CPU");
+    } else {
+        grade(c, e->warn_factor);
+    }
+
+    /* One core far slower than the median points at that core */
+    c = add_check(r, "core-spread", "x", 0.0, 0.0, e->core_spread);
+    if (p->num_cores < 2) {
+        c->status = MEMBENCH_HEALTH_SKIP;
+        snprintf(c->note, sizeof(c->note), "single CPU");
+    } else {
+        int n = p->num_cores < MEMBENCH_QUICK_MAX_CORES ? p->num_cores : MEMBENCH_QUICK_MAX_CORES;
+        double sorted[MEMBENCH_QUICK_MAX_CORES];
+        memcpy(sorted, p->core_l2_ns, (size_t)n * sizeof(double));
+        qsort(sorted, (size_t)n, sizeof(double), cmp_double);
+        double median = sorted[n / 2];
+        int slowest = 0;
+        for (int i = 1; i < n; i++)
+            if (p->core_l2_ns[i] > p->core_l2_ns[slowest]) slowest = i;
+        c->value = median > 0.0 ? p->core_l2_ns[slowest] / median : 0.0;
+        grade(c, SPREAD_WARN_FACTOR);
+        if (c->status != MEMBENCH_HEALTH_PASS && c->status != MEMBENCH_HEALTH_SKIP)
+            snprintf(c->note, sizeof(c->note), "core %d: %.2f ns vs %.2f ns median",
+                     slowest, p->core_l2_ns[slowest], median);
+    }
+
+    r->overall = MEMBENCH_HEALTH_PASS;
+    for (size_t i = 0; i < r->num_checks; i++) {
+        membench_health_status_t s = r->checks[i].status;
+        if (s != MEMBENCH_HEALTH_SKIP && s > r->overall) r->overall = s;
+    }
+}
@@ -0,0 +1,302 @@
+/**
+ * jobfile.c — INI-style job file parser and size-list syntax.
+ *
+ * Zero-dependency, like the CLI parser: one pass over the text, one line
+ * at a time, keys applied to the current job.  [global] keys become the
+ * starting point of every job declared after them.
+ */
+#include "membench/suite.h"
+#include "membench/cli.h"
+
+#include <ctype.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define JOB_LINE_MAX  512
+#define JOB_FILE_MAX  (1024 * 1024)
+#define JOB_THREADS_MAX 1024             /* one copy of the bench per thread */
+#define JOB_REPEAT_MAX  1000             /* timed runs per point */
+#define RANGE_STEPS_MAX 4096             /* x1.01 spans 1 B to 1 GB in ~2100 */
+
+/* ── Size lists ───────────────────────────────────────────────────────────── */
+
+static int parse_range(char *item, size_t *out, size_t max, size_t *count) {
+    char *parts[3] = { item, NULL, NULL };
+    int nparts = 1;
+    for (char *p = item; *p; p++) {
+        if (*p == ':') {
+            if (nparts == 3) return -1;
+            *p = '\0';
+            parts[nparts++] = p + 1;
+        }
+    }
+
+    size_t start = membench_parse_size(parts[0]);
+    if (start == 0) return -1;
+    if (nparts == 1) {
+        if (*count >= max) return -1;
+        out[(*count)++] = start;
+        return 0;
+    }
+
+    size_t end = membench_parse_size(parts[1]);
+    if (end < start) return -1;
+
+    /* Default step: doubling */
+    int linear = 0;
+    double factor = 2.0;
+    size_t step = 0;
+    if (nparts == 3) {
+        if (parts[2][0] == 'x' || parts[2][0] == '*') {
+            char *e = NULL;
+            factor = strtod(parts[2] + 1, &e);
+            if (e == parts[2] + 1 || *e || !(factor > 1.0)) return -1;
+        } else if (parts[2][0] == '+') {
+            step = membench_parse_size(parts[2] + 1);
+            if (step == 0) return -1;
+            linear = 1;
+        } else {
+            return -1;
+        }
+    }
+
+    double v = (double)start;
+    size_t prev = 0;
+    /* A factor barely above 1 repeats the same size for many steps; bound
+     * the steps taken, not only the sizes kept */
+    for (int steps = 0; v <= (double)end; steps++) {
+        if (steps >= RANGE_STEPS_MAX) return -1;
+        size_t s = (size_t)v;
+        if (s != prev) {
+            if (*count >= max) return -1;
+            out[(*count)++] = s;
+            prev = s;
+        }
+        v = linear ? v + (double)step : v * factor;
+    }
+    return 0;
+}
+
+int membench_parse_size_list(const char *spec, size_t *out, size_t max) {
+    if (!spec || !out) return -1;
+    char buf[JOB_LINE_MAX];
+    snprintf(buf, sizeof(buf), "%s", spec);
+
+    size_t count = 0;
+    char *save = buf;
+    for (char *item = buf; item; item = save) {
+        save = strchr(item, ',');
+        if (save) *save++ = '\0';
+        while (isspace((unsigned char)*item)) item++;
+        char *e = item + strlen(item);
+        while (e > item && isspace((unsigned char)e[-1])) *--e = '\0';
+        if (*item == '\0' || parse_range(item, out, max, &count) != 0) return -1;
+    }
+    return (int)count;
+}
+
+/* ── Job files ────────────────────────────────────────────────────────────── */
+
+static int job_error(char *err, size_t err_len, int line, const char *fmt, ...) {
+    if (err && err_len) {
+        int n = snprintf(err, err_len, "line %d: ", line);
+        if (n > 0 && (size_t)n < err_len) {
+            va_list ap;
+            va_start(ap, fmt);
+            vsnprintf(err + n, err_len - (size_t)n, fmt, ap);
+            va_end(ap);
+        }
+    }
+    return -1;
+}
+
+static char *trim(char *s) {
+    while (isspace((unsigned char)*s)) s++;
+    char *e = s + strlen(s);
+    while (e > s && isspace((unsigned char)e[-1])) *--e = '\0';
+    return s;
+}
+
+static int parse_numa(const char *v, membench_job_t *job) {
+    if (strcmp(v, "default") == 0 || strcmp(v, "local") == 0) {
+        job->numa = MEMBENCH_NUMA_DEFAULT;
+    } else if (strcmp(v, "interleave") == 0) {
+        job->numa = MEMBENCH_NUMA_INTERLEAVE;
+    } else if (strncmp(v, "bind:", 5) == 0 || strncmp(v, "preferred:", 10) == 0) {
+        const char *n = strchr(v, ':') + 1;
+        char *end = NULL;
+        long node = strtol(n, &end, 10);
+        if (end == n || *end || node < 0) return -1;
+        job->numa = v[0] == 'b' ? MEMBENCH_NUMA_BIND : MEMBENCH_NUMA_PREFERRED;
+        job->numa_node = (int)node;
+    } else {
+        return -1;
+    }
+    return 0;
+}
+
+/* Plain counts, comma-separated: no size suffixes or ranges */
+static int parse_threads(const char *v, membench_job_t *job) {
+    size_t n = 0;
+    for (const char *p = v; *p; ) {
+        char *end = NULL;
+        long t = strtol(p, &end, 10);
+        if (end == p || t < 1 || t > JOB_THREADS_MAX || n >= MEMBENCH_SUITE_MAX_THREADS) return -1;
+        job->threads[n++] = (int)t;
+        while (isspace((unsigned char)*end)) end++;
+        if (*end == ',') end++;
+        else if (*end) return -1;
+        p = end;
+    }
+    if (n == 0) return -1;
+    job->num_threads = n;
+    return 0;
+}
+
+static int apply_key(membench_job_t *job, const char *key, const char *val) {
+    if (strcmp(key, "bench") == 0 || strcmp(key, "test") == 0) {
+        snprintf(job->bench, sizeof(job->bench), "%s", val);
+    } else if (strcmp(key, "size") == 0) {
+        int n = membench_parse_size_list(val, job->sizes, MEMBENCH_SUITE_MAX_SIZES);
+        if (n <= 0) return -1;
+        job->num_sizes = (size_t)n;
+    } else if (strcmp(key, "threads") == 0) {
+        return parse_threads(val, job);
+    } else if (strcmp(key, "iterations") == 0) {
+        if (strcmp(val, "auto") == 0) {
+            job->iterations = 0;
+            return 0;
+        }
+        /* strtoull() would take "-1" as ULLONG_MAX */
+        if (!isdigit((unsigned char)val[0])) return -1;
+        char *end = NULL;
+        job->iterations = strtoull(val, &end, 10);
+        if (*end || job->iterations == 0) return -1;
+    } else if (strcmp(key, "repeat") == 0) {
+        char *end = NULL;
+        long r = strtol(val, &end, 10);
+        if (end == val || *end || r < 1 || r > JOB_REPEAT_MAX) return -1;
+        job->repeat = (int)r;
+    } else if (strcmp(key, "pages") == 0) {
+        if (strcmp(val, "default") == 0 || strcmp(val, "4K") == 0)
+            job->pages = MEMBENCH_PAGES_DEFAULT;
+        else if (strcmp(val, "huge") == 0 || strcmp(val, "2M") == 0)
+            job->pages = MEMBENCH_PAGES_HUGE;
+        else
+            return -1;
+    } else if (strcmp(key, "numa") == 0) {
+        return parse_numa(val, job);
+    } else {
+        return -2;
+    }
+    return 0;
+}
+
+static int finish_job(const membench_job_t *job, char *err, size_t err_len, int line) {
+    if (!job->bench[0])
+        return job_error(err, err_len, line, "job [%s] has no 'bench'", job->name);
+    if (!job->num_sizes)
+        return job_error(err, err_len, line, "job [%s] has no 'size'", job->name);
+    return 0;
+}
+
+int membench_suite_parse(const char *text, membench_suite_t *suite,
+                         char *err, size_t err_len) {
+    if (!text || !suite) return -1;
+    memset(suite, 0, sizeof(*suite));
+
+    membench_job_t global;
+    memset(&global, 0, sizeof(global));
+    global.repeat = 1;
+    global.threads[0] = 1;
+    global.num_threads = 1;
+
+    membench_job_t *cur = &global;
+    int line_no = 0, cur_line = 0;
+    const char *p = text;
+    while (*p) {
+        char line[JOB_LINE_MAX];
+        size_t len = strcspn(p, "\n");
+        line_no++;
+        if (len >= sizeof(line))
+            return job_error(err, err_len, line_no, "line too long");
+        memcpy(line, p, len);
+        line[len] = '\0';
+        p += len + (p[len] == '\n');
+
+        char *comment = strpbrk(line, ";#");
+        if (comment) *comment = '\0';
+        char *s = trim(line);
+        if (*s == '\0') continue;
+
+        if (*s == '[') {
+            char *close = strchr(s, ']');
+            if (!close || close[1] != '\0' || close == s + 1)
+                return job_error(err, err_len, line_no, "bad section header");
+            *close = '\0';
+            if (cur != &global && finish_job(cur, err, err_len, cur_line) != 0) return -1;
+
+            if (strcmp(s + 1, "global") == 0) {
+                cur = &global;
+                continue;
+            }
+            if (suite->num_jobs >= MEMBENCH_SUITE_MAX_JOBS)
+                return job_error(err, err_len, line_no, "more than %d jobs",
+                                 MEMBENCH_SUITE_MAX_JOBS);
+            cur = &suite->jobs[suite->num_jobs++];
+            *cur = global;
+            snprintf(cur->name, sizeof(cur->name), "%s", s + 1);
+            cur_line = line_no;
+            continue;
+        }
+
+        char *eq = strchr(s, '=');
+        if (!eq) return job_error(err, err_len, line_no, "expected key = value");
+        *eq = '\0';
+        char *key = trim(s), *val = trim(eq + 1);
+        int rc = apply_key(cur, key, val);
+        if (rc == -2) return job_error(err, err_len, line_no, "unknown key '%s'", key);
+        if (rc != 0) return job_error(err, err_len, line_no, "bad value for '%s': '%s'", key, val);
+    }
+
+    if (cur != &global && finish_job(cur, err, err_len, cur_line) != 0) return -1;
+    if (suite->num_jobs == 0) return job_error(err, err_len, line_no, "no jobs");
+    return 0;
+}
+
+int membench_suite_load(const char *path, membench_suite_t *suite,
+                        char *err, size_t err_len) {
+    FILE *f = path ? fopen(path, "rb") : NULL;
+    if (!f) {
+        if (err && err_len) snprintf(err, err_len, "cannot open '%s'", path ? path : "");
+        return -1;
+    }
+    char *text = (char *)malloc(JOB_FILE_MAX + 1);
+    if (!text) { fclose(f); return -1; }
+    size_t n = fread(text, 1, JOB_FILE_MAX, f);
+    int too_big = !feof(f);
+    fclose(f);
+    text[n] = '\0';
+
+    int rc;
+    if (too_big) {
+        if (err && err_len) snprintf(err, err_len, "'%s' is larger than 1 MB", path);
+        rc = -1;
+    } else {
+        rc = membench_suite_parse(text, suite, err, err_len);
+    }
+    free(text);
+    return rc;
+}
+
+const char *membench_numa_policy_name(membench_numa_policy_t policy) {
+    switch (policy) {
+    case MEMBENCH_NUMA_DEFAULT:    return "default";
+    case MEMBENCH_NUMA_INTERLEAVE: return "interleave";
+    case MEMBENCH_NUMA_BIND:       return "bind";
+    case MEMBENCH_NUMA_PREFERRED:  return "preferred";
+    default:                       return "unknown";
+    }
+}
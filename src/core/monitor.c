@@ -0,0 +1,281 @@
+/**
+ * monitor.c — Background clock and temperature sampling.
+ *
+ * The sampler thread sleeps on a condition variable between samples, so
+ * stopping it is immediate.  sysfs attributes are opened once and re-read
+ * with pread() at offset 0, which regenerates their contents; a sample
+ * over a few hundred CPUs costs microseconds, not file opens.
+ */
+#include "membench/monitor.h"
+#include "membench/platform.h"
+#include "membench/timer.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(MEMBENCH_PLATFORM_LINUX)
+    #include <fcntl.h>
+    #include <pthread.h>
+    #include <time.h>
+    #include <unistd.h>
+#endif
+
+#define PROBE_NS          20000ULL   /* one effective-frequency probe */
+#define PROBE_TRIES       3          /* best of: a preempted probe reads slow */
+#define PROBE_CYCLES_STEP 4.0        /* 64-bit multiply + add, dependent */
+#define MAX_ZONES         256
+
+static void set_err(char *err, size_t len, const char *msg) {
+    if (err && len) snprintf(err, len, "%s", msg);
+}
+
+const char *membench_monitor_source_name(membench_monitor_source_t source) {
+    switch (source) {
+    case MEMBENCH_MONITOR_CPUFREQ: return "cpufreq";
+    case MEMBENCH_MONITOR_PROBE:   return "probe";
+    default:                       return "none";
+    }
+}
+
+#if defined(MEMBENCH_PLATFORM_LINUX)
+
+static struct {
+    int       running;
+    membench_monitor_source_t source;
+    unsigned  interval_ms;
+    double    threshold_pct;
+    int      *freq_fds;          /* scaling_cur_freq per CPU, kHz */
+    size_t    num_freq;
+    int      *temp_fds;          /* thermal zone temp, millidegrees C */
+    size_t    num_temp;
+    uint64_t  probe_steps;
+    pthread_t thread;
+    pthread_mutex_t lock;
+    pthread_cond_t  wake;
+    int       stop;
+    int       window_open;
+    membench_monitor_stats_t window;
+    double    freq_second_min;   /* the flag needs two low samples */
+} g_mon = { .lock = PTHREAD_MUTEX_INITIALIZER, .wake = PTHREAD_COND_INITIALIZER };
+
+static volatile uint64_t g_probe_sink;
+
+static uint64_t probe_spin(uint64_t steps) {
+    uint64_t x = g_probe_sink | 1;
+    for (uint64_t i = 0; i < steps; i++) x = x * 6364136223846793005ULL + 1442695040888963407ULL;
+    return x;
+}
+
+static long read_fd_long(int fd) {
+    char buf[32];
+    ssize_t n = pread(fd, buf, sizeof(buf) - 1, 0);
+    if (n <= 0) return -1;
+    buf[n] = '\0';
+    return strtol(buf, NULL, 10);
+}
+
+static void sample(double *freq_mhz, double *temp_c) {
+    *freq_mhz = 0.0;
+    *temp_c = 0.0;
+    if (g_mon.source == MEMBENCH_MONITOR_CPUFREQ) {
+        for (size_t i = 0; i < g_mon.num_freq; i++) {
+            double f = (double)read_fd_long(g_mon.freq_fds[i]) / 1000.0;
+            if (f > *freq_mhz) *freq_mhz = f;
+        }
+    } else {
+        for (int i = 0; i < PROBE_TRIES; i++) {
+            uint64_t t0 = membench_timer_ns();
+            g_probe_sink = probe_spin(g_mon.probe_steps);
+            uint64_t ns = membench_timer_ns() - t0;
+            double f = ns ? (double)g_mon.probe_steps * PROBE_CYCLES_STEP * 1000.0 / (double)ns
+                          : 0.0;
+            if (f > *freq_mhz) *freq_mhz = f;
+        }
+    }
+    for (size_t i = 0; i < g_mon.num_temp; i++) {
+        long mc = read_fd_long(g_mon.temp_fds[i]);
+        if (mc > 0 && (double)mc / 1000.0 > *temp_c) *temp_c = (double)mc / 1000.0;
+    }
+}
+
+static void merge(double freq_mhz, double temp_c) {
+    pthread_mutex_lock(&g_mon.lock);
+    membench_monitor_stats_t *w = &g_mon.window;
+    if (g_mon.window_open && freq_mhz > 0.0) {
+        if (!w->samples || freq_mhz < w->freq_min_mhz) {
+            g_mon.freq_second_min = w->samples ? w->freq_min_mhz : freq_mhz;
+            w->freq_min_mhz = freq_mhz;
+        } else if (w->samples == 1 || freq_mhz < g_mon.freq_second_min) {
+            g_mon.freq_second_min = freq_mhz;
+        }
+        if (!w->samples || freq_mhz > w->freq_max_mhz) w->freq_max_mhz = freq_mhz;
+        if (temp_c > 0.0) {
+            if (w->temp_min_c == 0.0 || temp_c < w->temp_min_c) w->temp_min_c = temp_c;
+            if (temp_c > w->temp_max_c) w->temp_max_c = temp_c;
+        }
+        w->samples++;
+    }
+    pthread_mutex_unlock(&g_mon.lock);
+}
+
+static void *sampler_main(void *arg) {
+    (void)arg;
+    for (;;) {
+        struct timespec until;
+        clock_gettime(CLOCK_REALTIME, &until);
+        until.tv_nsec += (long)g_mon.interval_ms * 1000000L;
+        until.tv_sec += until.tv_nsec / 1000000000L;
+        until.tv_nsec %= 1000000000L;
+
+        pthread_mutex_lock(&g_mon.lock);
+        while (!g_mon.stop &&
+               pthread_cond_timedwait(&g_mon.wake, &g_mon.lock, &until) == 0) {}
+        int stop = g_mon.stop;
+        pthread_mutex_unlock(&g_mon.lock);
+        if (stop) break;
+
+        double f, t;
+        sample(&f, &t);
+        merge(f, t);
+    }
+    return NULL;
+}
+
+static int *open_attrs(const char *fmt, size_t max, size_t *count) {
+    int *fds = (int *)malloc(max * sizeof(int));
+    *count = 0;
+    if (!fds) return NULL;
+    for (size_t i = 0; i < max; i++) {
+        char path[128];
+        snprintf(path, sizeof(path), fmt, i);
+        int fd = open(path, O_RDONLY);
+        if (fd >= 0 && read_fd_long(fd) > 0) fds[(*count)++] = fd;
+        else if (fd >= 0) close(fd);
+    }
+    return fds;
+}
+
+static void close_attrs(int *fds, size_t count) {
+    for (size_t i = 0; fds && i < count; i++) close(fds[i]);
+    free(fds);
+}
+
+int membench_monitor_start(unsigned interval_ms, double threshold_pct,
+                           char *err, size_t err_len) {
+    if (g_mon.running) {
+        set_err(err, err_len, "monitor already running");
+        return -1;
+    }
+    long ncpu = sysconf(_SC_NPROCESSORS_CONF);
+    if (ncpu < 1) ncpu = 1;
+    g_mon.freq_fds = open_attrs("/sys/devices/system/cpu/cpu%zu/cpufreq/scaling_cur_freq",
+                                (size_t)ncpu, &g_mon.num_freq);
+    g_mon.temp_fds = open_attrs("/sys/class/thermal/thermal_zone%zu/temp", MAX_ZONES,
+                                &g_mon.num_temp);
+    g_mon.source = g_mon.num_freq ? MEMBENCH_MONITOR_CPUFREQ : MEMBENCH_MONITOR_PROBE;
+
+    /* Size the probe to PROBE_NS, growing past the timer's resolution */
+    if (g_mon.source == MEMBENCH_MONITOR_PROBE) {
+        uint64_t steps = 256, ns = 0;
+        for (;;) {
+            uint64_t t0 = membench_timer_ns();
+            g_probe_sink = probe_spin(steps);
+            ns = membench_timer_ns() - t0;
+            if (ns >= PROBE_NS / 4 || steps >= (1ULL << 30)) break;
+            steps *= 2;
+        }
+        g_mon.probe_steps = (uint64_t)((double)steps * (double)PROBE_NS / (double)(ns ? ns : 1));
+        if (g_mon.probe_steps < 1) g_mon.probe_steps = 1;
+    }
+
+    g_mon.interval_ms = interval_ms ? interval_ms : MEMBENCH_MONITOR_INTERVAL_MS;
+    g_mon.threshold_pct = threshold_pct > 0.0 ? threshold_pct : MEMBENCH_MONITOR_THRESHOLD_PCT;
+    g_mon.stop = 0;
+    g_mon.window_open = 0;
+    if (pthread_create(&g_mon.thread, NULL, sampler_main, NULL) != 0) {
+        close_attrs(g_mon.freq_fds, g_mon.num_freq);
+        close_attrs(g_mon.temp_fds, g_mon.num_temp);
+        g_mon.freq_fds = g_mon.temp_fds = NULL;
+        g_mon.source = MEMBENCH_MONITOR_NONE;
+        set_err(err, err_len, "cannot start the sampler thread");
+        return -1;
+    }
+    g_mon.running = 1;
+    return 0;
+}
+
+void membench_monitor_stop(void) {
+    if (!g_mon.running) return;
+    pthread_mutex_lock(&g_mon.lock);
+    g_mon.stop = 1;
+    pthread_cond_signal(&g_mon.wake);
+    pthread_mutex_unlock(&g_mon.lock);
+    pthread_join(g_mon.thread, NULL);
+
+    close_attrs(g_mon.freq_fds, g_mon.num_freq);
+    close_attrs(g_mon.temp_fds, g_mon.num_temp);
+    g_mon.freq_fds = g_mon.temp_fds = NULL;
+    g_mon.num_freq = g_mon.num_temp = 0;
+    g_mon.source = MEMBENCH_MONITOR_NONE;
+    g_mon.running = 0;
+}
+
+membench_monitor_source_t membench_monitor_source(void) {
+    return g_mon.running ? g_mon.source : MEMBENCH_MONITOR_NONE;
+}
+
+void membench_monitor_begin(void) {
+    if (!g_mon.running) return;
+    pthread_mutex_lock(&g_mon.lock);
+    memset(&g_mon.window, 0, sizeof(g_mon.window));
+    g_mon.window_open = 1;
+    pthread_mutex_unlock(&g_mon.lock);
+    double f, t;
+    sample(&f, &t);
+    merge(f, t);
+}
+
+void membench_monitor_end(membench_monitor_stats_t *stats) {
+    memset(stats, 0, sizeof(*stats));
+    if (!g_mon.running) return;
+    double f, t;
+    sample(&f, &t);
+    merge(f, t);
+    pthread_mutex_lock(&g_mon.lock);
+    *stats = g_mon.window;
+    double sustained = g_mon.freq_second_min;
+    g_mon.window_open = 0;
+    pthread_mutex_unlock(&g_mon.lock);
+    if (stats->freq_max_mhz > 0.0) {
+        stats->drop_pct = 100.0 * (stats->freq_max_mhz - stats->freq_min_mhz)
+                          / stats->freq_max_mhz;
+        stats->throttled = stats->samples >= 2 &&
+                           100.0 * (stats->freq_max_mhz - sustained) / stats->freq_max_mhz
+                           > g_mon.threshold_pct;
+    }
+}
+
+#else
+
+int membench_monitor_start(unsigned interval_ms, double threshold_pct,
+                           char *err, size_t err_len) {
+    (void)interval_ms;
+    (void)threshold_pct;
+    set_err(err, err_len, "clock monitoring needs Linux sysfs");
+    return -1;
+}
+
+void membench_monitor_stop(void) {}
+
+membench_monitor_source_t membench_monitor_source(void) {
+    return MEMBENCH_MONITOR_NONE;
+}
+
+void membench_monitor_begin(void) {}
+
+void membench_monitor_end(membench_monitor_stats_t *stats) {
+    memset(stats, 0, sizeof(*stats));
+}
+
+#endif
@@ -2,9 +2,12 @@
  * output.c — Output formatting for benchmark results.
  */
 #include "membench/output.h"
+#include "membench/timer.h"
 
 #include <stdio.h>
 #include <inttypes.h>
+#include <math.h>
+#include <string.h>
 
 /* ── Helpers ──────────────────────────────────────────────────────────────── */
 
@@ -29,17 +32,21 @@ void membench_print_latency(const membench_latency_result_t *r,
 
     switch (fmt) {
     case MEMBENCH_FMT_TABLE:
-        printf("  %-20s  size=%-10s  latency=%8.2f ns  (%" PRIu64 " accesses)\n",
+        printf("  %-20s  size=%-10s  latency=%8.2f ns  (%" PRIu64 " accesses)",
                label, sb, r->avg_latency_ns, r->accesses);
+        if (r->kernel) printf("  [%s]", r->kernel);
+        printf("\n");
         break;
     case MEMBENCH_FMT_CSV:
-        printf("%s,%zu,%.4f,%" PRIu64 "\n",
-               label, r->buffer_size, r->avg_latency_ns, r->accesses);
+        printf("%s,%zu,%.4f,%" PRIu64, label, r->buffer_size, r->avg_latency_ns, r->accesses);
+        printf(",%s\n", r->kernel ? r->kernel : "");
         break;
     case MEMBENCH_FMT_JSON:
         printf("{\"test\":\"%s\",\"buffer_size\":%zu,"
-               "\"avg_latency_ns\":%.4f,\"accesses\":%" PRIu64 "}\n",
+               "\"avg_latency_ns\":%.4f,\"accesses\":%" PRIu64,
                label, r->buffer_size, r->avg_latency_ns, r->accesses);
+        if (r->kernel) printf(",\"kernel\":\"%s\"", r->kernel);
+        printf("}\n");
         break;
     }
 }
@@ -53,17 +60,21 @@ void membench_print_bandwidth(const membench_bandwidth_result_t *r,
 
     switch (fmt) {
     case MEMBENCH_FMT_TABLE:
-        printf("  %-20s  size=%-10s  bandwidth=%8.2f GB/s\n",
-               label, sb, r->bandwidth_gbps);
+        printf("  %-20s  size=%-10s  bandwidth=%8.2f GB/s", label, sb, r->bandwidth_gbps);
+        if (r->kernel) printf("  [%s]", r->kernel);
+        printf("\n");
         break;
     case MEMBENCH_FMT_CSV:
-        printf("%s,%zu,%.4f,%" PRIu64 "\n",
-               label, r->buffer_size, r->bandwidth_gbps, r->bytes_moved);
+        printf("%s,%zu,%.4f,%" PRIu64, label, r->buffer_size, r->bandwidth_gbps,
+               r->bytes_moved);
+        printf(",%s\n", r->kernel ? r->kernel : "");
         break;
     case MEMBENCH_FMT_JSON:
         printf("{\"test\":\"%s\",\"buffer_size\":%zu,"
-               "\"bandwidth_gbps\":%.4f,\"bytes_moved\":%" PRIu64 "}\n",
+               "\"bandwidth_gbps\":%.4f,\"bytes_moved\":%" PRIu64,
                label, r->buffer_size, r->bandwidth_gbps, r->bytes_moved);
+        if (r->kernel) printf(",\"kernel\":\"%s\"", r->kernel);
+        printf("}\n");
         break;
     }
 }
@@ -123,6 +134,1303 @@ void membench_print_cache_info(const membench_cache_info_t *info,
     }
 }
 
+/* ── Hash table probe ─────────────────────────────────────────────────────── */
+
+void membench_print_hash_probe(const membench_hash_result_t *r,
+                               const char *label, membench_output_fmt_t fmt) {
+    char sb[64];
+    fmt_size(r->table_bytes, sb, sizeof(sb));
+
+    switch (fmt) {
+    case MEMBENCH_FMT_TABLE:
+        printf("  %-11s lf=%.2f  size=%-10s  hit=%7.2f ns  miss=%7.2f ns"
+               "  hit=%7.1f M/s  miss=%7.1f M/s  probes=%.2f\n",
+               label, r->load_factor, sb, r->hit_latency_ns, r->miss_latency_ns,
+               r->hit_mops, r->miss_mops, r->avg_probes_hit);
+        break;
+    case MEMBENCH_FMT_CSV:
+        printf("hash_probe,%s,%zu,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%" PRIu64 "\n",
+               label, r->table_bytes, r->load_factor, r->hit_latency_ns,
+               r->miss_latency_ns, r->hit_mops, r->miss_mops,
+               r->avg_probes_hit, r->lookups);
+        break;
+    case MEMBENCH_FMT_JSON:
+        printf("{\"test\":\"hash_probe\",\"scheme\":\"%s\",\"table_bytes\":%zu,"
+               "\"load_factor\":%.4f,\"hit_latency_ns\":%.4f,"
+               "\"miss_latency_ns\":%.4f,\"hit_mops\":%.4f,\"miss_mops\":%.4f,"
+               "\"avg_probes_hit\":%.4f,\"lookups\":%" PRIu64 "}\n",
+               label, r->table_bytes, r->load_factor, r->hit_latency_ns,
+               r->miss_latency_ns, r->hit_mops, r->miss_mops,
+               r->avg_probes_hit, r->lookups);
+        break;
+    }
+}
+
+/* ── Search layout ────────────────────────────────────────────────────────── */
+
+void membench_print_search(const membench_search_result_t *r,
+                           const char *label, membench_output_fmt_t fmt) {
+    char sb[64], lb[64];
+    fmt_size(r->array_bytes, sb, sizeof(sb));
+    fmt_size(r->layout_bytes, lb, sizeof(lb));
+
+    switch (fmt) {
+    case MEMBENCH_FMT_TABLE:
+        printf("  %-11s size=%-10s  layout=%-10s  latency=%8.2f ns  throughput=%8.1f M/s\n",
+               label, sb, lb, r->latency_ns, r->mops);
+        break;
+    case MEMBENCH_FMT_CSV:
+        printf("search_layout,%s,%zu,%zu,%zu,%.4f,%.4f,%" PRIu64 "\n",
+               label, r->array_bytes, r->layout_bytes, r->num_keys,
+               r->latency_ns, r->mops, r->lookups);
+        break;
+    case MEMBENCH_FMT_JSON:
+        printf("{\"test\":\"search_layout\",\"layout\":\"%s\",\"array_bytes\":%zu,"
+               "\"layout_bytes\":%zu,\"num_keys\":%zu,\"latency_ns\":%.4f,"
+               "\"mops\":%.4f,\"lookups\":%" PRIu64 "}\n",
+               label, r->array_bytes, r->layout_bytes, r->num_keys,
+               r->latency_ns, r->mops, r->lookups);
+        break;
+    }
+}
+
+/* ── B+tree node-size sweep ───────────────────────────────────────────────── */
+
+void membench_print_btree(const membench_btree_result_t *r,
+                          const char *label, membench_output_fmt_t fmt) {
+    char sb[64], nb[64];
+    fmt_size(r->tree_bytes, sb, sizeof(sb));
+    fmt_size(r->node_bytes, nb, sizeof(nb));
+
+    switch (fmt) {
+    case MEMBENCH_FMT_TABLE:
+        printf("  %-5s node=%-9s  tree=%-10s  height=%2d  lookup=%8.2f ns"
+               "  scan=%6.2f ns/key\n",
+               label, nb, sb, r->height, r->lookup_ns, r->scan_ns_per_key);
+        break;
+    case MEMBENCH_FMT_CSV:
+        printf("btree,%s,%zu,%zu,%zu,%d,%.4f,%.4f,%" PRIu64 "\n",
+               label, r->node_bytes, r->tree_bytes, r->num_keys, r->height,
+               r->lookup_ns, r->scan_ns_per_key, r->lookups);
+        break;
+    case MEMBENCH_FMT_JSON:
+        printf("{\"test\":\"btree\",\"tier\":\"%s\",\"node_bytes\":%zu,"
+               "\"tree_bytes\":%zu,\"num_keys\":%zu,\"height\":%d,"
+               "\"lookup_ns\":%.4f,\"scan_ns_per_key\":%.4f,\"lookups\":%" PRIu64 "}\n",
+               label, r->node_bytes, r->tree_bytes, r->num_keys, r->height,
+               r->lookup_ns, r->scan_ns_per_key, r->lookups);
+        break;
+    }
+}
+
+void membench_print_btree_tier(const membench_btree_tier_t *tier,
+                               membench_output_fmt_t fmt) {
+    char sb[64], lb[64], scb[64];
+    fmt_size(tier->tree_bytes, sb, sizeof(sb));
+    fmt_size(tier->best_lookup_node, lb, sizeof(lb));
+    fmt_size(tier->best_scan_node, scb, sizeof(scb));
+
+    switch (fmt) {
+    case MEMBENCH_FMT_TABLE:
+        printf("  %-5s (%-10s)  lookups: %-9s (%.2f ns)   scans: %-9s (%.2f ns/key)\n",
+               tier->name, sb, lb, tier->best_lookup_ns,
+               scb, tier->best_scan_ns_per_key);
+        break;
+    case MEMBENCH_FMT_CSV:
+        printf("btree_recommend,%s,%zu,%zu,%.4f,%zu,%.4f\n",
+               tier->name, tier->tree_bytes, tier->best_lookup_node,
+               tier->best_lookup_ns, tier->best_scan_node,
+               tier->best_scan_ns_per_key);
+        break;
+    case MEMBENCH_FMT_JSON:
+        printf("{\"test\":\"btree_recommend\",\"tier\":\"%s\",\"tree_bytes\":%zu,"
+               "\"lookup_node_bytes\":%zu,\"lookup_ns\":%.4f,"
+               "\"scan_node_bytes\":%zu,\"scan_ns_per_key\":%.4f}\n",
+               tier->name, tier->tree_bytes, tier->best_lookup_node,
+               tier->best_lookup_ns, tier->best_scan_node,
+               tier->best_scan_ns_per_key);
+        break;
+    }
+}
+
+/* ── Record layout ────────────────────────────────────────────────────────── */
+
+void membench_print_record_layout(const membench_record_result_t *r,
+                                  const char *layout, const char *kernel,
+                                  membench_output_fmt_t fmt) {
+    char sb[64];
+    fmt_size(r->working_set, sb, sizeof(sb));
+
+    switch (fmt) {
+    case MEMBENCH_FMT_TABLE:
+        printf("  %-5s %-6s  size=%-10s  %zu/%zu x %zuB  %8.3f ns/record  %8.2f GB/s\n",
+               layout, kernel, sb, r->scan_fields, r->num_fields, r->field_bytes,
+               r->ns_per_record, r->bandwidth_gbps);
+        break;
+    case MEMBENCH_FMT_CSV:
+        printf("record_layout,%s,%s,%zu,%zu,%zu,%zu,%zu,%.4f,%.4f,%" PRIu64 "\n",
+               layout, kernel, r->working_set, r->num_records, r->num_fields,
+               r->field_bytes, r->scan_fields, r->ns_per_record,
+               r->bandwidth_gbps, r->passes);
+        break;
+    case MEMBENCH_FMT_JSON:
+        printf("{\"test\":\"record_layout\",\"layout\":\"%s\",\"kernel\":\"%s\","
+               "\"working_set\":%zu,\"num_records\":%zu,\"num_fields\":%zu,"
+               "\"field_bytes\":%zu,\"scan_fields\":%zu,\"ns_per_record\":%.4f,"
+               "\"bandwidth_gbps\":%.4f,\"passes\":%" PRIu64 "}\n",
+               layout, kernel, r->working_set, r->num_records, r->num_fields,
+               r->field_bytes, r->scan_fields, r->ns_per_record,
+               r->bandwidth_gbps, r->passes);
+        break;
+    }
+}
+
+/* ── Linked-structure traversal ───────────────────────────────────────────── */
+
+void membench_print_linked(const membench_linked_result_t *r,
+                           const char *kind, const char *order,
+                           membench_output_fmt_t fmt) {
+    char sb[64];
+    fmt_size(r->working_set, sb, sizeof(sb));
+
+    switch (fmt) {
+    case MEMBENCH_FMT_TABLE:
+        printf("  %-4s %-9s  node=%4zuB  size=%-10s  %8.2f ns/node  %9.1f Mnodes/s"
+               "  x%.2f vs pool\n",
+               kind, order, r->node_bytes, sb, r->ns_per_node, r->mnodes_per_s,
+               r->vs_pool);
+        break;
+    case MEMBENCH_FMT_CSV:
+        printf("linked,%s,%s,%zu,%zu,%zu,%.4f,%.4f,%.4f,%" PRIu64 "\n",
+               kind, order, r->node_bytes, r->num_nodes, r->working_set,
+               r->ns_per_node, r->mnodes_per_s, r->vs_pool, r->passes);
+        break;
+    case MEMBENCH_FMT_JSON:
+        printf("{\"test\":\"linked\",\"structure\":\"%s\",\"order\":\"%s\","
+               "\"node_bytes\":%zu,\"num_nodes\":%zu,\"working_set\":%zu,"
+               "\"ns_per_node\":%.4f,\"mnodes_per_s\":%.4f,\"vs_pool\":%.4f,"
+               "\"passes\":%" PRIu64 "}\n",
+               kind, order, r->node_bytes, r->num_nodes, r->working_set,
+               r->ns_per_node, r->mnodes_per_s, r->vs_pool, r->passes);
+        break;
+    }
+}
+
+/* ── Skewed access latency ────────────────────────────────────────────────── */
+
+void membench_print_skewed(const membench_skew_result_t *r,
+                           membench_output_fmt_t fmt) {
+    char sb[64], hb[64], dist[32];
+    fmt_size(r->buffer_size, sb, sizeof(sb));
+    fmt_size(r->hot90_bytes, hb, sizeof(hb));
+    int zipf = r->skew.kind == MEMBENCH_SKEW_ZIPF;
+    if (zipf)
+        snprintf(dist, sizeof(dist), "zipf s=%.2f", r->skew.zipf_s);
+    else
+        snprintf(dist, sizeof(dist), "hot %.0f%%/%.0f%%",
+                 r->skew.hot_prob * 100.0, r->skew.hot_fraction * 100.0);
+
+    switch (fmt) {
+    case MEMBENCH_FMT_TABLE:
+        printf("  %-13s W=%-10s  hot90=%-10s  avg=%7.2f  p50=%7.2f  p90=%7.2f"
+               "  p99=%7.2f  p99.9=%7.2f ns\n",
+               dist, sb, hb, r->avg_latency_ns, r->p50_ns, r->p90_ns,
+               r->p99_ns, r->p999_ns);
+        break;
+    case MEMBENCH_FMT_CSV:
+        printf("skewed,%s,%.4f,%.4f,%.4f,%zu,%zu,%.4f,%.4f,%.4f,%.4f,%.4f,%" PRIu64 "\n",
+               zipf ? "zipf" : "hotcold", r->skew.zipf_s, r->skew.hot_fraction,
+               r->skew.hot_prob, r->buffer_size, r->hot90_bytes,
+               r->avg_latency_ns, r->p50_ns, r->p90_ns, r->p99_ns, r->p999_ns,
+               r->accesses);
+        break;
+    case MEMBENCH_FMT_JSON:
+        printf("{\"test\":\"skewed\",\"distribution\":\"%s\",\"zipf_s\":%.4f,"
+               "\"hot_fraction\":%.4f,\"hot_prob\":%.4f,\"buffer_size\":%zu,"
+               "\"hot90_bytes\":%zu,\"avg_latency_ns\":%.4f,\"p50_ns\":%.4f,"
+               "\"p90_ns\":%.4f,\"p99_ns\":%.4f,\"p999_ns\":%.4f,"
+               "\"accesses\":%" PRIu64 "}\n",
+               zipf ? "zipf" : "hotcold", r->skew.zipf_s, r->skew.hot_fraction,
+               r->skew.hot_prob, r->buffer_size, r->hot90_bytes,
+               r->avg_latency_ns, r->p50_ns, r->p90_ns, r->p99_ns, r->p999_ns,
+               r->accesses);
+        break;
+    }
+}
+
+/* ── Trace replay ─────────────────────────────────────────────────────────── */
+
+static void print_replay_phase(const membench_replay_phase_t *ph, const char *mode,
+                               const char *phase, membench_output_fmt_t fmt) {
+    switch (fmt) {
+    case MEMBENCH_FMT_TABLE:
+        printf("  %-11s %-6s  %12" PRIu64 " acc  (%5.1f%% wr)  %10.3f ms"
+               "  %8.2f GB/s  %8.2f ns/access\n",
+               mode, phase, ph->records,
+               ph->records ? 100.0 * (double)ph->writes / (double)ph->records : 0.0,
+               ph->elapsed_ns / 1e6, ph->bandwidth_gbps, ph->ns_per_access);
+        break;
+    case MEMBENCH_FMT_CSV:
+        printf("replay,%s,%s,%" PRIu64 ",%" PRIu64 ",%" PRIu64 ",%" PRIu64 ",%" PRIu64
+               ",%.0f,%.4f,%.4f\n",
+               mode, phase, ph->records, ph->reads, ph->writes, ph->bytes_read,
+               ph->bytes_written, ph->elapsed_ns, ph->bandwidth_gbps,
+               ph->ns_per_access);
+        break;
+    case MEMBENCH_FMT_JSON:
+        printf("{\"test\":\"replay\",\"mode\":\"%s\",\"phase\":\"%s\","
+               "\"records\":%" PRIu64 ",\"reads\":%" PRIu64 ",\"writes\":%" PRIu64 ","
+               "\"bytes_read\":%" PRIu64 ",\"bytes_written\":%" PRIu64 ","
+               "\"elapsed_ns\":%.0f,\"bandwidth_gbps\":%.4f,\"ns_per_access\":%.4f}\n",
+               mode, phase, ph->records, ph->reads, ph->writes, ph->bytes_read,
+               ph->bytes_written, ph->elapsed_ns, ph->bandwidth_gbps,
+               ph->ns_per_access);
+        break;
+    }
+}
+
+void membench_print_replay(const membench_replay_result_t *r,
+                           const char *mode, membench_output_fmt_t fmt) {
+    char name[32];
+    for (size_t i = 0; i < r->num_phases; i++) {
+        snprintf(name, sizeof(name), "%zu", i);
+        print_replay_phase(&r->phases[i], mode, name, fmt);
+    }
+    print_replay_phase(&r->total, mode, "total", fmt);
+}
+
+/* ── Cache simulator ──────────────────────────────────────────────────────── */
+
+void membench_print_cache_profile(const membench_cache_profile_t *p,
+                                  membench_output_fmt_t fmt) {
+    char sb[64];
+    for (size_t i = 0; i < p->num_levels; i++) {
+        const membench_sim_level_cfg_t *lv = &p->level[i];
+        fmt_size(lv->size_bytes, sb, sizeof(sb));
+        switch (fmt) {
+        case MEMBENCH_FMT_TABLE:
+            printf("  L%zu  %-10s  %2d-way  %3zu B lines  %7.2f ns\n",
+                   i + 1, sb, lv->ways, p->line_bytes, lv->latency_ns);
+            break;
+        case MEMBENCH_FMT_CSV:
+            printf("cache_profile,L%zu,%zu,%d,%zu,%.4f\n",
+                   i + 1, lv->size_bytes, lv->ways, p->line_bytes, lv->latency_ns);
+            break;
+        case MEMBENCH_FMT_JSON:
+            printf("{\"test\":\"cache_profile\",\"level\":\"L%zu\",\"size_bytes\":%zu,"
+                   "\"ways\":%d,\"line_bytes\":%zu,\"latency_ns\":%.4f}\n",
+                   i + 1, lv->size_bytes, lv->ways, p->line_bytes, lv->latency_ns);
+            break;
+        }
+    }
+    switch (fmt) {
+    case MEMBENCH_FMT_TABLE:
+        printf("  DRAM                                      %7.2f ns\n", p->memory_latency_ns);
+        break;
+    case MEMBENCH_FMT_CSV:
+        printf("cache_profile,DRAM,0,0,%zu,%.4f\n", p->line_bytes, p->memory_latency_ns);
+        break;
+    case MEMBENCH_FMT_JSON:
+        printf("{\"test\":\"cache_profile\",\"level\":\"DRAM\",\"latency_ns\":%.4f}\n",
+               p->memory_latency_ns);
+        break;
+    }
+}
+
+void membench_print_cachesim(const membench_sim_result_t *r,
+                             const membench_cache_profile_t *p,
+                             membench_output_fmt_t fmt) {
+    const char *pol = membench_sim_policy_name(r->policy);
+    for (size_t i = 0; i < r->num_levels; i++) {
+        const membench_sim_level_stats_t *lv = &r->level[i];
+        double miss = lv->accesses ? 100.0 * (double)lv->misses / (double)lv->accesses : 0.0;
+        switch (fmt) {
+        case MEMBENCH_FMT_TABLE:
+            printf("  %-4s L%zu  %12" PRIu64 " acc  %12" PRIu64 " hit  %12" PRIu64
+                   " miss  (%6.2f%%)  %10" PRIu64 " wb\n",
+                   pol, i + 1, lv->accesses, lv->hits, lv->misses, miss, lv->writebacks);
+            break;
+        case MEMBENCH_FMT_CSV:
+            printf("cache_sim,%s,L%zu,%" PRIu64 ",%" PRIu64 ",%" PRIu64 ",%" PRIu64 ",%.4f\n",
+                   pol, i + 1, lv->accesses, lv->hits, lv->misses, lv->writebacks,
+                   p->level[i].latency_ns);
+            break;
+        case MEMBENCH_FMT_JSON:
+            printf("{\"test\":\"cache_sim\",\"policy\":\"%s\",\"level\":\"L%zu\","
+                   "\"accesses\":%" PRIu64 ",\"hits\":%" PRIu64 ",\"misses\":%" PRIu64 ","
+                   "\"writebacks\":%" PRIu64 ",\"latency_ns\":%.4f}\n",
+                   pol, i + 1, lv->accesses, lv->hits, lv->misses, lv->writebacks,
+                   p->level[i].latency_ns);
+            break;
+        }
+    }
+
+    switch (fmt) {
+    case MEMBENCH_FMT_TABLE:
+        printf("  %-4s DRAM %12" PRIu64 " rd   %12" PRIu64 " wr   est. %.2f ns/access"
+               "  (%.3f ms serialised)\n",
+               pol, r->memory_reads, r->memory_writes, r->est_avg_latency_ns,
+               r->est_total_ns / 1e6);
+        break;
+    case MEMBENCH_FMT_CSV:
+        printf("cache_sim_summary,%s,%" PRIu64 ",%" PRIu64 ",%" PRIu64 ",%.4f,%.0f\n",
+               pol, r->accesses, r->memory_reads, r->memory_writes,
+               r->est_avg_latency_ns, r->est_total_ns);
+        break;
+    case MEMBENCH_FMT_JSON:
+        printf("{\"test\":\"cache_sim_summary\",\"policy\":\"%s\",\"accesses\":%" PRIu64 ","
+               "\"memory_reads\":%" PRIu64 ",\"memory_writes\":%" PRIu64 ","
+               "\"est_avg_latency_ns\":%.4f,\"est_total_ns\":%.0f}\n",
+               pol, r->accesses, r->memory_reads, r->memory_writes,
+               r->est_avg_latency_ns, r->est_total_ns);
+        break;
+    }
+}
+
+/* ── Tile search ──────────────────────────────────────────────────────────── */
+
+/* Transpose is scored in GB/s, matmul in GFLOP/s */
+static double tile_score(const membench_tile_result_t *r) {
+    return r->kernel == MEMBENCH_TILE_MATMUL ? r->gflops : r->gbps;
+}
+
+void membench_print_tile(const membench_tile_result_t *r, const char *kernel,
+                         const char *level, membench_output_fmt_t fmt) {
+    char fb[64];
+    fmt_size(r->tile_bytes, fb, sizeof(fb));
+    const char *unit = r->kernel == MEMBENCH_TILE_MATMUL ? "GF/s" : "GB/s";
+
+    switch (fmt) {
+    case MEMBENCH_FMT_TABLE:
+        if (r->tile)
+            printf("  %-9s n=%-5zu %-5s tile %4zu (%-9s)  %9.2f %s  %10.3f ms\n",
+                   kernel, r->n, level, r->tile, fb, tile_score(r), unit,
+                   r->elapsed_ns / 1e6);
+        else
+            printf("  %-9s n=%-5zu %-5s unblocked               %9.2f %s  %10.3f ms\n",
+                   kernel, r->n, level, tile_score(r), unit, r->elapsed_ns / 1e6);
+        break;
+    case MEMBENCH_FMT_CSV:
+        printf("tile,%s,%zu,%s,%zu,%zu,%.0f,%.4f,%.4f\n",
+               kernel, r->n, level, r->tile, r->tile_bytes, r->elapsed_ns,
+               r->gbps, r->gflops);
+        break;
+    case MEMBENCH_FMT_JSON:
+        printf("{\"test\":\"tile\",\"kernel\":\"%s\",\"n\":%zu,\"level\":\"%s\","
+               "\"tile\":%zu,\"tile_bytes\":%zu,\"elapsed_ns\":%.0f,"
+               "\"gbps\":%.4f,\"gflops\":%.4f}\n",
+               kernel, r->n, level, r->tile, r->tile_bytes, r->elapsed_ns,
+               r->gbps, r->gflops);
+        break;
+    }
+}
+
+void membench_print_tile_best(const membench_tile_level_t *level,
+                              const membench_tile_result_t *baseline,
+                              const char *kernel, membench_output_fmt_t fmt) {
+    const membench_tile_result_t *b = &level->best;
+    double base = tile_score(baseline);
+    double speedup = base > 0.0 ? tile_score(b) / base : 0.0;
+    char lb[64], fb[64];
+    fmt_size(level->level_bytes, lb, sizeof(lb));
+    fmt_size(b->tile_bytes, fb, sizeof(fb));
+
+    switch (fmt) {
+    case MEMBENCH_FMT_TABLE:
+        printf("  %-9s n=%-5zu %-3s (%-9s)  best tile %4zu (%-9s)  %5.2fx vs unblocked\n",
+               kernel, b->n, level->name, lb, b->tile, fb, speedup);
+        break;
+    case MEMBENCH_FMT_CSV:
+        printf("tile_recommend,%s,%zu,%s,%zu,%zu,%zu,%.4f\n",
+               kernel, b->n, level->name, level->level_bytes, b->tile,
+               b->tile_bytes, speedup);
+        break;
+    case MEMBENCH_FMT_JSON:
+        printf("{\"test\":\"tile_recommend\",\"kernel\":\"%s\",\"n\":%zu,"
+               "\"level\":\"%s\",\"level_bytes\":%zu,\"tile\":%zu,"
+               "\"tile_bytes\":%zu,\"speedup\":%.4f}\n",
+               kernel, b->n, level->name, level->level_bytes, b->tile,
+               b->tile_bytes, speedup);
+        break;
+    }
+}
+
+/* ── Roofline ─────────────────────────────────────────────────────────────── */
+
+static const char *ROOF_LEVEL_NAMES[MEMBENCH_ROOF_NUM_LEVELS] = { "L1", "L2", "L3", "DRAM" };
+
+/* Chart range: 1/16 .. 64 FLOP/byte */
+#define ROOF_AI_MIN_LOG2 (-4)
+#define ROOF_AI_MAX_LOG2 6
+
+/* A bandwidth roof in 10^9 bytes/s, so that GFLOP/s = FLOP/byte x roof */
+static double roof_bw(const membench_roofline_t *r, int lv, int c) {
+    return r->bw_gbps[lv][c] * MEMBENCH_GB_BYTES / 1e9;
+}
+
+void membench_print_roofline(const membench_roofline_t *r, membench_output_fmt_t fmt) {
+    const char *cores[2] = { "one", "all" };
+    const int threads[2] = { 1, r->threads };
+    char sb[64];
+
+    switch (fmt) {
+    case MEMBENCH_FMT_TABLE:
+        printf("  SIMD: %s, all-core threads: %d\n\n", r->simd_isa, r->threads);
+        printf("  %-22s %14s %14s %14s\n", "Ceiling", "1 core", "all cores", "ridge (F/B)");
+        printf("  %-22s %9.2f GF/s %9.2f GF/s\n", "Peak FLOP/s scalar",
+               r->peak_scalar_gflops[0], r->peak_scalar_gflops[1]);
+        printf("  %-22s %9.2f GF/s %9.2f GF/s\n", "Peak FLOP/s SIMD",
+               r->peak_simd_gflops[0], r->peak_simd_gflops[1]);
+        for (int lv = 0; lv < MEMBENCH_ROOF_NUM_LEVELS; lv++) {
+            if (!r->level_bytes[lv]) continue;
+            char label[96];
+            fmt_size(r->level_bytes[lv], sb, sizeof(sb));
+            snprintf(label, sizeof(label), "%s read (%s)", ROOF_LEVEL_NAMES[lv], sb);
+            printf("  %-22s %9.2f GB/s %9.2f GB/s %14.2f\n", label,
+                   r->bw_gbps[lv][0], r->bw_gbps[lv][1],
+                   r->peak_simd_gflops[1] / roof_bw(r, lv, 1));
+        }
+        break;
+    case MEMBENCH_FMT_CSV:
+        for (int c = 0; c < 2; c++) {
+            printf("roofline_peak,scalar,%s,%d,%.3f\n", cores[c], threads[c],
+                   r->peak_scalar_gflops[c]);
+            printf("roofline_peak,%s,%s,%d,%.3f\n", r->simd_isa, cores[c], threads[c],
+                   r->peak_simd_gflops[c]);
+        }
+        for (int lv = 0; lv < MEMBENCH_ROOF_NUM_LEVELS; lv++) {
+            if (!r->level_bytes[lv]) continue;
+            for (int c = 0; c < 2; c++)
+                printf("roofline_bw,%s,%zu,%s,%d,%.3f,%.4f\n", ROOF_LEVEL_NAMES[lv],
+                       r->level_bytes[lv], cores[c], threads[c], r->bw_gbps[lv][c],
+                       r->peak_simd_gflops[c] / roof_bw(r, lv, c));
+        }
+        break;
+    case MEMBENCH_FMT_JSON:
+        for (int c = 0; c < 2; c++) {
+            printf("{\"test\":\"roofline_peak\",\"kernel\":\"scalar\",\"cores\":\"%s\","
+                   "\"threads\":%d,\"gflops\":%.3f}\n",
+                   cores[c], threads[c], r->peak_scalar_gflops[c]);
+            printf("{\"test\":\"roofline_peak\",\"kernel\":\"%s\",\"cores\":\"%s\","
+                   "\"threads\":%d,\"gflops\":%.3f}\n",
+                   r->simd_isa, cores[c], threads[c], r->peak_simd_gflops[c]);
+        }
+        for (int lv = 0; lv < MEMBENCH_ROOF_NUM_LEVELS; lv++) {
+            if (!r->level_bytes[lv]) continue;
+            for (int c = 0; c < 2; c++)
+                printf("{\"test\":\"roofline_bw\",\"level\":\"%s\",\"working_set\":%zu,"
+                       "\"cores\":\"%s\",\"threads\":%d,\"gbps\":%.3f,"
+                       "\"ridge_flops_per_byte\":%.4f}\n",
+                       ROOF_LEVEL_NAMES[lv], r->level_bytes[lv], cores[c], threads[c],
+                       r->bw_gbps[lv][c], r->peak_simd_gflops[c] / roof_bw(r, lv, c));
+        }
+        break;
+    }
+}
+
+void membench_print_roofline_point(const membench_roofline_point_t *pt,
+                                   membench_output_fmt_t fmt) {
+    char sb[64];
+    fmt_size(pt->working_set, sb, sizeof(sb));
+    switch (fmt) {
+    case MEMBENCH_FMT_TABLE:
+        printf("  %-10s %3d thr  %4d fma/elem  %7.3f F/B  %9.2f GF/s  %9.2f GB/s\n",
+               sb, pt->threads, pt->fma_per_element, pt->flops_per_byte,
+               pt->gflops, pt->gbps);
+        break;
+    case MEMBENCH_FMT_CSV:
+        printf("roofline_point,%zu,%d,%d,%.4f,%.3f,%.3f\n",
+               pt->working_set, pt->threads, pt->fma_per_element,
+               pt->flops_per_byte, pt->gflops, pt->gbps);
+        break;
+    case MEMBENCH_FMT_JSON:
+        printf("{\"test\":\"roofline_point\",\"working_set\":%zu,\"threads\":%d,"
+               "\"fma_per_element\":%d,\"flops_per_byte\":%.4f,\"gflops\":%.3f,"
+               "\"gbps\":%.3f}\n",
+               pt->working_set, pt->threads, pt->fma_per_element,
+               pt->flops_per_byte, pt->gflops, pt->gbps);
+        break;
+    }
+}
+
+/** Vertical range of the chart: a little above the SIMD peak down to the
+ *  slowest ceiling at the leftmost intensity. */
+static void roof_y_range(const membench_roofline_t *r, double *lo, double *hi) {
+    double min = r->peak_scalar_gflops[0];
+    for (int lv = 0; lv < MEMBENCH_ROOF_NUM_LEVELS; lv++) {
+        if (!r->level_bytes[lv]) continue;
+        for (int c = 0; c < 2; c++) {
+            double y = roof_bw(r, lv, c) * pow(2.0, ROOF_AI_MIN_LOG2);
+            if (y < min) min = y;
+        }
+    }
+    *hi = log10(r->peak_simd_gflops[1] * 2.0);
+    *lo = log10(min / 2.0);
+}
+
+#define CHART_COLS_PER_OCTAVE 6
+#define CHART_COLS ((ROOF_AI_MAX_LOG2 - ROOF_AI_MIN_LOG2) * CHART_COLS_PER_OCTAVE + 1)
+#define CHART_ROWS 18
+
+void membench_print_roofline_chart(const membench_roofline_t *r,
+                                   const membench_roofline_point_t *pts, size_t n) {
+    static const char MARKS[MEMBENCH_ROOF_NUM_LEVELS] = { '1', '2', '3', 'D' };
+    char grid[CHART_ROWS][CHART_COLS + 1];
+    double lo, hi;
+    roof_y_range(r, &lo, &hi);
+
+    memset(grid, ' ', sizeof(grid));
+    for (int row = 0; row < CHART_ROWS; row++) grid[row][CHART_COLS] = '\0';
+
+#define ROW_OF(y) ((int)((hi - log10(y)) / (hi - lo) * (CHART_ROWS - 1) + 0.5))
+#define PLOT(y, ch)                                                           \
+    do {                                                                      \
+        int rr_ = ROW_OF(y);                                                  \
+        if (rr_ >= 0 && rr_ < CHART_ROWS) grid[rr_][col] = (ch);              \
+    } while (0)
+
+    for (int col = 0; col < CHART_COLS; col++) {
+        double ai = pow(2.0, ROOF_AI_MIN_LOG2 + (double)col / CHART_COLS_PER_OCTAVE);
+        PLOT(r->peak_scalar_gflops[1], '.');
+        PLOT(r->peak_simd_gflops[1], '=');
+        for (int lv = MEMBENCH_ROOF_NUM_LEVELS - 1; lv >= 0; lv--) {
+            if (!r->level_bytes[lv]) continue;
+            double y = roof_bw(r, lv, 1) * ai;
+            if (y < r->peak_simd_gflops[1]) PLOT(y, MARKS[lv]);
+        }
+    }
+    for (size_t i = 0; i < n; i++) {
+        double x = log2(pts[i].flops_per_byte);
+        int col = (int)((x - ROOF_AI_MIN_LOG2) * CHART_COLS_PER_OCTAVE + 0.5);
+        if (col < 0 || col >= CHART_COLS) continue;
+        PLOT(pts[i].gflops, pts[i].threads == r->threads ? '*' : 'o');
+    }
+#undef PLOT
+#undef ROW_OF
+
+    printf("\n  GFLOP/s (log)\n");
+    for (int row = 0; row < CHART_ROWS; row++) {
+        if (row == 0 || row == CHART_ROWS - 1 || row == CHART_ROWS / 2)
+            printf("  %9.2f |%s\n",
+                   pow(10.0, hi - (hi - lo) * row / (CHART_ROWS - 1)), grid[row]);
+        else
+            printf("  %9s |%s\n", "", grid[row]);
+    }
+    printf("  %9s +", "");
+    for (int col = 0; col < CHART_COLS; col++)
+        putchar(col % (2 * CHART_COLS_PER_OCTAVE) == 0 ? '+' : '-');
+    printf("\n  %9s ", "");
+    char axis[CHART_COLS + 8];
+    size_t end = 0;
+    memset(axis, ' ', sizeof(axis));
+    for (int o = ROOF_AI_MIN_LOG2; o <= ROOF_AI_MAX_LOG2; o += 2) {
+        char lab[16];
+        if (o < 0) snprintf(lab, sizeof(lab), "1/%d", 1 << -o);
+        else       snprintf(lab, sizeof(lab), "%d", 1 << o);
+        size_t at = (size_t)((o - ROOF_AI_MIN_LOG2) * CHART_COLS_PER_OCTAVE);
+        for (size_t k = 0; lab[k] && at + k < sizeof(axis) - 1; k++) {
+            axis[at + k] = lab[k];
+            end = at + k + 1;
+        }
+    }
+    axis[end] = '\0';
+    printf("%s  FLOP/byte\n", axis);
+    printf("  = SIMD peak  . scalar peak  1/2/3/D L1/L2/L3/DRAM roof  * kernel");
+    if (r->threads > 1) printf(" (%d thr)  o kernel (1 thr)", r->threads);
+    printf("\n");
+}
+
+int membench_write_roofline_svg(const char *path, const membench_roofline_t *r,
+                                const membench_roofline_point_t *pts, size_t n) {
+    static const char *COLORS[MEMBENCH_ROOF_NUM_LEVELS] = {
+        "#1f77b4", "#2ca02c", "#ff7f0e", "#d62728"
+    };
+    const double X0 = 70, Y0 = 20, W = 660, H = 420;
+    double lo, hi;
+    roof_y_range(r, &lo, &hi);
+
+    FILE *f = fopen(path, "w");
+    if (!f) return -1;
+
+#define SX(ai) (X0 + (log2(ai) - ROOF_AI_MIN_LOG2) / (ROOF_AI_MAX_LOG2 - ROOF_AI_MIN_LOG2) * W)
+#define SY(y)  (Y0 + (hi - log10(y)) / (hi - lo) * H)
+
+    fprintf(f, "<svg xmlns=\"http://www.w3.org/2000/svg\" width=\"760\" height=\"500\" "
+               "font-family=\"sans-serif\" font-size=\"12\">\n");
+    fprintf(f, "<rect width=\"760\" height=\"500\" fill=\"white\"/>\n");
+    fprintf(f, "<rect x=\"%.0f\" y=\"%.0f\" width=\"%.0f\" height=\"%.0f\" "
+               "fill=\"none\" stroke=\"black\"/>\n", X0, Y0, W, H);
+
+    /* Axes: octaves of intensity, decades of FLOP/s */
+    for (int o = ROOF_AI_MIN_LOG2; o <= ROOF_AI_MAX_LOG2; o++) {
+        double x = SX(pow(2.0, o));
+        fprintf(f, "<line x1=\"%.1f\" y1=\"%.0f\" x2=\"%.1f\" y2=\"%.0f\" stroke=\"#ddd\"/>\n",
+                x, Y0, x, Y0 + H);
+        if (o < 0)
+            fprintf(f, "<text x=\"%.1f\" y=\"%.0f\" text-anchor=\"middle\">1/%d</text>\n",
+                    x, Y0 + H + 16, 1 << -o);
+        else
+            fprintf(f, "<text x=\"%.1f\" y=\"%.0f\" text-anchor=\"middle\">%d</text>\n",
+                    x, Y0 + H + 16, 1 << o);
+    }
+    for (int d = (int)ceil(lo); d <= (int)floor(hi); d++) {
+        double y = SY(pow(10.0, d));
+        fprintf(f, "<line x1=\"%.0f\" y1=\"%.1f\" x2=\"%.0f\" y2=\"%.1f\" stroke=\"#ddd\"/>\n",
+                X0, y, X0 + W, y);
+        fprintf(f, "<text x=\"%.0f\" y=\"%.1f\" text-anchor=\"end\">%g</text>\n",
+                X0 - 6, y + 4, pow(10.0, d));
+    }
+    fprintf(f, "<text x=\"%.0f\" y=\"%.0f\" text-anchor=\"middle\">"
+               "Arithmetic intensity (FLOP/byte)</text>\n", X0 + W / 2, Y0 + H + 34);
+    fprintf(f, "<text transform=\"translate(16,%.0f) rotate(-90)\" text-anchor=\"middle\">"
+               "GFLOP/s</text>\n", Y0 + H / 2);
+
+    /* Ceilings: all cores solid, one core dashed */
+    const double ai_lo = pow(2.0, ROOF_AI_MIN_LOG2), ai_hi = pow(2.0, ROOF_AI_MAX_LOG2);
+    int legend = 0;
+    for (int c = MEMBENCH_ROOF_ALL_CORES; c >= MEMBENCH_ROOF_ONE_CORE; c--) {
+        if (c == MEMBENCH_ROOF_ONE_CORE && r->threads == 1) break;
+        const char *dash = c == MEMBENCH_ROOF_ONE_CORE ? " stroke-dasharray=\"6,4\"" : "";
+        double peak = r->peak_simd_gflops[c];
+        for (int lv = 0; lv < MEMBENCH_ROOF_NUM_LEVELS; lv++) {
+            if (!r->level_bytes[lv]) continue;
+            double bw = roof_bw(r, lv, c);
+            double ridge = peak / bw;
+            if (ridge < ai_lo) ridge = ai_lo;
+            if (ridge > ai_hi) ridge = ai_hi;
+            fprintf(f, "<polyline fill=\"none\" stroke=\"%s\" stroke-width=\"2\"%s "
+                       "points=\"%.1f,%.1f %.1f,%.1f %.1f,%.1f\"/>\n",
+                    COLORS[lv], dash, SX(ai_lo), SY(bw * ai_lo), SX(ridge),
+                    SY(bw * ridge < peak ? bw * ridge : peak), SX(ai_hi), SY(peak));
+            if (c == MEMBENCH_ROOF_ALL_CORES)
+                fprintf(f, "<text x=\"%.0f\" y=\"%.0f\" fill=\"%s\">%s %.1f GB/s</text>\n",
+                        X0 + 10, Y0 + 18 + 16 * legend++, COLORS[lv],
+                        ROOF_LEVEL_NAMES[lv], bw);
+        }
+        fprintf(f, "<line x1=\"%.1f\" y1=\"%.1f\" x2=\"%.1f\" y2=\"%.1f\" stroke=\"gray\"%s/>\n",
+                SX(ai_lo), SY(r->peak_scalar_gflops[c]), SX(ai_hi),
+                SY(r->peak_scalar_gflops[c]), dash[0] ? dash : " stroke-dasharray=\"2,3\"");
+    }
+    fprintf(f, "<text x=\"%.0f\" y=\"%.0f\">%s peak %.1f GFLOP/s, scalar %.1f "
+               "(%d threads; dashed = 1 thread)</text>\n",
+            X0 + 10, Y0 + 18 + 16 * legend, r->simd_isa,
+            r->peak_simd_gflops[1], r->peak_scalar_gflops[1], r->threads);
+
+    for (size_t i = 0; i < n; i++) {
+        double x = pts[i].flops_per_byte;
+        if (x < ai_lo || x > ai_hi || pts[i].gflops <= 0.0) continue;
+        int all = pts[i].threads == r->threads;
+        fprintf(f, "<circle cx=\"%.1f\" cy=\"%.1f\" r=\"4\" stroke=\"black\" fill=\"%s\"/>\n",
+                SX(x), SY(pts[i].gflops), all ? "black" : "white");
+    }
+#undef SX
+#undef SY
+
+    fprintf(f, "</svg>\n");
+    return fclose(f) == 0 ? 0 : -1;
+}
+
+/* ── Tuning advisor ───────────────────────────────────────────────────────── */
+
+void membench_print_tuning(const membench_tuning_t *t, membench_output_fmt_t fmt) {
+    char l1[64], l2[64], nt[64];
+    fmt_size(t->l1_block_bytes, l1, sizeof(l1));
+    fmt_size(t->l2_block_bytes, l2, sizeof(l2));
+    if (t->nt_store_threshold) fmt_size(t->nt_store_threshold, nt, sizeof(nt));
+    else                       snprintf(nt, sizeof(nt), "never");
+
+    switch (fmt) {
+    case MEMBENCH_FMT_TABLE:
+        printf("  %-22s %zu B\n", "Padding", t->pad_bytes);
+        printf("  %-22s %s\n", "L1 block", l1);
+        printf("  %-22s %s\n", "L2 block", l2);
+        printf("  %-22s %u lines\n", "Prefetch distance", t->prefetch_distance);
+        printf("  %-22s %d\n", "Bandwidth threads", t->bw_max_threads);
+        printf("  %-22s %s (%d node%s)\n", "NUMA policy", t->numa_policy,
+               t->numa_nodes, t->numa_nodes == 1 ? "" : "s");
+        printf("  %-22s %s\n", "NT stores from", nt);
+        break;
+    case MEMBENCH_FMT_CSV:
+        printf("tuning,%zu,%zu,%zu,%u,%d,%s,%zu\n",
+               t->pad_bytes, t->l1_block_bytes, t->l2_block_bytes,
+               t->prefetch_distance, t->bw_max_threads, t->numa_policy,
+               t->nt_store_threshold);
+        break;
+    case MEMBENCH_FMT_JSON:
+        printf("{\"test\":\"tuning\",\"pad_bytes\":%zu,\"l1_block_bytes\":%zu,"
+               "\"l2_block_bytes\":%zu,\"prefetch_distance\":%u,"
+               "\"bw_max_threads\":%d,\"numa_policy\":\"%s\","
+               "\"nt_store_threshold\":%zu}\n",
+               t->pad_bytes, t->l1_block_bytes, t->l2_block_bytes,
+               t->prefetch_distance, t->bw_max_threads, t->numa_policy,
+               t->nt_store_threshold);
+        break;
+    }
+}
+
+/* ── Registry benchmarks ──────────────────────────────────────────────────── */
+
+void membench_print_bench(const membench_bench_t *b, const membench_bench_result_t *r,
+                          membench_output_fmt_t fmt) {
+    char sb[64];
+    fmt_size(r->buffer_size, sb, sizeof(sb));
+    const char *label = b->label ? b->label : b->name;
+
+    switch (fmt) {
+    case MEMBENCH_FMT_TABLE:
+        if (b->kind == MEMBENCH_BENCH_BANDWIDTH)
+            printf("  %-20s  size=%-10s  bandwidth=%8.2f GB/s  (%.2f..%.2f ns/op, %d reps)\n",
+                   label, sb, r->bandwidth_gbps, r->ns_per_op_min, r->ns_per_op_max, r->reps);
+        else
+            printf("  %-20s  size=%-10s  latency=%8.2f ns  (%.2f..%.2f, %d reps)\n",
+                   label, sb, r->ns_per_op, r->ns_per_op_min, r->ns_per_op_max, r->reps);
+        break;
+    case MEMBENCH_FMT_CSV:
+        printf("bench,%s,%zu,%d,%.4f,%.4f,%.4f,%.4f\n",
+               b->name, r->buffer_size, r->reps, r->ns_per_op, r->ns_per_op_min,
+               r->ns_per_op_max, r->bandwidth_gbps);
+        break;
+    case MEMBENCH_FMT_JSON:
+        printf("{\"test\":\"bench\",\"name\":\"%s\",\"buffer_size\":%zu,\"reps\":%d,"
+               "\"ns_per_op\":%.4f,\"ns_per_op_min\":%.4f,\"ns_per_op_max\":%.4f,"
+               "\"bandwidth_gbps\":%.4f}\n",
+               b->name, r->buffer_size, r->reps, r->ns_per_op, r->ns_per_op_min,
+               r->ns_per_op_max, r->bandwidth_gbps);
+        break;
+    }
+}
+
+/* ── Suite output ─────────────────────────────────────────────────────────── */
+
+static void print_json_string(const char *s) {
+    putchar('"');
+    for (; *s; s++) {
+        if (*s == '"' || *s == '\\') putchar('\\');
+        if ((unsigned char)*s >= 0x20) putchar(*s);
+    }
+    putchar('"');
+}
+
+static void print_json_env_int(const char *key, int v) {
+    if (v == MEMBENCH_ENV_UNKNOWN) printf(",\"%s\":null", key);
+    else                           printf(",\"%s\":%d", key, v);
+}
+
+/* Environment object shared by the "environment" record and the suite
+ * document */
+static void print_json_environment(const membench_sysinfo_t *si) {
+    const membench_env_t *e = &si->env;
+    printf("{\"governor\":");
+    print_json_string(e->governor);
+    print_json_env_int("turbo", e->turbo);
+    print_json_env_int("smt", e->smt);
+    printf(",\"thp\":");
+    print_json_string(e->thp);
+    print_json_env_int("perf_event_paranoid", e->perf_paranoid);
+    print_json_env_int("numa_balancing", e->numa_balancing);
+    print_json_env_int("virtualized", e->virtualized);
+    if (e->loadavg >= 0.0) printf(",\"loadavg\":%.2f", e->loadavg);
+    else                   printf(",\"loadavg\":null");
+    printf(",\"swap_total\":%zu,\"swap_used\":%zu", e->swap_total, e->swap_used);
+    printf(",\"noise\":{\"samples\":%u,\"median_ns\":%.1f,\"p99_ratio\":%.4f,"
+           "\"outlier_pct\":%.2f},\"warnings\":[",
+           e->noise_samples, e->noise_median_ns, e->noise_p99_ratio, e->noise_outlier_pct);
+    char msgs[16][MEMBENCH_ENV_MSG_LEN];
+    size_t n = membench_env_warnings(si, msgs, 16);
+    for (size_t i = 0; i < n; i++) {
+        if (i) putchar(',');
+        print_json_string(msgs[i]);
+    }
+    printf("]}");
+}
+
+static void print_suite_row_json(const membench_suite_t *suite, const membench_suite_row_t *row) {
+    const membench_job_t *job = &suite->jobs[row->job];
+    const membench_bench_result_t *r = &row->result;
+    printf("{\"test\":\"suite\",\"job\":");
+    print_json_string(job->name);
+    printf(",\"bench\":");
+    print_json_string(job->bench);
+    printf(",\"buffer_size\":%zu,\"threads\":%d,\"ok\":%s", r->buffer_size, row->threads,
+           row->status == 0 ? "true" : "false");
+    if (row->status == 0)
+        printf(",\"iterations\":%" PRIu64 ",\"reps\":%d,\"ns_per_op\":%.4f,\"ns_per_op_min\":%.4f,"
+               "\"ns_per_op_max\":%.4f,\"bandwidth_gbps\":%.4f",
+               r->iterations, r->reps, r->ns_per_op, r->ns_per_op_min,
+               r->ns_per_op_max, r->bandwidth_gbps);
+    putchar('}');
+}
+
+void membench_print_suite_row(const membench_suite_t *suite, const membench_suite_row_t *row,
+                              membench_output_fmt_t fmt) {
+    const membench_job_t *job = &suite->jobs[row->job];
+    const membench_bench_result_t *r = &row->result;
+    char sb[64];
+    fmt_size(r->buffer_size, sb, sizeof(sb));
+
+    switch (fmt) {
+    case MEMBENCH_FMT_TABLE:
+        if (row->status != 0)
+            printf("  %-20s  size=%-10s  threads=%-3d  FAILED\n", job->name, sb, row->threads);
+        else if (row->kind == MEMBENCH_BENCH_BANDWIDTH)
+            printf("  %-20s  size=%-10s  threads=%-3d  bandwidth=%8.2f GB/s  (%.2f ns/op)\n",
+                   job->name, sb, row->threads, r->bandwidth_gbps, r->ns_per_op);
+        else
+            printf("  %-20s  size=%-10s  threads=%-3d  latency=%8.2f ns  (%.2f..%.2f)\n",
+                   job->name, sb, row->threads, r->ns_per_op, r->ns_per_op_min,
+                   r->ns_per_op_max);
+        break;
+    case MEMBENCH_FMT_CSV:
+        printf("suite,%s,%s,%zu,%d,%d,%.4f,%.4f,%.4f,%.4f\n",
+               job->name, job->bench, r->buffer_size, row->threads, row->status == 0,
+               r->ns_per_op, r->ns_per_op_min, r->ns_per_op_max, r->bandwidth_gbps);
+        break;
+    case MEMBENCH_FMT_JSON:
+        print_suite_row_json(suite, row);
+        putchar('\n');
+        break;
+    }
+}
+
+void membench_print_suite_json(const membench_suite_t *suite, const membench_suite_row_t *rows,
+                               size_t num_rows, const membench_sysinfo_t *si) {
+    static const char *const PAGES[] = { "default", "huge" };
+
+    printf("{\"test\":\"suite\",\"system\":{\"cpu\":");
+    print_json_string(si->cpu_model);
+    printf(",\"cores_physical\":%d,\"cores_logical\":%d,\"l1d\":%zu,\"l2\":%zu,"
+           "\"l3\":%zu,\"cache_line\":%zu,\"numa_nodes\":%d,\"ram\":%zu,\"environment\":",
+           si->num_cores_physical, si->num_cores_logical, si->l1_data_cache, si->l2_cache,
+           si->l3_cache, si->cache_line, si->numa_nodes, si->total_ram);
+    print_json_environment(si);
+    printf("},\n\"jobs\":[");
+
+    for (size_t j = 0; j < suite->num_jobs; j++) {
+        const membench_job_t *job = &suite->jobs[j];
+        printf("%s\n{\"name\":", j ? "," : "");
+        print_json_string(job->name);
+        printf(",\"bench\":");
+        print_json_string(job->bench);
+        printf(",\"sizes\":[");
+        for (size_t s = 0; s < job->num_sizes; s++)
+            printf("%s%zu", s ? "," : "", job->sizes[s]);
+        printf("],\"threads\":[");
+        for (size_t t = 0; t < job->num_threads; t++)
+            printf("%s%d", t ? "," : "", job->threads[t]);
+        printf("],\"iterations\":%" PRIu64 ",\"repeat\":%d,\"pages\":\"%s\",\"numa\":\"%s\"",
+               job->iterations, job->repeat, PAGES[job->pages == MEMBENCH_PAGES_HUGE],
+               membench_numa_policy_name(job->numa));
+        if (job->numa == MEMBENCH_NUMA_BIND || job->numa == MEMBENCH_NUMA_PREFERRED)
+            printf(",\"numa_node\":%d", job->numa_node);
+        putchar('}');
+    }
+
+    printf("],\n\"results\":[");
+    for (size_t i = 0; i < num_rows; i++) {
+        printf("%s\n", i ? "," : "");
+        print_suite_row_json(suite, &rows[i]);
+    }
+    printf("]}\n");
+}
+
+/* ── Harness profile ──────────────────────────────────────────────────────── */
+
+void membench_print_profile(const membench_phase_totals_t *p, uint64_t total_ns,
+                            membench_output_fmt_t fmt) {
+    uint64_t accounted = 0;
+    for (int i = 0; i < MEMBENCH_PHASE_COUNT; i++) accounted += p->ns[i];
+    uint64_t other = total_ns > accounted ? total_ns - accounted : 0;
+    double total = total_ns ? (double)total_ns : 1.0;
+    double eff = (double)p->ns[MEMBENCH_PHASE_MEASURE] / total;
+
+    switch (fmt) {
+    case MEMBENCH_FMT_TABLE:
+        printf("  %-10s  %10s  %7s  %8s\n", "Phase", "Time (s)", "Share", "Calls");
+        for (int i = 0; i < MEMBENCH_PHASE_COUNT; i++)
+            printf("  %-10s  %10.3f  %6.1f%%  %8" PRIu64 "\n",
+                   membench_phase_name((membench_phase_t)i), (double)p->ns[i] / 1e9,
+                   100.0 * (double)p->ns[i] / total, p->calls[i]);
+        printf("  %-10s  %10.3f  %6.1f%%            (set-up, output, unprofiled tests)\n",
+               "other", (double)other / 1e9, 100.0 * (double)other / total);
+        printf("  %-10s  %10.3f\n", "total", (double)total_ns / 1e9);
+        printf("  Efficiency: %.1f%% of wall time inside timed regions\n", 100.0 * eff);
+        break;
+    case MEMBENCH_FMT_CSV:
+        for (int i = 0; i < MEMBENCH_PHASE_COUNT; i++)
+            printf("profile,%s,%" PRIu64 ",%" PRIu64 "\n",
+                   membench_phase_name((membench_phase_t)i), p->ns[i], p->calls[i]);
+        printf("profile,other,%" PRIu64 ",0\n", other);
+        printf("profile,total,%" PRIu64 ",0\n", total_ns);
+        printf("profile,efficiency,%.4f,0\n", eff);
+        break;
+    case MEMBENCH_FMT_JSON:
+        printf("{\"test\":\"profile\",\"total_ns\":%" PRIu64 ",\"phases\":{", total_ns);
+        for (int i = 0; i < MEMBENCH_PHASE_COUNT; i++)
+            printf("%s\"%s\":{\"ns\":%" PRIu64 ",\"calls\":%" PRIu64 "}", i ? "," : "",
+                   membench_phase_name((membench_phase_t)i), p->ns[i], p->calls[i]);
+        printf("},\"other_ns\":%" PRIu64 ",\"efficiency\":%.4f}\n", other, eff);
+        break;
+    }
+}
+
+void membench_print_energy(const char *label, size_t buffer_size,
+                           const membench_energy_result_t *r, membench_output_fmt_t fmt) {
+    char sb[64];
+    fmt_size(buffer_size, sb, sizeof(sb));
+    int per_byte = r->nj_per_byte > 0.0;
+
+    switch (fmt) {
+    case MEMBENCH_FMT_TABLE:
+        printf("  %-20s  size=%-10s  energy=%8.3f J", "  (energy)", sb, r->package_j + r->dram_j);
+        if (r->has_dram) printf(" (DRAM %.3f J)", r->dram_j);
+        printf("  power=%6.1f W  %8.3f nJ/%s\n", r->watts,
+               per_byte ? r->nj_per_byte : r->nj_per_op, per_byte ? "byte" : "access");
+        break;
+    case MEMBENCH_FMT_CSV:
+        printf("energy,%s,%zu,%.6f,%.6f,%.3f,%.6f,%.6f,%.4f\n", label, buffer_size,
+               r->package_j, r->has_dram ? r->dram_j : -1.0, r->watts,
+               r->nj_per_byte, r->nj_per_op, r->seconds);
+        break;
+    case MEMBENCH_FMT_JSON:
+        printf("{\"test\":\"energy\",\"bench\":");
+        print_json_string(label);
+        printf(",\"buffer_size\":%zu,\"package_j\":%.6f,", buffer_size, r->package_j);
+        if (r->has_dram) printf("\"dram_j\":%.6f,", r->dram_j);
+        else             printf("\"dram_j\":null,");
+        printf("\"watts\":%.3f,\"nj_per_byte\":%.6f,\"nj_per_op\":%.6f,\"seconds\":%.4f}\n",
+               r->watts, r->nj_per_byte, r->nj_per_op, r->seconds);
+        break;
+    }
+}
+
+void membench_print_monitor(const char *label, size_t buffer_size,
+                            const membench_monitor_stats_t *m,
+                            membench_monitor_source_t source, membench_output_fmt_t fmt) {
+    char sb[64];
+    fmt_size(buffer_size, sb, sizeof(sb));
+    const char *src = membench_monitor_source_name(source);
+
+    switch (fmt) {
+    case MEMBENCH_FMT_TABLE:
+        printf("  %-20s  size=%-10s  clock=%5.0f -%5.0f MHz (%s)", "  (clock)", sb,
+               m->freq_min_mhz, m->freq_max_mhz, src);
+        if (m->temp_max_c > 0.0) printf("  temp=%.0f-%.0f C", m->temp_min_c, m->temp_max_c);
+        if (m->throttled) printf("  THROTTLED: clock fell %.1f%%", m->drop_pct);
+        printf("\n");
+        break;
+    case MEMBENCH_FMT_CSV:
+        printf("clock,%s,%zu,%s,%.1f,%.1f,%.2f,%.1f,%.1f,%u,%d\n", label, buffer_size, src,
+               m->freq_min_mhz, m->freq_max_mhz, m->drop_pct, m->temp_min_c, m->temp_max_c,
+               m->samples, m->throttled);
+        break;
+    case MEMBENCH_FMT_JSON:
+        printf("{\"test\":\"clock\",\"bench\":\"%s\",\"buffer_size\":%zu,\"source\":\"%s\","
+               "\"freq_min_mhz\":%.1f,\"freq_max_mhz\":%.1f,\"drop_pct\":%.2f,", label,
+               buffer_size, src, m->freq_min_mhz, m->freq_max_mhz, m->drop_pct);
+        if (m->temp_max_c > 0.0)
+            printf("\"temp_min_c\":%.1f,\"temp_max_c\":%.1f,", m->temp_min_c, m->temp_max_c);
+        else
+            printf("\"temp_min_c\":null,\"temp_max_c\":null,");
+        printf("\"samples\":%u,\"throttled\":%s}\n", m->samples,
+               m->throttled ? "true" : "false");
+        break;
+    }
+}
+
+void membench_print_environment(const membench_sysinfo_t *si, membench_output_fmt_t fmt) {
+    const membench_env_t *e = &si->env;
+    char msgs[16][MEMBENCH_ENV_MSG_LEN];
+    size_t n;
+
+    switch (fmt) {
+    case MEMBENCH_FMT_TABLE:
+        break;              /* part of membench_sysinfo_print() */
+    case MEMBENCH_FMT_CSV:
+        printf("env,governor,%s\n", e->governor);
+        printf("env,turbo,%d\n", e->turbo);
+        printf("env,smt,%d\n", e->smt);
+        printf("env,thp,%s\n", e->thp);
+        printf("env,perf_event_paranoid,%d\n", e->perf_paranoid);
+        printf("env,numa_balancing,%d\n", e->numa_balancing);
+        printf("env,virtualized,%d\n", e->virtualized);
+        printf("env,loadavg,%.2f\n", e->loadavg);
+        printf("env,swap_used,%zu\n", e->swap_used);
+        printf("env,noise_p99_ratio,%.4f\n", e->noise_p99_ratio);
+        printf("env,noise_outlier_pct,%.2f\n", e->noise_outlier_pct);
+        n = membench_env_warnings(si, msgs, 16);
+        for (size_t i = 0; i < n; i++)
+            printf("env,warning,\"%s\"\n", msgs[i]);
+        break;
+    case MEMBENCH_FMT_JSON:
+        printf("{\"test\":\"environment\",\"cpu\":");
+        print_json_string(si->cpu_model);
+        printf(",\"environment\":");
+        print_json_environment(si);
+        printf("}\n");
+        break;
+    }
+}
+
+static void fmt_health_range(const membench_health_check_t *c, char *buf, size_t len) {
+    if (c->lo > 0.0 && c->hi > 0.0) snprintf(buf, len, "%.1f .. %.1f", c->lo, c->hi);
+    else if (c->lo > 0.0)            snprintf(buf, len, ">= %.2f", c->lo);
+    else if (c->hi > 0.0)            snprintf(buf, len, "<= %.2f", c->hi);
+    else                             snprintf(buf, len, "-");
+}
+
+void membench_print_health(const membench_health_report_t *r, membench_output_fmt_t fmt) {
+    switch (fmt) {
+    case MEMBENCH_FMT_TABLE:
+        printf("  Expected ranges: %s\n", r->family);
+        printf("  %-16s  %12s  %14s  %-7s\n", "Check", "Value", "Expected", "Verdict");
+        for (size_t i = 0; i < r->num_checks; i++) {
+            const membench_health_check_t *c = &r->checks[i];
+            char range[32], value[32];
+            fmt_health_range(c, range, sizeof(range));
+            if (c->status == MEMBENCH_HEALTH_SKIP && c->value <= 0.0)
+                snprintf(value, sizeof(value), "-");
+            else if (c->unit[0])
+                snprintf(value, sizeof(value), "%.2f %s", c->value, c->unit);
+            else
+                snprintf(value, sizeof(value), "%s", c->value > 0.0 ? "ok" : "no");
+            printf("  %-16s  %12s  %14s  %-7s %s\n", c->name, value, range,
+                   membench_health_status_name(c->status), c->note);
+        }
+        printf("  Verdict: %s (%.2f s)\n", membench_health_status_name(r->overall),
+               (double)r->elapsed_ns / 1e9);
+        break;
+    case MEMBENCH_FMT_CSV:
+        for (size_t i = 0; i < r->num_checks; i++) {
+            const membench_health_check_t *c = &r->checks[i];
+            printf("health,%s,%.4f,%s,%.4f,%.4f,%s\n", c->name, c->value, c->unit,
+                   c->lo, c->hi, membench_health_status_name(c->status));
+        }
+        printf("health,overall,%.4f,s,0,0,%s\n", (double)r->elapsed_ns / 1e9,
+               membench_health_status_name(r->overall));
+        break;
+    case MEMBENCH_FMT_JSON:
+        printf("{\"test\":\"health\",\"family\":");
+        print_json_string(r->family);
+        printf(",\"overall\":\"%s\",\"elapsed_ns\":%" PRIu64 ",\"checks\":[",
+               membench_health_status_name(r->overall), r->elapsed_ns);
+        for (size_t i = 0; i < r->num_checks; i++) {
+            const membench_health_check_t *c = &r->checks[i];
+            printf("%s{\"name\":\"%s\",\"value\":%.4f,\"unit\":\"%s\",\"lo\":%.4f,"
+                   "\"hi\":%.4f,\"status\":\"%s\",\"note\":", i ? "," : "", c->name,
+                   c->value, c->unit, c->lo, c->hi, membench_health_status_name(c->status));
+            print_json_string(c->note);
+            printf("}");
+        }
+        printf("]}\n");
+        break;
+    }
+}
+
+/* ── Instruction-side detection ───────────────────────────────────────────── */
+
+static const char *ICACHE_SWEEP_NAMES[MEMBENCH_ICACHE_NUM_SWEEPS] = { "lines", "uops", "pages" };
+static const char *ICACHE_SWEEP_HELP[MEMBENCH_ICACHE_NUM_SWEEPS] = {
+    "one jump per cache line", "cache lines packed with nops", "one jump per page"
+};
+/* What the first, second and third step of each sweep usually are */
+static const char *ICACHE_LEVEL_NAMES[MEMBENCH_ICACHE_NUM_SWEEPS][3] = {
+    { "L1i", "L2", "L3" },
+    { "uop cache", "L1i", "L2" },
+    { "iTLB", "L1i", "L2 TLB" },
+};
+
+void membench_print_icache(const membench_icache_result_t *r, membench_output_fmt_t fmt) {
+    const membench_cache_info_t *c = &r->curve;
+    const size_t steps[3] = { c->l1_size_bytes, c->l2_size_bytes, c->l3_size_bytes };
+    const char *sweep = ICACHE_SWEEP_NAMES[r->sweep];
+    const char *const *levels = ICACHE_LEVEL_NAMES[r->sweep];
+    char sb[64];
+
+    switch (fmt) {
+    case MEMBENCH_FMT_TABLE:
+        printf("  --- %s: %s, %zu B apart, %zu instruction%s each ---\n", sweep,
+               ICACHE_SWEEP_HELP[r->sweep], r->stride, r->block_instrs,
+               r->block_instrs == 1 ? "" : "s");
+        for (int i = 0; i < 3; i++) {
+            if (!steps[i]) continue;
+            fmt_size(steps[i], sb, sizeof(sb));
+            printf("  Step at %-10s  %-10s  (%zu blocks, %zu instructions)\n", sb, levels[i],
+                   steps[i] / r->stride, steps[i] / r->stride * r->block_instrs);
+        }
+        if (!steps[0]) printf("  No step found\n");
+        printf("  %-12s  %s\n", "Footprint", "ns/block");
+        for (size_t i = 0; i < c->num_samples; i++) {
+            fmt_size(c->sample_sizes[i], sb, sizeof(sb));
+            printf("  %-12s  %8.2f\n", sb, c->sample_latencies[i]);
+        }
+        break;
+    case MEMBENCH_FMT_CSV:
+        for (int i = 0; i < 3; i++)
+            if (steps[i])
+                printf("icache_step,%s,%s,%zu,%zu\n", sweep, levels[i], steps[i],
+                       steps[i] / r->stride);
+        for (size_t i = 0; i < c->num_samples; i++)
+            printf("icache,%s,%zu,%.4f\n", sweep, c->sample_sizes[i], c->sample_latencies[i]);
+        break;
+    case MEMBENCH_FMT_JSON:
+        printf("{\"test\":\"icache\",\"sweep\":\"%s\",\"stride\":%zu,"
+               "\"block_instrs\":%zu,\"steps\":[", sweep, r->stride, r->block_instrs);
+        for (int i = 0, first = 1; i < 3; i++) {
+            if (!steps[i]) continue;
+            printf("%s{\"level\":\"%s\",\"bytes\":%zu,\"blocks\":%zu}", first ? "" : ",",
+                   levels[i], steps[i], steps[i] / r->stride);
+            first = 0;
+        }
+        printf("],\"curve\":[");
+        for (size_t i = 0; i < c->num_samples; i++)
+            printf("%s{\"size\":%zu,\"ns\":%.4f}", i ? "," : "", c->sample_sizes[i],
+                   c->sample_latencies[i]);
+        printf("]}\n");
+        break;
+    }
+}
+
+/* ── Vector frequency license ─────────────────────────────────────────────── */
+
+void membench_print_license(const membench_license_t *r, membench_output_fmt_t fmt) {
+    double slot_us = r->window_ms * 1000.0 / MEMBENCH_LICENSE_SLOTS;
+    char sb[64];
+
+    switch (fmt) {
+    case MEMBENCH_FMT_TABLE:
+        if (r->num_widths == 0) {
+            printf("  No vector ISA to test on this CPU\n");
+            break;
+        }
+        fmt_size(r->buffer_bytes, sb, sizeof(sb));
+        printf("  Bursts of %.1f ms over %s, %.1f ms watched after each, %d repeats\n\n",
+               r->burst_ms, sb, r->window_ms, r->repeats);
+        printf("  %-5s  %-9s  %10s  %8s  %17s  %9s  %19s  %10s\n", "Width", "ISA",
+               "Burst GB/s", "Base GHz", "During GHz (drop)", "After GHz",
+               "Chase ns base/after", "Recovery");
+        for (size_t i = 0; i < r->num_widths; i++) {
+            const membench_license_width_t *w = &r->widths[i];
+            char rec[32];
+            if (w->recovery_us < 0.0)
+                snprintf(rec, sizeof(rec), "> %.0f us", r->window_ms * 1000.0);
+            else
+                snprintf(rec, sizeof(rec), "%.0f us", w->recovery_us);
+            printf("  %-5d  %-9s  %10.2f  %8.2f  %9.2f (%5.1f%%)  %9.2f  %8.2f / %-8.2f  %10s\n",
+                   w->width_bits, w->isa, w->burst_gbps, w->base_ghz, w->during_ghz,
+                   w->drop_pct, w->after_ghz, w->base_chase_ns, w->after_chase_ns, rec);
+        }
+        printf("\n  Clock after the burst (GHz):\n  %8s", "t (us)");
+        for (size_t i = 0; i < r->num_widths; i++) printf("  %7d", r->widths[i].width_bits);
+        printf("\n");
+        for (size_t s = 0; s < MEMBENCH_LICENSE_SLOTS; s++) {
+            printf("  %8.0f", slot_us * (double)s);
+            for (size_t i = 0; i < r->num_widths; i++)
+                printf("  %7.2f", r->widths[i].slot_ghz[s]);
+            printf("\n");
+        }
+        break;
+    case MEMBENCH_FMT_CSV:
+        for (size_t i = 0; i < r->num_widths; i++) {
+            const membench_license_width_t *w = &r->widths[i];
+            printf("license,%d,%s,%.4f,%.4f,%.4f,%.4f,%.2f,%.4f,%.4f,%.4f,%.1f\n",
+                   w->width_bits, w->isa, w->burst_gbps, w->base_ghz, w->during_ghz,
+                   w->after_ghz, w->drop_pct, w->base_chase_ns, w->during_chase_ns,
+                   w->after_chase_ns, w->recovery_us);
+            for (size_t s = 0; s < MEMBENCH_LICENSE_SLOTS; s++)
+                printf("license_slot,%d,%.1f,%.4f,%.4f\n", w->width_bits, slot_us * (double)s,
+                       w->slot_ghz[s], w->slot_chase_ns[s]);
+        }
+        break;
+    case MEMBENCH_FMT_JSON:
+        for (size_t i = 0; i < r->num_widths; i++) {
+            const membench_license_width_t *w = &r->widths[i];
+            printf("{\"test\":\"license\",\"width_bits\":%d,\"isa\":\"%s\","
+                   "\"buffer_bytes\":%zu,\"burst_ms\":%.3f,\"window_ms\":%.3f,"
+                   "\"burst_gbps\":%.4f,\"base_ghz\":%.4f,\"during_ghz\":%.4f,"
+                   "\"after_ghz\":%.4f,\"drop_pct\":%.2f,\"base_chase_ns\":%.4f,"
+                   "\"during_chase_ns\":%.4f,\"after_chase_ns\":%.4f,",
+                   w->width_bits, w->isa, r->buffer_bytes, r->burst_ms, r->window_ms,
+                   w->burst_gbps, w->base_ghz, w->during_ghz, w->after_ghz, w->drop_pct,
+                   w->base_chase_ns, w->during_chase_ns, w->after_chase_ns);
+            if (w->recovery_us < 0.0)
+                printf("\"recovery_us\":null,\"timeline\":[");
+            else
+                printf("\"recovery_us\":%.1f,\"timeline\":[", w->recovery_us);
+            for (size_t s = 0; s < MEMBENCH_LICENSE_SLOTS; s++)
+                printf("%s{\"t_us\":%.1f,\"ghz\":%.4f,\"chase_ns\":%.4f}", s ? "," : "",
+                       slot_us * (double)s, w->slot_ghz[s], w->slot_chase_ns[s]);
+            printf("]}\n");
+        }
+        break;
+    }
+}
+
+/* ── Data-memory-dependent prefetch ───────────────────────────────────────── */
+
+static const char *DMP_LEVEL_NAMES[MEMBENCH_DMP_NUM_LEVELS] = { "L1", "L2", "L3", "DRAM" };
+
+void membench_print_dmp(const membench_dmp_t *r, membench_output_fmt_t fmt) {
+    char sb[64];
+    int best = -1;                       /* level with the largest gain past L1 */
+    double best_gain = 0.0;
+    for (int lv = MEMBENCH_DMP_L2; lv < MEMBENCH_DMP_NUM_LEVELS; lv++) {
+        const membench_dmp_row_t *w = &r->levels[lv];
+        double g = w->scan_gain_pct > w->chase_gain_pct ? w->scan_gain_pct
+                                                         : w->chase_gain_pct;
+        if (w->bytes && (best < 0 || g > best_gain)) { best = lv; best_gain = g; }
+    }
+
+    switch (fmt) {
+    case MEMBENCH_FMT_TABLE:
+        printf("  Pointer vs XOR-masked contents, %" PRIu64 " accesses a run, "
+               "median of %d runs\n\n", r->accesses, r->repeats);
+        printf("  %-5s  %11s  %12s  %12s  %7s  %12s  %12s  %7s\n", "Level", "Working set",
+               "Scan ptr ns", "masked ns", "gain", "Chase ptr ns", "masked ns", "gain");
+        for (int lv = 0; lv < MEMBENCH_DMP_NUM_LEVELS; lv++) {
+            const membench_dmp_row_t *w = &r->levels[lv];
+            if (!w->bytes) continue;
+            fmt_size(w->bytes, sb, sizeof(sb));
+            printf("  %-5s  %11s  %12.2f  %12.2f  %6.1f%%  %12.2f  %12.2f  %6.1f%%\n",
+                   DMP_LEVEL_NAMES[lv], sb, w->scan_ptr_ns, w->scan_masked_ns,
+                   w->scan_gain_pct, w->chase_ptr_ns, w->chase_masked_ns, w->chase_gain_pct);
+        }
+        if (r->active)
+            printf("\n  Pointer-content prefetch: ACTIVE, pointers run %.0f%% faster at %s\n",
+                   best_gain, DMP_LEVEL_NAMES[best]);
+        else
+            printf("\n  Pointer-content prefetch: not detected (no level past L1 gains %.0f%%)\n",
+                   r->threshold_pct);
+        break;
+    case MEMBENCH_FMT_CSV:
+        for (int lv = 0; lv < MEMBENCH_DMP_NUM_LEVELS; lv++) {
+            const membench_dmp_row_t *w = &r->levels[lv];
+            if (!w->bytes) continue;
+            printf("dmp,%s,%zu,%.4f,%.4f,%.2f,%.4f,%.4f,%.2f\n", DMP_LEVEL_NAMES[lv], w->bytes,
+                   w->scan_ptr_ns, w->scan_masked_ns, w->scan_gain_pct,
+                   w->chase_ptr_ns, w->chase_masked_ns, w->chase_gain_pct);
+        }
+        printf("dmp_active,%d,%.1f\n", r->active, r->threshold_pct);
+        break;
+    case MEMBENCH_FMT_JSON:
+        printf("{\"test\":\"dmp\",\"active\":%s,\"threshold_pct\":%.1f,"
+               "\"accesses\":%" PRIu64 ",\"repeats\":%d,\"levels\":[",
+               r->active ? "true" : "false", r->threshold_pct, r->accesses, r->repeats);
+        for (int lv = 0, first = 1; lv < MEMBENCH_DMP_NUM_LEVELS; lv++) {
+            const membench_dmp_row_t *w = &r->levels[lv];
+            if (!w->bytes) continue;
+            printf("%s{\"level\":\"%s\",\"bytes\":%zu,\"scan_ptr_ns\":%.4f,"
+                   "\"scan_masked_ns\":%.4f,\"scan_gain_pct\":%.2f,\"chase_ptr_ns\":%.4f,"
+                   "\"chase_masked_ns\":%.4f,\"chase_gain_pct\":%.2f}",
+                   first ? "" : ",", DMP_LEVEL_NAMES[lv], w->bytes, w->scan_ptr_ns,
+                   w->scan_masked_ns, w->scan_gain_pct, w->chase_ptr_ns,
+                   w->chase_masked_ns, w->chase_gain_pct);
+            first = 0;
+        }
+        printf("]}\n");
+        break;
+    }
+}
+
 /* ── GPU output ───────────────────────────────────────────────────────────── */
 
 void membench_print_gpu_info(const membench_gpu_info_t *info,
@@ -0,0 +1,48 @@
+/**
+ * profile.c — Per-thread phase accounting for the harness.
+ */
+#include "membench/profile.h"
+#include "membench/timer.h"
+#include "membench/timeline.h"
+#include "membench/platform.h"
+
+#include <string.h>
+
+static MEMBENCH_THREAD_LOCAL membench_phase_totals_t g_phases;
+
+void membench_phase_add(membench_phase_t phase, uint64_t ns) {
+    if ((unsigned)phase >= MEMBENCH_PHASE_COUNT) return;
+    g_phases.ns[phase] += ns;
+    g_phases.calls[phase]++;
+}
+
+void membench_phase_span(membench_phase_t phase, uint64_t t0_ns, uint64_t t1_ns) {
+    membench_phase_add(phase, t1_ns - t0_ns);
+    membench_timeline_span(membench_phase_name(phase), t0_ns, t1_ns, 0);
+}
+
+uint64_t membench_phase_mark(membench_phase_t phase, uint64_t since) {
+    uint64_t now = membench_timer_ns();
+    membench_phase_span(phase, since, now);
+    return now;
+}
+
+void membench_phase_get(membench_phase_totals_t *out) {
+    if (out) *out = g_phases;
+}
+
+void membench_phase_reset(void) {
+    memset(&g_phases, 0, sizeof(g_phases));
+}
+
+const char *membench_phase_name(membench_phase_t phase) {
+    switch (phase) {
+    case MEMBENCH_PHASE_ALLOC:   return "alloc";
+    case MEMBENCH_PHASE_BUILD:   return "build";
+    case MEMBENCH_PHASE_WARMUP:  return "warmup";
+    case MEMBENCH_PHASE_MEASURE: return "measure";
+    case MEMBENCH_PHASE_FREE:    return "free";
+    case MEMBENCH_PHASE_ANALYZE: return "analyze";
+    default:                     return "unknown";
+    }
+}
@@ -0,0 +1,238 @@
+/**
+ * registry.c — Benchmark registry, plugin loader and run harness.
+ *
+ * The registry is a fixed table filled at start-up (built-ins first, then
+ * plugins in command-line order), so lookups never allocate.
+ */
+#include "membench/registry.h"
+#include "membench/timer.h"
+#include "membench/checkpoint.h"
+#include "membench/timeline.h"
+#include "membench/profile.h"
+#include "membench/platform.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(MEMBENCH_PLATFORM_WINDOWS)
+    #define WIN32_LEAN_AND_MEAN
+    #include <windows.h>
+#else
+    #include <dlfcn.h>
+    #if defined(MEMBENCH_PLATFORM_LINUX)
+        #include <sched.h>  /* _GNU_SOURCE is set by the build */
+    #endif
+#endif
+
+typedef int (*plugin_init_fn)(int abi, membench_registry_add_fn add);
+
+static const membench_bench_t *g_benches[MEMBENCH_REGISTRY_MAX];
+static size_t g_num_benches;
+
+/* ── Registry ─────────────────────────────────────────────────────────────── */
+
+int membench_registry_add(const membench_bench_t *bench) {
+    if (!bench || !bench->name || !bench->run) return -1;
+    if (g_num_benches >= MEMBENCH_REGISTRY_MAX) return -1;
+    if (membench_registry_find(bench->name)) return -1;
+    g_benches[g_num_benches++] = bench;
+    return 0;
+}
+
+const membench_bench_t *membench_registry_find(const char *name) {
+    if (!name) return NULL;
+    for (size_t i = 0; i < g_num_benches; i++)
+        if (strcmp(g_benches[i]->name, name) == 0) return g_benches[i];
+    return NULL;
+}
+
+size_t membench_registry_count(void) {
+    return g_num_benches;
+}
+
+const membench_bench_t *membench_registry_get(size_t i) {
+    return i < g_num_benches ? g_benches[i] : NULL;
+}
+
+/* ── Plugins ──────────────────────────────────────────────────────────────── */
+
+int membench_plugin_load(const char *path) {
+    if (!path) return -1;
+    plugin_init_fn init = NULL;
+
+#if defined(MEMBENCH_PLATFORM_WINDOWS)
+    HMODULE lib = LoadLibraryA(path);
+    if (!lib) {
+        fprintf(stderr, "Cannot load plugin '%s' (error %lu)\n", path,
+                (unsigned long)GetLastError());
+        return -1;
+    }
+    init = (plugin_init_fn)(void (*)(void))GetProcAddress(lib, MEMBENCH_PLUGIN_ENTRY);
+#else
+    void *lib = dlopen(path, RTLD_NOW | RTLD_LOCAL);
+    if (!lib) {
+        fprintf(stderr, "Cannot load plugin: %s\n", dlerror());
+        return -1;
+    }
+    /* POSIX-sanctioned way to turn dlsym()'s void * into a function pointer */
+    *(void **)(&init) = dlsym(lib, MEMBENCH_PLUGIN_ENTRY);
+#endif
+    if (!init) {
+        fprintf(stderr, "Plugin '%s' does not export %s()\n", path, MEMBENCH_PLUGIN_ENTRY);
+        return -1;
+    }
+
+    size_t before = g_num_benches;
+    if (init(MEMBENCH_PLUGIN_ABI, membench_registry_add) != 0) {
+        fprintf(stderr, "Plugin '%s' failed to initialise (ABI %d)\n", path,
+                MEMBENCH_PLUGIN_ABI);
+        return -1;
+    }
+    /* The library is never unloaded: descriptors and callbacks live in it */
+    return (int)(g_num_benches - before);
+}
+
+/* ── Thread pinning ───────────────────────────────────────────────────────── */
+
+/*
+ * Keep the calling thread on the CPU it is running on for the duration of
+ * a measurement, so a migration cannot land mid-run on a cold core.
+ */
+typedef struct {
+#if defined(MEMBENCH_PLATFORM_LINUX)
+    cpu_set_t saved;
+#elif defined(MEMBENCH_PLATFORM_WINDOWS)
+    DWORD_PTR saved;
+#endif
+    int pinned;
+} pin_state_t;
+
+static void pin_current(pin_state_t *ps) {
+    ps->pinned = 0;
+#if defined(MEMBENCH_PLATFORM_LINUX)
+    int cpu = sched_getcpu();
+    if (cpu < 0 || sched_getaffinity(0, sizeof(ps->saved), &ps->saved) != 0) return;
+    cpu_set_t one;
+    CPU_ZERO(&one);
+    CPU_SET(cpu, &one);
+    ps->pinned = sched_setaffinity(0, sizeof(one), &one) == 0;
+#elif defined(MEMBENCH_PLATFORM_WINDOWS)
+    DWORD cpu = GetCurrentProcessorNumber();
+    if (cpu >= sizeof(DWORD_PTR) * 8) return;
+    ps->saved = SetThreadAffinityMask(GetCurrentThread(), (DWORD_PTR)1 << cpu);
+    ps->pinned = ps->saved != 0;
+#endif
+}
+
+static void unpin_current(pin_state_t *ps) {
+    if (!ps->pinned) return;
+#if defined(MEMBENCH_PLATFORM_LINUX)
+    sched_setaffinity(0, sizeof(ps->saved), &ps->saved);
+#elif defined(MEMBENCH_PLATFORM_WINDOWS)
+    SetThreadAffinityMask(GetCurrentThread(), ps->saved);
+#endif
+}
+
+/* ── Harness ──────────────────────────────────────────────────────────────── */
+
+static int cmp_double(const void *a, const void *b) {
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+int membench_bench_run(const membench_bench_t *bench, size_t buffer_size,
+                       uint64_t iterations, int reps, membench_bench_result_t *result) {
+    if (!bench || !bench->run || !result || buffer_size == 0 || iterations == 0)
+        return -1;
+    if (reps < 1) reps = 1;
+    memset(result, 0, sizeof(*result));
+
+    double *ns = (double *)calloc((size_t)reps, sizeof(double));
+    if (!ns) return -1;
+
+    /* Self-timed built-ins charge their own phases; plugins are charged here */
+    int self_timed = (bench->flags & MEMBENCH_BENCH_SELF_TIMED) != 0;
+    uint64_t t_start = membench_timer_ns(), t = t_start;
+
+    void *state = NULL;
+    if (bench->setup && bench->setup(buffer_size, &state) != 0) {
+        free(ns);
+        return -1;
+    }
+    if (!self_timed) t = membench_phase_mark(MEMBENCH_PHASE_BUILD, t);
+
+    pin_state_t pin;
+    pin_current(&pin);
+
+    int rc = 0;
+    membench_bench_metrics_t m;
+    if (!self_timed) {
+        memset(&m, 0, sizeof(m));
+        rc = bench->run(state, 1, &m);                  /* warm-up, faults pages */
+        membench_phase_mark(MEMBENCH_PHASE_WARMUP, t);
+    }
+
+    for (int r = 0; r < reps && rc == 0; r++) {
+        if (membench_cancel_requested()) { rc = -1; break; }
+        memset(&m, 0, sizeof(m));
+        uint64_t t0 = membench_timer_ns();
+        rc = bench->run(state, iterations, &m);
+        uint64_t t1 = membench_timer_ns();
+        if (self_timed) membench_timeline_span("rep", t0, t1, (uint64_t)r);
+        else            membench_phase_span(MEMBENCH_PHASE_MEASURE, t0, t1);
+        if (rc != 0 || m.ops == 0) { rc = -1; break; }
+
+        uint64_t elapsed = m.elapsed_ns ? m.elapsed_ns : t1 - t0;
+        ns[r] = (double)elapsed / (double)m.ops;
+        result->ops = m.ops;
+        result->bytes = m.bytes;
+    }
+
+    unpin_current(&pin);
+    t = membench_timer_ns();
+    if (bench->teardown) bench->teardown(state);
+    t = self_timed ? membench_timer_ns() : membench_phase_mark(MEMBENCH_PHASE_FREE, t);
+    membench_timeline_span(bench->name, t_start, t, buffer_size);
+
+    if (rc == 0) {
+        qsort(ns, (size_t)reps, sizeof(double), cmp_double);
+        result->buffer_size = buffer_size;
+        result->iterations = iterations;
+        result->reps = reps;
+        result->ns_per_op_min = ns[0];
+        result->ns_per_op_max = ns[reps - 1];
+        result->ns_per_op = (reps % 2) ? ns[reps / 2]
+                                       : (ns[reps / 2 - 1] + ns[reps / 2]) / 2.0;
+        result->bandwidth_gbps = membench_gbps((double)result->bytes,
+                                               result->ns_per_op * (double)result->ops);
+    }
+    free(ns);
+    return rc;
+}
+
+void membench_bench_result_pack(const membench_bench_result_t *r,
+                                double v[MEMBENCH_BENCH_RESULT_VALUES]) {
+    v[0] = (double)r->buffer_size;
+    v[1] = (double)r->iterations;
+    v[2] = (double)r->reps;
+    v[3] = (double)r->ops;
+    v[4] = (double)r->bytes;
+    v[5] = r->ns_per_op;
+    v[6] = r->ns_per_op_min;
+    v[7] = r->ns_per_op_max;
+    v[8] = r->bandwidth_gbps;
+}
+
+void membench_bench_result_unpack(const double v[MEMBENCH_BENCH_RESULT_VALUES],
+                                  membench_bench_result_t *r) {
+    r->buffer_size = (size_t)v[0];
+    r->iterations = (uint64_t)v[1];
+    r->reps = (int)v[2];
+    r->ops = (uint64_t)v[3];
+    r->bytes = (uint64_t)v[4];
+    r->ns_per_op = v[5];
+    r->ns_per_op_min = v[6];
+    r->ns_per_op_max = v[7];
+    r->bandwidth_gbps = v[8];
+}
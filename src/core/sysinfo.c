@@ -3,8 +3,10 @@
  */
 #include "membench/sysinfo.h"
 #include "membench/platform.h"
+#include "membench/timer.h"
 
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 
 #if defined(MEMBENCH_PLATFORM_WINDOWS)
@@ -78,6 +80,196 @@ static void detect_cpu_model(char *buf, size_t len) {
 #endif
 }
 
+/* ── Environment ──────────────────────────────────────────────────────────── */
+
+#if defined(MEMBENCH_PLATFORM_LINUX)
+/* First line of a small /sys or /proc file, newline stripped */
+static int read_line(const char *path, char *buf, size_t len) {
+    FILE *f = fopen(path, "r");
+    if (!f) return -1;
+    char *ok = fgets(buf, (int)len, f);
+    fclose(f);
+    if (!ok) return -1;
+    buf[strcspn(buf, "\n")] = '\0';
+    return 0;
+}
+
+static int read_int(const char *path) {
+    char buf[32];
+    char *end = NULL;
+    if (read_line(path, buf, sizeof(buf)) != 0) return MEMBENCH_ENV_UNKNOWN;
+    long v = strtol(buf, &end, 10);
+    return end == buf ? MEMBENCH_ENV_UNKNOWN : (int)v;
+}
+
+static void detect_env_linux(membench_env_t *env) {
+    read_line("/sys/devices/system/cpu/cpu0/cpufreq/scaling_governor",
+              env->governor, sizeof(env->governor));
+
+    /* intel_pstate reports the inverse; acpi-cpufreq and amd-pstate use boost */
+    int v = read_int("/sys/devices/system/cpu/intel_pstate/no_turbo");
+    if (v != MEMBENCH_ENV_UNKNOWN) env->turbo = !v;
+    else env->turbo = read_int("/sys/devices/system/cpu/cpufreq/boost");
+
+    env->smt = read_int("/sys/devices/system/cpu/smt/active");
+
+    /* "always [madvise] never": the bracketed word is the mode */
+    char line[128];
+    if (read_line("/sys/kernel/mm/transparent_hugepage/enabled", line, sizeof(line)) == 0) {
+        char *open = strchr(line, '['), *close = open ? strchr(open, ']') : NULL;
+        if (close) {
+            *close = '\0';
+            snprintf(env->thp, sizeof(env->thp), "%s", open + 1);
+        }
+    }
+
+    env->perf_paranoid = read_int("/proc/sys/kernel/perf_event_paranoid");
+    env->numa_balancing = read_int("/proc/sys/kernel/numa_balancing");
+
+    if (read_line("/proc/loadavg", line, sizeof(line)) == 0)
+        env->loadavg = strtod(line, NULL);
+
+    FILE *f = fopen("/proc/meminfo", "r");
+    if (f) {
+        unsigned long long total = 0, free_kb = 0;
+        while (fgets(line, sizeof(line), f)) {
+            if (sscanf(line, "SwapTotal: %llu", &total) == 1) continue;
+            if (sscanf(line, "SwapFree: %llu", &free_kb) == 1) continue;
+        }
+        fclose(f);
+        env->swap_total = (size_t)total * 1024;
+        env->swap_used = total > free_kb ? (size_t)(total - free_kb) * 1024 : 0;
+    }
+}
+#endif
+
+static void detect_env(membench_env_t *env) {
+    env->turbo = MEMBENCH_ENV_UNKNOWN;
+    env->smt = MEMBENCH_ENV_UNKNOWN;
+    env->perf_paranoid = MEMBENCH_ENV_UNKNOWN;
+    env->numa_balancing = MEMBENCH_ENV_UNKNOWN;
+    env->virtualized = MEMBENCH_ENV_UNKNOWN;
+    env->loadavg = -1.0;
+
+#if defined(MEMBENCH_ARCH_X86_64) || defined(MEMBENCH_ARCH_X86)
+    /* CPUID.1:ECX bit 31 is reserved for hypervisors to set */
+    int regs[4];
+    cpuid(regs, 1);
+    env->virtualized = (int)(((unsigned)regs[2] >> 31) & 1);
+#endif
+
+#if defined(MEMBENCH_PLATFORM_LINUX)
+    detect_env_linux(env);
+#elif defined(MEMBENCH_PLATFORM_MACOS)
+    double load[1];
+    if (getloadavg(load, 1) == 1) env->loadavg = load[0];
+    struct xsw_usage swap;
+    size_t sz = sizeof(swap);
+    if (sysctlbyname("vm.swapusage", &swap, &sz, NULL, 0) == 0) {
+        env->swap_total = (size_t)swap.xsu_total;
+        env->swap_used = (size_t)swap.xsu_used;
+    }
+#endif
+}
+
+#define NOISE_DEFAULT_NS  100000000ULL /* 100 ms pre-flight */
+#define NOISE_SAMPLE_NS   20000ULL     /* one busy-loop sample */
+#define NOISE_MAX_SAMPLES 4096
+
+static volatile uint64_t g_noise_sink;
+
+/* A dependent multiply chain: no memory traffic, so only the CPU's
+ * availability and clock move it */
+static uint64_t noise_spin(uint64_t n) {
+    uint64_t x = g_noise_sink | 1;
+    for (uint64_t i = 0; i < n; i++) x = x * 6364136223846793005ULL + 1442695040888963407ULL;
+    return x;
+}
+
+static int cmp_u64(const void *a, const void *b) {
+    uint64_t x = *(const uint64_t *)a, y = *(const uint64_t *)b;
+    return (x > y) - (x < y);
+}
+
+int membench_env_measure_noise(membench_env_t *env, uint64_t duration_ns) {
+    if (duration_ns == 0) duration_ns = NOISE_DEFAULT_NS;
+    if (!env || duration_ns < NOISE_SAMPLE_NS) return -1;
+
+    /* Size the loop to one sample, growing until it clears the timer's
+     * resolution comfortably */
+    uint64_t n = 1024, t = 0;
+    for (;;) {
+        uint64_t t0 = membench_timer_ns();
+        g_noise_sink = noise_spin(n);
+        t = membench_timer_ns() - t0;
+        if (t >= NOISE_SAMPLE_NS / 4 || n >= (1ULL << 32)) break;
+        n *= 2;
+    }
+    n = (uint64_t)((double)n * (double)NOISE_SAMPLE_NS / (double)(t ? t : 1));
+    if (n < 1) n = 1;
+
+    uint64_t samples[NOISE_MAX_SAMPLES];
+    uint64_t want = duration_ns / NOISE_SAMPLE_NS;
+    if (want > NOISE_MAX_SAMPLES) want = NOISE_MAX_SAMPLES;
+    for (uint64_t i = 0; i < want; i++) {
+        uint64_t t0 = membench_timer_ns();
+        g_noise_sink = noise_spin(n);
+        samples[i] = membench_timer_ns() - t0;
+    }
+    qsort(samples, (size_t)want, sizeof(uint64_t), cmp_u64);
+
+    double median = (double)samples[want / 2];
+    if (median <= 0.0) return -1;
+    uint64_t outliers = 0;
+    for (uint64_t i = 0; i < want; i++)
+        if ((double)samples[i] > 1.5 * median) outliers++;
+
+    env->noise_samples = (uint32_t)want;
+    env->noise_median_ns = median;
+    env->noise_p99_ratio = (double)samples[(want * 99) / 100] / median;
+    env->noise_outlier_pct = 100.0 * (double)outliers / (double)want;
+    return 0;
+}
+
+#define NOISE_WARN_P99      1.10
+#define NOISE_WARN_OUTLIERS 1.0         /* % */
+#define LOAD_WARN_PER_CPU   0.25        /* runnable tasks per logical CPU */
+
+size_t membench_env_warnings(const membench_sysinfo_t *info,
+                             char msgs[][MEMBENCH_ENV_MSG_LEN], size_t max) {
+    const membench_env_t *e = &info->env;
+    size_t n = 0;
+#define WARN(...) do { if (n < max) snprintf(msgs[n++], MEMBENCH_ENV_MSG_LEN, __VA_ARGS__); } while (0)
+
+    if (e->governor[0] && strcmp(e->governor, "performance") != 0)
+        WARN("cpufreq governor is '%s': clocks ramp with load; use 'performance'", e->governor);
+    if (e->turbo == 1)
+        WARN("turbo boost is on: clocks depend on temperature and how many cores are busy");
+    if (e->smt == 1)
+        WARN("SMT is on: threads may share a core's L1/L2 with a sibling");
+    if (strcmp(e->thp, "always") == 0)
+        WARN("transparent huge pages 'always': TLB reach varies with what khugepaged did");
+    if (e->numa_balancing > 0 && info->numa_nodes > 1)
+        WARN("NUMA balancing is on: pages may migrate between nodes mid-run");
+    if (e->swap_used > 0)
+        WARN("%.1f MB of swap in use: large buffers may page", (double)e->swap_used / (1024.0 * 1024.0));
+    int cpus = info->num_cores_logical > 0 ? info->num_cores_logical : 1;
+    if (e->loadavg >= 1.0 && e->loadavg >= LOAD_WARN_PER_CPU * cpus)
+        WARN("load average %.2f on %d CPUs: other tasks compete for CPU and memory bandwidth",
+             e->loadavg, cpus);
+    if (e->virtualized == 1)
+        WARN("running under a hypervisor: cache sizes and timings may not be the host's");
+    if (e->noise_samples &&
+        (e->noise_p99_ratio > NOISE_WARN_P99 || e->noise_outlier_pct > NOISE_WARN_OUTLIERS))
+        WARN("timer noise: p99 sample %.2fx the median, %.1f%% of samples interrupted",
+             e->noise_p99_ratio, e->noise_outlier_pct);
+    if (e->perf_paranoid > 2)
+        WARN("perf_event_paranoid is %d: hardware counters unavailable without root",
+             e->perf_paranoid);
+#undef WARN
+    return n;
+}
+
 int membench_sysinfo_get(membench_sysinfo_t *info) {
     if (!info) return -1;
     memset(info, 0, sizeof(*info));
@@ -105,12 +297,17 @@ int membench_sysinfo_get(membench_sysinfo_t *info) {
                         physical++;
                     } else if (buf[i].Relationship == RelationCache) {
                         CACHE_DESCRIPTOR *cd = &buf[i].Cache;
-                        if (cd->Level == 1 && cd->Type == CacheData && info->l1_data_cache == 0)
+                        if (cd->Level == 1 && cd->Type == CacheData && info->l1_data_cache == 0) {
                             info->l1_data_cache = cd->Size;
-                        else if (cd->Level == 2 && info->l2_cache == 0)
+                            info->l1_ways = cd->Associativity;
+                            info->cache_line = cd->LineSize;
+                        } else if (cd->Level == 2 && info->l2_cache == 0) {
                             info->l2_cache = cd->Size;
-                        else if (cd->Level == 3 && info->l3_cache == 0)
+                            info->l2_ways = cd->Associativity;
+                        } else if (cd->Level == 3 && info->l3_cache == 0) {
                             info->l3_cache = cd->Size;
+                            info->l3_ways = cd->Associativity;
+                        }
                     }
                 }
                 info->num_cores_physical = physical;
@@ -126,6 +323,12 @@ int membench_sysinfo_get(membench_sysinfo_t *info) {
         info->total_ram = (size_t)mem.ullTotalPhys;
     }
 
+    {
+        ULONG highest = 0;
+        if (GetNumaHighestNodeNumber(&highest))
+            info->numa_nodes = (int)highest + 1;
+    }
+
 #elif defined(MEMBENCH_PLATFORM_LINUX)
     info->num_cores_logical = (int)sysconf(_SC_NPROCESSORS_ONLN);
     info->num_cores_physical = info->num_cores_logical; /* fallback */
@@ -163,6 +366,51 @@ int membench_sysinfo_get(membench_sysinfo_t *info) {
         }
     }
 
+    /* Associativity and line size, same indices */
+    {
+        const char *paths[] = {
+            "/sys/devices/system/cpu/cpu0/cache/index0/ways_of_associativity",
+            "/sys/devices/system/cpu/cpu0/cache/index2/ways_of_associativity",
+            "/sys/devices/system/cpu/cpu0/cache/index3/ways_of_associativity",
+        };
+        int *targets[] = {&info->l1_ways, &info->l2_ways, &info->l3_ways};
+
+        for (int i = 0; i < 3; i++) {
+            FILE *f = fopen(paths[i], "r");
+            if (f) {
+                if (fscanf(f, "%d", targets[i]) != 1) *targets[i] = 0;
+                fclose(f);
+            }
+        }
+
+        FILE *f = fopen("/sys/devices/system/cpu/cpu0/cache/index0/coherency_line_size", "r");
+        if (f) {
+            unsigned long val = 0;
+            if (fscanf(f, "%lu", &val) == 1) info->cache_line = (size_t)val;
+            fclose(f);
+        }
+    }
+
+    /* NUMA nodes: "online" holds ranges such as "0" or "0-1,4-5" */
+    {
+        FILE *f = fopen("/sys/devices/system/node/online", "r");
+        if (f) {
+            int lo, hi, n = 0;
+            char sep;
+            while (fscanf(f, "%d", &lo) == 1) {
+                hi = lo;
+                if (fscanf(f, "%c", &sep) == 1 && sep == '-') {
+                    if (fscanf(f, "%d", &hi) != 1) break;
+                    if (fscanf(f, "%c", &sep) != 1) sep = 0;
+                }
+                n += hi - lo + 1;
+                if (sep != ',') break;
+            }
+            info->numa_nodes = n;
+            fclose(f);
+        }
+    }
+
     {
         long pages = sysconf(_SC_PHYS_PAGES);
         long pagesz = sysconf(_SC_PAGESIZE);
@@ -205,6 +453,11 @@ int membench_sysinfo_get(membench_sysinfo_t *info) {
             sysctlbyname("hw.l3cachesize", &val, &sz, NULL, 0);
         }
         info->l3_cache = val;
+
+        /* Associativity is not exposed on macOS */
+        sz = sizeof(val); val = 0;
+        sysctlbyname("hw.cachelinesize", &val, &sz, NULL, 0);
+        info->cache_line = val;
     }
     {
         uint64_t memsize = 0;
@@ -214,6 +467,8 @@ int membench_sysinfo_get(membench_sysinfo_t *info) {
     }
 #endif
 
+    if (info->numa_nodes < 1) info->numa_nodes = 1;
+    detect_env(&info->env);
     return 0;
 }
 
@@ -250,4 +505,26 @@ void membench_sysinfo_print(const membench_sysinfo_t *info) {
     }
     format_size(buf, sizeof(buf), info->total_ram);
     printf("  Total RAM:    %s\n", buf);
+    if (info->numa_nodes > 1)
+        printf("  NUMA nodes:   %d\n", info->numa_nodes);
+
+    const membench_env_t *e = &info->env;
+    if (e->governor[0])
+        printf("  Governor:     %s\n", e->governor);
+    if (e->turbo != MEMBENCH_ENV_UNKNOWN)
+        printf("  Turbo:        %s\n", e->turbo ? "on" : "off");
+    if (e->smt != MEMBENCH_ENV_UNKNOWN)
+        printf("  SMT:          %s\n", e->smt ? "on" : "off");
+    if (e->thp[0])
+        printf("  THP:          %s\n", e->thp);
+    if (e->loadavg >= 0.0)
+        printf("  Load avg:     %.2f\n", e->loadavg);
+    if (e->noise_samples)
+        printf("  Timer noise:  p99 %.2fx median, %.1f%% outliers (%u samples)\n",
+               e->noise_p99_ratio, e->noise_outlier_pct, e->noise_samples);
+
+    char msgs[16][MEMBENCH_ENV_MSG_LEN];
+    size_t n = membench_env_warnings(info, msgs, 16);
+    for (size_t i = 0; i < n; i++)
+        printf("  Warning:      %s\n", msgs[i]);
 }
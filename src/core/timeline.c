@@ -0,0 +1,234 @@
+/**
+ * timeline.c — Per-thread event buffers and the Chrome trace writer.
+ *
+ * A thread claims a slot the first time it records; after that it only
+ * ever touches its own buffer.  Buffers grow by doubling up to the
+ * per-thread cap, and are read only by the writer once the workers have
+ * been joined.  A thread that releases its slot on exit leaves the buffer
+ * to the next thread of the same name, so the worker pools that
+ * run_on_threads() starts for every point share one track per worker
+ * instead of using up a slot each.
+ */
+#include "membench/timeline.h"
+#include "membench/timer.h"
+#include "membench/platform.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <inttypes.h>
+#include <string.h>
+
+#if defined(_MSC_VER)
+    #include <intrin.h>
+    #define FETCH_INC(p) (_InterlockedIncrement(p) - 1)
+    #define TRY_ACQUIRE(p) (_InterlockedCompareExchange((p), 1, 0) == 0)
+    #define RELEASE(p)     _InterlockedExchange((p), 0)
+#else
+    #define FETCH_INC(p) __atomic_fetch_add((p), 1, __ATOMIC_RELAXED)
+    #define TRY_ACQUIRE(p) tl_try_acquire(p)
+    #define RELEASE(p)     __atomic_store_n((p), 0, __ATOMIC_RELEASE)
+#endif
+
+#define TIMELINE_INITIAL_EVENTS 256
+
+typedef struct {
+    const char *name;
+    uint64_t    ts;
+    uint64_t    dur;
+    uint64_t    arg;
+    char        ph;              /* 'X' complete, 'i' instant */
+} tl_event_t;
+
+typedef struct {
+    char        name[32];
+    size_t      count, cap;
+    size_t      dropped;
+    tl_event_t *ev;
+    volatile long owned;         /* 1 while a live thread records here */
+} tl_thread_t;
+
+static volatile int   g_enabled;
+static size_t         g_max_events;
+static uint64_t       g_base_ns;
+static tl_thread_t   *g_threads[MEMBENCH_TIMELINE_MAX_THREADS];
+static volatile long  g_num_threads;       /* slots claimed, may pass the max */
+static volatile long  g_lost_threads;
+
+static MEMBENCH_THREAD_LOCAL tl_thread_t *tl_self;
+
+#if !defined(_MSC_VER)
+static int tl_try_acquire(volatile long *p) {
+    long expected = 0;
+    return __atomic_compare_exchange_n(p, &expected, 1, 0, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED);
+}
+#endif
+
+/* A released slot already named `name`, now owned by the caller */
+static tl_thread_t *tl_adopt(const char *name) {
+    size_t n = (size_t)g_num_threads;
+    if (n > MEMBENCH_TIMELINE_MAX_THREADS) n = MEMBENCH_TIMELINE_MAX_THREADS;
+    for (size_t i = 0; i < n; i++) {
+        tl_thread_t *t = g_threads[i];
+        if (t && !t->owned && strcmp(t->name, name) == 0 && TRY_ACQUIRE(&t->owned)) {
+            tl_self = t;
+            return t;
+        }
+    }
+    return NULL;
+}
+
+/* Slow path: first event on this thread */
+static tl_thread_t *tl_claim(void) {
+    size_t slot = (size_t)FETCH_INC(&g_num_threads);
+    if (slot >= MEMBENCH_TIMELINE_MAX_THREADS) {
+        FETCH_INC(&g_lost_threads);
+        return NULL;
+    }
+    tl_thread_t *t = (tl_thread_t *)calloc(1, sizeof(*t));
+    if (!t) return NULL;
+    snprintf(t->name, sizeof(t->name), slot == 0 ? "main" : "thread %zu", slot);
+    t->owned = 1;
+    g_threads[slot] = t;
+    tl_self = t;
+    return t;
+}
+
+static tl_event_t *tl_append(void) {
+    tl_thread_t *t = tl_self ? tl_self : tl_claim();
+    if (!t) return NULL;
+    if (t->count == t->cap) {
+        size_t cap = t->cap ? t->cap * 2 : TIMELINE_INITIAL_EVENTS;
+        if (cap > g_max_events) cap = g_max_events;
+        tl_event_t *ev = cap > t->cap ? (tl_event_t *)realloc(t->ev, cap * sizeof(*ev)) : NULL;
+        if (!ev) {
+            t->dropped++;
+            return NULL;
+        }
+        t->ev = ev;
+        t->cap = cap;
+    }
+    return &t->ev[t->count++];
+}
+
+int membench_timeline_enable(size_t events_per_thread) {
+    if (g_enabled) return 0;
+    g_max_events = events_per_thread ? events_per_thread : MEMBENCH_TIMELINE_DEFAULT_EVENTS;
+    g_base_ns = membench_timer_ns();
+    g_enabled = 1;
+    return 0;
+}
+
+int membench_timeline_enabled(void) {
+    return g_enabled;
+}
+
+void membench_timeline_disable(void) {
+    g_enabled = 0;
+    size_t n = (size_t)g_num_threads;
+    if (n > MEMBENCH_TIMELINE_MAX_THREADS) n = MEMBENCH_TIMELINE_MAX_THREADS;
+    for (size_t i = 0; i < n; i++) {
+        if (g_threads[i]) free(g_threads[i]->ev);
+        free(g_threads[i]);
+        g_threads[i] = NULL;
+    }
+    g_num_threads = 0;
+    g_lost_threads = 0;
+    /* Only the calling thread's cached pointer can be reset here; other
+     * threads must not record again after a disable */
+    tl_self = NULL;
+}
+
+void membench_timeline_thread_name(const char *name) {
+    if (!g_enabled || !name) return;
+    if (!tl_self && tl_adopt(name)) return;
+    tl_thread_t *t = tl_self ? tl_self : tl_claim();
+    if (t) snprintf(t->name, sizeof(t->name), "%s", name);
+}
+
+void membench_timeline_thread_exit(void) {
+    tl_thread_t *t = tl_self;
+    if (!t) return;
+    tl_self = NULL;
+    RELEASE(&t->owned);
+}
+
+void membench_timeline_span(const char *name, uint64_t t0_ns, uint64_t t1_ns, uint64_t arg) {
+    if (!g_enabled) return;
+    tl_event_t *e = tl_append();
+    if (!e) return;
+    e->name = name;
+    e->ts = t0_ns;
+    e->dur = t1_ns > t0_ns ? t1_ns - t0_ns : 0;
+    e->arg = arg;
+    e->ph = 'X';
+}
+
+void membench_timeline_instant(const char *name, uint64_t arg) {
+    if (!g_enabled) return;
+    tl_event_t *e = tl_append();
+    if (!e) return;
+    e->name = name;
+    e->ts = membench_timer_ns();
+    e->dur = 0;
+    e->arg = arg;
+    e->ph = 'i';
+}
+
+size_t membench_timeline_lost_threads(void) {
+    return (size_t)g_lost_threads;
+}
+
+size_t membench_timeline_dropped(void) {
+    size_t n = (size_t)g_num_threads, dropped = (size_t)g_lost_threads;
+    if (n > MEMBENCH_TIMELINE_MAX_THREADS) n = MEMBENCH_TIMELINE_MAX_THREADS;
+    for (size_t i = 0; i < n; i++)
+        if (g_threads[i]) dropped += g_threads[i]->dropped;
+    return dropped;
+}
+
+static void json_string(FILE *f, const char *s) {
+    fputc('"', f);
+    for (; s && *s; s++) {
+        if (*s == '"' || *s == '\\') fputc('\\', f);
+        if ((unsigned char)*s >= 0x20) fputc(*s, f);
+    }
+    fputc('"', f);
+}
+
+/* Trace-event timestamps are microseconds */
+static double tl_us(uint64_t ns) {
+    return (double)ns / 1000.0;
+}
+
+int membench_timeline_write(const char *path) {
+    if (!path) return -1;
+    FILE *f = fopen(path, "w");
+    if (!f) return -1;
+
+    fprintf(f, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+    fprintf(f, "{\"ph\":\"M\",\"pid\":1,\"tid\":0,\"name\":\"process_name\","
+               "\"args\":{\"name\":\"membench\"}}");
+
+    size_t n = (size_t)g_num_threads;
+    if (n > MEMBENCH_TIMELINE_MAX_THREADS) n = MEMBENCH_TIMELINE_MAX_THREADS;
+    for (size_t i = 0; i < n; i++) {
+        const tl_thread_t *t = g_threads[i];
+        if (!t) continue;
+        fprintf(f, ",\n{\"ph\":\"M\",\"pid\":1,\"tid\":%zu,\"name\":\"thread_name\","
+                   "\"args\":{\"name\":", i + 1);
+        json_string(f, t->name);
+        fprintf(f, "}}");
+        for (size_t k = 0; k < t->count; k++) {
+            const tl_event_t *e = &t->ev[k];
+            uint64_t ts = e->ts > g_base_ns ? e->ts - g_base_ns : 0;
+            fprintf(f, ",\n{\"ph\":\"%c\",\"pid\":1,\"tid\":%zu,\"name\":", e->ph, i + 1);
+            json_string(f, e->name);
+            fprintf(f, ",\"ts\":%.3f", tl_us(ts));
+            if (e->ph == 'X') fprintf(f, ",\"dur\":%.3f", tl_us(e->dur));
+            else              fprintf(f, ",\"s\":\"t\"");
+            fprintf(f, ",\"args\":{\"arg\":%" PRIu64 "}}", e->arg);
+        }
+    }
+    fprintf(f, "\n]}\n");
+    return fclose(f) == 0 ? 0 : -1;
+}
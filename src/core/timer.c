@@ -59,7 +59,7 @@ double membench_timer_resolution_ns(void) {
     return 1e9 / (double)g_freq.QuadPart;
 #elif defined(MEMBENCH_PLATFORM_LINUX)
     struct timespec res;
-    clock_gettime(CLOCK_MONOTONIC, &res);
+    clock_getres(CLOCK_MONOTONIC, &res);
     return (double)res.tv_sec * 1e9 + (double)res.tv_nsec;
 #elif defined(MEMBENCH_PLATFORM_MACOS)
     return (double)g_timebase.numer / (double)g_timebase.denom;
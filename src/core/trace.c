@@ -0,0 +1,213 @@
+/**
+ * trace.c — Binary trace writer and streaming reader.
+ *
+ * The reader maps the file through a sliding window of TRACE_WINDOW bytes
+ * (mmap on POSIX, buffered reads on Windows), so memory use stays constant
+ * however long the trace is.  Records are written in host byte order; every
+ * supported target is little-endian, which is what the format specifies.
+ */
+#include "membench/trace.h"
+#include "membench/platform.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(MEMBENCH_PLATFORM_WINDOWS)
+    #define TRACE_STDIO 1
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+#define TRACE_WINDOW ((size_t)64 * 1024 * 1024)
+#define TRACE_REC    sizeof(uint64_t)
+
+/* ── Writer ───────────────────────────────────────────────────────────────── */
+
+struct membench_trace_writer {
+    FILE    *fp;
+    uint64_t count;
+    uint64_t span;
+};
+
+static void header_init(membench_trace_header_t *h) {
+    memset(h, 0, sizeof(*h));
+    memcpy(h->magic, MEMBENCH_TRACE_MAGIC, sizeof(h->magic));
+    h->version = MEMBENCH_TRACE_VERSION;
+    h->header_bytes = (uint32_t)sizeof(*h);
+}
+
+membench_trace_writer_t *membench_trace_create(const char *path) {
+    if (!path) return NULL;
+    membench_trace_writer_t *w = (membench_trace_writer_t *)calloc(1, sizeof(*w));
+    if (!w) return NULL;
+
+    w->fp = fopen(path, "wb");
+    if (!w->fp) { free(w); return NULL; }
+
+    /* Placeholder header: an unfinished trace is still readable to EOF */
+    membench_trace_header_t h;
+    header_init(&h);
+    if (fwrite(&h, sizeof(h), 1, w->fp) != 1) {
+        fclose(w->fp);
+        free(w);
+        return NULL;
+    }
+    return w;
+}
+
+int membench_trace_append(membench_trace_writer_t *w, uint64_t offset,
+                          uint32_t size, int is_write, int new_phase) {
+    if (!w || size == 0 || size > MEMBENCH_TRACE_MAX_SIZE) return -1;
+    if (offset > MEMBENCH_TRACE_MAX_OFFSET) return -1;
+
+    uint64_t rec = membench_trace_encode(offset, size, is_write, new_phase);
+    if (fwrite(&rec, TRACE_REC, 1, w->fp) != 1) return -1;
+    w->count++;
+    if (offset + size > w->span) w->span = offset + size;
+    return 0;
+}
+
+int membench_trace_finish(membench_trace_writer_t *w) {
+    if (!w) return -1;
+    membench_trace_header_t h;
+    header_init(&h);
+    h.num_records = w->count;
+    h.span_bytes = w->span;
+
+    int rc = 0;
+    if (fseek(w->fp, 0, SEEK_SET) != 0 || fwrite(&h, sizeof(h), 1, w->fp) != 1)
+        rc = -1;
+    if (fclose(w->fp) != 0) rc = -1;
+    free(w);
+    return rc;
+}
+
+/* ── Reader ───────────────────────────────────────────────────────────────── */
+
+struct membench_trace_reader {
+    membench_trace_header_t header;
+    uint64_t  next;             /* index of the next record to hand out */
+#if defined(TRACE_STDIO)
+    FILE     *fp;
+    uint64_t *buf;
+#else
+    int       fd;
+    void     *map;
+    size_t    map_len;
+#endif
+};
+
+static int header_valid(const membench_trace_header_t *h) {
+    return memcmp(h->magic, MEMBENCH_TRACE_MAGIC, sizeof(h->magic)) == 0
+        && h->version == MEMBENCH_TRACE_VERSION
+        && h->header_bytes >= sizeof(*h)
+        && h->header_bytes % TRACE_REC == 0;
+}
+
+membench_trace_reader_t *membench_trace_open(const char *path) {
+    if (!path) return NULL;
+    membench_trace_reader_t *r = (membench_trace_reader_t *)calloc(1, sizeof(*r));
+    if (!r) return NULL;
+
+    uint64_t file_bytes = 0;
+#if defined(TRACE_STDIO)
+    r->fp = fopen(path, "rb");
+    if (!r->fp) { free(r); return NULL; }
+    r->buf = (uint64_t *)malloc(TRACE_WINDOW);
+    if (!r->buf || fread(&r->header, sizeof(r->header), 1, r->fp) != 1 ||
+        _fseeki64(r->fp, 0, SEEK_END) != 0) {
+        membench_trace_close(r);
+        return NULL;
+    }
+    file_bytes = (uint64_t)_ftelli64(r->fp);
+#else
+    r->fd = open(path, O_RDONLY);
+    if (r->fd < 0) { free(r); return NULL; }
+    struct stat st;
+    if (fstat(r->fd, &st) != 0 ||
+        pread(r->fd, &r->header, sizeof(r->header), 0) != (ssize_t)sizeof(r->header)) {
+        membench_trace_close(r);
+        return NULL;
+    }
+    file_bytes = (uint64_t)st.st_size;
+#endif
+
+    if (!header_valid(&r->header) || file_bytes < r->header.header_bytes) {
+        membench_trace_close(r);
+        return NULL;
+    }
+
+    /* A producer that never finished leaves the count at 0 */
+    uint64_t on_disk = (file_bytes - r->header.header_bytes) / TRACE_REC;
+    if (r->header.num_records == 0 || r->header.num_records > on_disk)
+        r->header.num_records = on_disk;
+
+    if (membench_trace_rewind(r) != 0) {
+        membench_trace_close(r);
+        return NULL;
+    }
+    return r;
+}
+
+const membench_trace_header_t *membench_trace_info(const membench_trace_reader_t *r) {
+    return r ? &r->header : NULL;
+}
+
+size_t membench_trace_next(membench_trace_reader_t *r, const uint64_t **recs) {
+    if (!r || !recs || r->next >= r->header.num_records) return 0;
+
+    uint64_t left = r->header.num_records - r->next;
+    size_t n = TRACE_WINDOW / TRACE_REC;
+    if ((uint64_t)n > left) n = (size_t)left;
+    uint64_t pos = r->header.header_bytes + r->next * TRACE_REC;
+
+#if defined(TRACE_STDIO)
+    if (_fseeki64(r->fp, (long long)pos, SEEK_SET) != 0) return 0;
+    n = fread(r->buf, TRACE_REC, n, r->fp);
+    *recs = r->buf;
+#else
+    if (r->map) {
+        munmap(r->map, r->map_len);
+        r->map = NULL;
+    }
+    /* mmap offsets must be page-aligned; start the window a bit early */
+    uint64_t page = (uint64_t)sysconf(_SC_PAGESIZE);
+    uint64_t base = pos / page * page;
+    size_t lead = (size_t)(pos - base);
+    r->map_len = lead + n * TRACE_REC;
+    r->map = mmap(NULL, r->map_len, PROT_READ, MAP_PRIVATE, r->fd, (off_t)base);
+    if (r->map == MAP_FAILED) {
+        r->map = NULL;
+        return 0;
+    }
+#if defined(MADV_SEQUENTIAL)
+    madvise(r->map, r->map_len, MADV_SEQUENTIAL);
+#endif
+    *recs = (const uint64_t *)((const char *)r->map + lead);
+#endif
+
+    r->next += n;
+    return n;
+}
+
+int membench_trace_rewind(membench_trace_reader_t *r) {
+    if (!r) return -1;
+    r->next = 0;
+    return 0;
+}
+
+void membench_trace_close(membench_trace_reader_t *r) {
+    if (!r) return;
+#if defined(TRACE_STDIO)
+    if (r->fp) fclose(r->fp);
+    free(r->buf);
+#else
+    if (r->map) munmap(r->map, r->map_len);
+    if (r->fd >= 0) close(r->fd);
+#endif
+    free(r);
+}
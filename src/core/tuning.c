@@ -0,0 +1,131 @@
+/**
+ * tuning.c — Derive and write machine-specific tuning parameters.
+ *
+ * The rules are simple, so the output is easy to audit:
+ *
+ *   padding          one cache line
+ *   L1/L2 blocks     half the level, leaving room for everything else
+ *   prefetch         lines in flight to cover DRAM latency at one-core
+ *                    bandwidth (Little's law: latency x bandwidth / line)
+ *   threads          the fewest that reach 90% of the best bandwidth
+ *   NUMA             interleave when there is more than one node
+ *   NT stores        the smallest buffer from which streaming stores stay
+ *                    ahead of normal stores at every larger size
+ */
+#include "membench/tuning.h"
+
+#include <math.h>
+#include <stdio.h>
+
+#define TUNE_BW_FRACTION   0.9
+#define TUNE_MAX_PREFETCH  64
+
+void membench_tuning_derive(membench_tuning_t *t) {
+    if (!t) return;
+
+    size_t line = t->cache_line ? t->cache_line : 64;
+    t->pad_bytes = line;
+    t->l1_block_bytes = t->l1_bytes ? t->l1_bytes / 2 : 16 * 1024;
+    t->l2_block_bytes = t->l2_bytes ? t->l2_bytes / 2 : 128 * 1024;
+    t->l1_block_bytes -= t->l1_block_bytes % line;   /* detected sizes need not be round */
+    t->l2_block_bytes -= t->l2_block_bytes % line;
+
+    /* bytes/ns == GB/s, so latency x bandwidth is the bytes in flight */
+    double one_core = t->num_thread_points ? t->bw_gbps[0] : 0.0;
+    if (t->dram_latency_ns > 0.0 && one_core > 0.0) {
+        double lines = ceil(t->dram_latency_ns * one_core / (double)line);
+        if (lines < 1.0) lines = 1.0;
+        if (lines > TUNE_MAX_PREFETCH) lines = TUNE_MAX_PREFETCH;
+        t->prefetch_distance = (unsigned)lines;
+    } else {
+        t->prefetch_distance = 8;
+    }
+
+    double best = 0.0;
+    for (size_t i = 0; i < t->num_thread_points; i++)
+        if (t->bw_gbps[i] > best) best = t->bw_gbps[i];
+    t->bw_max_threads = 1;
+    for (size_t i = 0; i < t->num_thread_points; i++) {
+        if (t->bw_gbps[i] >= TUNE_BW_FRACTION * best) {
+            t->bw_max_threads = t->bw_threads[i];
+            break;
+        }
+    }
+
+    t->numa_policy = t->numa_nodes > 1 ? "interleave" : "none";
+
+    /* Walk down from the largest size while NT stores are still ahead */
+    t->nt_store_threshold = 0;
+    for (size_t i = t->num_store_points; i-- > 0; ) {
+        if (t->nt_store_gbps[i] <= t->store_gbps[i]) break;
+        t->nt_store_threshold = t->store_bytes[i];
+    }
+}
+
+int membench_tuning_write_header(const char *path, const membench_tuning_t *t) {
+    if (!path || !t) return -1;
+    FILE *f = fopen(path, "w");
+    if (!f) return -1;
+
+    fprintf(f, "/* Generated by membench --emit-tuning on: %s */\n", t->cpu_model);
+    fprintf(f, "#ifndef MEMBENCH_TUNE_H\n#define MEMBENCH_TUNE_H\n\n");
+    fprintf(f, "#define MEMBENCH_TUNE_CACHE_LINE          %zu\n",
+            t->cache_line ? t->cache_line : (size_t)64);
+    fprintf(f, "#define MEMBENCH_TUNE_PAD_BYTES           %zu\n", t->pad_bytes);
+    fprintf(f, "#define MEMBENCH_TUNE_L1_BLOCK_BYTES      %zu\n", t->l1_block_bytes);
+    fprintf(f, "#define MEMBENCH_TUNE_L2_BLOCK_BYTES      %zu\n", t->l2_block_bytes);
+    fprintf(f, "#define MEMBENCH_TUNE_PREFETCH_DISTANCE   %u  /* cache lines */\n",
+            t->prefetch_distance);
+    fprintf(f, "#define MEMBENCH_TUNE_BW_MAX_THREADS      %d\n", t->bw_max_threads);
+    fprintf(f, "#define MEMBENCH_TUNE_NUMA_NODES          %d\n", t->numa_nodes);
+    fprintf(f, "#define MEMBENCH_TUNE_NUMA_INTERLEAVE     %d\n", t->numa_nodes > 1);
+    fprintf(f, "#define MEMBENCH_TUNE_NT_STORE_THRESHOLD  %zu  /* bytes, 0 = never */\n",
+            t->nt_store_threshold);
+    fprintf(f, "\n#endif /* MEMBENCH_TUNE_H */\n");
+
+    return fclose(f) == 0 ? 0 : -1;
+}
+
+static void json_string(FILE *f, const char *s) {
+    fputc('"', f);
+    for (; *s; s++) {
+        if (*s == '"' || *s == '\\') fputc('\\', f);
+        if ((unsigned char)*s >= 0x20) fputc(*s, f);
+    }
+    fputc('"', f);
+}
+
+int membench_tuning_write_json(const char *path, const membench_tuning_t *t) {
+    if (!path || !t) return -1;
+    FILE *f = fopen(path, "w");
+    if (!f) return -1;
+
+    fprintf(f, "{\n  \"cpu\": ");
+    json_string(f, t->cpu_model);
+    fprintf(f, ",\n  \"parameters\": {\n");
+    fprintf(f, "    \"cache_line\": %zu,\n", t->cache_line ? t->cache_line : (size_t)64);
+    fprintf(f, "    \"pad_bytes\": %zu,\n", t->pad_bytes);
+    fprintf(f, "    \"l1_block_bytes\": %zu,\n", t->l1_block_bytes);
+    fprintf(f, "    \"l2_block_bytes\": %zu,\n", t->l2_block_bytes);
+    fprintf(f, "    \"prefetch_distance_lines\": %u,\n", t->prefetch_distance);
+    fprintf(f, "    \"bw_max_threads\": %d,\n", t->bw_max_threads);
+    fprintf(f, "    \"numa_policy\": \"%s\",\n", t->numa_policy ? t->numa_policy : "none");
+    fprintf(f, "    \"nt_store_threshold\": %zu\n", t->nt_store_threshold);
+    fprintf(f, "  },\n  \"measured\": {\n");
+    fprintf(f, "    \"l1_bytes\": %zu,\n", t->l1_bytes);
+    fprintf(f, "    \"l2_bytes\": %zu,\n", t->l2_bytes);
+    fprintf(f, "    \"l3_bytes\": %zu,\n", t->l3_bytes);
+    fprintf(f, "    \"dram_latency_ns\": %.2f,\n", t->dram_latency_ns);
+    fprintf(f, "    \"numa_nodes\": %d,\n", t->numa_nodes);
+    fprintf(f, "    \"bandwidth_by_threads\": [");
+    for (size_t i = 0; i < t->num_thread_points; i++)
+        fprintf(f, "%s{\"threads\": %d, \"gbps\": %.2f}", i ? ", " : "",
+                t->bw_threads[i], t->bw_gbps[i]);
+    fprintf(f, "],\n    \"store_bandwidth\": [");
+    for (size_t i = 0; i < t->num_store_points; i++)
+        fprintf(f, "%s{\"bytes\": %zu, \"store_gbps\": %.2f, \"nt_gbps\": %.2f}",
+                i ? ", " : "", t->store_bytes[i], t->store_gbps[i], t->nt_store_gbps[i]);
+    fprintf(f, "]\n  }\n}\n");
+
+    return fclose(f) == 0 ? 0 : -1;
+}
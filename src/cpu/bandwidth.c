@@ -8,10 +8,127 @@
 #include "membench/alloc.h"
 #include "membench/timer.h"
 #include "membench/platform.h"
+#include "membench/profile.h"
+#include "cpu_internal.h"
 
 #include <stdint.h>
 #include <string.h>
 
+#if defined(MEMBENCH_ARCH_X86_64)
+    #include <emmintrin.h>
+    #define HAVE_V128 1
+#elif defined(MEMBENCH_ARCH_ARM64)
+    #include <arm_neon.h>
+    #define HAVE_V128 1
+#endif
+
+/* ── Unrolled stream kernels ──────────────────────────────────────────────── */
+
+/*
+ * Read bandwidth sums the buffer.  With one accumulator and one loop test
+ * per element, an L1-resident stream is capped at one dependent add a
+ * cycle, well under what the load ports deliver.  The variants below are
+ * specialised at compile time for element width (64-bit scalar; 128-bit
+ * vectors where SSE2 or NEON is baseline) and unroll factor, and spread
+ * the sum over eight accumulators.  The run picks the widest element,
+ * then the largest unroll whose block fits in the buffer; the tail goes
+ * through the scalar single-step loop.
+ */
+typedef uint64_t (*stream_kernel_fn)(const void *buf, size_t blocks);
+
+#define U64_T            uint64_t
+#define U64_ZERO         0
+#define U64_STEP(k)      acc[(k) & 7] += q[k];
+#define U64_FOLD(acc, s) for (int a = 0; a < 8; a++) s += acc[a];
+#define U64_LOOP         SCALAR_LOOP
+#define U64_KEEP_STEP(k) SCALAR_KEEP_U64(acc[k]);
+#define U64_KEEP(acc)    UNROLL8(U64_KEEP_STEP, 0)
+
+#if defined(MEMBENCH_ARCH_X86_64)
+#define V128_T           __m128i
+#define V128_ZERO        _mm_setzero_si128()
+#define V128_STEP(k)     acc[(k) & 7] = _mm_add_epi64(acc[(k) & 7], _mm_loadu_si128(q + (k)));
+#define V128_FOLD(acc, s)                                                     \
+    for (int a = 1; a < 8; a++) acc[0] = _mm_add_epi64(acc[0], acc[a]);      \
+    uint64_t lanes[2];                                                        \
+    _mm_storeu_si128((__m128i *)lanes, acc[0]);                               \
+    s = lanes[0] + lanes[1];
+#elif defined(MEMBENCH_ARCH_ARM64)
+#define V128_T           uint64x2_t
+#define V128_ZERO        vdupq_n_u64(0)
+#define V128_STEP(k)     acc[(k) & 7] = vaddq_u64(acc[(k) & 7],                 \
+                                                  vld1q_u64((const uint64_t *)(q + (k))));
+#define V128_FOLD(acc, s)                                                     \
+    for (int a = 1; a < 8; a++) acc[0] = vaddq_u64(acc[0], acc[a]);          \
+    s = vgetq_lane_u64(acc[0], 0) + vgetq_lane_u64(acc[0], 1);
+#endif
+#define V128_LOOP
+#define V128_KEEP(acc)
+
+/* The scalar variants stay scalar, past both the loop and the SLP
+ * vectorisers: the vector ones are the wider widths */
+#define DEFINE_STREAM_KERNEL(P, U, ATTR)                                      \
+    ATTR static uint64_t stream_##P##_x##U(const void *buf, size_t blocks) {  \
+        const P##_T *q = (const P##_T *)buf;                                  \
+        P##_T acc[8];                                                         \
+        uint64_t s = 0;                                                       \
+        for (int a = 0; a < 8; a++) acc[a] = P##_ZERO;                        \
+        P##_LOOP                                                              \
+        for (size_t b = 0; b < blocks; b++, q += U) {                         \
+            UNROLL##U(P##_STEP, 0)                                            \
+            P##_KEEP(acc)                                                     \
+        }                                                                     \
+        P##_FOLD(acc, s)                                                      \
+        return s;                                                             \
+    }
+
+DEFINE_STREAM_KERNEL(U64, 1, MEMBENCH_NO_VECTORIZE)
+DEFINE_STREAM_KERNEL(U64, 4, MEMBENCH_NO_VECTORIZE)
+DEFINE_STREAM_KERNEL(U64, 8, MEMBENCH_NO_VECTORIZE)
+DEFINE_STREAM_KERNEL(U64, 16, MEMBENCH_NO_VECTORIZE)
+DEFINE_STREAM_KERNEL(U64, 32, MEMBENCH_NO_VECTORIZE)
+#if defined(HAVE_V128)
+DEFINE_STREAM_KERNEL(V128, 1, )
+DEFINE_STREAM_KERNEL(V128, 4, )
+DEFINE_STREAM_KERNEL(V128, 8, )
+DEFINE_STREAM_KERNEL(V128, 16, )
+DEFINE_STREAM_KERNEL(V128, 32, )
+#endif
+
+static const struct {
+    size_t width;                      /* bytes per element */
+    size_t unroll;
+    stream_kernel_fn fn;
+    const char *name;
+} STREAM_KERNELS[] = {
+#if defined(HAVE_V128)
+    { 16, 32, stream_V128_x32, "stream-v128x32" },
+    { 16, 16, stream_V128_x16, "stream-v128x16" },
+    { 16,  8, stream_V128_x8,  "stream-v128x8"  },
+    { 16,  4, stream_V128_x4,  "stream-v128x4"  },
+    { 16,  1, stream_V128_x1,  "stream-v128x1"  },
+#endif
+    {  8, 32, stream_U64_x32,  "stream-u64x32"  },
+    {  8, 16, stream_U64_x16,  "stream-u64x16"  },
+    {  8,  8, stream_U64_x8,   "stream-u64x8"   },
+    {  8,  4, stream_U64_x4,   "stream-u64x4"   },
+    {  8,  1, stream_U64_x1,   "stream-u64x1"   },
+};
+#define NUM_STREAM_KERNELS (sizeof(STREAM_KERNELS) / sizeof(STREAM_KERNELS[0]))
+
+/* First (widest, most unrolled) variant with a whole block in `bytes` */
+static size_t pick_stream_kernel(size_t bytes) {
+    size_t k = 0;
+    while (k + 1 < NUM_STREAM_KERNELS
+           && STREAM_KERNELS[k].width * STREAM_KERNELS[k].unroll > bytes) k++;
+    return k;
+}
+
+const char *stream_kernel_name(size_t buffer_size) {
+    return STREAM_KERNELS[pick_stream_kernel(buffer_size / sizeof(uint64_t)
+                                             * sizeof(uint64_t))].name;
+}
+
 /* ── Sequential read bandwidth ────────────────────────────────────────────── */
 
 int membench_cpu_read_bandwidth(size_t buffer_size, uint64_t iterations,
@@ -22,13 +139,16 @@ int membench_cpu_read_bandwidth(size_t buffer_size, uint64_t iterations,
     size_t count = buffer_size / sizeof(uint64_t);
     if (count == 0) return -1;
 
+    uint64_t t = membench_timer_ns();
     uint64_t *buf = (uint64_t *)membench_alloc(count * sizeof(uint64_t));
     if (!buf) return -1;
+    t = membench_phase_mark(MEMBENCH_PHASE_ALLOC, t);
 
     /* Initialize with non-zero pattern */
     for (size_t i = 0; i < count; i++) {
         buf[i] = (uint64_t)i;
     }
+    t = membench_phase_mark(MEMBENCH_PHASE_BUILD, t);
 
     /* Warmup pass */
     {
@@ -38,30 +158,41 @@ int membench_cpu_read_bandwidth(size_t buffer_size, uint64_t iterations,
         }
         (void)sink;
     }
+    membench_phase_mark(MEMBENCH_PHASE_WARMUP, t);
+
+    size_t bytes = count * sizeof(uint64_t);
+    size_t k = pick_stream_kernel(bytes);
+    size_t block = STREAM_KERNELS[k].width * STREAM_KERNELS[k].unroll;
+    size_t blocks = bytes / block;
+    size_t tail = (bytes - blocks * block) / sizeof(uint64_t);
+    stream_kernel_fn fn = STREAM_KERNELS[k].fn;
 
     uint64_t total_bytes = iterations * count * sizeof(uint64_t);
     volatile uint64_t sink = 0;
+    /* Re-read every pass, so the compiler cannot prove the passes alike */
+    const uint64_t *volatile vbuf = buf;
 
     uint64_t start = membench_timer_ns();
 
     for (uint64_t iter = 0; iter < iterations; iter++) {
-        uint64_t local_sum = 0;
-        for (size_t i = 0; i < count; i++) {
-            local_sum += buf[i];
-        }
+        const uint64_t *p = vbuf;
+        uint64_t local_sum = fn(p, blocks);
+        local_sum += stream_U64_x1(p + blocks * block / sizeof(uint64_t), tail);
         sink += local_sum; /* prevent dead-code elimination */
     }
 
     uint64_t end = membench_timer_ns();
     (void)sink;
+    membench_phase_span(MEMBENCH_PHASE_MEASURE, start, end);
 
-    double elapsed_s = (double)(end - start) / 1e9;
     result->buffer_size = buffer_size;
-    result->bandwidth_gbps = ((double)total_bytes / (1024.0 * 1024.0 * 1024.0)) / elapsed_s;
+    result->bandwidth_gbps = membench_gbps((double)total_bytes, (double)(end - start));
     result->bytes_moved = total_bytes;
     result->avg_latency_ns = (double)(end - start) / (double)(iterations * count);
+    result->kernel = STREAM_KERNELS[k].name;
 
     membench_free(buf, count * sizeof(uint64_t));
+    membench_phase_mark(MEMBENCH_PHASE_FREE, end);
     return 0;
 }
 
@@ -74,13 +205,16 @@ int membench_cpu_write_bandwidth(size_t buffer_size, uint64_t iterations,
     size_t count = buffer_size / sizeof(uint64_t);
     if (count == 0) return -1;
 
+    uint64_t t = membench_timer_ns();
     uint64_t *buf = (uint64_t *)membench_alloc(count * sizeof(uint64_t));
     if (!buf) return -1;
+    t = membench_phase_mark(MEMBENCH_PHASE_ALLOC, t);
 
     /* Warmup pass */
     for (size_t i = 0; i < count; i++) {
         buf[i] = 0;
     }
+    membench_phase_mark(MEMBENCH_PHASE_WARMUP, t);
 
     uint64_t total_bytes = iterations * count * sizeof(uint64_t);
 
@@ -97,13 +231,84 @@ int membench_cpu_write_bandwidth(size_t buffer_size, uint64_t iterations,
     /* Read one value back to prevent compiler from removing writes entirely */
     volatile uint64_t check = buf[count / 2];
     (void)check;
+    membench_phase_span(MEMBENCH_PHASE_MEASURE, start, end);
+
+    result->buffer_size = buffer_size;
+    result->bandwidth_gbps = membench_gbps((double)total_bytes, (double)(end - start));
+    result->bytes_moved = total_bytes;
+    result->avg_latency_ns = (double)(end - start) / (double)(iterations * count);
+    result->kernel = NULL;
+
+    membench_free(buf, count * sizeof(uint64_t));
+    membench_phase_mark(MEMBENCH_PHASE_FREE, end);
+    return 0;
+}
+
+/* ── Non-temporal write bandwidth ─────────────────────────────────────────── */
+
+/*
+ * Streaming stores write combine in the fill buffers and go straight to
+ * memory, skipping the read-for-ownership of a normal store.  That wins
+ * once the buffer is far larger than the caches and loses while it fits.
+ */
+static int nt_fill(uint64_t *buf, size_t count, uint64_t v) {
+#if defined(MEMBENCH_ARCH_X86_64)
+    __m128i x = _mm_set1_epi64x((long long)v);
+    for (size_t i = 0; i < count; i += 2)
+        _mm_stream_si128((__m128i *)(buf + i), x);
+    _mm_sfence();
+    return 0;
+#elif defined(MEMBENCH_ARCH_ARM64) && !defined(_MSC_VER)
+    for (size_t i = 0; i < count; i += 2)
+        __asm__ __volatile__("stnp %0, %0, [%1]" :: "r"(v), "r"(buf + i) : "memory");
+    __asm__ __volatile__("dmb ish" ::: "memory");
+    return 0;
+#else
+    (void)buf; (void)count; (void)v;
+    return -1;
+#endif
+}
+
+int membench_cpu_nt_write_bandwidth(size_t buffer_size, uint64_t iterations,
+                                    membench_bandwidth_result_t *result) {
+    if (!result || buffer_size == 0) return -1;
+
+    /* Whole 16-byte pairs; membench_alloc is page-aligned */
+    size_t count = buffer_size / sizeof(uint64_t) / 2 * 2;
+    if (count == 0) return -1;
+
+    uint64_t t = membench_timer_ns();
+    uint64_t *buf = (uint64_t *)membench_alloc(count * sizeof(uint64_t));
+    if (!buf) return -1;
+    t = membench_phase_mark(MEMBENCH_PHASE_ALLOC, t);
+
+    /* Warmup pass, also tells us whether the ISA has streaming stores */
+    if (nt_fill(buf, count, 0) != 0) {
+        membench_free(buf, count * sizeof(uint64_t));
+        return -1;
+    }
+    membench_phase_mark(MEMBENCH_PHASE_WARMUP, t);
+
+    uint64_t total_bytes = iterations * count * sizeof(uint64_t);
+
+    uint64_t start = membench_timer_ns();
+
+    for (uint64_t iter = 0; iter < iterations; iter++)
+        nt_fill(buf, count, iter);
+
+    uint64_t end = membench_timer_ns();
+
+    volatile uint64_t check = buf[count / 2];
+    (void)check;
+    membench_phase_span(MEMBENCH_PHASE_MEASURE, start, end);
 
-    double elapsed_s = (double)(end - start) / 1e9;
     result->buffer_size = buffer_size;
-    result->bandwidth_gbps = ((double)total_bytes / (1024.0 * 1024.0 * 1024.0)) / elapsed_s;
+    result->bandwidth_gbps = membench_gbps((double)total_bytes, (double)(end - start));
     result->bytes_moved = total_bytes;
     result->avg_latency_ns = (double)(end - start) / (double)(iterations * count);
+    result->kernel = NULL;
 
     membench_free(buf, count * sizeof(uint64_t));
+    membench_phase_mark(MEMBENCH_PHASE_FREE, end);
     return 0;
 }
@@ -0,0 +1,308 @@
+/**
+ * btree.c — B+tree node-size sweep.
+ *
+ * Bulk-loads an in-memory B+tree of 64-bit keys and values with a given
+ * node size (64 B .. 16 KB) and working-set size, then times:
+ *
+ *   - point lookups: a dependent chain of root-to-leaf descents, each
+ *     node searched with a branchless binary search;
+ *   - range scans: descend to a random key, then walk SCAN_KEYS entries
+ *     along the leaf chain.
+ *
+ * Small nodes mean more levels (more dependent misses) but cheap in-node
+ * search; large nodes mean fewer levels but more lines touched per node.
+ * Where the optimum lands depends on which cache level the tree fits in,
+ * so membench_cpu_btree_tiers() derives the working-set sizes from the
+ * cache-detect result.
+ *
+ * Node layout (all words uint64_t, `cap` = (node_bytes / 8 - 2) / 2):
+ *   word[0]          entry count
+ *   word[1]          leaf: next leaf pointer, internal: unused
+ *   word[2 .. ]      cap keys (internal: separator i = min key of child i+1)
+ *   word[2+cap .. ]  cap values (leaf) or child pointers (internal)
+ *
+ * Nodes are filled to BTREE_FILL_PCT percent, typical of a tree that has
+ * seen random inserts, and stored level by level with leaves in key order.
+ */
+#include "membench/bench_cpu.h"
+#include "membench/alloc.h"
+#include "membench/timer.h"
+#include "membench/platform.h"
+#include "cpu_internal.h"
+
+#include <string.h>
+
+#define BTREE_FILL_PCT   70
+#define BTREE_MAX_LEVELS 32
+#define SCAN_KEYS        256
+
+typedef struct {
+    uint64_t *arena;
+    size_t    arena_bytes;
+    size_t    node_words;
+    size_t    cap;
+    const uint64_t *root;
+    int       height;
+    uint64_t  dep_mask;   /* always 0; loaded through volatile */
+} btree_t;
+
+MEMBENCH_INLINE uint64_t key_at(size_t i) {
+    return 2 * (uint64_t)i + 1;
+}
+
+/** Number of keys in k[0..n) that are <= x. */
+MEMBENCH_INLINE size_t upper_bound_u64(const uint64_t *k, size_t n, uint64_t x) {
+    size_t lo = 0;
+    while (n > 0) {
+        size_t half = n / 2;
+        int go = k[lo + half] <= x;
+        lo  = go ? lo + half + 1 : lo;
+        n   = go ? n - half - 1 : half;
+    }
+    return lo;
+}
+
+/** Number of keys in k[0..n) that are < x. */
+MEMBENCH_INLINE size_t lower_bound_u64(const uint64_t *k, size_t n, uint64_t x) {
+    size_t lo = 0;
+    while (n > 0) {
+        size_t half = n / 2;
+        int go = k[lo + half] < x;
+        lo  = go ? lo + half + 1 : lo;
+        n   = go ? n - half - 1 : half;
+    }
+    return lo;
+}
+
+/** Descend to the leaf that holds x; returns the leaf and the slot in *pos. */
+MEMBENCH_INLINE const uint64_t *find_leaf(const btree_t *t, uint64_t x, size_t *pos) {
+    const uint64_t *node = t->root;
+    for (int h = t->height - 1; h > 0; h--) {
+        size_t i = upper_bound_u64(node + 2, (size_t)node[0], x);
+        node = (const uint64_t *)(uintptr_t)node[2 + t->cap + i];
+    }
+    *pos = lower_bound_u64(node + 2, (size_t)node[0], x);
+    return node;
+}
+
+static int btree_build(btree_t *t, size_t node_bytes, size_t n) {
+    t->node_words = node_bytes / sizeof(uint64_t);
+    t->cap = (t->node_words - 2) / 2;
+    if (t->cap < 2) return -1;
+
+    size_t fill = t->cap * BTREE_FILL_PCT / 100;
+    if (fill < 2) fill = 2;
+
+    size_t count[BTREE_MAX_LEVELS];
+    count[0] = (n + fill - 1) / fill;
+    int levels = 1;
+    while (count[levels - 1] > 1) {
+        if (levels == BTREE_MAX_LEVELS) return -1;
+        count[levels] = (count[levels - 1] + fill - 1) / fill;
+        levels++;
+    }
+
+    size_t total = 0;
+    for (int h = 0; h < levels; h++) total += count[h];
+    t->arena_bytes = total * node_bytes;
+    t->arena = (uint64_t *)membench_alloc(t->arena_bytes);
+    if (!t->arena) return -1;
+
+    /* Root first, leaves last */
+    uint64_t *level_base[BTREE_MAX_LEVELS];
+    size_t off = 0;
+    for (int h = levels - 1; h >= 0; h--) {
+        level_base[h] = t->arena + off;
+        off += count[h] * t->node_words;
+    }
+
+    /* Leaves: `fill` consecutive keys each, linked in key order */
+    for (size_t j = 0; j < count[0]; j++) {
+        uint64_t *leaf = level_base[0] + j * t->node_words;
+        size_t first = j * fill;
+        size_t m = (n - first < fill) ? n - first : fill;
+        leaf[0] = m;
+        leaf[1] = (j + 1 < count[0])
+                  ? (uint64_t)(uintptr_t)(leaf + t->node_words) : 0;
+        for (size_t i = 0; i < m; i++) {
+            leaf[2 + i] = key_at(first + i);
+            leaf[2 + t->cap + i] = key_at(first + i) ^ 0x5A5A5A5AULL;
+        }
+    }
+
+    /* Internal levels: child c of node j at level h is node j*fill + c of
+     * level h-1, whose smallest key is that of leaf (j*fill + c) * span. */
+    size_t span = 1;
+    for (int h = 1; h < levels; h++) {
+        for (size_t j = 0; j < count[h]; j++) {
+            uint64_t *node = level_base[h] + j * t->node_words;
+            size_t first = j * fill;
+            size_t m = (count[h - 1] - first < fill) ? count[h - 1] - first : fill;
+            node[0] = m - 1;
+            node[1] = 0;
+            for (size_t c = 0; c < m; c++) {
+                if (c > 0) node[2 + c - 1] = key_at((first + c) * span * fill);
+                node[2 + t->cap + c] =
+                    (uint64_t)(uintptr_t)(level_base[h - 1] + (first + c) * t->node_words);
+            }
+        }
+        span *= fill;
+    }
+
+    t->root = level_base[levels - 1];
+    t->height = levels;
+    return 0;
+}
+
+static uint64_t lookup_chain(const btree_t *t, const uint64_t *q, size_t nq,
+                             uint64_t n) {
+    uint64_t r = 0;
+    size_t i = 0;
+    for (uint64_t k = 0; k < n; k++) {
+        size_t pos;
+        const uint64_t *leaf = find_leaf(t, q[i] ^ (r & t->dep_mask), &pos);
+        r = leaf[2 + t->cap + pos];
+        if (++i == nq) i = 0;
+    }
+    return r;
+}
+
+static uint64_t scan_loop(const btree_t *t, const uint64_t *q, size_t nq,
+                          uint64_t scans) {
+    uint64_t sum = 0;
+    size_t i = 0;
+    for (uint64_t s = 0; s < scans; s++) {
+        size_t pos;
+        const uint64_t *leaf = find_leaf(t, q[i], &pos);
+        for (size_t got = 0; got < SCAN_KEYS && leaf; ) {
+            size_t m = (size_t)leaf[0];
+            for (; pos < m && got < SCAN_KEYS; pos++, got++)
+                sum += leaf[2 + t->cap + pos];
+            leaf = (const uint64_t *)(uintptr_t)leaf[1];
+            pos = 0;
+        }
+        if (++i == nq) i = 0;
+    }
+    return sum;
+}
+
+/* ── Public API ───────────────────────────────────────────────────────────── */
+
+int membench_cpu_btree(size_t node_bytes, size_t tree_bytes, uint64_t lookups,
+                       membench_btree_result_t *result) {
+    if (!result || lookups == 0) return -1;
+    if (node_bytes < 64 || (node_bytes & (node_bytes - 1)) != 0) return -1;
+    if (tree_bytes < 4 * node_bytes) return -1;
+
+    size_t cap = (node_bytes / sizeof(uint64_t) - 2) / 2;
+    size_t fill = cap * BTREE_FILL_PCT / 100;
+    if (fill < 2) fill = 2;
+    /* Internal levels add 1/fill + 1/fill^2 + ... of the leaf count, so
+     * size the leaf level to keep the whole tree near tree_bytes. */
+    size_t leaves = (tree_bytes / node_bytes) * (fill - 1) / fill;
+    if (leaves < 2) leaves = 2;
+    size_t n = leaves * fill;
+
+    btree_t t;
+    memset(&t, 0, sizeof(t));
+    if (btree_build(&t, node_bytes, n) != 0) return -1;
+
+    size_t nq = n < (1u << 20) ? n : (1u << 20);
+    size_t q_bytes = nq * sizeof(uint64_t);
+    uint64_t *q = (uint64_t *)membench_alloc(q_bytes);
+    if (!q) { membench_free(t.arena, t.arena_bytes); return -1; }
+
+    uint64_t rng = 42;
+    for (size_t i = 0; i < nq; i++) q[i] = key_at((size_t)rng_below(&rng, n));
+
+    t.dep_mask = *(volatile uint64_t *)&t.dep_mask;
+
+    /* Warmup and sanity check: every query must land on its key */
+    for (size_t i = 0; i < nq; i++) {
+        size_t pos;
+        const uint64_t *leaf = find_leaf(&t, q[i], &pos);
+        if (pos >= leaf[0] || leaf[2 + pos] != q[i]) {
+            membench_free(q, q_bytes);
+            membench_free(t.arena, t.arena_bytes);
+            return -1;
+        }
+    }
+
+    memory_fence();
+    uint64_t start = membench_timer_ns();
+    uint64_t r = lookup_chain(&t, q, nq, lookups);
+    memory_fence();
+    uint64_t mid = membench_timer_ns();
+
+    uint64_t scans = lookups / 16 ? lookups / 16 : 1;
+    memory_fence();
+    uint64_t scan_start = membench_timer_ns();
+    r += scan_loop(&t, q, nq, scans);
+    memory_fence();
+    uint64_t end = membench_timer_ns();
+
+    volatile uint64_t sink = r;
+    (void)sink;
+
+    result->node_bytes = node_bytes;
+    result->tree_bytes = t.arena_bytes;
+    result->num_keys = n;
+    result->height = t.height;
+    result->lookup_ns = (double)(mid - start) / (double)lookups;
+    result->scan_ns_per_key = (double)(end - scan_start) /
+                              (double)(scans * SCAN_KEYS);
+    result->lookups = lookups;
+
+    membench_free(q, q_bytes);
+    membench_free(t.arena, t.arena_bytes);
+    return 0;
+}
+
+size_t membench_cpu_btree_tiers(const membench_cache_info_t *cache,
+                                membench_btree_tier_t tiers[MEMBENCH_BTREE_MAX_TIERS]) {
+    if (!cache || !tiers) return 0;
+
+    /* Half of each level leaves room for the query stream and the
+     * neighbouring level's residue; DRAM is well past the last level. */
+    const size_t levels[3] = {
+        cache->l1_size_bytes, cache->l2_size_bytes, cache->l3_size_bytes
+    };
+    static const char *const names[MEMBENCH_BTREE_MAX_TIERS] = {
+        "L1", "L2", "L3", "DRAM"
+    };
+
+    size_t n = 0, largest = 0;
+    for (int i = 0; i < 3; i++) {
+        if (levels[i] == 0 || levels[i] <= largest) continue;
+        tiers[n].name = names[i];
+        tiers[n].tree_bytes = levels[i] / 2;
+        n++;
+        largest = levels[i];
+    }
+    size_t dram = largest * 8;
+    if (dram < (size_t)256 * 1024 * 1024) dram = (size_t)256 * 1024 * 1024;
+    tiers[n].name = names[3];
+    tiers[n].tree_bytes = dram;
+    n++;
+
+    for (size_t i = 0; i < n; i++) {
+        tiers[i].best_lookup_node = 0;
+        tiers[i].best_scan_node = 0;
+        tiers[i].best_lookup_ns = 0.0;
+        tiers[i].best_scan_ns_per_key = 0.0;
+    }
+    return n;
+}
+
+void membench_btree_tier_update(membench_btree_tier_t *tier,
+                                const membench_btree_result_t *r) {
+    if (!tier || !r) return;
+    if (tier->best_lookup_node == 0 || r->lookup_ns < tier->best_lookup_ns) {
+        tier->best_lookup_node = r->node_bytes;
+        tier->best_lookup_ns = r->lookup_ns;
+    }
+    if (tier->best_scan_node == 0 || r->scan_ns_per_key < tier->best_scan_ns_per_key) {
+        tier->best_scan_node = r->node_bytes;
+        tier->best_scan_ns_per_key = r->scan_ns_per_key;
+    }
+}
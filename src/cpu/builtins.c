@@ -0,0 +1,96 @@
+/**
+ * builtins.c — Registry entries for the core latency and bandwidth tests.
+ *
+ * Each entry wraps one of the membench_cpu_* functions.  Those allocate,
+ * warm up and time their own loop, so the entries are marked self-timed
+ * and report the function's own elapsed time rather than the harness's
+ * (which would include allocation).
+ */
+#include "membench/bench_cpu.h"
+#include "membench/registry.h"
+#include "cpu_internal.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+typedef int (*latency_fn)(size_t, uint64_t, membench_latency_result_t *);
+typedef int (*bandwidth_fn)(size_t, uint64_t, membench_bandwidth_result_t *);
+
+static int size_setup(size_t buffer_size, void **state) {
+    size_t *s = (size_t *)malloc(sizeof(size_t));
+    if (!s) return -1;
+    *s = buffer_size;
+    *state = s;
+    return 0;
+}
+
+static void size_teardown(void *state) {
+    free(state);
+}
+
+static int run_latency(latency_fn fn, void *state, uint64_t iterations,
+                       membench_bench_metrics_t *m) {
+    membench_latency_result_t r = {0};
+    if (fn(*(size_t *)state, iterations, &r) != 0) return -1;
+    m->ops = r.accesses;
+    m->elapsed_ns = (uint64_t)(r.avg_latency_ns * (double)r.accesses + 0.5);
+    return 0;
+}
+
+static int run_bandwidth(bandwidth_fn fn, void *state, uint64_t iterations,
+                         membench_bench_metrics_t *m) {
+    membench_bandwidth_result_t r = {0};
+    if (fn(*(size_t *)state, iterations, &r) != 0) return -1;
+    m->bytes = r.bytes_moved;
+    m->ops = r.bytes_moved / sizeof(uint64_t);
+    m->elapsed_ns = (uint64_t)(r.avg_latency_ns * (double)m->ops + 0.5);
+    return 0;
+}
+
+static int read_latency_run(void *s, uint64_t it, membench_bench_metrics_t *m) {
+    return run_latency(membench_cpu_read_latency, s, it, m);
+}
+static int write_latency_run(void *s, uint64_t it, membench_bench_metrics_t *m) {
+    return run_latency(membench_cpu_write_latency, s, it, m);
+}
+static int read_bw_run(void *s, uint64_t it, membench_bench_metrics_t *m) {
+    return run_bandwidth(membench_cpu_read_bandwidth, s, it, m);
+}
+static int write_bw_run(void *s, uint64_t it, membench_bench_metrics_t *m) {
+    return run_bandwidth(membench_cpu_write_bandwidth, s, it, m);
+}
+
+static const membench_bench_t BUILTINS[] = {
+    { "read-latency",  "Read Latency",  MEMBENCH_BENCH_LATENCY,   MEMBENCH_BENCH_SELF_TIMED,
+      size_setup, read_latency_run,  size_teardown },
+    { "write-latency", "Write Latency", MEMBENCH_BENCH_LATENCY,   MEMBENCH_BENCH_SELF_TIMED,
+      size_setup, write_latency_run, size_teardown },
+    { "read-bw",       "Read BW",       MEMBENCH_BENCH_BANDWIDTH, MEMBENCH_BENCH_SELF_TIMED,
+      size_setup, read_bw_run,       size_teardown },
+    { "write-bw",      "Write BW",      MEMBENCH_BENCH_BANDWIDTH, MEMBENCH_BENCH_SELF_TIMED,
+      size_setup, write_bw_run,      size_teardown },
+};
+
+#define AUTO_LATENCY_ACCESSES 20000000ULL
+#define AUTO_BW_ELEMENTS      5000000ULL
+
+uint64_t membench_cpu_auto_iterations(size_t buffer_size, int is_latency) {
+    size_t elems = buffer_size / (is_latency ? membench_get_cache_line_size()
+                                             : sizeof(uint64_t));
+    if (elems == 0) elems = 1;
+    uint64_t iters = (is_latency ? AUTO_LATENCY_ACCESSES : AUTO_BW_ELEMENTS) / elems;
+    return iters < 2 ? 2 : iters;
+}
+
+const char *membench_cpu_kernel_name(const char *bench, size_t buffer_size) {
+    if (!bench) return NULL;
+    if (strcmp(bench, "read-latency") == 0) return chase_kernel_name(buffer_size);
+    if (strcmp(bench, "read-bw") == 0) return stream_kernel_name(buffer_size);
+    return NULL;
+}
+
+int membench_cpu_register_builtins(void) {
+    for (size_t i = 0; i < sizeof(BUILTINS) / sizeof(BUILTINS[0]); i++)
+        if (membench_registry_add(&BUILTINS[i]) != 0) return -1;
+    return 0;
+}
@@ -28,9 +28,12 @@
 #include "membench/bench_cpu.h"
 #include "membench/alloc.h"
 #include "membench/timer.h"
+#include "membench/checkpoint.h"
+#include "membench/profile.h"
+#include "membench/timeline.h"
 #include "membench/platform.h"
+#include "cpu_internal.h"
 
-#include <stdio.h>
 #include <stdlib.h>
 #include <math.h>
 
@@ -39,37 +42,39 @@
     #define WIN32_LEAN_AND_MEAN
     #include <windows.h>
 #elif defined(MEMBENCH_PLATFORM_LINUX)
-    #define _GNU_SOURCE
-    #include <sched.h>
+    #include <sched.h>  /* _GNU_SOURCE is set by the build */
 #elif defined(MEMBENCH_PLATFORM_MACOS)
     #include <pthread.h>
     #include <sys/sysctl.h>
 #endif
 
-/* ── Test sizes: logarithmic sweep from 1 KB to 512 MB ───────────────────── */
+/* ── Test sizes: logarithmic sweep from 1 KB to MEMBENCH_DETECT_MAX_BYTES ── */
 
 #define MIN_SIZE_KB    1
-#define MAX_SIZE_KB    (512 * 1024)  /* 512 MB */
 #define STEPS_PER_OCTAVE 4           /* 4 points per doubling */
 
-static size_t generate_sizes(size_t **out_sizes) {
+size_t membench_cpu_generate_sizes(size_t min_bytes, size_t max_bytes,
+                                   int steps_per_octave, size_t **out_sizes) {
+    if (!out_sizes || min_bytes == 0 || steps_per_octave < 1) return 0;
+
     size_t count = 0;
-    double sz = MIN_SIZE_KB;
-    double factor = pow(2.0, 1.0 / STEPS_PER_OCTAVE);
+    double sz = (double)min_bytes;
+    double factor = pow(2.0, 1.0 / steps_per_octave);
 
-    while (sz <= MAX_SIZE_KB) {
+    while (sz <= (double)max_bytes) {
         count++;
         sz *= factor;
     }
+    if (count == 0) return 0;
 
     *out_sizes = (size_t *)malloc(count * sizeof(size_t));
     if (!*out_sizes) return 0;
 
-    sz = MIN_SIZE_KB;
+    sz = (double)min_bytes;
     size_t prev = 0;
     size_t actual = 0;
     for (size_t i = 0; i < count; i++) {
-        size_t bytes = (size_t)(sz * 1024.0);  /* multiply BEFORE cast */
+        size_t bytes = (size_t)sz;
         sz *= factor;
         if (bytes == prev) continue;           /* skip duplicate sizes */
         prev = bytes;
@@ -78,6 +83,11 @@ static size_t generate_sizes(size_t **out_sizes) {
     return actual;
 }
 
+static size_t generate_sizes(size_t max_bytes, size_t **out_sizes) {
+    return membench_cpu_generate_sizes((size_t)MIN_SIZE_KB * 1024, max_bytes,
+                                       STEPS_PER_OCTAVE, out_sizes);
+}
+
 /**
  * Auto-iteration count: ensure enough total accesses so wall-clock time
  * is well above timer granularity. For cache detection we use cache-line
@@ -92,15 +102,17 @@ static size_t get_cache_line_size_cd(void) {
     return 64;
 }
 
-static uint64_t auto_iterations(size_t buffer_size) {
+#define DEFAULT_VISITS 100000000ULL
+
+static uint64_t auto_iterations(size_t buffer_size, uint64_t visits) {
     size_t cl = get_cache_line_size_cd();
     size_t nodes = buffer_size / cl;
     if (nodes == 0) nodes = 1;
     /*
-     * Target ~100 million node-visits per measurement.
+     * Target `visits` (default ~100 million) node-visits per measurement.
      * Tiny buffers (L1) need many iterations; large buffers (DRAM) need few.
      */
-    uint64_t iters = 100000000ULL / nodes;
+    uint64_t iters = visits / nodes;
     if (iters < 4) iters = 4;
     return iters;
 }
@@ -131,8 +143,8 @@ static double median_of(const double *arr, size_t n) {
  * underestimated cache sizes because the forward-looking derivative
  * window detected transitions W samples too early.
  */
-static void detect_boundaries(const size_t *sizes, const double *latencies,
-                              size_t n, membench_cache_info_t *info) {
+void detect_boundaries(const size_t *sizes, const double *latencies,
+                       size_t n, membench_cache_info_t *info) {
     info->l1_size_bytes = 0;
     info->l2_size_bytes = 0;
     info->l3_size_bytes = 0;
@@ -323,23 +335,38 @@ cleanup:
 /* ── Public API ───────────────────────────────────────────────────────────── */
 
 int membench_cpu_detect_cache(membench_cache_info_t *info) {
+    return membench_cpu_detect_cache_range(MEMBENCH_DETECT_MAX_BYTES, 0, info);
+}
+
+int membench_cpu_detect_cache_range(size_t max_bytes, uint64_t visits,
+                                    membench_cache_info_t *info) {
+    return detect_cache_sweep(max_bytes, visits, MEMBENCH_CHASE_SEED, 0, info);
+}
+
+int detect_cache_sweep(size_t max_bytes, uint64_t visits, uint64_t seed,
+                       int pin_cpu, membench_cache_info_t *info) {
     if (!info) return -1;
+    if (visits == 0) visits = DEFAULT_VISITS;
 
     size_t *sizes = NULL;
-    size_t num = generate_sizes(&sizes);
+    size_t num = generate_sizes(max_bytes, &sizes);
     if (num == 0 || !sizes) return -1;
 
     double *latencies = (double *)malloc(num * sizeof(double));
     if (!latencies) { free(sizes); return -1; }
 
-    /* Pin to core 0 so all measurements use the same L1/L2 (per-core caches)
-     * and we avoid migration-induced noise. */
+    /* Pin to one core so all measurements use the same L1/L2 (per-core
+     * caches) and we avoid migration-induced noise. */
 #if defined(MEMBENCH_PLATFORM_WINDOWS)
-    DWORD_PTR old_affinity = SetThreadAffinityMask(GetCurrentThread(), 1);
+    if (pin_cpu < 0) pin_cpu = (int)GetCurrentProcessorNumber();
+    DWORD_PTR old_affinity = pin_cpu < (int)(sizeof(DWORD_PTR) * 8)
+        ? SetThreadAffinityMask(GetCurrentThread(), (DWORD_PTR)1 << pin_cpu) : 0;
 #elif defined(MEMBENCH_PLATFORM_LINUX)
+    if (pin_cpu < 0) pin_cpu = sched_getcpu();
+    if (pin_cpu < 0) pin_cpu = 0;
     cpu_set_t old_mask, new_mask;
     CPU_ZERO(&new_mask);
-    CPU_SET(0, &new_mask);
+    CPU_SET(pin_cpu, &new_mask);
     sched_getaffinity(0, sizeof(old_mask), &old_mask);
     sched_setaffinity(0, sizeof(new_mask), &new_mask);
 #elif defined(MEMBENCH_PLATFORM_MACOS)
@@ -348,14 +375,15 @@ int membench_cpu_detect_cache(membench_cache_info_t *info) {
     pthread_set_qos_class_self_np(QOS_CLASS_USER_INTERACTIVE, 0);
 #endif
 
-    printf("  Sweeping %zu buffer sizes from %zu KB to %zu MB...\n",
-           num, sizes[0] / 1024, sizes[num - 1] / (1024 * 1024));
-
+    /* The full sweep takes minutes; stop between sizes when cancelled */
+    uint64_t t_sweep = membench_timer_ns();
+    int cancelled = 0;
     for (size_t i = 0; i < num; i++) {
+        if (membench_cancel_requested()) { cancelled = 1; break; }
         membench_latency_result_t lat = {0};
-        uint64_t iters = auto_iterations(sizes[i]);
+        uint64_t iters = auto_iterations(sizes[i], visits);
 
-        int ret = membench_cpu_read_latency(sizes[i], iters, &lat);
+        int ret = chase_read_latency(sizes[i], iters, seed, &lat);
         if (ret != 0) {
             latencies[i] = -1.0;
             continue;
@@ -372,7 +400,16 @@ int membench_cpu_detect_cache(membench_cache_info_t *info) {
     pthread_set_qos_class_self_np(QOS_CLASS_DEFAULT, 0);
 #endif
 
+    if (cancelled) {
+        free(sizes);
+        free(latencies);
+        return -1;
+    }
+
+    uint64_t t = membench_timer_ns();
+    membench_timeline_span("cache-sweep", t_sweep, t, max_bytes);
     detect_boundaries(sizes, latencies, num, info);
+    membench_phase_mark(MEMBENCH_PHASE_ANALYZE, t);
 
     info->num_samples = num;
     info->sample_sizes = sizes;
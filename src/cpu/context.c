@@ -0,0 +1,144 @@
+/**
+ * context.c — Reentrant context API over the CPU probes.
+ *
+ * The probes themselves keep no mutable globals; what used to be implicit
+ * process state (the srand() seed behind the pointer chains, the timer
+ * set-up, printing) is either carried in the context or left to the
+ * caller.
+ */
+#include "membench/context.h"
+#include "membench/timer.h"
+#include "cpu_internal.h"
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+struct membench_ctx {
+    uint64_t rng;                /* splitmix64 state, one draw per chain */
+    size_t   cache_line;
+    size_t   max_buffer;
+    double   timer_res_ns;
+    char     error[160];
+};
+
+static int ctx_fail(membench_ctx_t *ctx, const char *fmt, ...) {
+    va_list ap;
+    va_start(ap, fmt);
+    vsnprintf(ctx->error, sizeof(ctx->error), fmt, ap);
+    va_end(ap);
+    return -1;
+}
+
+static int ctx_check(membench_ctx_t *ctx, size_t buffer_size, const void *result) {
+    ctx->error[0] = '\0';
+    if (!result) return ctx_fail(ctx, "result is NULL");
+    if (buffer_size < ctx->cache_line)
+        return ctx_fail(ctx, "buffer of %zu bytes is below one cache line", buffer_size);
+    if (ctx->max_buffer && buffer_size > ctx->max_buffer)
+        return ctx_fail(ctx, "buffer of %zu bytes exceeds the %zu byte limit",
+                        buffer_size, ctx->max_buffer);
+    return 0;
+}
+
+static uint64_t ctx_iters(size_t buffer_size, uint64_t iterations, int is_latency) {
+    return iterations ? iterations : membench_cpu_auto_iterations(buffer_size, is_latency);
+}
+
+/* ── Lifetime ─────────────────────────────────────────────────────────────── */
+
+membench_ctx_t *membench_ctx_create(const membench_ctx_config_t *cfg) {
+    membench_ctx_t *ctx = (membench_ctx_t *)calloc(1, sizeof(*ctx));
+    if (!ctx) return NULL;
+    if (membench_timer_init() != 0) {
+        free(ctx);
+        return NULL;
+    }
+    ctx->rng = (cfg && cfg->seed) ? cfg->seed : MEMBENCH_CHASE_SEED;
+    ctx->max_buffer = cfg ? cfg->max_buffer_bytes : 0;
+    ctx->cache_line = membench_get_cache_line_size();
+    ctx->timer_res_ns = membench_timer_resolution_ns();
+    return ctx;
+}
+
+void membench_ctx_destroy(membench_ctx_t *ctx) {
+    free(ctx);
+}
+
+const char *membench_ctx_error(const membench_ctx_t *ctx) {
+    return ctx ? ctx->error : "no context";
+}
+
+double membench_ctx_timer_resolution_ns(const membench_ctx_t *ctx) {
+    return ctx ? ctx->timer_res_ns : 0.0;
+}
+
+int membench_ctx_sysinfo(membench_ctx_t *ctx, membench_sysinfo_t *info) {
+    if (!ctx) return -1;
+    ctx->error[0] = '\0';
+    if (!info || membench_sysinfo_get(info) != 0)
+        return ctx_fail(ctx, "system information unavailable");
+    return 0;
+}
+
+/* ── Probes ───────────────────────────────────────────────────────────────── */
+
+int membench_ctx_read_latency(membench_ctx_t *ctx, size_t buffer_size,
+                              uint64_t iterations, membench_latency_result_t *result) {
+    if (!ctx || ctx_check(ctx, buffer_size, result) != 0) return -1;
+    if (chase_read_latency(buffer_size, ctx_iters(buffer_size, iterations, 1),
+                           rng_next(&ctx->rng), result) != 0)
+        return ctx_fail(ctx, "read latency: cannot allocate %zu bytes", buffer_size);
+    return 0;
+}
+
+int membench_ctx_write_latency(membench_ctx_t *ctx, size_t buffer_size,
+                               uint64_t iterations, membench_latency_result_t *result) {
+    if (!ctx || ctx_check(ctx, buffer_size, result) != 0) return -1;
+    if (chase_write_latency(buffer_size, ctx_iters(buffer_size, iterations, 1),
+                            rng_next(&ctx->rng), result) != 0)
+        return ctx_fail(ctx, "write latency: cannot allocate %zu bytes", buffer_size);
+    return 0;
+}
+
+int membench_ctx_read_bandwidth(membench_ctx_t *ctx, size_t buffer_size,
+                                uint64_t iterations, membench_bandwidth_result_t *result) {
+    if (!ctx || ctx_check(ctx, buffer_size, result) != 0) return -1;
+    if (membench_cpu_read_bandwidth(buffer_size, ctx_iters(buffer_size, iterations, 0),
+                                    result) != 0)
+        return ctx_fail(ctx, "read bandwidth: cannot allocate %zu bytes", buffer_size);
+    return 0;
+}
+
+int membench_ctx_write_bandwidth(membench_ctx_t *ctx, size_t buffer_size,
+                                 uint64_t iterations, membench_bandwidth_result_t *result) {
+    if (!ctx || ctx_check(ctx, buffer_size, result) != 0) return -1;
+    if (membench_cpu_write_bandwidth(buffer_size, ctx_iters(buffer_size, iterations, 0),
+                                     result) != 0)
+        return ctx_fail(ctx, "write bandwidth: cannot allocate %zu bytes", buffer_size);
+    return 0;
+}
+
+int membench_ctx_detect_cache(membench_ctx_t *ctx, size_t max_bytes, uint64_t visits,
+                              membench_ctx_cache_t *result) {
+    if (!max_bytes) max_bytes = MEMBENCH_DETECT_MAX_BYTES;
+    if (ctx && ctx->max_buffer && max_bytes > ctx->max_buffer) max_bytes = ctx->max_buffer;
+    if (!ctx || ctx_check(ctx, max_bytes, result) != 0) return -1;
+
+    membench_cache_info_t info = {0};
+    if (detect_cache_sweep(max_bytes, visits, rng_next(&ctx->rng), -1, &info) != 0)
+        return ctx_fail(ctx, "cache detection failed");
+
+    memset(result, 0, sizeof(*result));
+    result->l1_size_bytes = info.l1_size_bytes;
+    result->l2_size_bytes = info.l2_size_bytes;
+    result->l3_size_bytes = info.l3_size_bytes;
+    size_t n = info.num_samples < MEMBENCH_CTX_MAX_SAMPLES ? info.num_samples
+                                                           : MEMBENCH_CTX_MAX_SAMPLES;
+    memcpy(result->sample_sizes, info.sample_sizes, n * sizeof(size_t));
+    memcpy(result->sample_latencies, info.sample_latencies, n * sizeof(double));
+    result->num_samples = n;
+    membench_cache_info_free(&info);
+    return 0;
+}
@@ -0,0 +1,251 @@
+/**
+ * cpu_internal.h — Helpers shared by the CPU benchmark translation units.
+ *
+ * Not part of the public API; only included from the src/cpu sources.
+ */
+#ifndef MEMBENCH_CPU_INTERNAL_H
+#define MEMBENCH_CPU_INTERNAL_H
+
+#include "membench/bench_cpu.h"
+#include "membench/platform.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(_MSC_VER)
+    #include <intrin.h>
+#endif
+
+/* ── Pointer-chase construction (latency.c) ──────────────────────────────── */
+
+/** Runtime cache line size: sysctl on macOS, 64 B elsewhere. */
+size_t membench_get_cache_line_size(void);
+
+/** Seed of the public entry points, so runs are comparable across calls. */
+#define MEMBENCH_CHASE_SEED 42
+
+/**
+ * Build a random cyclic pointer-chase within buf.
+ * `node_count` nodes are each `ptrs_per_line` pointers apart; the order
+ * is a function of `seed` alone.
+ */
+void build_pointer_chase_cl(void **buf, size_t node_count, size_t ptrs_per_line,
+                            uint64_t seed);
+
+/** Chase loop membench_cpu_read_latency() runs for `buffer_size` bytes. */
+const char *chase_kernel_name(size_t buffer_size);
+
+/** membench_cpu_read/write_latency() with an explicit chain seed. */
+int chase_read_latency(size_t buffer_size, uint64_t iterations, uint64_t seed,
+                       membench_latency_result_t *result);
+int chase_write_latency(size_t buffer_size, uint64_t iterations, uint64_t seed,
+                        membench_latency_result_t *result);
+
+/* ── Streaming reads (bandwidth.c) ────────────────────────────────────────── */
+
+/** Stream loop membench_cpu_read_bandwidth() runs for `buffer_size` bytes. */
+const char *stream_kernel_name(size_t buffer_size);
+
+/* ── Cache detection (cache_detect.c) ─────────────────────────────────────── */
+
+/**
+ * membench_cpu_detect_cache_range() with an explicit chain seed, pinned
+ * to `pin_cpu` for the sweep (-1 = whichever CPU the caller is on).
+ */
+int detect_cache_sweep(size_t max_bytes, uint64_t visits, uint64_t seed,
+                       int pin_cpu, membench_cache_info_t *info);
+
+/**
+ * Set info->l1/l2/l3_size_bytes to the first three latency steps of a
+ * (size, latency) curve sorted by size, 0 where there is none.  Needs at
+ * least 10 points; latencies <= 0 are treated as missing.
+ */
+void detect_boundaries(const size_t *sizes, const double *latencies,
+                       size_t n, membench_cache_info_t *info);
+
+/* ── Multi-threaded runs (threads.c) ─────────────────────────────────────── */
+
+typedef void (*membench_thread_fn)(void *arg, int tid);
+
+/**
+ * Run fn(arg, tid) for tid = 0..nthreads-1, each on its own thread, all
+ * released together.  Returns the wall time in ns from release to the last
+ * thread finishing, or 0 on failure.  nthreads == 1 runs on the caller.
+ */
+uint64_t run_on_threads(int nthreads, membench_thread_fn fn, void *arg);
+
+/* ── Memory fence ─────────────────────────────────────────────────────────── */
+
+MEMBENCH_INLINE void memory_fence(void) {
+#if defined(MEMBENCH_ARCH_X86_64) || defined(MEMBENCH_ARCH_X86)
+    #ifdef _MSC_VER
+        _ReadWriteBarrier();
+    #else
+        __asm__ __volatile__("mfence" ::: "memory");
+    #endif
+#elif defined(MEMBENCH_ARCH_ARM64)
+    #ifdef _MSC_VER
+        __dmb(_ARM64_BARRIER_SY);
+    #else
+        __asm__ __volatile__("dmb sy" ::: "memory");
+    #endif
+#else
+    /* Generic C11 fallback — compiler fence only */
+    __asm__ __volatile__("" ::: "memory");
+#endif
+}
+
+/**
+ * Force-read a pointer through volatile to prevent the compiler
+ * from optimizing out the dereference chain.
+ */
+MEMBENCH_INLINE void **chase_load(void **p) {
+    return (void **)(*(void * volatile *)p);
+}
+
+/* ── Deterministic RNG (splitmix64) ───────────────────────────────────────── */
+
+/**
+ * rand() is only 15 bits on MSVC, which is not enough to shuffle or key
+ * multi-million-entry structures; the newer benchmarks use this instead.
+ */
+MEMBENCH_INLINE uint64_t rng_next(uint64_t *state) {
+    uint64_t z = (*state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+/** Uniform integer in [0, bound). */
+MEMBENCH_INLINE uint64_t rng_below(uint64_t *state, uint64_t bound) {
+    return rng_next(state) % bound;
+}
+
+/* ── Bit helpers ──────────────────────────────────────────────────────────── */
+
+MEMBENCH_INLINE unsigned ctz64(uint64_t x) {
+#ifdef _MSC_VER
+    unsigned long idx;
+    _BitScanForward64(&idx, x);
+    return (unsigned)idx;
+#else
+    return (unsigned)__builtin_ctzll(x);
+#endif
+}
+
+MEMBENCH_INLINE unsigned popcount32(uint32_t x) {
+#ifdef _MSC_VER
+    unsigned n = 0;
+    for (; x; x &= x - 1) n++;
+    return n;
+#else
+    return (unsigned)__builtin_popcount(x);
+#endif
+}
+
+/** Software prefetch for read; a hint only, never faults. */
+MEMBENCH_INLINE void prefetch_read(const void *p) {
+#if defined(_MSC_VER) && (defined(MEMBENCH_ARCH_X86_64) || defined(MEMBENCH_ARCH_X86))
+    _mm_prefetch((const char *)p, _MM_HINT_T0);
+#elif defined(_MSC_VER)
+    __prefetch(p);
+#else
+    __builtin_prefetch(p, 0, 3);
+#endif
+}
+
+/** Largest power of two <= x (x > 0). */
+MEMBENCH_INLINE size_t floor_pow2(size_t x) {
+    size_t p = 1;
+    while (p <= x / 2) p <<= 1;
+    return p;
+}
+
+/* ── Run-time ISA checks (x86-64) ─────────────────────────────────────────── */
+
+#if defined(MEMBENCH_ARCH_X86_64)
+/** AVX2 and FMA usable: the CPU has them and the OS saves the YMM state. */
+MEMBENCH_INLINE int cpu_has_avx2_fma(void) {
+#if defined(_MSC_VER) && !defined(__clang__)
+    int r[4];
+    __cpuid(r, 1);
+    int fma = (r[2] >> 12) & 1, osxsave = (r[2] >> 27) & 1, avx = (r[2] >> 28) & 1;
+    if (!fma || !osxsave || !avx || (_xgetbv(0) & 6) != 6) return 0;
+    __cpuidex(r, 7, 0);
+    return (r[1] >> 5) & 1;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+#endif
+}
+
+/** AVX-512F usable: the CPU has it and the OS saves the ZMM and mask state. */
+MEMBENCH_INLINE int cpu_has_avx512f(void) {
+#if defined(_MSC_VER) && !defined(__clang__)
+    int r[4];
+    __cpuid(r, 1);
+    if (!((r[2] >> 27) & 1) || (_xgetbv(0) & 0xE6) != 0xE6) return 0;
+    __cpuidex(r, 7, 0);
+    return (r[1] >> 16) & 1;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx512f");
+#endif
+}
+#endif
+
+/* ── Compile-time unrolling ───────────────────────────────────────────────── */
+
+/*
+ * UNROLL<N>(X, b) expands to X(b) X(b + 1) ... X(b + N - 1): a kernel body
+ * written once becomes N copies with constant offsets, and the only loop
+ * left is the one around the block, with one counter and branch per N
+ * accesses.
+ */
+#define UNROLL1(X, b)   X(b)
+#define UNROLL4(X, b)   X(b) X((b) + 1) X((b) + 2) X((b) + 3)
+#define UNROLL8(X, b)   UNROLL4(X, b) UNROLL4(X, (b) + 4)
+#define UNROLL16(X, b)  UNROLL8(X, b) UNROLL8(X, (b) + 8)
+#define UNROLL32(X, b)  UNROLL16(X, b) UNROLL16(X, (b) + 16)
+
+/* ── Scalar reference loops ────────────────────────────────────────────────── */
+
+/*
+ * Reference "scalar" kernels must stay scalar at any optimisation level,
+ * otherwise the compiler's auto-vectoriser turns them into SIMD kernels and
+ * a scalar-vs-SIMD comparison measures nothing.  Put SCALAR_LOOP directly
+ * before the loop and MEMBENCH_NO_VECTORIZE on the enclosing function.
+ */
+#if defined(__clang__)
+    #define MEMBENCH_NO_VECTORIZE
+    #define SCALAR_LOOP _Pragma("clang loop vectorize(disable) interleave(disable)")
+#elif defined(__GNUC__)
+    #define MEMBENCH_NO_VECTORIZE __attribute__((optimize("no-tree-vectorize")))
+    #define SCALAR_LOOP
+#elif defined(_MSC_VER)
+    #define MEMBENCH_NO_VECTORIZE
+    #define SCALAR_LOOP __pragma(loop(no_vector))
+#else
+    #define MEMBENCH_NO_VECTORIZE
+    #define SCALAR_LOOP
+#endif
+
+/*
+ * Under clang neither of the above stops the SLP vectoriser, which packs
+ * independent scalar chains (a0 += ..., a1 += ...) into vector lanes
+ * (GCC's no-tree-vectorize covers SLP too).  SCALAR_KEEP_F64(v) /
+ * SCALAR_KEEP_U64(v) pin one chain to its own register for the statement
+ * and emit no instruction; apply one to every chain, every iteration.
+ */
+#if defined(__clang__) && defined(MEMBENCH_ARCH_X86_64)
+    #define SCALAR_KEEP_F64(v) __asm__("" : "+x"(v))
+    #define SCALAR_KEEP_U64(v) __asm__("" : "+r"(v))
+#elif defined(__clang__) && defined(MEMBENCH_ARCH_ARM64)
+    #define SCALAR_KEEP_F64(v) __asm__("" : "+w"(v))
+    #define SCALAR_KEEP_U64(v) __asm__("" : "+r"(v))
+#else
+    #define SCALAR_KEEP_F64(v) ((void)0)
+    #define SCALAR_KEEP_U64(v) ((void)0)
+#endif
+
+#endif /* MEMBENCH_CPU_INTERNAL_H */
@@ -0,0 +1,179 @@
+/**
+ * dmp.c — Data-memory-dependent prefetcher detection.
+ *
+ * Some cores (Apple M-series, some recent Intel parts) look at the values
+ * of the lines they fetch and prefetch whatever those values point to.
+ * That makes arrays of pointers, and possibly the pointer chase itself,
+ * faster than the addresses alone would suggest.  Every level is measured
+ * four ways, over one working set of randomly ordered cache lines:
+ *
+ *   scan   walk a slot array in order, loading the line each slot names;
+ *          the loads are independent, so this is a gather
+ *   chase  follow the links through the same lines, one at a time
+ *
+ * each once with the slots and links stored as valid pointers and once
+ * XOR-masked with DMP_MASK, which leaves them non-canonical.  The kernels
+ * XOR every value with a key read at run time, 0 for pointers and DMP_MASK
+ * for the masked runs, so both run identical instructions on identical
+ * addresses and only the memory contents differ.  The runs alternate,
+ * each DMP_REPEATS times; times are medians and gains are medians of the
+ * back-to-back pairs.
+ */
+#include "membench/bench_cpu.h"
+#include "membench/alloc.h"
+#include "membench/timer.h"
+#include "membench/checkpoint.h"
+#include "cpu_internal.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define DMP_MASK          0xA5A5A5A500000000ULL   /* high bits: never a pointer */
+#define DMP_ACCESSES      2000000ULL   /* gather slots per timed scan */
+#define DMP_CHASE_SHARE   8            /* a chase step costs up to ~10 slots */
+#define DMP_REPEATS       5
+#define DMP_ACTIVE_PCT    20.0
+#define DMP_SEED          (MEMBENCH_CHASE_SEED + 1)
+
+/* ── Kernels ──────────────────────────────────────────────────────────────── */
+
+#define DMP_LOAD(addr)    (*(const volatile uint64_t *)(uintptr_t)(addr))
+#define SCAN_STEP(k)      sum += DMP_LOAD(slots[i + (k)] ^ key);
+#define CHASE_STEP(k)     p = DMP_LOAD(p ^ key);
+
+/* Slots are whole blocks of 8: slot counts are multiples of 8 */
+static uint64_t scan_slots(const uint64_t *slots, size_t n, uint64_t passes, uint64_t key) {
+    uint64_t sum = 0;
+    for (uint64_t r = 0; r < passes; r++)
+        for (size_t i = 0; i < n; i += 8) {
+            UNROLL8(SCAN_STEP, 0)
+        }
+    return sum;
+}
+
+static uint64_t chase_links(uint64_t p, uint64_t steps, uint64_t key) {
+    for (uint64_t s = 0; s < steps; s += 8) {
+        UNROLL8(CHASE_STEP, 0)
+    }
+    return p;
+}
+
+static void mask_words(uint64_t *w, size_t n, size_t stride) {
+    for (size_t i = 0; i < n; i++) w[i * stride] ^= DMP_MASK;
+}
+
+static int cmp_double(const void *a, const void *b) {
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+static double median(double *v, size_t n) {
+    qsort(v, n, sizeof(double), cmp_double);
+    return n % 2 ? v[n / 2] : 0.5 * (v[n / 2 - 1] + v[n / 2]);
+}
+
+/* Median over runs of each masked run against the pointer run just before
+ * it, so slow drift (clock, neighbours) cancels out of the pair */
+static double gain_pct(const double *ptr_ns, const double *masked_ns) {
+    double g[DMP_REPEATS];
+    for (int r = 0; r < DMP_REPEATS; r++)
+        g[r] = ptr_ns[r] > 0.0 ? 100.0 * (masked_ns[r] / ptr_ns[r] - 1.0) : 0.0;
+    return median(g, DMP_REPEATS);
+}
+
+/* ── One level ────────────────────────────────────────────────────────────── */
+
+static int dmp_level(size_t bytes, uint64_t accesses, membench_dmp_row_t *row) {
+    size_t cl = membench_get_cache_line_size();
+    size_t words = cl / sizeof(uint64_t);
+    size_t lines = bytes / cl / 8 * 8;
+    if (lines < 8) lines = 8;
+    bytes = lines * cl;
+
+    uint64_t *lines_buf = (uint64_t *)membench_alloc(bytes);
+    uint64_t *slots = (uint64_t *)malloc(lines * sizeof(uint64_t));
+    if (!lines_buf || !slots) {
+        if (lines_buf) membench_free(lines_buf, bytes);
+        free(slots);
+        return -1;
+    }
+
+    /* The chain's cyclic order also fills the slots, so the scan visits the
+     * lines in the order the chase does */
+    build_pointer_chase_cl((void **)lines_buf, lines, words, DMP_SEED);
+    uint64_t p = (uint64_t)(uintptr_t)lines_buf;
+    for (size_t i = 0; i < lines; i++) {
+        slots[i] = p;
+        p = DMP_LOAD(p);
+    }
+
+    /* Large working sets scan a prefix of the slots; it still lands on
+     * random lines across the whole set */
+    size_t n = accesses < lines ? (size_t)accesses / 8 * 8 : lines;
+    if (n < 8) n = 8;
+    uint64_t passes = accesses / n;
+    if (passes < 1) passes = 1;
+    uint64_t steps = accesses / DMP_CHASE_SHARE / 8 * 8;
+    if (steps < 8) steps = 8;
+    volatile uint64_t key_src[2] = { 0, DMP_MASK };
+    volatile uint64_t sink = 0;
+    double t[4][DMP_REPEATS];
+    int masked = 0;                      /* current state of slots and links */
+
+    for (int r = 0; r < DMP_REPEATS && !membench_cancel_requested(); r++) {
+        for (int m = 0; m < 2; m++) {
+            if (masked != m) {
+                mask_words(slots, lines, 1);
+                mask_words(lines_buf, lines, words);
+                masked = m;
+            }
+            uint64_t key = key_src[m];
+            sink += scan_slots(slots, n, 1, key);              /* warm-up pass */
+
+            uint64_t t0 = membench_timer_ns();
+            sink += scan_slots(slots, n, passes, key);
+            uint64_t t1 = membench_timer_ns();
+            sink += chase_links((uint64_t)(uintptr_t)lines_buf ^ key, steps, key);
+            uint64_t t2 = membench_timer_ns();
+
+            t[m][r] = (double)(t1 - t0) / ((double)passes * (double)n);
+            t[2 + m][r] = (double)(t2 - t1) / (double)steps;
+        }
+    }
+    (void)sink;
+    membench_free(lines_buf, bytes);
+    free(slots);
+    if (membench_cancel_requested()) return -1;
+
+    row->bytes = bytes;
+    row->scan_gain_pct = gain_pct(t[0], t[1]);
+    row->chase_gain_pct = gain_pct(t[2], t[3]);
+    row->scan_ptr_ns = median(t[0], DMP_REPEATS);
+    row->scan_masked_ns = median(t[1], DMP_REPEATS);
+    row->chase_ptr_ns = median(t[2], DMP_REPEATS);
+    row->chase_masked_ns = median(t[3], DMP_REPEATS);
+    return 0;
+}
+
+/* ── Public API ───────────────────────────────────────────────────────────── */
+
+int membench_cpu_dmp(const size_t level_bytes[MEMBENCH_DMP_NUM_LEVELS], uint64_t accesses,
+                     membench_dmp_t *result) {
+    if (!level_bytes || !result) return -1;
+    memset(result, 0, sizeof(*result));
+    if (accesses == 0) accesses = DMP_ACCESSES;
+    result->threshold_pct = DMP_ACTIVE_PCT;
+    result->accesses = accesses;
+    result->repeats = DMP_REPEATS;
+
+    for (int lv = 0; lv < MEMBENCH_DMP_NUM_LEVELS; lv++) {
+        if (!level_bytes[lv]) continue;
+        membench_dmp_row_t *row = &result->levels[lv];
+        if (dmp_level(level_bytes[lv], accesses, row) != 0) return -1;
+        /* Nothing to prefetch while everything already hits in L1 */
+        if (lv > MEMBENCH_DMP_L1 && (row->scan_gain_pct >= DMP_ACTIVE_PCT ||
+                                     row->chase_gain_pct >= DMP_ACTIVE_PCT))
+            result->active = 1;
+    }
+    return 0;
+}
@@ -0,0 +1,409 @@
+/**
+ * hashtable.c — Open-addressing hash table probe benchmark.
+ *
+ * Builds a table of 64-bit keys / 64-bit values in one of four layouts and
+ * times lookups as the table outgrows each cache level:
+ *
+ *   linear      — probe slot h, h+1, h+2, ...
+ *   quadratic   — probe slot h, h+1, h+3, h+6, ... (triangular numbers,
+ *                 visits every slot of a power-of-two table)
+ *   robin-hood  — linear probing where inserts steal slots from entries
+ *                 closer to home; misses stop as soon as the probe distance
+ *                 exceeds the resident entry's distance
+ *   bucketized  — Swiss-table style: 16-slot groups with a separate array of
+ *                 7-bit tags matched 16 at a time (SSE2 / NEON / SWAR)
+ *
+ * Latency is measured with a dependent chain: each lookup's key is XORed
+ * with (previous result & dep_mask), where dep_mask is zero at runtime but
+ * opaque to the compiler.  Miss lookups return a value loaded from the slot
+ * or control word that terminated the probe, so the chain waits for that
+ * line too instead of racing ahead on a predicted "not found" branch.
+ * Throughput is measured with the same lookups issued independently.
+ */
+#include "membench/bench_cpu.h"
+#include "membench/alloc.h"
+#include "membench/timer.h"
+#include "membench/platform.h"
+#include "cpu_internal.h"
+
+#include <string.h>
+
+#if defined(MEMBENCH_ARCH_X86_64)
+    #include <emmintrin.h>
+#elif defined(MEMBENCH_ARCH_ARM64)
+    #include <arm_neon.h>
+#endif
+
+/* ── Table layout ─────────────────────────────────────────────────────────── */
+
+#define MISS_BIT    (1ULL << 63)   /* set in miss results and miss keys  */
+#define GROUP_WIDTH 16             /* slots per bucketized group          */
+#define CTRL_EMPTY  0x80           /* tags are 7-bit, so high bit = empty */
+
+typedef struct {
+    uint64_t key;   /* 0 = empty */
+    uint64_t val;
+} slot_t;
+
+typedef struct {
+    slot_t  *slots;
+    uint8_t *ctrl;          /* bucketized only: one tag per slot */
+    size_t   capacity;      /* power of two */
+    size_t   mask;          /* capacity - 1 */
+    size_t   group_mask;    /* (capacity / GROUP_WIDTH) - 1 */
+    size_t   slot_bytes;
+    size_t   ctrl_bytes;
+    uint64_t dep_mask;      /* always 0; loaded through volatile */
+} table_t;
+
+static const char *const SCHEME_NAMES[MEMBENCH_HASH_NUM_SCHEMES] = {
+    "linear", "quadratic", "robin-hood", "bucketized"
+};
+
+const char *membench_hash_scheme_name(membench_hash_scheme_t scheme) {
+    if ((int)scheme < 0 || scheme >= MEMBENCH_HASH_NUM_SCHEMES) return "unknown";
+    return SCHEME_NAMES[scheme];
+}
+
+/** Murmur3 finalizer: cheap and well-mixed in both low and high bits. */
+MEMBENCH_INLINE uint64_t hash_key(uint64_t k) {
+    k ^= k >> 33;
+    k *= 0xFF51AFD7ED558CCDULL;
+    k ^= k >> 33;
+    k *= 0xC4CEB9FE1A85EC53ULL;
+    k ^= k >> 33;
+    return k;
+}
+
+MEMBENCH_INLINE uint64_t value_for(uint64_t key) {
+    return (key ^ 0x2545F4914F6CDD1DULL) & ~MISS_BIT;
+}
+
+/* ── Linear probing ───────────────────────────────────────────────────────── */
+
+MEMBENCH_INLINE uint64_t lookup_linear(const table_t *t, uint64_t key) {
+    size_t pos = (size_t)hash_key(key) & t->mask;
+    for (;;) {
+        const slot_t *s = &t->slots[pos];
+        if (s->key == key) return s->val;
+        if (s->key == 0)   return s->val | MISS_BIT;
+        pos = (pos + 1) & t->mask;
+    }
+}
+
+static size_t insert_linear(table_t *t, uint64_t key, uint64_t val) {
+    size_t pos = (size_t)hash_key(key) & t->mask;
+    for (size_t probes = 1;; probes++) {
+        slot_t *s = &t->slots[pos];
+        if (s->key == key) return 0;
+        if (s->key == 0) { s->key = key; s->val = val; return probes; }
+        pos = (pos + 1) & t->mask;
+    }
+}
+
+/* ── Quadratic probing ────────────────────────────────────────────────────── */
+
+MEMBENCH_INLINE uint64_t lookup_quadratic(const table_t *t, uint64_t key) {
+    size_t pos = (size_t)hash_key(key) & t->mask;
+    for (size_t i = 1;; i++) {
+        const slot_t *s = &t->slots[pos];
+        if (s->key == key) return s->val;
+        if (s->key == 0)   return s->val | MISS_BIT;
+        pos = (pos + i) & t->mask;
+    }
+}
+
+static size_t insert_quadratic(table_t *t, uint64_t key, uint64_t val) {
+    size_t pos = (size_t)hash_key(key) & t->mask;
+    for (size_t i = 1;; i++) {
+        slot_t *s = &t->slots[pos];
+        if (s->key == key) return 0;
+        if (s->key == 0) { s->key = key; s->val = val; return i; }
+        pos = (pos + i) & t->mask;
+    }
+}
+
+/* ── Robin Hood ───────────────────────────────────────────────────────────── */
+
+MEMBENCH_INLINE size_t rh_dist(const table_t *t, uint64_t key, size_t pos) {
+    return (pos - ((size_t)hash_key(key) & t->mask)) & t->mask;
+}
+
+MEMBENCH_INLINE uint64_t lookup_robin_hood(const table_t *t, uint64_t key) {
+    size_t pos = (size_t)hash_key(key) & t->mask;
+    for (size_t dist = 0;; dist++) {
+        const slot_t *s = &t->slots[pos];
+        if (s->key == key) return s->val;
+        if (s->key == 0 || rh_dist(t, s->key, pos) < dist)
+            return s->val | MISS_BIT;
+        pos = (pos + 1) & t->mask;
+    }
+}
+
+static size_t insert_robin_hood(table_t *t, uint64_t key, uint64_t val) {
+    if (!(lookup_robin_hood(t, key) & MISS_BIT)) return 0;
+
+    size_t pos = (size_t)hash_key(key) & t->mask;
+    for (size_t dist = 0;; dist++) {
+        slot_t *s = &t->slots[pos];
+        if (s->key == 0) { s->key = key; s->val = val; return 1; }
+        size_t resident = rh_dist(t, s->key, pos);
+        if (resident < dist) {
+            uint64_t tk = s->key, tv = s->val;
+            s->key = key; s->val = val;
+            key = tk; val = tv;
+            dist = resident;
+        }
+        pos = (pos + 1) & t->mask;
+    }
+}
+
+/* ── Bucketized (16-way tag groups) ───────────────────────────────────────── */
+
+/*
+ * match_tag() returns a mask with one set bit per matching lane; the lane
+ * index is ctz(mask) >> LANE_SHIFT.  SSE2 gives one bit per byte directly,
+ * NEON narrows to a nibble per byte (keeping one bit of each), SWAR gathers
+ * the high bit of each byte with a multiply.
+ * The SWAR zero-byte trick can report false positives above a true match;
+ * callers always compare the full key so that only costs a probe.
+ */
+#if defined(MEMBENCH_ARCH_X86_64)
+    #define LANE_SHIFT 0
+    MEMBENCH_INLINE uint64_t match_tag(const uint8_t *ctrl, uint8_t tag) {
+        __m128i c = _mm_load_si128((const __m128i *)ctrl);
+        return (uint64_t)(unsigned)_mm_movemask_epi8(
+            _mm_cmpeq_epi8(c, _mm_set1_epi8((char)tag)));
+    }
+    MEMBENCH_INLINE uint64_t match_empty(const uint8_t *ctrl) {
+        return (uint64_t)(unsigned)_mm_movemask_epi8(
+            _mm_load_si128((const __m128i *)ctrl));
+    }
+#elif defined(MEMBENCH_ARCH_ARM64)
+    #define LANE_SHIFT 2
+    MEMBENCH_INLINE uint64_t neon_mask(uint8x16_t eq) {
+        uint8x8_t n = vshrn_n_u16(vreinterpretq_u16_u8(eq), 4);
+        return vget_lane_u64(vreinterpret_u64_u8(n), 0) & 0x8888888888888888ULL;
+    }
+    MEMBENCH_INLINE uint64_t match_tag(const uint8_t *ctrl, uint8_t tag) {
+        return neon_mask(vceqq_u8(vld1q_u8(ctrl), vdupq_n_u8(tag)));
+    }
+    MEMBENCH_INLINE uint64_t match_empty(const uint8_t *ctrl) {
+        return neon_mask(vtstq_u8(vld1q_u8(ctrl), vdupq_n_u8(CTRL_EMPTY)));
+    }
+#else
+    #define LANE_SHIFT 0
+    #define SWAR_LO 0x0101010101010101ULL
+    #define SWAR_HI 0x8080808080808080ULL
+    /** Gather the high bit of each byte into an 8-bit lane mask. */
+    MEMBENCH_INLINE uint64_t swar_movemask(uint64_t x) {
+        return ((x & SWAR_HI) * 0x0002040810204081ULL) >> 56;
+    }
+    MEMBENCH_INLINE uint64_t swar_zero(uint64_t x) {
+        return (x - SWAR_LO) & ~x & SWAR_HI;
+    }
+    MEMBENCH_INLINE uint64_t match_tag(const uint8_t *ctrl, uint8_t tag) {
+        uint64_t lo, hi;
+        memcpy(&lo, ctrl, 8);
+        memcpy(&hi, ctrl + 8, 8);
+        return swar_movemask(swar_zero(lo ^ (SWAR_LO * tag))) |
+               swar_movemask(swar_zero(hi ^ (SWAR_LO * tag))) << 8;
+    }
+    MEMBENCH_INLINE uint64_t match_empty(const uint8_t *ctrl) {
+        uint64_t lo, hi;
+        memcpy(&lo, ctrl, 8);
+        memcpy(&hi, ctrl + 8, 8);
+        return swar_movemask(lo) | swar_movemask(hi) << 8;
+    }
+#endif
+
+MEMBENCH_INLINE uint8_t tag_of(uint64_t h) {
+    return (uint8_t)(h >> 57);
+}
+
+MEMBENCH_INLINE uint64_t lookup_bucketized(const table_t *t, uint64_t key) {
+    uint64_t h = hash_key(key);
+    uint8_t tag = tag_of(h);
+    size_t g = (size_t)h & t->group_mask;
+    for (size_t step = 1;; step++) {
+        size_t base = g * GROUP_WIDTH;
+        const uint8_t *ctrl = &t->ctrl[base];
+        for (uint64_t m = match_tag(ctrl, tag); m; m &= m - 1) {
+            const slot_t *s = &t->slots[base + (ctz64(m) >> LANE_SHIFT)];
+            if (s->key == key) return s->val;
+        }
+        uint64_t empty = match_empty(ctrl);
+        if (empty) return empty | MISS_BIT;
+        g = (g + step) & t->group_mask;
+    }
+}
+
+static size_t insert_bucketized(table_t *t, uint64_t key, uint64_t val) {
+    if (!(lookup_bucketized(t, key) & MISS_BIT)) return 0;
+
+    uint64_t h = hash_key(key);
+    size_t g = (size_t)h & t->group_mask;
+    for (size_t step = 1;; step++) {
+        size_t base = g * GROUP_WIDTH;
+        for (size_t i = 0; i < GROUP_WIDTH; i++) {
+            if (t->ctrl[base + i] == CTRL_EMPTY) {
+                t->ctrl[base + i] = tag_of(h);
+                t->slots[base + i].key = key;
+                t->slots[base + i].val = val;
+                return step;
+            }
+        }
+        g = (g + step) & t->group_mask;
+    }
+}
+
+/* ── Timed loops (one specialisation per scheme, no indirect calls) ───────── */
+
+#define DEFINE_TIMED_LOOPS(NAME, LOOKUP)                                      \
+    static uint64_t NAME##_chain(const table_t *t, const uint64_t *q,         \
+                                 size_t nq, uint64_t n) {                     \
+        uint64_t r = 0;                                                       \
+        size_t i = 0;                                                         \
+        for (uint64_t k = 0; k < n; k++) {                                    \
+            r = LOOKUP(t, q[i] ^ (r & t->dep_mask));                          \
+            if (++i == nq) i = 0;                                             \
+        }                                                                     \
+        return r;                                                             \
+    }                                                                         \
+    static uint64_t NAME##_indep(const table_t *t, const uint64_t *q,         \
+                                 size_t nq, uint64_t n) {                     \
+        uint64_t sum = 0;                                                     \
+        size_t i = 0;                                                         \
+        for (uint64_t k = 0; k < n; k++) {                                    \
+            sum += LOOKUP(t, q[i]);                                           \
+            if (++i == nq) i = 0;                                             \
+        }                                                                     \
+        return sum;                                                           \
+    }
+
+DEFINE_TIMED_LOOPS(linear,     lookup_linear)
+DEFINE_TIMED_LOOPS(quadratic,  lookup_quadratic)
+DEFINE_TIMED_LOOPS(robin_hood, lookup_robin_hood)
+DEFINE_TIMED_LOOPS(bucketized, lookup_bucketized)
+
+typedef uint64_t (*loop_fn)(const table_t *, const uint64_t *, size_t, uint64_t);
+typedef size_t   (*insert_fn)(table_t *, uint64_t, uint64_t);
+
+static const loop_fn CHAIN_LOOPS[MEMBENCH_HASH_NUM_SCHEMES] = {
+    linear_chain, quadratic_chain, robin_hood_chain, bucketized_chain
+};
+static const loop_fn INDEP_LOOPS[MEMBENCH_HASH_NUM_SCHEMES] = {
+    linear_indep, quadratic_indep, robin_hood_indep, bucketized_indep
+};
+static const insert_fn INSERTS[MEMBENCH_HASH_NUM_SCHEMES] = {
+    insert_linear, insert_quadratic, insert_robin_hood, insert_bucketized
+};
+
+static double time_loop(loop_fn fn, const table_t *t, const uint64_t *q,
+                        size_t nq, uint64_t n) {
+    memory_fence();
+    uint64_t start = membench_timer_ns();
+    uint64_t r = fn(t, q, nq, n);
+    memory_fence();
+    uint64_t end = membench_timer_ns();
+
+    volatile uint64_t sink = r;
+    (void)sink;
+    return (double)(end - start);
+}
+
+/* ── Public API ───────────────────────────────────────────────────────────── */
+
+int membench_cpu_hash_probe(membench_hash_scheme_t scheme, size_t table_bytes,
+                            double load_factor, uint64_t lookups,
+                            membench_hash_result_t *result) {
+    if (!result || (int)scheme < 0 || scheme >= MEMBENCH_HASH_NUM_SCHEMES)
+        return -1;
+    if (load_factor <= 0.0 || load_factor >= 1.0 || lookups == 0) return -1;
+
+    table_t t;
+    memset(&t, 0, sizeof(t));
+    t.capacity = floor_pow2(table_bytes / sizeof(slot_t));
+    if (t.capacity < GROUP_WIDTH) return -1;
+    t.mask = t.capacity - 1;
+    t.group_mask = t.capacity / GROUP_WIDTH - 1;
+
+    size_t count = (size_t)(load_factor * (double)t.capacity);
+    if (count >= t.capacity) count = t.capacity - 1;
+    if (count == 0) return -1;
+
+    t.slot_bytes = t.capacity * sizeof(slot_t);
+    t.slots = (slot_t *)membench_alloc(t.slot_bytes);
+    if (!t.slots) return -1;
+    if (scheme == MEMBENCH_HASH_BUCKETIZED) {
+        t.ctrl_bytes = t.capacity;
+        t.ctrl = (uint8_t *)membench_alloc(t.ctrl_bytes);
+        if (!t.ctrl) { membench_free(t.slots, t.slot_bytes); return -1; }
+        memset(t.ctrl, CTRL_EMPTY, t.ctrl_bytes);
+    }
+
+    size_t q_bytes = count * sizeof(uint64_t);
+    uint64_t *hit_q  = (uint64_t *)membench_alloc(q_bytes);
+    uint64_t *miss_q = (uint64_t *)membench_alloc(q_bytes);
+    if (!hit_q || !miss_q) {
+        membench_free(hit_q, q_bytes);
+        membench_free(miss_q, q_bytes);
+        membench_free(t.ctrl, t.ctrl_bytes);
+        membench_free(t.slots, t.slot_bytes);
+        return -1;
+    }
+
+    /* Fill: hit keys have bit 63 clear, miss keys have it set, so the two
+     * sets are disjoint by construction.  Keys are random, so insertion
+     * order is already a random permutation of table positions. */
+    uint64_t rng = 42;
+    uint64_t probe_sum = 0;
+    for (size_t i = 0; i < count; ) {
+        uint64_t key = (rng_next(&rng) | 1) & ~MISS_BIT;
+        size_t probes = INSERTS[scheme](&t, key, value_for(key));
+        if (probes == 0) continue;  /* duplicate key — draw again */
+        hit_q[i++] = key;
+        probe_sum += probes;
+    }
+    for (size_t i = 0; i < count; i++) {
+        miss_q[i] = rng_next(&rng) | MISS_BIT;
+    }
+    if (scheme == MEMBENCH_HASH_ROBIN_HOOD) {
+        /* Displacement changes after insert; recount from final positions */
+        probe_sum = 0;
+        for (size_t pos = 0; pos < t.capacity; pos++) {
+            if (t.slots[pos].key) probe_sum += rh_dist(&t, t.slots[pos].key, pos) + 1;
+        }
+    }
+
+    t.dep_mask = *(volatile uint64_t *)&t.dep_mask;
+
+    /* Warmup: one independent pass over the hit keys */
+    {
+        volatile uint64_t sink = INDEP_LOOPS[scheme](&t, hit_q, count, count);
+        (void)sink;
+    }
+
+    result->scheme = scheme;
+    result->table_bytes = t.slot_bytes + t.ctrl_bytes;
+    result->capacity = t.capacity;
+    result->load_factor = (double)count / (double)t.capacity;
+    result->avg_probes_hit = (double)probe_sum / (double)count;
+    result->lookups = lookups;
+
+    double ns;
+    ns = time_loop(CHAIN_LOOPS[scheme], &t, hit_q, count, lookups);
+    result->hit_latency_ns = ns / (double)lookups;
+    ns = time_loop(CHAIN_LOOPS[scheme], &t, miss_q, count, lookups);
+    result->miss_latency_ns = ns / (double)lookups;
+    ns = time_loop(INDEP_LOOPS[scheme], &t, hit_q, count, lookups);
+    result->hit_mops = (double)lookups / (ns / 1e3);
+    ns = time_loop(INDEP_LOOPS[scheme], &t, miss_q, count, lookups);
+    result->miss_mops = (double)lookups / (ns / 1e3);
+
+    membench_free(miss_q, q_bytes);
+    membench_free(hit_q, q_bytes);
+    membench_free(t.ctrl, t.ctrl_bytes);
+    membench_free(t.slots, t.slot_bytes);
+    return 0;
+}
@@ -0,0 +1,273 @@
+/**
+ * icache.c — Instruction-side hierarchy detection with generated code.
+ *
+ * The data-side sweep in cache_detect.c chases pointers; this one chases
+ * jumps.  A chain of small code blocks, `stride` bytes apart, is written
+ * into a buffer that is then made executable: each block runs a few nops
+ * and jumps to the next block of a random cyclic order, the last one loops
+ * back until a lap counter runs out.  Random order keeps the next-line
+ * instruction prefetcher from hiding the misses, the same way the data
+ * chase defeats the stream prefetcher.  Timing laps over growing code
+ * footprints and handing the curve to detect_boundaries() finds the steps:
+ *
+ *   lines  one jump per 64 B line: L1i reach, then L2 (or L3) reach
+ *   uops   lines packed with executed nops, 15 instructions per line: the
+ *          decoded-uop cache runs out before L1i does
+ *   pages  one jump per page, each one line further into its page so the
+ *          lines spread over every L1i set: L1 iTLB, then second-level TLB
+ *
+ * The buffer is written while read-write and then switched to read-execute,
+ * so the code also runs where writable executable memory is refused.
+ */
+#include "membench/bench_cpu.h"
+#include "membench/alloc.h"
+#include "membench/timer.h"
+#include "membench/checkpoint.h"
+#include "membench/platform.h"
+#include "cpu_internal.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(MEMBENCH_PLATFORM_WINDOWS)
+    #define WIN32_LEAN_AND_MEAN
+    #include <windows.h>
+#else
+    #include <sys/mman.h>
+#endif
+
+#if defined(MEMBENCH_ARCH_X86_64) || defined(MEMBENCH_ARCH_ARM64)
+    #define HAVE_CODEGEN 1
+#endif
+
+#define ICACHE_VISITS      2000000ULL
+#define ICACHE_MIN_LAPS    4
+#define ICACHE_REPEATS     3           /* best of, per footprint */
+#define ICACHE_MIN_BYTES   1024
+#define ICACHE_PAGE_MIN    (64 * 4096)
+#define STEPS_PER_OCTAVE   4
+#define LINE_BYTES         64
+#define PAGE_STRIDE        (4096 + LINE_BYTES)
+#define UOP_BLOCK_NOPS     14          /* + the jump: 15 instructions a line */
+#define HUGE_BYTES         (2u << 20)
+
+typedef void (*chain_fn)(uint64_t laps);
+
+/* ── Code generation ──────────────────────────────────────────────────────── */
+
+#if defined(HAVE_CODEGEN)
+
+#if defined(MEMBENCH_ARCH_X86_64)
+#define NOP_BYTES   4
+#define JUMP_BYTES  5
+#define TAIL_BYTES  10                 /* dec, jnz rel32, ret */
+
+static uint8_t *put_rel32(uint8_t *p, const uint8_t *next, const uint8_t *target) {
+    int32_t rel = (int32_t)(target - next);
+    memcpy(p, &rel, sizeof(rel));
+    return p + 4;
+}
+
+static uint8_t *emit_nops(uint8_t *p, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        static const uint8_t nop4[NOP_BYTES] = { 0x0F, 0x1F, 0x40, 0x00 };
+        memcpy(p, nop4, NOP_BYTES);
+        p += NOP_BYTES;
+    }
+    return p;
+}
+
+static void emit_jump(uint8_t *p, const uint8_t *target) {
+    *p = 0xE9;                                             /* jmp rel32 */
+    put_rel32(p + 1, p + JUMP_BYTES, target);
+}
+
+static void emit_tail(uint8_t *p, const uint8_t *entry) {
+    /* The lap counter is the first integer argument */
+#if defined(MEMBENCH_PLATFORM_WINDOWS)
+    static const uint8_t dec[3] = { 0x48, 0xFF, 0xC9 };    /* dec rcx */
+#else
+    static const uint8_t dec[3] = { 0x48, 0xFF, 0xCF };    /* dec rdi */
+#endif
+    memcpy(p, dec, sizeof(dec));
+    p[3] = 0x0F;                                           /* jnz rel32 */
+    p[4] = 0x85;
+    put_rel32(p + 5, p + 9, entry);
+    p[9] = 0xC3;                                           /* ret */
+}
+#else /* ARM64 */
+#define NOP_BYTES   4
+#define JUMP_BYTES  4
+#define TAIL_BYTES  16                 /* subs, b.eq ret, b entry, ret */
+
+static void put32(uint8_t *p, uint32_t insn) {
+    memcpy(p, &insn, sizeof(insn));
+}
+
+static uint8_t *emit_nops(uint8_t *p, size_t count) {
+    for (size_t i = 0; i < count; i++, p += NOP_BYTES) put32(p, 0xD503201FU);
+    return p;
+}
+
+static void emit_jump(uint8_t *p, const uint8_t *target) {
+    int64_t words = (int64_t)(target - p) / 4;             /* b: +-128 MB */
+    put32(p, 0x14000000U | ((uint32_t)words & 0x03FFFFFFU));
+}
+
+static void emit_tail(uint8_t *p, const uint8_t *entry) {
+    put32(p, 0xF1000400U);                                 /* subs x0, x0, #1 */
+    put32(p + 4, 0x54000000U | (2U << 5));                 /* b.eq +8 */
+    emit_jump(p + 8, entry);                               /* b entry */
+    put32(p + 12, 0xD65F03C0U);                            /* ret */
+}
+#endif
+
+static int code_writable(void *p, size_t n) {
+#if defined(MEMBENCH_PLATFORM_WINDOWS)
+    DWORD old;
+    return VirtualProtect(p, n, PAGE_READWRITE, &old) ? 0 : -1;
+#else
+    return mprotect(p, n, PROT_READ | PROT_WRITE);
+#endif
+}
+
+static int code_executable(void *p, size_t n) {
+#if defined(MEMBENCH_PLATFORM_WINDOWS)
+    DWORD old;
+    if (!VirtualProtect(p, n, PAGE_EXECUTE_READ, &old)) return -1;
+    FlushInstructionCache(GetCurrentProcess(), p, n);
+    return 0;
+#else
+    if (mprotect(p, n, PROT_READ | PROT_EXEC) != 0) return -1;
+  #if defined(MEMBENCH_ARCH_ARM64)
+    __builtin___clear_cache((char *)p, (char *)p + n);
+  #endif
+    return 0;
+#endif
+}
+
+/*
+ * Write a chain of `blocks` blocks into `code` and return its entry.
+ * Block k sits at k * stride; `order` is a random cyclic visiting order
+ * starting at block 0.
+ */
+static uint8_t *build_chain(uint8_t *code, size_t blocks, size_t stride, size_t nops,
+                            size_t *order) {
+    uint64_t rng = MEMBENCH_CHASE_SEED;
+    for (size_t i = 0; i < blocks; i++) order[i] = i;
+    for (size_t i = blocks - 1; i > 1; i--) {                /* keep block 0 first */
+        size_t j = 1 + (size_t)rng_below(&rng, i);
+        size_t t = order[i]; order[i] = order[j]; order[j] = t;
+    }
+
+    size_t tail_nops = (stride - TAIL_BYTES) / NOP_BYTES;
+    if (tail_nops > nops) tail_nops = nops;
+    for (size_t k = 0; k + 1 < blocks; k++) {
+        uint8_t *p = emit_nops(code + order[k] * stride, nops);
+        emit_jump(p, code + order[k + 1] * stride);
+    }
+    emit_tail(emit_nops(code + order[blocks - 1] * stride, tail_nops), code);
+    return code;
+}
+
+/* Best of ICACHE_REPEATS timed runs of `laps` laps, in ns per block */
+static double time_chain(uint8_t *entry, size_t blocks, uint64_t laps) {
+    chain_fn fn;
+    memcpy(&fn, &entry, sizeof(fn));     /* object to function pointer */
+    fn(1);                               /* warm-up lap */
+    uint64_t best = UINT64_MAX;
+    for (int r = 0; r < ICACHE_REPEATS; r++) {
+        uint64_t t0 = membench_timer_ns();
+        fn(laps);
+        uint64_t ns = membench_timer_ns() - t0;
+        if (ns < best) best = ns;
+    }
+    return (double)best / ((double)laps * (double)blocks);
+}
+
+#endif /* HAVE_CODEGEN */
+
+/* ── Public API ───────────────────────────────────────────────────────────── */
+
+int membench_cpu_icache_sweep(membench_icache_sweep_t sweep, size_t max_footprint,
+                              uint64_t visits, membench_icache_result_t *result) {
+    if (!result || sweep >= MEMBENCH_ICACHE_NUM_SWEEPS) return -1;
+    memset(result, 0, sizeof(*result));
+    result->sweep = sweep;
+#if !defined(HAVE_CODEGEN)
+    (void)max_footprint;
+    (void)visits;
+    return -2;
+#else
+    if (visits == 0) visits = ICACHE_VISITS;
+    size_t nops = sweep == MEMBENCH_ICACHE_UOPS ? UOP_BLOCK_NOPS : 0;
+    size_t stride = sweep == MEMBENCH_ICACHE_PAGES ? PAGE_STRIDE : LINE_BYTES;
+    size_t min_bytes = sweep == MEMBENCH_ICACHE_PAGES ? ICACHE_PAGE_MIN : ICACHE_MIN_BYTES;
+    result->stride = stride;
+    result->block_instrs = nops + 1;
+    if (max_footprint < min_bytes * 16) max_footprint = min_bytes * 16;
+
+    size_t *sizes = NULL;
+    size_t num = membench_cpu_generate_sizes(min_bytes, max_footprint, STEPS_PER_OCTAVE,
+                                             &sizes);
+    if (num == 0) return -1;
+
+    /*
+     * Huge pages keep iTLB misses out of the line and uop sweeps.  The
+     * buffer is aligned to a huge page and protection is always changed a
+     * whole huge page at a time: mprotect() on part of one splits it back
+     * into small pages.
+     */
+    int huge = sweep != MEMBENCH_ICACHE_PAGES;
+    size_t grain = huge ? HUGE_BYTES : membench_page_size();
+    size_t max_blocks = max_footprint / stride;
+    size_t code_bytes = ((max_blocks + 1) * stride + grain - 1) / grain * grain;
+    size_t alloc_bytes = code_bytes + (huge ? HUGE_BYTES : 0);
+    double *ns = (double *)malloc(num * sizeof(double));
+    size_t *order = (size_t *)malloc(max_blocks * sizeof(size_t));
+    membench_page_policy_t old_pages = membench_alloc_set_pages(
+        huge ? MEMBENCH_PAGES_HUGE : MEMBENCH_PAGES_DEFAULT);
+    uint8_t *base = (uint8_t *)membench_alloc(alloc_bytes);
+    membench_alloc_set_pages(old_pages);
+    uint8_t *code = base;
+    if (base && huge)
+        code = base + (HUGE_BYTES - (uintptr_t)base % HUGE_BYTES) % HUGE_BYTES;
+    int rc = (ns && order && base) ? 0 : -1;
+
+    size_t kept = 0, prev_blocks = 0;
+    for (size_t i = 0; rc == 0 && i < num; i++) {
+        if (membench_cancel_requested()) { rc = -1; break; }
+        size_t blocks = sizes[i] / stride;
+        if (blocks < 2 || blocks == prev_blocks) continue;
+        prev_blocks = blocks;
+
+        size_t span = ((blocks + 1) * stride + grain - 1) / grain * grain;
+        if (code_writable(code, span) != 0) { rc = -2; break; }
+        uint8_t *entry = build_chain(code, blocks, stride, nops, order);
+        if (code_executable(code, span) != 0) { rc = -2; break; }
+
+        uint64_t laps = visits / blocks;
+        if (laps < ICACHE_MIN_LAPS) laps = ICACHE_MIN_LAPS;
+        sizes[kept] = blocks * stride;
+        ns[kept] = time_chain(entry, blocks, laps);
+        kept++;
+    }
+
+    if (base) {
+        code_writable(code, code_bytes);   /* back to plain data for the free */
+        membench_free(base, alloc_bytes);
+    }
+    free(order);
+    if (rc != 0) {
+        free(sizes);
+        free(ns);
+        return rc;
+    }
+
+    detect_boundaries(sizes, ns, kept, &result->curve);
+    result->curve.num_samples = kept;
+    result->curve.sample_sizes = sizes;
+    result->curve.sample_latencies = ns;
+    return 0;
+#endif
+}
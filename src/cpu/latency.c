@@ -15,9 +15,10 @@
 #include "membench/alloc.h"
 #include "membench/timer.h"
 #include "membench/platform.h"
+#include "membench/profile.h"
+#include "cpu_internal.h"
 
 #include <stdlib.h>
-#include <string.h>
 
 /* ── Constants ────────────────────────────────────────────────────────────── */
 
@@ -31,7 +32,7 @@
 #include <sys/sysctl.h>
 #endif
 
-static size_t membench_get_cache_line_size(void) {
+size_t membench_get_cache_line_size(void) {
 #if defined(MEMBENCH_PLATFORM_MACOS)
     size_t line = 0, sz = sizeof(line);
     if (sysctlbyname("hw.cachelinesize", &line, &sz, NULL, 0) == 0 && line > 0)
@@ -49,9 +50,11 @@ static size_t membench_get_cache_line_size(void) {
  * Build a random cyclic pointer-chase within buf. 
  * `node_count` nodes are each CACHE_LINE_BYTES apart.
  * Node i lives at buf[i * PTRS_PER_LINE].
- * The chain visits every node exactly once.
+ * The chain visits every node exactly once; the order depends only on
+ * `seed`, so concurrent callers cannot disturb each other.
  */
-static void build_pointer_chase_cl(void **buf, size_t node_count, size_t ptrs_per_line) {
+void build_pointer_chase_cl(void **buf, size_t node_count, size_t ptrs_per_line,
+                            uint64_t seed) {
     /* Fisher-Yates shuffle of node indices → random Hamiltonian cycle */
     size_t *idx = (size_t *)malloc(node_count * sizeof(size_t));
     if (!idx) return;
@@ -59,7 +62,7 @@ static void build_pointer_chase_cl(void **buf, size_t node_count, size_t ptrs_pe
     for (size_t i = 0; i < node_count; i++) idx[i] = i;
 
     for (size_t i = node_count - 1; i > 0; i--) {
-        size_t j = (size_t)rand() % (i + 1);
+        size_t j = (size_t)rng_below(&seed, i + 1);
         size_t tmp = idx[i]; idx[i] = idx[j]; idx[j] = tmp;
     }
 
@@ -71,58 +74,82 @@ static void build_pointer_chase_cl(void **buf, size_t node_count, size_t ptrs_pe
     free(idx);
 }
 
-/* ── Memory fence helpers ─────────────────────────────────────────────────── */
-
-MEMBENCH_INLINE void memory_fence(void) {
-#if defined(MEMBENCH_ARCH_X86_64) || defined(MEMBENCH_ARCH_X86)
-    #ifdef _MSC_VER
-        _ReadWriteBarrier();
-    #else
-        __asm__ __volatile__("mfence" ::: "memory");
-    #endif
-#elif defined(MEMBENCH_ARCH_ARM64)
-    #ifdef _MSC_VER
-        __dmb(_ARM64_BARRIER_SY);
-    #else
-        __asm__ __volatile__("dmb sy" ::: "memory");
-    #endif
-#else
-    /* Generic C11 fallback — compiler fence only */
-    __asm__ __volatile__("" ::: "memory");
-#endif
-}
+/* ── Unrolled chase kernels ───────────────────────────────────────────────── */
 
-/**
- * Force-read a pointer through volatile to prevent the compiler
- * from optimizing out the dereference chain.  The cast to
- * (void * volatile *) makes each load non-eliminable.
+/*
+ * A plain chase loop spends a counter increment, compare and branch on
+ * every load.  Out-of-order cores mostly hide that behind the load, but
+ * at L1, where a load is only 4-5 cycles, it still shows.  Each variant
+ * below does `blocks` blocks of U dependent loads with one loop test per
+ * block; the run picks the largest U no longer than the chain.
  */
-MEMBENCH_INLINE void **chase_load(void **p) {
-    return (void **)(*(void * volatile *)p);
+typedef void **(*chase_kernel_fn)(void **p, uint64_t blocks);
+
+#define CHASE_STEP(k) p = chase_load(p);
+#define DEFINE_CHASE_KERNEL(U)                                                \
+    static void **chase_x##U(void **p, uint64_t blocks) {                     \
+        for (uint64_t b = 0; b < blocks; b++) {                               \
+            UNROLL##U(CHASE_STEP, 0)                                          \
+        }                                                                     \
+        return p;                                                             \
+    }
+
+DEFINE_CHASE_KERNEL(1)
+DEFINE_CHASE_KERNEL(4)
+DEFINE_CHASE_KERNEL(8)
+DEFINE_CHASE_KERNEL(16)
+DEFINE_CHASE_KERNEL(32)
+
+static const struct {
+    size_t unroll;
+    chase_kernel_fn fn;
+    const char *name;
+} CHASE_KERNELS[] = {
+    { 32, chase_x32, "chase-x32" },
+    { 16, chase_x16, "chase-x16" },
+    {  8, chase_x8,  "chase-x8"  },
+    {  4, chase_x4,  "chase-x4"  },
+    {  1, chase_x1,  "chase-x1"  },
+};
+#define NUM_CHASE_KERNELS (sizeof(CHASE_KERNELS) / sizeof(CHASE_KERNELS[0]))
+
+static size_t chase_node_count(size_t buffer_size) {
+    size_t node_count = buffer_size / membench_get_cache_line_size();
+    return node_count < 2 ? 2 : node_count;
+}
+
+static size_t pick_chase_kernel(size_t node_count) {
+    size_t k = 0;
+    while (k + 1 < NUM_CHASE_KERNELS && CHASE_KERNELS[k].unroll > node_count) k++;
+    return k;
+}
+
+const char *chase_kernel_name(size_t buffer_size) {
+    return CHASE_KERNELS[pick_chase_kernel(chase_node_count(buffer_size))].name;
 }
 
 /* ── Read latency (pointer-chase, cache-line stride) ──────────────────────── */
 
-int membench_cpu_read_latency(size_t buffer_size, uint64_t iterations,
-                              membench_latency_result_t *result) {
+int chase_read_latency(size_t buffer_size, uint64_t iterations, uint64_t seed,
+                       membench_latency_result_t *result) {
     size_t cl = membench_get_cache_line_size();
     size_t ptrs_per_line = cl / sizeof(void *);
 
     if (!result || buffer_size < cl) return -1;
 
     /* Number of cache-line-spaced nodes that fit in the buffer */
-    size_t node_count = buffer_size / cl;
-    if (node_count < 2) node_count = 2;
+    size_t node_count = chase_node_count(buffer_size);
 
     /* Allocate the full array (node_count * ptrs_per_line pointers) */
     size_t alloc_elems = node_count * ptrs_per_line;
+    uint64_t t = membench_timer_ns();
     void **buf = (void **)membench_alloc(alloc_elems * sizeof(void *));
     if (!buf) return -1;
+    t = membench_phase_mark(MEMBENCH_PHASE_ALLOC, t);
 
-    /* Zero-fill, then build the cache-line-stride chase */
-    memset(buf, 0, alloc_elems * sizeof(void *));
-    srand(42);
-    build_pointer_chase_cl(buf, node_count, ptrs_per_line);
+    /* membench_alloc returns zeroed memory; build the cache-line-stride chase */
+    build_pointer_chase_cl(buf, node_count, ptrs_per_line, seed);
+    t = membench_phase_mark(MEMBENCH_PHASE_BUILD, t);
 
     /* Warmup: one full traversal */
     {
@@ -133,19 +160,21 @@ int membench_cpu_read_latency(size_t buffer_size, uint64_t iterations,
         memory_fence();
         (void)p;
     }
+    membench_phase_mark(MEMBENCH_PHASE_WARMUP, t);
 
-    /* Timed traversals */
+    /* Timed traversals: the chain is cyclic, so laps need not line up with
+     * unrolled blocks; the remainder runs one load at a time */
+    size_t k = pick_chase_kernel(node_count);
     uint64_t total_accesses = iterations * node_count;
+    uint64_t blocks = total_accesses / CHASE_KERNELS[k].unroll;
+    uint64_t rest = total_accesses % CHASE_KERNELS[k].unroll;
     void **p = &buf[0];
 
     memory_fence();
     uint64_t start = membench_timer_ns();
 
-    for (uint64_t iter = 0; iter < iterations; iter++) {
-        for (size_t i = 0; i < node_count; i++) {
-            p = chase_load(p);
-        }
-    }
+    p = CHASE_KERNELS[k].fn(p, blocks);
+    p = chase_x1(p, rest);
 
     memory_fence();
     uint64_t end = membench_timer_ns();
@@ -153,12 +182,15 @@ int membench_cpu_read_latency(size_t buffer_size, uint64_t iterations,
     /* Prevent dead-code elimination */
     volatile void *sink = p;
     (void)sink;
+    membench_phase_span(MEMBENCH_PHASE_MEASURE, start, end);
 
     result->buffer_size = buffer_size;
     result->accesses = total_accesses;
     result->avg_latency_ns = (double)(end - start) / (double)total_accesses;
+    result->kernel = CHASE_KERNELS[k].name;
 
     membench_free(buf, alloc_elems * sizeof(void *));
+    membench_phase_mark(MEMBENCH_PHASE_FREE, end);
     return 0;
 }
 
@@ -175,8 +207,8 @@ int membench_cpu_read_latency(size_t buffer_size, uint64_t iterations,
  *   word[0] = next pointer       (used for the chase)
  *   word[1] = scratch for writes (modified each visit)
  */
-int membench_cpu_write_latency(size_t buffer_size, uint64_t iterations,
-                               membench_latency_result_t *result) {
+int chase_write_latency(size_t buffer_size, uint64_t iterations, uint64_t seed,
+                        membench_latency_result_t *result) {
     size_t cl = membench_get_cache_line_size();
     size_t ptrs_per_line = cl / sizeof(void *);
 
@@ -186,13 +218,14 @@ int membench_cpu_write_latency(size_t buffer_size, uint64_t iterations,
     if (node_count < 2) node_count = 2;
 
     size_t alloc_elems = node_count * ptrs_per_line;
+    uint64_t t = membench_timer_ns();
     void **buf = (void **)membench_alloc(alloc_elems * sizeof(void *));
     if (!buf) return -1;
+    t = membench_phase_mark(MEMBENCH_PHASE_ALLOC, t);
 
-    /* Build cache-line-stride chase */
-    memset(buf, 0, alloc_elems * sizeof(void *));
-    srand(42);
-    build_pointer_chase_cl(buf, node_count, ptrs_per_line);
+    /* Build cache-line-stride chase (membench_alloc returns zeroed memory) */
+    build_pointer_chase_cl(buf, node_count, ptrs_per_line, seed);
+    t = membench_phase_mark(MEMBENCH_PHASE_BUILD, t);
 
     /* Warmup */
     {
@@ -203,6 +236,7 @@ int membench_cpu_write_latency(size_t buffer_size, uint64_t iterations,
         }
         memory_fence();
     }
+    membench_phase_mark(MEMBENCH_PHASE_WARMUP, t);
 
     /* Timed traversals: read pointer -> write scratch -> follow -> repeat */
     uint64_t total_accesses = iterations * node_count;
@@ -225,11 +259,26 @@ int membench_cpu_write_latency(size_t buffer_size, uint64_t iterations,
 
     volatile void *sink = p;
     (void)sink;
+    membench_phase_span(MEMBENCH_PHASE_MEASURE, start, end);
 
     result->buffer_size = buffer_size;
     result->accesses = total_accesses;
     result->avg_latency_ns = (double)(end - start) / (double)total_accesses;
+    result->kernel = NULL;
 
     membench_free(buf, alloc_elems * sizeof(void *));
+    membench_phase_mark(MEMBENCH_PHASE_FREE, end);
     return 0;
 }
+
+/* ── Public entry points (fixed seed, reproducible chains) ─────────────────── */
+
+int membench_cpu_read_latency(size_t buffer_size, uint64_t iterations,
+                              membench_latency_result_t *result) {
+    return chase_read_latency(buffer_size, iterations, MEMBENCH_CHASE_SEED, result);
+}
+
+int membench_cpu_write_latency(size_t buffer_size, uint64_t iterations,
+                               membench_latency_result_t *result) {
+    return chase_write_latency(buffer_size, iterations, MEMBENCH_CHASE_SEED, result);
+}
@@ -0,0 +1,360 @@
+/**
+ * license.c — Frequency license impact of wide vector code.
+ *
+ * Many x86 cores run heavy 256- and 512-bit instructions at a lower clock
+ * (a "license") than scalar code, and stay there for a while after the
+ * vector code stops, slowing whatever runs next on the core.  Each width
+ * the CPU supports is measured the same way:
+ *
+ *   base   one window of scalar probes; the second half is kept, by which
+ *          time any earlier license has expired
+ *   burst  passes of vector multiply-adds over the buffer, with a probe
+ *          between passes once per pacing interval; the second half is kept
+ *   after  one window of probes straight after the last pass, binned into
+ *          MEMBENCH_LICENSE_SLOTS slots
+ *
+ * The probe is a dependent 64-bit multiply-add chain (4 cycles a step, as
+ * in the clock monitor) for the effective clock and a short chase through
+ * an L1-resident chain for the latency that scalar code sees.  Both are
+ * scalar, so the probe never holds a license of its own.  Every width runs
+ * LICENSE_REPEATS times and each figure is the median over all of them,
+ * which drops the odd preempted sample.
+ */
+#include "membench/bench_cpu.h"
+#include "membench/alloc.h"
+#include "membench/timer.h"
+#include "cpu_internal.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(MEMBENCH_ARCH_X86_64)
+    #include <emmintrin.h>
+    #include <immintrin.h>
+    #define HAVE_SSE2 1
+    #if defined(__GNUC__) || defined(__clang__)
+        #define HAVE_AVX 1
+        #define AVX2_ATTR   __attribute__((target("avx2,fma")))
+        #define AVX512_ATTR __attribute__((target("avx512f")))
+    #elif defined(_MSC_VER)
+        #define HAVE_AVX 1
+        #define AVX2_ATTR
+        #define AVX512_ATTR
+    #endif
+#elif defined(MEMBENCH_ARCH_ARM64)
+    #include <arm_neon.h>
+    #define HAVE_NEON 1
+#endif
+
+#define LICENSE_REPEATS    5
+#define PACE_NS            16000ULL    /* at most one probe per interval */
+#define PROBE_SPIN_STEPS   512
+#define PROBE_CYCLES_STEP  4.0         /* 64-bit multiply + add, dependent */
+#define PROBE_CHASE_BYTES  4096        /* one page, beside the burst in L1 */
+#define PROBE_CHASE_STEPS  1024
+#define RECOVERED_PCT      3.0         /* a slot this close to base is recovered */
+#define BURST_ALIGN        64          /* doubles per kernel step, any width */
+#define BURST_MUL          0.999999
+
+static volatile double g_burst_sink;
+
+/* ── Vector kernels ───────────────────────────────────────────────────────── */
+
+/*
+ * One pass over `n` doubles: eight independent multiply-add accumulators
+ * fed straight from loads, the heaviest instruction mix a width has.  P
+ * names a family of macros as in roofline.c: P##_V, P##_L, P##_SET1,
+ * P##_LOAD, P##_ADD, P##_FMA(a, b, c) = a*b + c, P##_STORE.
+ */
+#define DEFINE_BURST_KERNEL(ISA, ATTR, P)                                     \
+    ATTR static double burst_##ISA(const double *buf, size_t n) {             \
+        const size_t L = P##_L;                                               \
+        const P##_V m = P##_SET1(BURST_MUL);                                  \
+        P##_V a0 = P##_SET1(0.0), a1 = a0, a2 = a0, a3 = a0,                  \
+              a4 = a0, a5 = a0, a6 = a0, a7 = a0;                             \
+        for (size_t i = 0; i < n; i += 8 * L) {                               \
+            const double *q = buf + i;                                        \
+            a0 = P##_FMA(P##_LOAD(q), m, a0);                                 \
+            a1 = P##_FMA(P##_LOAD(q + L), m, a1);                             \
+            a2 = P##_FMA(P##_LOAD(q + 2 * L), m, a2);                         \
+            a3 = P##_FMA(P##_LOAD(q + 3 * L), m, a3);                         \
+            a4 = P##_FMA(P##_LOAD(q + 4 * L), m, a4);                         \
+            a5 = P##_FMA(P##_LOAD(q + 5 * L), m, a5);                         \
+            a6 = P##_FMA(P##_LOAD(q + 6 * L), m, a6);                         \
+            a7 = P##_FMA(P##_LOAD(q + 7 * L), m, a7);                         \
+        }                                                                     \
+        a0 = P##_ADD(P##_ADD(P##_ADD(a0, a1), P##_ADD(a2, a3)),               \
+                     P##_ADD(P##_ADD(a4, a5), P##_ADD(a6, a7)));              \
+        double lanes[P##_L], sum = 0.0;                                       \
+        P##_STORE(lanes, a0);                                                 \
+        for (int l = 0; l < P##_L; l++) sum += lanes[l];                      \
+        return sum;                                                           \
+    }
+
+#if defined(HAVE_SSE2)
+#define SSE_V            __m128d
+#define SSE_L            2
+#define SSE_SET1         _mm_set1_pd
+#define SSE_LOAD         _mm_load_pd
+#define SSE_ADD          _mm_add_pd
+#define SSE_FMA(a, b, c) _mm_add_pd(_mm_mul_pd(a, b), c)
+#define SSE_STORE        _mm_storeu_pd
+DEFINE_BURST_KERNEL(sse2, , SSE)
+#endif
+
+#if defined(HAVE_AVX)
+#define AVX_V            __m256d
+#define AVX_L            4
+#define AVX_SET1         _mm256_set1_pd
+#define AVX_LOAD         _mm256_load_pd
+#define AVX_ADD          _mm256_add_pd
+#define AVX_FMA          _mm256_fmadd_pd
+#define AVX_STORE        _mm256_storeu_pd
+DEFINE_BURST_KERNEL(avx2, AVX2_ATTR, AVX)
+
+#define AVX512_V         __m512d
+#define AVX512_L         8
+#define AVX512_SET1      _mm512_set1_pd
+#define AVX512_LOAD      _mm512_load_pd
+#define AVX512_ADD       _mm512_add_pd
+#define AVX512_FMA       _mm512_fmadd_pd
+#define AVX512_STORE     _mm512_storeu_pd
+DEFINE_BURST_KERNEL(avx512, AVX512_ATTR, AVX512)
+#endif
+
+#if defined(HAVE_NEON)
+#define NEON_V           float64x2_t
+#define NEON_L           2
+#define NEON_SET1        vdupq_n_f64
+#define NEON_LOAD        vld1q_f64
+#define NEON_ADD         vaddq_f64
+#define NEON_FMA(a, b, c) vfmaq_f64(c, a, b)
+#define NEON_STORE       vst1q_f64
+DEFINE_BURST_KERNEL(neon, , NEON)
+#endif
+
+typedef struct {
+    int         bits;
+    const char *name;
+    double    (*pass)(const double *buf, size_t n);
+} license_isa_t;
+
+/** Widths this CPU can run, narrowest first. */
+static size_t license_isas(license_isa_t out[MEMBENCH_LICENSE_MAX_WIDTHS]) {
+    size_t n = 0;
+#if defined(HAVE_SSE2)
+    out[n++] = (license_isa_t){ 128, "sse2", burst_sse2 };
+#endif
+#if defined(HAVE_AVX)
+    if (cpu_has_avx2_fma()) out[n++] = (license_isa_t){ 256, "avx2-fma", burst_avx2 };
+    if (cpu_has_avx512f())  out[n++] = (license_isa_t){ 512, "avx512f", burst_avx512 };
+#endif
+#if defined(HAVE_NEON)
+    out[n++] = (license_isa_t){ 128, "neon", burst_neon };
+#endif
+    (void)out;
+    return n;
+}
+
+/* ── Scalar probe ─────────────────────────────────────────────────────────── */
+
+typedef struct {
+    void   **pos;                /* current node of the L1 chain */
+    uint64_t x;                  /* multiply-add chain state */
+} probe_t;
+
+MEMBENCH_NO_VECTORIZE
+static void probe(probe_t *p, double *ghz, double *chase_ns) {
+    uint64_t t0 = membench_timer_ns();
+    uint64_t x = p->x;
+    SCALAR_LOOP
+    for (int i = 0; i < PROBE_SPIN_STEPS; i++)
+        x = x * 6364136223846793005ULL + 1442695040888963407ULL;
+    uint64_t t1 = membench_timer_ns();
+    void **q = p->pos;
+    for (int i = 0; i < PROBE_CHASE_STEPS; i++) q = chase_load(q);
+    memory_fence();
+    uint64_t t2 = membench_timer_ns();
+    p->x = x;
+    p->pos = q;
+    *ghz = t1 > t0 ? PROBE_SPIN_STEPS * PROBE_CYCLES_STEP / (double)(t1 - t0) : 0.0;
+    *chase_ns = t2 > t1 ? (double)(t2 - t1) / PROBE_CHASE_STEPS : 0.0;
+}
+
+/* Probe results of one phase or slot, over all repeats */
+typedef struct {
+    double *ghz;
+    double *chase_ns;
+    size_t  n, cap;
+} samples_t;
+
+static void samples_push(samples_t *s, double ghz, double chase_ns) {
+    if (s->n >= s->cap || ghz <= 0.0 || chase_ns <= 0.0) return;
+    s->ghz[s->n] = ghz;
+    s->chase_ns[s->n] = chase_ns;
+    s->n++;
+}
+
+static int cmp_double(const void *a, const void *b) {
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+/** Median of v[0..n), sorting v; 0 when empty. */
+static double median(double *v, size_t n) {
+    if (n == 0) return 0.0;
+    qsort(v, n, sizeof(double), cmp_double);
+    return n % 2 ? v[n / 2] : 0.5 * (v[n / 2 - 1] + v[n / 2]);
+}
+
+/* Every sample set of one width: base, during, then one per slot */
+#define SET_BASE    0
+#define SET_DURING  1
+#define SET_SLOT0   2
+#define NUM_SETS    (SET_SLOT0 + MEMBENCH_LICENSE_SLOTS)
+
+/* ── One repeat ───────────────────────────────────────────────────────────── */
+
+static void run_once(const license_isa_t *isa, const double *buf, size_t n, probe_t *p,
+                     uint64_t burst_ns, uint64_t window_ns, samples_t *sets,
+                     double *bytes, double *vector_ns) {
+    double g, c;
+
+    /* Base: scalar only, probing on the pacing grid */
+    uint64_t start = membench_timer_ns(), next = start, now = start;
+    while (now - start < window_ns) {
+        if (now >= next) {
+            next = now + PACE_NS;
+            probe(p, &g, &c);
+            if (now - start >= window_ns / 2) samples_push(&sets[SET_BASE], g, c);
+        }
+        now = membench_timer_ns();
+    }
+
+    /* Burst: vector passes back to back, a probe between two when one is due */
+    start = membench_timer_ns();
+    next = start + PACE_NS;
+    now = start;
+    double sink = 0.0;
+    while (now - start < burst_ns) {
+        uint64_t t0 = now;
+        sink += isa->pass(buf, n);
+        now = membench_timer_ns();
+        *vector_ns += (double)(now - t0);
+        *bytes += (double)n * sizeof(double);
+        if (now >= next) {
+            next = now + PACE_NS;
+            probe(p, &g, &c);
+            if (now - start >= burst_ns / 2) samples_push(&sets[SET_DURING], g, c);
+            now = membench_timer_ns();
+        }
+    }
+    g_burst_sink = sink;
+
+    /* After: scalar only again, each probe binned by when it started */
+    start = membench_timer_ns();
+    next = start;
+    now = start;
+    while (now - start < window_ns) {
+        if (now >= next) {
+            next = now + PACE_NS;
+            size_t slot = (size_t)((now - start) * MEMBENCH_LICENSE_SLOTS / window_ns);
+            probe(p, &g, &c);
+            samples_push(&sets[SET_SLOT0 + slot], g, c);
+        }
+        now = membench_timer_ns();
+    }
+}
+
+static void summarize(samples_t *sets, double window_us, membench_license_width_t *w) {
+    w->base_ghz = median(sets[SET_BASE].ghz, sets[SET_BASE].n);
+    w->base_chase_ns = median(sets[SET_BASE].chase_ns, sets[SET_BASE].n);
+    w->during_ghz = median(sets[SET_DURING].ghz, sets[SET_DURING].n);
+    w->during_chase_ns = median(sets[SET_DURING].chase_ns, sets[SET_DURING].n);
+    for (size_t i = 0; i < MEMBENCH_LICENSE_SLOTS; i++) {
+        samples_t *s = &sets[SET_SLOT0 + i];
+        w->slot_ghz[i] = median(s->ghz, s->n);
+        w->slot_chase_ns[i] = median(s->chase_ns, s->n);
+    }
+    w->after_ghz = w->slot_ghz[0];
+    w->after_chase_ns = w->slot_chase_ns[0];
+    if (w->base_ghz > 0.0 && w->during_ghz > 0.0)
+        w->drop_pct = 100.0 * (1.0 - w->during_ghz / w->base_ghz);
+
+    /* Recovered at the end of the run of low slots the burst left behind;
+     * a lone dip later in the window is noise, not the license */
+    size_t low = 0;
+    double floor_ghz = w->base_ghz * (1.0 - RECOVERED_PCT / 100.0);
+    while (low < MEMBENCH_LICENSE_SLOTS && w->slot_ghz[low] < floor_ghz) low++;
+    w->recovery_us = low == MEMBENCH_LICENSE_SLOTS
+                     ? -1.0 : (double)low * window_us / MEMBENCH_LICENSE_SLOTS;
+}
+
+/* ── Public API ───────────────────────────────────────────────────────────── */
+
+int membench_cpu_vector_license(size_t buffer_bytes, double burst_ms, double window_ms,
+                                membench_license_t *result) {
+    if (!result || burst_ms <= 0.0 || window_ms <= 0.0) return -1;
+    memset(result, 0, sizeof(*result));
+
+    size_t n = buffer_bytes / sizeof(double) / BURST_ALIGN * BURST_ALIGN;
+    if (n == 0) n = BURST_ALIGN;
+    uint64_t burst_ns = (uint64_t)(burst_ms * 1e6);
+    uint64_t window_ns = (uint64_t)(window_ms * 1e6);
+    result->buffer_bytes = n * sizeof(double);
+    result->burst_ms = burst_ms;
+    result->window_ms = window_ms;
+    result->repeats = LICENSE_REPEATS;
+
+    license_isa_t isas[MEMBENCH_LICENSE_MAX_WIDTHS];
+    size_t num_isas = license_isas(isas);
+    if (num_isas == 0) return 0;
+
+    /* Room for every probe the pacing allows in each set, over all repeats */
+    size_t caps[NUM_SETS], total = 0;
+    caps[SET_BASE] = (size_t)(window_ns / 2 / PACE_NS + 2) * LICENSE_REPEATS;
+    caps[SET_DURING] = (size_t)(burst_ns / 2 / PACE_NS + 2) * LICENSE_REPEATS;
+    for (size_t i = 0; i < MEMBENCH_LICENSE_SLOTS; i++)
+        caps[SET_SLOT0 + i] = (size_t)(window_ns / MEMBENCH_LICENSE_SLOTS / PACE_NS + 2)
+                              * LICENSE_REPEATS;
+    for (size_t i = 0; i < NUM_SETS; i++) total += caps[i];
+
+    size_t cl = membench_get_cache_line_size();
+    size_t ptrs_per_line = cl / sizeof(void *);
+    size_t chain_nodes = PROBE_CHASE_BYTES / cl;
+    size_t chain_bytes = chain_nodes * cl;
+
+    double *store = (double *)malloc(total * 2 * sizeof(double));
+    double *buf = (double *)membench_alloc(result->buffer_bytes);
+    void **chain = (void **)membench_alloc(chain_bytes);
+    int rc = (store && buf && chain) ? 0 : -1;
+
+    if (rc == 0) {
+        for (size_t i = 0; i < n; i++) buf[i] = 1e-3;
+        build_pointer_chase_cl(chain, chain_nodes, ptrs_per_line, MEMBENCH_CHASE_SEED);
+        probe_t p = { chain, 1 };
+
+        for (size_t w = 0; w < num_isas; w++) {
+            samples_t sets[NUM_SETS];
+            double *at = store;
+            for (size_t i = 0; i < NUM_SETS; i++) {
+                sets[i] = (samples_t){ at, at + caps[i], 0, caps[i] };
+                at += 2 * caps[i];
+            }
+            double bytes = 0.0, vector_ns = 0.0;
+            for (int r = 0; r < LICENSE_REPEATS; r++)
+                run_once(&isas[w], buf, n, &p, burst_ns, window_ns, sets, &bytes, &vector_ns);
+
+            membench_license_width_t *out = &result->widths[result->num_widths++];
+            out->width_bits = isas[w].bits;
+            out->isa = isas[w].name;
+            out->burst_gbps = membench_gbps(bytes, vector_ns);
+            summarize(sets, window_ms * 1000.0, out);
+        }
+    }
+
+    free(store);
+    if (buf) membench_free(buf, result->buffer_bytes);
+    if (chain) membench_free(chain, chain_bytes);
+    return rc;
+}
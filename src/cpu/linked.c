@@ -0,0 +1,250 @@
+/**
+ * linked.c — Linked-structure traversal benchmark.
+ *
+ * Times full traversals of a singly linked list and of a balanced binary
+ * search tree (iterative preorder walk) whose nodes are placed three ways:
+ *
+ *   pool       — one arena, nodes packed in traversal order
+ *   malloc     — one malloc() per node, in traversal order; the allocator's
+ *                headers and size-class rounding spread the nodes out
+ *   scattered  — one arena, nodes at random slots, as in a long-lived heap;
+ *                the slot order is the random cycle that the latency test's
+ *                build_pointer_chase_cl() lays over the arena
+ *
+ * All three orders are run for the same structure, node size and node
+ * count, and every result carries its slowdown relative to the pool.
+ *
+ * Node layout (machine words):
+ *   list:  [0] next,             [1] payload
+ *   tree:  [0] left, [1] right,  [2] key
+ * The rest of the node is padding up to node_bytes.
+ */
+#include "membench/bench_cpu.h"
+#include "membench/alloc.h"
+#include "membench/timer.h"
+#include "membench/platform.h"
+#include "cpu_internal.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define TREE_MAX_DEPTH 64
+#define AUTO_NODE_VISITS (4ULL << 20)
+
+typedef struct {
+    membench_alloc_order_t order;
+    size_t   node_bytes;
+    size_t   n;
+    unsigned char *arena;       /* pool, scattered */
+    size_t   arena_bytes;
+    void   **cursor;            /* scattered: next slot on the random cycle */
+    void   **nodes;             /* malloc: every node, for freeing */
+    size_t   handed;
+} node_pool_t;
+
+static int pool_init(node_pool_t *p, membench_alloc_order_t order,
+                     size_t node_bytes, size_t n) {
+    memset(p, 0, sizeof(*p));
+    p->order = order;
+    p->node_bytes = node_bytes;
+    p->n = n;
+
+    if (order == MEMBENCH_ALLOC_MALLOC) {
+        p->nodes = (void **)malloc(n * sizeof(void *));
+        return p->nodes ? 0 : -1;
+    }
+
+    p->arena_bytes = n * node_bytes;
+    p->arena = (unsigned char *)membench_alloc(p->arena_bytes);
+    if (!p->arena) return -1;
+
+    if (order == MEMBENCH_ALLOC_SCATTERED) {
+        build_pointer_chase_cl((void **)p->arena, n, node_bytes / sizeof(void *),
+                               MEMBENCH_CHASE_SEED);
+        p->cursor = (void **)p->arena;
+    }
+    return 0;
+}
+
+/** Hand out the next node; nodes come back zeroed. */
+static uintptr_t *pool_new(node_pool_t *p) {
+    void *node = NULL;
+    switch (p->order) {
+    case MEMBENCH_ALLOC_POOL:
+        node = p->arena + p->handed * p->node_bytes;
+        break;
+    case MEMBENCH_ALLOC_MALLOC:
+        node = malloc(p->node_bytes);
+        if (!node) return NULL;
+        p->nodes[p->handed] = node;
+        break;
+    default:
+        /* Follow the chase cycle before the caller overwrites the link */
+        node = p->cursor;
+        p->cursor = (void **)*p->cursor;
+        break;
+    }
+    memset(node, 0, p->node_bytes);
+    p->handed++;
+    return (uintptr_t *)node;
+}
+
+static void pool_destroy(node_pool_t *p) {
+    if (p->nodes) {
+        for (size_t i = 0; i < p->handed; i++) free(p->nodes[i]);
+        free(p->nodes);
+    }
+    if (p->arena) membench_free(p->arena, p->arena_bytes);
+}
+
+/* ── List ─────────────────────────────────────────────────────────────────── */
+
+static uintptr_t *list_build(node_pool_t *p) {
+    uintptr_t *head = pool_new(p);
+    if (!head) return NULL;
+    uintptr_t *prev = head;
+    for (size_t i = 1; i < p->n; i++) {
+        uintptr_t *node = pool_new(p);
+        if (!node) return NULL;
+        node[1] = i;
+        prev[0] = (uintptr_t)node;
+        prev = node;
+    }
+    prev[0] = (uintptr_t)head;   /* cyclic, like the latency chase */
+    return head;
+}
+
+static uint64_t list_walk(const uintptr_t *head, size_t n) {
+    uint64_t sum = 0;
+    const uintptr_t *p = head;
+    for (size_t i = 0; i < n; i++) {
+        sum += p[1];
+        p = (const uintptr_t *)p[0];
+    }
+    return sum + (p == head ? 0 : 1);   /* +1 flags a broken cycle */
+}
+
+/* ── Tree ─────────────────────────────────────────────────────────────────── */
+
+/** Balanced BST over keys [lo, hi), nodes created in preorder. */
+static uintptr_t *tree_build(node_pool_t *p, size_t lo, size_t hi) {
+    if (lo >= hi) return NULL;
+    size_t mid = lo + (hi - lo) / 2;
+    uintptr_t *node = pool_new(p);
+    if (!node) return NULL;
+    node[2] = mid;
+    node[0] = (uintptr_t)tree_build(p, lo, mid);
+    node[1] = (uintptr_t)tree_build(p, mid + 1, hi);
+    return node;
+}
+
+static uint64_t tree_walk(const uintptr_t *root) {
+    const uintptr_t *stack[TREE_MAX_DEPTH];
+    size_t top = 0;
+    uint64_t sum = 0;
+    stack[top++] = root;
+    while (top > 0) {
+        const uintptr_t *node = stack[--top];
+        sum += node[2];
+        if (node[1]) stack[top++] = (const uintptr_t *)node[1];
+        if (node[0]) stack[top++] = (const uintptr_t *)node[0];
+    }
+    return sum;
+}
+
+/* ── Public API ───────────────────────────────────────────────────────────── */
+
+static int run_order(membench_linked_kind_t kind, membench_alloc_order_t order,
+                     size_t node_bytes, size_t n, uint64_t passes,
+                     membench_linked_result_t *result) {
+    node_pool_t p;
+    if (pool_init(&p, order, node_bytes, n) != 0) {
+        pool_destroy(&p);
+        return -1;
+    }
+
+    const uintptr_t *root = (kind == MEMBENCH_LINKED_LIST)
+                            ? list_build(&p) : tree_build(&p, 0, n);
+    if (!root || p.handed != n) {
+        pool_destroy(&p);
+        return -1;
+    }
+
+    /* Warmup doubles as the check: keys 0..n-1 are each visited once */
+    uint64_t expect = (uint64_t)n * (n - 1) / 2;
+    uint64_t got = (kind == MEMBENCH_LINKED_LIST) ? list_walk(root, n) : tree_walk(root);
+    if (got != expect) {
+        pool_destroy(&p);
+        return -1;
+    }
+
+    uint64_t sum = 0;
+    memory_fence();
+    uint64_t start = membench_timer_ns();
+    for (uint64_t i = 0; i < passes; i++)
+        sum += (kind == MEMBENCH_LINKED_LIST) ? list_walk(root, n) : tree_walk(root);
+    memory_fence();
+    uint64_t end = membench_timer_ns();
+
+    volatile uint64_t sink = sum;
+    (void)sink;
+
+    double visits = (double)n * (double)passes;
+    result->kind = kind;
+    result->order = order;
+    result->node_bytes = node_bytes;
+    result->num_nodes = n;
+    result->working_set = n * node_bytes;
+    result->ns_per_node = (double)(end - start) / visits;
+    result->mnodes_per_s = visits * 1e3 / (double)(end - start);
+    result->vs_pool = 1.0;
+    result->passes = passes;
+
+    pool_destroy(&p);
+    return 0;
+}
+
+int membench_cpu_linked(membench_linked_kind_t kind, size_t node_bytes,
+                        size_t working_set, uint64_t passes,
+                        membench_linked_result_t results[MEMBENCH_ALLOC_NUM_ORDERS]) {
+    if (!results || passes == 0) return -1;
+    if ((unsigned)kind >= MEMBENCH_LINKED_NUM_KINDS) return -1;
+    if (node_bytes < 4 * sizeof(void *) || node_bytes % sizeof(void *) != 0) return -1;
+
+    size_t n = working_set / node_bytes;
+    if (n < 2) return -1;
+
+    for (int o = 0; o < MEMBENCH_ALLOC_NUM_ORDERS; o++) {
+        if (run_order(kind, (membench_alloc_order_t)o, node_bytes, n, passes,
+                      &results[o]) != 0)
+            return -1;
+    }
+    for (int o = 1; o < MEMBENCH_ALLOC_NUM_ORDERS; o++)
+        results[o].vs_pool = results[o].ns_per_node /
+                             results[MEMBENCH_ALLOC_POOL].ns_per_node;
+    return 0;
+}
+
+uint64_t membench_cpu_linked_auto_passes(size_t node_bytes, size_t working_set) {
+    size_t n = node_bytes ? working_set / node_bytes : 0;
+    if (n == 0) n = 1;
+    uint64_t passes = AUTO_NODE_VISITS / n;
+    return passes < 1 ? 1 : passes;
+}
+
+const char *membench_linked_kind_name(membench_linked_kind_t kind) {
+    switch (kind) {
+    case MEMBENCH_LINKED_LIST: return "list";
+    case MEMBENCH_LINKED_TREE: return "tree";
+    default:                   return "unknown";
+    }
+}
+
+const char *membench_alloc_order_name(membench_alloc_order_t order) {
+    switch (order) {
+    case MEMBENCH_ALLOC_POOL:      return "pool";
+    case MEMBENCH_ALLOC_MALLOC:    return "malloc";
+    case MEMBENCH_ALLOC_SCATTERED: return "scattered";
+    default:                       return "unknown";
+    }
+}
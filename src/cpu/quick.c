@@ -0,0 +1,93 @@
+/**
+ * quick.c — Probes for the quick health check.
+ *
+ * One pointer chase per memory level, stopped after a fixed number of
+ * steps rather than whole laps of the chain (a lap of a DRAM-sized chain
+ * alone is millions of misses), the roofline stream kernel for DRAM
+ * bandwidth on one core and on all of them, and an L2 chase on every core
+ * at once.  The whole set is sized to finish in a few seconds; the
+ * verdicts are in health.c.
+ */
+#include "membench/bench_cpu.h"
+#include "membench/alloc.h"
+#include "membench/timer.h"
+#include "membench/profile.h"
+#include "cpu_internal.h"
+
+#include <string.h>
+
+#define QUICK_CACHE_ACCESSES 2000000ULL
+#define QUICK_DRAM_ACCESSES  500000ULL
+
+/*
+ * Average ns per step of `accesses` steps along a random chain over
+ * `bytes`.  The warm-up walks the whole chain when it fits the budget
+ * (cache levels) and a quarter of the steps otherwise (DRAM, which is
+ * meant to miss anyway).
+ */
+static double quick_latency(size_t bytes, uint64_t accesses, uint64_t seed) {
+    size_t cl = membench_get_cache_line_size();
+    size_t ptrs_per_line = cl / sizeof(void *);
+    size_t nodes = bytes / cl;
+    if (nodes < 2) return 0.0;
+
+    uint64_t t = membench_timer_ns();
+    size_t alloc_bytes = nodes * ptrs_per_line * sizeof(void *);
+    void **buf = (void **)membench_alloc(alloc_bytes);
+    if (!buf) return 0.0;
+    t = membench_phase_mark(MEMBENCH_PHASE_ALLOC, t);
+    build_pointer_chase_cl(buf, nodes, ptrs_per_line, seed);
+    t = membench_phase_mark(MEMBENCH_PHASE_BUILD, t);
+
+    uint64_t warm = nodes <= accesses ? nodes : accesses / 4;
+    void **p = &buf[0];
+    for (uint64_t i = 0; i < warm; i++) p = chase_load(p);
+    memory_fence();
+    membench_phase_mark(MEMBENCH_PHASE_WARMUP, t);
+
+    uint64_t start = membench_timer_ns();
+    for (uint64_t i = 0; i < accesses; i++) p = chase_load(p);
+    memory_fence();
+    uint64_t end = membench_timer_ns();
+    volatile void *sink = p;
+    (void)sink;
+    membench_phase_span(MEMBENCH_PHASE_MEASURE, start, end);
+
+    membench_free(buf, alloc_bytes);
+    membench_phase_mark(MEMBENCH_PHASE_FREE, end);
+    return (double)(end - start) / (double)accesses;
+}
+
+static void core_l2_thread(void *arg, int tid) {
+    membench_quick_probe_t *p = (membench_quick_probe_t *)arg;
+    /* Half the per-level probe so SMT siblings sharing an L2 still fit */
+    p->core_l2_ns[tid] = quick_latency(p->l2_bytes / 2, QUICK_CACHE_ACCESSES,
+                                       MEMBENCH_CHASE_SEED + (uint64_t)tid);
+}
+
+int membench_cpu_quick_probe(membench_quick_probe_t *p) {
+    if (!p || !p->l1_bytes || !p->l2_bytes || !p->dram_bytes) return -1;
+    if (p->threads < 1) p->threads = 1;
+    uint64_t start = membench_timer_ns();
+
+    p->l1_ns = quick_latency(p->l1_bytes, QUICK_CACHE_ACCESSES, MEMBENCH_CHASE_SEED);
+    p->l2_ns = quick_latency(p->l2_bytes, QUICK_CACHE_ACCESSES, MEMBENCH_CHASE_SEED);
+    p->l3_ns = p->l3_bytes ? quick_latency(p->l3_bytes, QUICK_CACHE_ACCESSES, MEMBENCH_CHASE_SEED)
+                           : 0.0;
+    p->dram_ns = quick_latency(p->dram_bytes, QUICK_DRAM_ACCESSES, MEMBENCH_CHASE_SEED);
+
+    membench_roofline_point_t pt;
+    if (membench_cpu_roofline_kernel(p->dram_bytes, 0, 1, &pt) == 0)
+        p->bw_1core_gbps = pt.gbps;
+    if (p->threads > 1 && membench_cpu_roofline_kernel(p->dram_bytes, 0, p->threads, &pt) == 0)
+        p->bw_allcore_gbps = pt.gbps;
+
+    p->num_cores = p->threads < MEMBENCH_QUICK_MAX_CORES ? p->threads
+                                                         : MEMBENCH_QUICK_MAX_CORES;
+    memset(p->core_l2_ns, 0, sizeof(p->core_l2_ns));
+    if (p->num_cores > 1 && run_on_threads(p->num_cores, core_l2_thread, p) == 0)
+        p->num_cores = 0;
+
+    p->elapsed_ns = membench_timer_ns() - start;
+    return 0;
+}
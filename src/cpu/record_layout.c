@@ -0,0 +1,335 @@
+/**
+ * record_layout.c — AoS vs SoA vs AoSoA field-subset scan benchmark.
+ *
+ * Records have `n` integer fields of 4 or 8 bytes.  A scan sums `k` of the
+ * `n` fields over every record, with the same logical data stored three
+ * ways:
+ *
+ *   aos    — array of structures: record r, field f at [r*n + f]
+ *   soa    — structure of arrays: one contiguous column per field
+ *   aosoa  — blocks of one cache line of records per field: the block
+ *            holds field 0 of 64/w records, then field 1, ...
+ *
+ * AoS drags all n fields through the hierarchy for k useful ones; SoA and
+ * AoSoA only touch the selected columns.  Each layout has a scalar kernel
+ * (kept scalar with SCALAR_LOOP) and a 128-bit SIMD kernel.  The AoS SIMD
+ * kernel streams whole records and masks out the unselected fields, which
+ * is what a compiler does with AoS when it vectorises at all.
+ *
+ * Effective bandwidth counts useful bytes only (k fields per record), so
+ * the layouts are directly comparable at the same working-set size.
+ */
+#include "membench/bench_cpu.h"
+#include "membench/alloc.h"
+#include "membench/timer.h"
+#include "membench/platform.h"
+#include "cpu_internal.h"
+
+#include <string.h>
+
+#if defined(MEMBENCH_ARCH_X86_64)
+    #include <emmintrin.h>
+    #define HAVE_SIMD 1
+#elif defined(MEMBENCH_ARCH_ARM64)
+    #include <arm_neon.h>
+    #define HAVE_SIMD 1
+#else
+    #define HAVE_SIMD 0
+#endif
+
+#define BLOCK_BYTES 64   /* AoSoA: one cache line of each field per block */
+#define VEC_BYTES   16
+
+typedef struct {
+    const void *buf;
+    size_t      records;    /* multiple of the AoSoA block */
+    size_t      fields;
+    size_t      scan;       /* k */
+    size_t      sel[MEMBENCH_RECORD_MAX_FIELDS];
+    unsigned char selected[MEMBENCH_RECORD_MAX_FIELDS];
+} record_set_t;
+
+/* ── Scalar kernels ───────────────────────────────────────────────────────── */
+
+#define DEFINE_SCALAR_KERNELS(W, T)                                           \
+    MEMBENCH_NO_VECTORIZE                                                     \
+    static uint64_t aos_scalar_##W(const record_set_t *s) {                   \
+        const T *a = (const T *)s->buf;                                       \
+        T sum = 0;                                                            \
+        for (size_t r = 0; r < s->records; r++) {                             \
+            const T *rec = a + r * s->fields;                                 \
+            SCALAR_LOOP                                                       \
+            for (size_t j = 0; j < s->scan; j++) sum += rec[s->sel[j]];       \
+        }                                                                     \
+        return sum;                                                           \
+    }                                                                         \
+    MEMBENCH_NO_VECTORIZE                                                     \
+    static uint64_t soa_scalar_##W(const record_set_t *s) {                   \
+        const T *a = (const T *)s->buf;                                       \
+        T sum = 0;                                                            \
+        for (size_t j = 0; j < s->scan; j++) {                                \
+            const T *col = a + s->sel[j] * s->records;                        \
+            SCALAR_LOOP                                                       \
+            for (size_t r = 0; r < s->records; r++) sum += col[r];            \
+        }                                                                     \
+        return sum;                                                           \
+    }                                                                         \
+    MEMBENCH_NO_VECTORIZE                                                     \
+    static uint64_t aosoa_scalar_##W(const record_set_t *s) {                 \
+        const size_t B = BLOCK_BYTES / sizeof(T);                             \
+        const T *a = (const T *)s->buf;                                       \
+        T sum = 0;                                                            \
+        for (size_t b = 0; b < s->records / B; b++) {                         \
+            const T *block = a + b * s->fields * B;                           \
+            for (size_t j = 0; j < s->scan; j++) {                            \
+                const T *chunk = block + s->sel[j] * B;                       \
+                SCALAR_LOOP                                                   \
+                for (size_t l = 0; l < B; l++) sum += chunk[l];               \
+            }                                                                 \
+        }                                                                     \
+        return sum;                                                           \
+    }
+
+DEFINE_SCALAR_KERNELS(32, uint32_t)
+DEFINE_SCALAR_KERNELS(64, uint64_t)
+
+/* ── SIMD kernels ─────────────────────────────────────────────────────────── */
+
+#if defined(MEMBENCH_ARCH_X86_64)
+    #define VEC32               __m128i
+    #define VEC64               __m128i
+    #define VLOAD32(p)          _mm_loadu_si128((const __m128i *)(p))
+    #define VLOAD64(p)          _mm_loadu_si128((const __m128i *)(p))
+    #define VSTORE32(p, v)      _mm_storeu_si128((__m128i *)(p), (v))
+    #define VSTORE64(p, v)      _mm_storeu_si128((__m128i *)(p), (v))
+    #define VADD32(a, b)        _mm_add_epi32((a), (b))
+    #define VADD64(a, b)        _mm_add_epi64((a), (b))
+    #define VAND32(a, b)        _mm_and_si128((a), (b))
+    #define VAND64(a, b)        _mm_and_si128((a), (b))
+    #define VZERO32()           _mm_setzero_si128()
+    #define VZERO64()           _mm_setzero_si128()
+#elif defined(MEMBENCH_ARCH_ARM64)
+    #define VEC32               uint32x4_t
+    #define VEC64               uint64x2_t
+    #define VLOAD32(p)          vld1q_u32((const uint32_t *)(p))
+    #define VLOAD64(p)          vld1q_u64((const uint64_t *)(p))
+    #define VSTORE32(p, v)      vst1q_u32((uint32_t *)(p), (v))
+    #define VSTORE64(p, v)      vst1q_u64((uint64_t *)(p), (v))
+    #define VADD32(a, b)        vaddq_u32((a), (b))
+    #define VADD64(a, b)        vaddq_u64((a), (b))
+    #define VAND32(a, b)        vandq_u32((a), (b))
+    #define VAND64(a, b)        vandq_u64((a), (b))
+    #define VZERO32()           vdupq_n_u32(0)
+    #define VZERO64()           vdupq_n_u64(0)
+#endif
+
+#if HAVE_SIMD
+
+#define DEFINE_SIMD_KERNELS(W, T)                                             \
+    static uint64_t reduce_##W(VEC##W acc) {                                  \
+        T lanes[VEC_BYTES / sizeof(T)];                                       \
+        VSTORE##W(lanes, acc);                                                \
+        T sum = 0;                                                            \
+        for (size_t l = 0; l < VEC_BYTES / sizeof(T); l++) sum += lanes[l];   \
+        return sum;                                                           \
+    }                                                                         \
+    static uint64_t aos_simd_##W(const record_set_t *s) {                     \
+        const size_t L = VEC_BYTES / sizeof(T);                               \
+        const T *a = (const T *)s->buf;                                       \
+        /* n vectors cover L whole records; mask m selects their fields */    \
+        VEC##W mask[MEMBENCH_RECORD_MAX_FIELDS];                              \
+        for (size_t m = 0; m < s->fields; m++) {                              \
+            T bits[VEC_BYTES / sizeof(T)];                                    \
+            for (size_t l = 0; l < L; l++)                                    \
+                bits[l] = s->selected[(m * L + l) % s->fields] ? (T)~(T)0 : 0;\
+            mask[m] = VLOAD##W(bits);                                         \
+        }                                                                     \
+        size_t nvec = s->records * s->fields / L;                             \
+        VEC##W acc = VZERO##W();                                              \
+        for (size_t v = 0; v < nvec; v += s->fields) {                        \
+            const T *p = a + v * L;                                           \
+            for (size_t m = 0; m < s->fields; m++)                            \
+                acc = VADD##W(acc, VAND##W(VLOAD##W(p + m * L), mask[m]));    \
+        }                                                                     \
+        return reduce_##W(acc);                                               \
+    }                                                                         \
+    static uint64_t soa_simd_##W(const record_set_t *s) {                     \
+        const size_t L = VEC_BYTES / sizeof(T);                               \
+        const T *a = (const T *)s->buf;                                       \
+        VEC##W acc0 = VZERO##W(), acc1 = VZERO##W();                          \
+        for (size_t j = 0; j < s->scan; j++) {                                \
+            const T *col = a + s->sel[j] * s->records;                        \
+            for (size_t r = 0; r < s->records; r += 2 * L) {                  \
+                acc0 = VADD##W(acc0, VLOAD##W(col + r));                      \
+                acc1 = VADD##W(acc1, VLOAD##W(col + r + L));                  \
+            }                                                                 \
+        }                                                                     \
+        return reduce_##W(VADD##W(acc0, acc1));                               \
+    }                                                                         \
+    static uint64_t aosoa_simd_##W(const record_set_t *s) {                   \
+        const size_t L = VEC_BYTES / sizeof(T);                               \
+        const size_t B = BLOCK_BYTES / sizeof(T);                             \
+        const T *a = (const T *)s->buf;                                       \
+        VEC##W acc0 = VZERO##W(), acc1 = VZERO##W();                          \
+        for (size_t b = 0; b < s->records / B; b++) {                         \
+            const T *block = a + b * s->fields * B;                           \
+            for (size_t j = 0; j < s->scan; j++) {                            \
+                const T *chunk = block + s->sel[j] * B;                       \
+                acc0 = VADD##W(acc0, VLOAD##W(chunk));                        \
+                acc1 = VADD##W(acc1, VLOAD##W(chunk + L));                    \
+                acc0 = VADD##W(acc0, VLOAD##W(chunk + 2 * L));                \
+                acc1 = VADD##W(acc1, VLOAD##W(chunk + 3 * L));                \
+            }                                                                 \
+        }                                                                     \
+        return reduce_##W(VADD##W(acc0, acc1));                               \
+    }
+
+DEFINE_SIMD_KERNELS(32, uint32_t)
+DEFINE_SIMD_KERNELS(64, uint64_t)
+
+#endif /* HAVE_SIMD */
+
+typedef uint64_t (*scan_fn)(const record_set_t *);
+
+static const scan_fn SCALAR_32[MEMBENCH_RECORD_NUM_LAYOUTS] = {
+    aos_scalar_32, soa_scalar_32, aosoa_scalar_32
+};
+static const scan_fn SCALAR_64[MEMBENCH_RECORD_NUM_LAYOUTS] = {
+    aos_scalar_64, soa_scalar_64, aosoa_scalar_64
+};
+#if HAVE_SIMD
+static const scan_fn SIMD_32[MEMBENCH_RECORD_NUM_LAYOUTS] = {
+    aos_simd_32, soa_simd_32, aosoa_simd_32
+};
+static const scan_fn SIMD_64[MEMBENCH_RECORD_NUM_LAYOUTS] = {
+    aos_simd_64, soa_simd_64, aosoa_simd_64
+};
+#endif
+
+static scan_fn pick_kernel(membench_record_layout_t layout,
+                           membench_scan_kernel_t kernel, size_t field_bytes) {
+    if (kernel == MEMBENCH_KERNEL_SCALAR)
+        return field_bytes == 4 ? SCALAR_32[layout] : SCALAR_64[layout];
+#if HAVE_SIMD
+    return field_bytes == 4 ? SIMD_32[layout] : SIMD_64[layout];
+#else
+    return NULL;
+#endif
+}
+
+/* ── Data placement ───────────────────────────────────────────────────────── */
+
+static size_t slot_of(membench_record_layout_t layout, size_t records,
+                      size_t fields, size_t block, size_t r, size_t f) {
+    switch (layout) {
+    case MEMBENCH_RECORD_AOS:   return r * fields + f;
+    case MEMBENCH_RECORD_SOA:   return f * records + r;
+    default:                    return ((r / block) * fields + f) * block + r % block;
+    }
+}
+
+/* ── Public API ───────────────────────────────────────────────────────────── */
+
+int membench_cpu_record_layout(membench_record_layout_t layout,
+                               membench_scan_kernel_t kernel,
+                               size_t num_fields, size_t field_bytes,
+                               size_t scan_fields, size_t working_set,
+                               uint64_t passes,
+                               membench_record_result_t *result) {
+    if (!result || passes == 0) return -1;
+    if ((unsigned)layout >= MEMBENCH_RECORD_NUM_LAYOUTS) return -1;
+    if ((unsigned)kernel >= MEMBENCH_NUM_SCAN_KERNELS) return -1;
+    if (field_bytes != 4 && field_bytes != 8) return -1;
+    if (num_fields == 0 || num_fields > MEMBENCH_RECORD_MAX_FIELDS) return -1;
+    if (scan_fields == 0 || scan_fields > num_fields) return -1;
+
+    scan_fn fn = pick_kernel(layout, kernel, field_bytes);
+    if (!fn) return -1;
+
+    size_t block = BLOCK_BYTES / field_bytes;
+    size_t record_bytes = num_fields * field_bytes;
+    size_t records = working_set / record_bytes / block * block;
+    if (records == 0) return -1;
+    size_t bytes = records * record_bytes;
+
+    void *buf = membench_alloc(bytes);
+    if (!buf) return -1;
+
+    /* Field f of record r holds r*n + f, wherever the layout puts it */
+    for (size_t r = 0; r < records; r++) {
+        for (size_t f = 0; f < num_fields; f++) {
+            size_t i = slot_of(layout, records, num_fields, block, r, f);
+            uint64_t v = (uint64_t)(r * num_fields + f);
+            if (field_bytes == 4) ((uint32_t *)buf)[i] = (uint32_t)v;
+            else                  ((uint64_t *)buf)[i] = v;
+        }
+    }
+
+    record_set_t s;
+    memset(&s, 0, sizeof(s));
+    s.buf = buf;
+    s.records = records;
+    s.fields = num_fields;
+    s.scan = scan_fields;
+    /* Spread the k selected fields evenly over the record */
+    for (size_t j = 0; j < scan_fields; j++) {
+        s.sel[j] = j * num_fields / scan_fields;
+        s.selected[s.sel[j]] = 1;
+    }
+
+    /* Warmup doubles as the correctness check (sums wrap at field width) */
+    uint64_t expect = 0;
+    for (size_t r = 0; r < records; r++)
+        for (size_t j = 0; j < scan_fields; j++)
+            expect += (uint64_t)(r * num_fields + s.sel[j]);
+    if (field_bytes == 4) expect = (uint32_t)expect;
+    if (fn(&s) != expect) {
+        membench_free(buf, bytes);
+        return -1;
+    }
+
+    uint64_t sum = 0;
+    memory_fence();
+    uint64_t start = membench_timer_ns();
+    for (uint64_t p = 0; p < passes; p++)
+        sum += fn(&s);
+    memory_fence();
+    uint64_t end = membench_timer_ns();
+
+    volatile uint64_t sink = sum;
+    (void)sink;
+
+    double elapsed = (double)(end - start);
+    double scanned = (double)records * (double)passes;
+
+    result->layout = layout;
+    result->kernel = kernel;
+    result->working_set = bytes;
+    result->num_records = records;
+    result->num_fields = num_fields;
+    result->field_bytes = field_bytes;
+    result->scan_fields = scan_fields;
+    result->ns_per_record = elapsed / scanned;
+    result->bandwidth_gbps = membench_gbps(scanned * (double)(scan_fields * field_bytes), elapsed);
+    result->passes = passes;
+
+    membench_free(buf, bytes);
+    return 0;
+}
+
+const char *membench_record_layout_name(membench_record_layout_t layout) {
+    switch (layout) {
+    case MEMBENCH_RECORD_AOS:   return "aos";
+    case MEMBENCH_RECORD_SOA:   return "soa";
+    case MEMBENCH_RECORD_AOSOA: return "aosoa";
+    default:                    return "unknown";
+    }
+}
+
+const char *membench_scan_kernel_name(membench_scan_kernel_t kernel) {
+    switch (kernel) {
+    case MEMBENCH_KERNEL_SCALAR: return "scalar";
+    case MEMBENCH_KERNEL_SIMD:   return "simd";
+    default:                     return "unknown";
+    }
+}
@@ -0,0 +1,200 @@
+/**
+ * replay.c — Trace-driven replay of application memory accesses.
+ *
+ * Streams a membench trace (see membench/trace.h) and performs each access
+ * against a membench_alloc buffer sized to the trace's address span:
+ *
+ *   dependent    — every access's address is offset by the previous loaded
+ *                  value masked with a runtime zero, so accesses serialise
+ *                  and the per-access time is a latency
+ *   independent  — addresses come straight from the trace and the core
+ *                  overlaps as many accesses as it can; the per-access time
+ *                  is an inverse throughput
+ *
+ * Accesses are widened to whole aligned 8-byte words.  Reads are summed,
+ * writes store zero (the buffer stays zeroed, which keeps the dependent
+ * chain's offsets at zero).  A record with the phase bit set closes the
+ * current phase; each phase is timed separately.
+ *
+ * A validation pass over the trace runs first: it computes the span and
+ * phase count, rejects truncated or corrupt records, and pulls the trace
+ * into the page cache so the timed pass does not measure the disk.  The
+ * timed pass still streams the trace itself, 8 bytes per access.
+ */
+#include "membench/bench_cpu.h"
+#include "membench/alloc.h"
+#include "membench/timer.h"
+#include "membench/trace.h"
+#include "membench/platform.h"
+#include "cpu_internal.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+/* Runtime zero for the dependency mask; volatile so it cannot be folded */
+static volatile uint64_t g_dep_mask = 0;
+
+typedef struct {
+    uint64_t *buf;
+    uint64_t  dep_mask;
+    uint64_t  v;                /* last loaded value, carried across batches */
+} replay_state_t;
+
+/*
+ * Replay recs[start..n) until the next record that opens a phase (other
+ * than recs[start] itself). Returns the index it stopped at.
+ */
+#define DEFINE_REPLAY(NAME, CHAIN)                                            \
+    static size_t NAME(replay_state_t *st, const uint64_t *recs, size_t start,\
+                       size_t n, membench_replay_phase_t *ph) {               \
+        uint64_t *buf = st->buf;                                              \
+        uint64_t v = st->v, sum = 0;                                          \
+        size_t i;                                                             \
+        for (i = start; i < n; i++) {                                         \
+            uint64_t rec = recs[i];                                           \
+            if (membench_trace_new_phase(rec) && i != start) break;           \
+            uint64_t off = membench_trace_offset(rec);                        \
+            uint64_t end = off + membench_trace_size(rec);                    \
+            uint64_t *p = buf + off / 8 + (CHAIN);                            \
+            size_t words = (size_t)((end + 7) / 8 - off / 8);                 \
+            if (membench_trace_is_write(rec)) {                               \
+                for (size_t w = 0; w < words; w++) p[w] = 0;                  \
+                ph->writes++;                                                 \
+                ph->bytes_written += words * 8;                               \
+            } else {                                                          \
+                uint64_t x = p[0];                                            \
+                for (size_t w = 1; w < words; w++) x += p[w];                 \
+                v = x;                                                        \
+                sum += x;                                                     \
+                ph->reads++;                                                  \
+                ph->bytes_read += words * 8;                                  \
+            }                                                                 \
+        }                                                                     \
+        ph->records += i - start;                                             \
+        st->v = v + sum;                                                      \
+        return i;                                                             \
+    }
+
+DEFINE_REPLAY(replay_dependent,   v & st->dep_mask)
+DEFINE_REPLAY(replay_independent, 0)
+
+typedef size_t (*replay_fn)(replay_state_t *, const uint64_t *, size_t, size_t,
+                            membench_replay_phase_t *);
+
+static void phase_finish(membench_replay_phase_t *ph, uint64_t ns) {
+    ph->elapsed_ns = (double)ns;
+    double bytes = (double)(ph->bytes_read + ph->bytes_written);
+    ph->bandwidth_gbps = membench_gbps(bytes, (double)ns);
+    ph->ns_per_access = ph->records ? (double)ns / (double)ph->records : 0.0;
+}
+
+/** Validation pass: span, phase count, corrupt-record check. */
+static int trace_scan(membench_trace_reader_t *tr, uint64_t *span, size_t *phases) {
+    const uint64_t *recs;
+    size_t n;
+    uint64_t max_end = 0, count = 0;
+    size_t np = 0;
+    while ((n = membench_trace_next(tr, &recs)) > 0) {
+        for (size_t i = 0; i < n; i++) {
+            uint64_t end = membench_trace_offset(recs[i]) + membench_trace_size(recs[i]);
+            if (end > max_end) max_end = end;
+            if (count == 0 || membench_trace_new_phase(recs[i])) np++;
+            count++;
+        }
+    }
+    if (count != membench_trace_info(tr)->num_records || count == 0) return -1;
+    *span = max_end;
+    *phases = np;
+    return membench_trace_rewind(tr);
+}
+
+int membench_cpu_replay(const char *path, membench_replay_mode_t mode,
+                        size_t max_buffer, membench_replay_result_t *result) {
+    if (!path || !result) return -1;
+    memset(result, 0, sizeof(*result));
+
+    membench_trace_reader_t *tr = membench_trace_open(path);
+    if (!tr) return -1;
+
+    uint64_t span;
+    size_t nphases;
+    if (trace_scan(tr, &span, &nphases) != 0) {
+        membench_trace_close(tr);
+        return -1;
+    }
+
+    /* Whole pages, plus one word of slack for widened accesses */
+    size_t page = membench_page_size();
+    size_t buf_bytes = (size_t)((span + 8 + page - 1) / page * page);
+    if (max_buffer && buf_bytes > max_buffer) {
+        membench_trace_close(tr);
+        return -1;
+    }
+
+    membench_replay_phase_t *phases =
+        (membench_replay_phase_t *)calloc(nphases, sizeof(*phases));
+    replay_state_t st;
+    st.buf = (uint64_t *)membench_alloc(buf_bytes);
+    st.dep_mask = g_dep_mask;
+    st.v = 0;
+    if (!phases || !st.buf) {
+        free(phases);
+        if (st.buf) membench_free(st.buf, buf_bytes);
+        membench_trace_close(tr);
+        return -1;
+    }
+
+    replay_fn fn = (mode == MEMBENCH_REPLAY_DEPENDENT)
+                   ? replay_dependent : replay_independent;
+
+    const uint64_t *recs;
+    size_t n, p = 0;
+    int started = 0;
+    memory_fence();
+    uint64_t t0 = membench_timer_ns();
+    while ((n = membench_trace_next(tr, &recs)) > 0) {
+        size_t i = 0;
+        while (i < n) {
+            /* A phase bit on the very first record opens phase 0 */
+            if (membench_trace_new_phase(recs[i]) && started) {
+                uint64_t t1 = membench_timer_ns();
+                phase_finish(&phases[p], t1 - t0);
+                p++;
+                t0 = t1;
+            }
+            started = 1;
+            i = fn(&st, recs, i, n, &phases[p]);
+        }
+    }
+    memory_fence();
+    phase_finish(&phases[p], membench_timer_ns() - t0);
+
+    volatile uint64_t sink = st.v;
+    (void)sink;
+
+    result->mode = mode;
+    result->buffer_size = buf_bytes;
+    result->phases = phases;
+    result->num_phases = nphases;
+    double total_ns = 0.0;
+    for (size_t k = 0; k < nphases; k++) {
+        result->total.records += phases[k].records;
+        result->total.reads += phases[k].reads;
+        result->total.writes += phases[k].writes;
+        result->total.bytes_read += phases[k].bytes_read;
+        result->total.bytes_written += phases[k].bytes_written;
+        total_ns += phases[k].elapsed_ns;
+    }
+    phase_finish(&result->total, (uint64_t)total_ns);
+
+    membench_free(st.buf, buf_bytes);
+    membench_trace_close(tr);
+    return 0;
+}
+
+void membench_replay_result_free(membench_replay_result_t *result) {
+    if (!result) return;
+    free(result->phases);
+    result->phases = NULL;
+    result->num_phases = 0;
+}
@@ -0,0 +1,373 @@
+/**
+ * roofline.c — Roofline ceilings and a tunable arithmetic-intensity kernel.
+ *
+ * Compute ceilings: twelve independent multiply-add chains held in
+ * registers, enough to cover the latency of the FP pipes on current cores,
+ * so the loop runs at the FMA issue rate.  The scalar ceiling uses one
+ * double per chain; the SIMD ceiling uses the widest vector ISA available
+ * at run time (AVX2+FMA, else SSE2 on x86-64; NEON on ARM64).  SSE2 has no
+ * FMA, so its "multiply-add" is a multiply and an add; every multiply-add
+ * counts as 2 FLOPs either way.
+ *
+ * Memory ceilings: the same vector ISA streams a buffer sized for each
+ * level, summing into eight accumulators (1 FLOP per 8-byte element).
+ *
+ * The intensity kernel streams a buffer the same way but applies `f`
+ * dependent multiply-adds to every element, giving 2f FLOPs per 8 bytes.
+ * Sweeping f walks a kernel from the bandwidth roof to the compute roof.
+ *
+ * Each measurement is calibrated to ~50 ms and the best of three runs is
+ * kept.  Multi-core runs use one thread per core (see threads.c).
+ */
+#include "membench/bench_cpu.h"
+#include "membench/alloc.h"
+#include "membench/timer.h"
+#include "membench/platform.h"
+#include "cpu_internal.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(MEMBENCH_ARCH_X86_64)
+    #include <emmintrin.h>
+    #include <immintrin.h>
+    #define HAVE_SSE2 1
+    #if defined(__GNUC__) || defined(__clang__)
+        #define HAVE_AVX2 1
+        #define AVX2_ATTR __attribute__((target("avx2,fma")))
+    #elif defined(_MSC_VER)
+        #define HAVE_AVX2 1
+        #define AVX2_ATTR
+    #endif
+#elif defined(MEMBENCH_ARCH_ARM64)
+    #include <arm_neon.h>
+    #define HAVE_NEON 1
+#endif
+
+/* a = a*M + C converges to C/(1-M) = 1.0: no overflow, no denormals */
+#define CHAIN_MUL   0.999999
+#define CHAIN_ADD   0.000001
+#define CHAINS      12          /* peak kernel */
+#define STREAM_VECS 8           /* stream kernel: vectors per step */
+#define ELEM_ALIGN  64          /* doubles per buffer step, any ISA */
+
+/* Chain start values come from a runtime load so nothing can be folded;
+ * each chain starts at a different value so they cannot be merged. */
+static volatile double g_seed = 1.0;
+
+#define CALIBRATE_NS 20000000ULL
+#define TARGET_NS    50000000ULL
+#define REPEATS      3
+
+/* ── Kernels ──────────────────────────────────────────────────────────────── */
+
+/*
+ * One peak and one stream kernel per ISA.  P names a family of macros:
+ * P##_V (vector type), P##_L (doubles per vector), P##_SET1, P##_LOAD,
+ * P##_ADD, P##_FMA(a, b, c) = a*b + c, P##_STORE, and P##_KEEP(a), which
+ * keeps a scalar chain out of the SLP vectoriser (a no-op for vectors).
+ */
+#define DEFINE_ROOF_KERNELS(ISA, ATTR, P)                                     \
+    ATTR static double peak_##ISA(uint64_t reps) {                            \
+        const P##_V m = P##_SET1(CHAIN_MUL), c = P##_SET1(CHAIN_ADD);         \
+        const double s = g_seed;                                              \
+        P##_V a0 = P##_SET1(s),          a1 = P##_SET1(s + 0.001),            \
+              a2 = P##_SET1(s + 0.002),  a3 = P##_SET1(s + 0.003),            \
+              a4 = P##_SET1(s + 0.004),  a5 = P##_SET1(s + 0.005),            \
+              a6 = P##_SET1(s + 0.006),  a7 = P##_SET1(s + 0.007),            \
+              a8 = P##_SET1(s + 0.008),  a9 = P##_SET1(s + 0.009),            \
+              a10 = P##_SET1(s + 0.010), a11 = P##_SET1(s + 0.011);           \
+        SCALAR_LOOP                                                           \
+        for (uint64_t r = 0; r < reps; r++) {                                 \
+            a0 = P##_FMA(a0, m, c);   a1 = P##_FMA(a1, m, c);                 \
+            a2 = P##_FMA(a2, m, c);   a3 = P##_FMA(a3, m, c);                 \
+            a4 = P##_FMA(a4, m, c);   a5 = P##_FMA(a5, m, c);                 \
+            a6 = P##_FMA(a6, m, c);   a7 = P##_FMA(a7, m, c);                 \
+            a8 = P##_FMA(a8, m, c);   a9 = P##_FMA(a9, m, c);                 \
+            a10 = P##_FMA(a10, m, c); a11 = P##_FMA(a11, m, c);               \
+            P##_KEEP(a0); P##_KEEP(a1); P##_KEEP(a2);  P##_KEEP(a3);          \
+            P##_KEEP(a4); P##_KEEP(a5); P##_KEEP(a6);  P##_KEEP(a7);          \
+            P##_KEEP(a8); P##_KEEP(a9); P##_KEEP(a10); P##_KEEP(a11);         \
+        }                                                                     \
+        a0 = P##_ADD(P##_ADD(P##_ADD(a0, a1), P##_ADD(a2, a3)),               \
+                     P##_ADD(P##_ADD(a4, a5), P##_ADD(a6, a7)));              \
+        a0 = P##_ADD(a0, P##_ADD(P##_ADD(a8, a9), P##_ADD(a10, a11)));        \
+        double lanes[P##_L], sum = 0.0;                                       \
+        P##_STORE(lanes, a0);                                                 \
+        for (int l = 0; l < P##_L; l++) sum += lanes[l];                      \
+        return sum;                                                           \
+    }                                                                         \
+    ATTR static double stream_##ISA(const double *buf, size_t n, int fma,     \
+                                    uint64_t passes) {                        \
+        const P##_V c = P##_SET1(CHAIN_ADD);                                  \
+        const size_t L = P##_L;                                               \
+        const double s = fma ? g_seed : 0.0;                                  \
+        P##_V a0 = P##_SET1(s),         a1 = P##_SET1(s + 0.001),             \
+              a2 = P##_SET1(s + 0.002), a3 = P##_SET1(s + 0.003),             \
+              a4 = P##_SET1(s + 0.004), a5 = P##_SET1(s + 0.005),             \
+              a6 = P##_SET1(s + 0.006), a7 = P##_SET1(s + 0.007);             \
+        for (uint64_t p = 0; p < passes; p++) {                               \
+            if (fma == 0) {                                                   \
+                SCALAR_LOOP                                                   \
+                for (size_t i = 0; i < n; i += STREAM_VECS * L) {             \
+                    const double *q = buf + i;                                \
+                    a0 = P##_ADD(a0, P##_LOAD(q));                            \
+                    a1 = P##_ADD(a1, P##_LOAD(q + L));                        \
+                    a2 = P##_ADD(a2, P##_LOAD(q + 2 * L));                    \
+                    a3 = P##_ADD(a3, P##_LOAD(q + 3 * L));                    \
+                    a4 = P##_ADD(a4, P##_LOAD(q + 4 * L));                    \
+                    a5 = P##_ADD(a5, P##_LOAD(q + 5 * L));                    \
+                    a6 = P##_ADD(a6, P##_LOAD(q + 6 * L));                    \
+                    a7 = P##_ADD(a7, P##_LOAD(q + 7 * L));                    \
+                    P##_KEEP(a0); P##_KEEP(a1); P##_KEEP(a2); P##_KEEP(a3);   \
+                    P##_KEEP(a4); P##_KEEP(a5); P##_KEEP(a6); P##_KEEP(a7);   \
+                }                                                             \
+                continue;                                                     \
+            }                                                                 \
+            SCALAR_LOOP                                                       \
+            for (size_t i = 0; i < n; i += STREAM_VECS * L) {                 \
+                const double *q = buf + i;                                    \
+                const P##_V v0 = P##_LOAD(q),         v1 = P##_LOAD(q + L),   \
+                            v2 = P##_LOAD(q + 2 * L), v3 = P##_LOAD(q + 3 * L),\
+                            v4 = P##_LOAD(q + 4 * L), v5 = P##_LOAD(q + 5 * L),\
+                            v6 = P##_LOAD(q + 6 * L), v7 = P##_LOAD(q + 7 * L);\
+                SCALAR_LOOP                                                   \
+                for (int k = 0; k < fma; k++) {                               \
+                    a0 = P##_FMA(a0, v0, c); a1 = P##_FMA(a1, v1, c);         \
+                    a2 = P##_FMA(a2, v2, c); a3 = P##_FMA(a3, v3, c);         \
+                    a4 = P##_FMA(a4, v4, c); a5 = P##_FMA(a5, v5, c);         \
+                    a6 = P##_FMA(a6, v6, c); a7 = P##_FMA(a7, v7, c);         \
+                    P##_KEEP(a0); P##_KEEP(a1); P##_KEEP(a2); P##_KEEP(a3);   \
+                    P##_KEEP(a4); P##_KEEP(a5); P##_KEEP(a6); P##_KEEP(a7);   \
+                }                                                             \
+            }                                                                 \
+        }                                                                     \
+        a0 = P##_ADD(P##_ADD(P##_ADD(a0, a1), P##_ADD(a2, a3)),               \
+                     P##_ADD(P##_ADD(a4, a5), P##_ADD(a6, a7)));              \
+        double lanes[P##_L], sum = 0.0;                                       \
+        P##_STORE(lanes, a0);                                                 \
+        for (int l = 0; l < P##_L; l++) sum += lanes[l];                      \
+        return sum;                                                           \
+    }
+
+/* Plain doubles; MEMBENCH_NO_VECTORIZE and SC_KEEP keep the chains scalar */
+#define SC_V             double
+#define SC_L             1
+#define SC_SET1(x)       (x)
+#define SC_LOAD(p)       (*(p))
+#define SC_ADD(a, b)     ((a) + (b))
+#define SC_FMA(a, b, c)  ((a) * (b) + (c))
+#define SC_STORE(p, v)   (*(p) = (v))
+#define SC_KEEP(v)       SCALAR_KEEP_F64(v)
+DEFINE_ROOF_KERNELS(scalar, MEMBENCH_NO_VECTORIZE, SC)
+
+#if defined(HAVE_SSE2)
+#define SSE_V            __m128d
+#define SSE_L            2
+#define SSE_SET1         _mm_set1_pd
+#define SSE_LOAD         _mm_load_pd
+#define SSE_ADD          _mm_add_pd
+#define SSE_FMA(a, b, c) _mm_add_pd(_mm_mul_pd(a, b), c)
+#define SSE_STORE        _mm_storeu_pd
+#define SSE_KEEP(v)      ((void)0)
+DEFINE_ROOF_KERNELS(sse2, , SSE)
+#endif
+
+#if defined(HAVE_AVX2)
+#define AVX_V            __m256d
+#define AVX_L            4
+#define AVX_SET1         _mm256_set1_pd
+#define AVX_LOAD         _mm256_load_pd
+#define AVX_ADD          _mm256_add_pd
+#define AVX_FMA          _mm256_fmadd_pd
+#define AVX_STORE        _mm256_storeu_pd
+#define AVX_KEEP(v)      ((void)0)
+DEFINE_ROOF_KERNELS(avx2, AVX2_ATTR, AVX)
+#endif
+
+#if defined(HAVE_NEON)
+#define NEON_V           float64x2_t
+#define NEON_L           2
+#define NEON_SET1        vdupq_n_f64
+#define NEON_LOAD        vld1q_f64
+#define NEON_ADD         vaddq_f64
+#define NEON_FMA(a, b, c) vfmaq_f64(c, a, b)
+#define NEON_STORE       vst1q_f64
+#define NEON_KEEP(v)     ((void)0)
+DEFINE_ROOF_KERNELS(neon, , NEON)
+#endif
+
+typedef struct {
+    const char *name;
+    int         lanes;
+    double    (*peak)(uint64_t reps);
+    double    (*stream)(const double *buf, size_t n, int fma, uint64_t passes);
+} roof_isa_t;
+
+static const roof_isa_t ISA_SCALAR = { "scalar", 1, peak_scalar, stream_scalar };
+
+static const roof_isa_t *simd_isa(void) {
+#if defined(HAVE_AVX2)
+    static const roof_isa_t avx2 = { "avx2-fma", 4, peak_avx2, stream_avx2 };
+    if (cpu_has_avx2_fma()) return &avx2;
+#endif
+#if defined(HAVE_SSE2)
+    static const roof_isa_t sse2 = { "sse2", 2, peak_sse2, stream_sse2 };
+    return &sse2;
+#elif defined(HAVE_NEON)
+    static const roof_isa_t neon = { "neon", 2, peak_neon, stream_neon };
+    return &neon;
+#else
+    return &ISA_SCALAR;
+#endif
+}
+
+/* ── Timed runs ───────────────────────────────────────────────────────────── */
+
+typedef struct {
+    const roof_isa_t *isa;
+    double  **bufs;             /* stream: one buffer per thread */
+    size_t    n;                /* stream: doubles per buffer */
+    int       fma;
+    uint64_t  reps;             /* peak iterations or stream passes */
+    double   *sink;             /* one result per thread */
+} roof_job_t;
+
+static void peak_thread(void *arg, int tid) {
+    roof_job_t *job = (roof_job_t *)arg;
+    job->sink[tid] = job->isa->peak(job->reps);
+}
+
+static void stream_thread(void *arg, int tid) {
+    roof_job_t *job = (roof_job_t *)arg;
+    job->sink[tid] = job->isa->stream(job->bufs[tid], job->n, job->fma, job->reps);
+}
+
+/** Calibrate job->reps to ~TARGET_NS, then return the best of REPEATS. */
+static uint64_t timed_best(membench_thread_fn fn, roof_job_t *job, int threads) {
+    uint64_t t;
+    job->reps = 1;
+    for (;;) {
+        t = run_on_threads(threads, fn, job);
+        if (t == 0) return 0;
+        if (t >= CALIBRATE_NS || job->reps >= (1ULL << 40)) break;
+        job->reps *= 2;
+    }
+    uint64_t scaled = (uint64_t)((double)job->reps * (double)TARGET_NS / (double)t);
+    job->reps = scaled > 0 ? scaled : 1;
+
+    uint64_t best = UINT64_MAX;
+    for (int i = 0; i < REPEATS; i++) {
+        t = run_on_threads(threads, fn, job);
+        if (t == 0) return 0;
+        if (t < best) best = t;
+    }
+    return best;
+}
+
+static double measure_peak(const roof_isa_t *isa, int threads) {
+    double *sink = (double *)calloc((size_t)threads, sizeof(double));
+    if (!sink) return 0.0;
+    roof_job_t job = { isa, NULL, 0, 0, 0, sink };
+    uint64_t ns = timed_best(peak_thread, &job, threads);
+    free(sink);
+    if (ns == 0) return 0.0;
+    double flops = (double)job.reps * CHAINS * isa->lanes * 2.0 * threads;
+    return flops / (double)ns;
+}
+
+/** Stream per_thread bytes on each of `threads`; returns -1 on failure. */
+static int measure_stream(const roof_isa_t *isa, size_t per_thread, int fma,
+                          int threads, double *gbps, double *gflops) {
+    size_t n = per_thread / sizeof(double) / ELEM_ALIGN * ELEM_ALIGN;
+    if (n == 0) n = ELEM_ALIGN;
+    size_t bytes = n * sizeof(double);
+
+    double **bufs = (double **)calloc((size_t)threads, sizeof(double *));
+    double *sink = (double *)calloc((size_t)threads, sizeof(double));
+    int rc = (bufs && sink) ? 0 : -1;
+    for (int t = 0; rc == 0 && t < threads; t++) {
+        bufs[t] = (double *)membench_alloc(bytes);
+        if (!bufs[t]) { rc = -1; break; }
+        for (size_t i = 0; i < n; i++) bufs[t][i] = CHAIN_MUL;
+    }
+
+    if (rc == 0) {
+        roof_job_t job = { isa, bufs, n, fma, 1, sink };
+        run_on_threads(threads, stream_thread, &job);   /* warm-up */
+        uint64_t ns = timed_best(stream_thread, &job, threads);
+        if (ns == 0) {
+            rc = -1;
+        } else {
+            double elems = (double)n * (double)job.reps * threads;
+            *gbps = membench_gbps(elems * sizeof(double), (double)ns);
+            *gflops = elems * (fma ? 2.0 * fma : 1.0) / (double)ns;
+        }
+    }
+
+    for (int t = 0; bufs && t < threads; t++)
+        if (bufs[t]) membench_free(bufs[t], bytes);
+    free(bufs);
+    free(sink);
+    return rc;
+}
+
+/* ── Public API ───────────────────────────────────────────────────────────── */
+
+int membench_cpu_roofline(const size_t level_bytes[MEMBENCH_ROOF_NUM_LEVELS],
+                          int threads, membench_roofline_t *result) {
+    if (!level_bytes || !result) return -1;
+    memset(result, 0, sizeof(*result));
+    if (threads < 1) threads = 1;
+
+    const roof_isa_t *isa = simd_isa();
+    result->simd_isa = isa->name;
+    result->threads = threads;
+
+    const int counts[2] = { 1, threads };
+    for (int c = 0; c < 2; c++) {
+        if (c == MEMBENCH_ROOF_ALL_CORES && threads == 1) {
+            result->peak_scalar_gflops[c] = result->peak_scalar_gflops[0];
+            result->peak_simd_gflops[c] = result->peak_simd_gflops[0];
+            continue;
+        }
+        result->peak_scalar_gflops[c] = measure_peak(&ISA_SCALAR, counts[c]);
+        result->peak_simd_gflops[c] = measure_peak(isa, counts[c]);
+        if (result->peak_scalar_gflops[c] <= 0.0 || result->peak_simd_gflops[c] <= 0.0)
+            return -1;
+    }
+
+    for (int lv = 0; lv < MEMBENCH_ROOF_NUM_LEVELS; lv++) {
+        if (level_bytes[lv] == 0) continue;
+        result->level_bytes[lv] = level_bytes[lv];
+        int shared = (lv == MEMBENCH_ROOF_L3 || lv == MEMBENCH_ROOF_DRAM);
+        for (int c = 0; c < 2; c++) {
+            if (c == MEMBENCH_ROOF_ALL_CORES && threads == 1) {
+                result->bw_gbps[lv][c] = result->bw_gbps[lv][0];
+                continue;
+            }
+            size_t per_thread = shared ? level_bytes[lv] / (size_t)counts[c]
+                                       : level_bytes[lv];
+            double gflops;
+            if (measure_stream(isa, per_thread, 0, counts[c],
+                               &result->bw_gbps[lv][c], &gflops) != 0)
+                return -1;
+        }
+    }
+    return 0;
+}
+
+int membench_cpu_roofline_kernel(size_t working_set, int fma_per_element,
+                                 int threads, membench_roofline_point_t *result) {
+    if (!result || working_set == 0 || fma_per_element < 0) return -1;
+    if (threads < 1) threads = 1;
+    memset(result, 0, sizeof(*result));
+
+    result->fma_per_element = fma_per_element;
+    result->threads = threads;
+    result->working_set = working_set;
+    result->flops_per_byte = (fma_per_element ? 2.0 * fma_per_element : 1.0)
+                             / sizeof(double);
+    return measure_stream(simd_isa(), working_set / (size_t)threads, fma_per_element,
+                          threads, &result->gbps, &result->gflops);
+}
@@ -0,0 +1,391 @@
+/**
+ * search_layout.c — Sorted-array search layout benchmark.
+ *
+ * Times lower_bound() over the same set of 32-bit keys stored in five
+ * layouts, as the key set grows from L1 to DRAM:
+ *
+ *   branchy     — textbook binary search; one unpredictable branch per level
+ *   branchless  — binary search with a conditional move per level
+ *   eytzinger   — BFS (heap) order; prefetches the 16 descendants four
+ *                 levels down, which share one cache line
+ *   s-tree      — implicit static B-tree, one 16-key cache line per node,
+ *                 17 children; a node's children are computed, not stored
+ *   b-plus      — static B+tree: keys in contiguous 16-key leaves, internal
+ *                 levels of 16 separators stored top-down
+ *
+ * Keys are the odd numbers 1, 3, ..., 2n-1 and queries are uniform over
+ * [0, 2n], so half the queries hit and every lookup exercises the full
+ * depth.  Latency uses a dependent chain (each query is XORed with the
+ * previous result masked by a runtime zero), throughput issues the same
+ * queries independently.  Every layout is cross-checked against the plain
+ * binary search before timing.
+ */
+#include "membench/bench_cpu.h"
+#include "membench/alloc.h"
+#include "membench/timer.h"
+#include "membench/platform.h"
+#include "cpu_internal.h"
+
+#include <string.h>
+
+#if defined(MEMBENCH_ARCH_X86_64)
+    #include <emmintrin.h>
+#elif defined(MEMBENCH_ARCH_ARM64)
+    #include <arm_neon.h>
+#endif
+
+/* ── Layout parameters ────────────────────────────────────────────────────── */
+
+#define NODE_KEYS   16            /* 64-byte cache line of uint32_t keys */
+#define KEY_MAX     0x7FFFFFFFu   /* padding; keeps signed SIMD compares valid */
+#define MAX_LEVELS  16
+#define CHECK_QUERIES 4096
+
+static const char *const LAYOUT_NAMES[MEMBENCH_SEARCH_NUM_LAYOUTS] = {
+    "branchy", "branchless", "eytzinger", "s-tree", "b-plus"
+};
+
+const char *membench_search_layout_name(membench_search_layout_t layout) {
+    if ((int)layout < 0 || layout >= MEMBENCH_SEARCH_NUM_LAYOUTS) return "unknown";
+    return LAYOUT_NAMES[layout];
+}
+
+typedef struct {
+    const uint32_t *sorted;     /* n keys, ascending */
+    size_t          n;
+    uint32_t       *tree;       /* layout-specific storage */
+    size_t          tree_bytes;
+    size_t          nblocks;    /* s-tree nodes / b-plus leaves */
+    size_t          levels;     /* b-plus: number of levels incl. leaves */
+    size_t          level_off[MAX_LEVELS];  /* b-plus: key offset per level */
+    uint32_t        dep_mask;   /* always 0; loaded through volatile */
+} search_t;
+
+/** Number of keys in a 16-key node that are < x. */
+MEMBENCH_INLINE unsigned rank16(const uint32_t *node, uint32_t x) {
+#if defined(MEMBENCH_ARCH_X86_64)
+    __m128i xv = _mm_set1_epi32((int)x);
+    const __m128i *v = (const __m128i *)node;
+    __m128i a = _mm_packs_epi32(_mm_cmpgt_epi32(xv, _mm_load_si128(v)),
+                                _mm_cmpgt_epi32(xv, _mm_load_si128(v + 1)));
+    __m128i b = _mm_packs_epi32(_mm_cmpgt_epi32(xv, _mm_load_si128(v + 2)),
+                                _mm_cmpgt_epi32(xv, _mm_load_si128(v + 3)));
+    return popcount32((uint32_t)_mm_movemask_epi8(_mm_packs_epi16(a, b)));
+#elif defined(MEMBENCH_ARCH_ARM64)
+    uint32x4_t xv = vdupq_n_u32(x);
+    uint32x4_t c = vshrq_n_u32(vcltq_u32(vld1q_u32(node), xv), 31);
+    c = vaddq_u32(c, vshrq_n_u32(vcltq_u32(vld1q_u32(node + 4), xv), 31));
+    c = vaddq_u32(c, vshrq_n_u32(vcltq_u32(vld1q_u32(node + 8), xv), 31));
+    c = vaddq_u32(c, vshrq_n_u32(vcltq_u32(vld1q_u32(node + 12), xv), 31));
+    return vaddvq_u32(c);
+#else
+    unsigned r = 0;
+    for (int i = 0; i < NODE_KEYS; i++) r += node[i] < x;
+    return r;
+#endif
+}
+
+/* ── Sorted array ─────────────────────────────────────────────────────────── */
+
+MEMBENCH_INLINE uint32_t search_branchy(const search_t *s, uint32_t x) {
+    const uint32_t *a = s->sorted;
+    size_t lo = 0, hi = s->n;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (a[mid] < x) lo = mid + 1;
+        else            hi = mid;
+    }
+    return lo < s->n ? a[lo] : KEY_MAX;
+}
+
+MEMBENCH_INLINE uint32_t search_branchless(const search_t *s, uint32_t x) {
+    const uint32_t *base = s->sorted;
+    size_t len = s->n;
+    while (len > 1) {
+        size_t half = len / 2;
+        base += (base[half - 1] < x) ? half : 0;
+        len -= half;
+    }
+    if (*base >= x) return *base;
+    return (size_t)(base + 1 - s->sorted) < s->n ? base[1] : KEY_MAX;
+}
+
+/* ── Eytzinger ────────────────────────────────────────────────────────────── */
+
+/* tree[0] is unused so that node k's children are 2k and 2k+1 and its
+ * 16 great-great-grandchildren start at 16k — one aligned cache line. */
+static size_t eytzinger_fill(uint32_t *tree, size_t n, const uint32_t *a,
+                             size_t i, size_t k) {
+    if (k <= n) {
+        i = eytzinger_fill(tree, n, a, i, 2 * k);
+        tree[k] = a[i++];
+        i = eytzinger_fill(tree, n, a, i, 2 * k + 1);
+    }
+    return i;
+}
+
+MEMBENCH_INLINE uint32_t search_eytzinger(const search_t *s, uint32_t x) {
+    const uint32_t *t = s->tree;
+    size_t k = 1;
+    while (k <= s->n) {
+        prefetch_read(t + k * NODE_KEYS);
+        k = 2 * k + (t[k] < x);
+    }
+    /* Undo the trailing right turns plus the final left turn */
+    k >>= ctz64(~(uint64_t)k) + 1;
+    return k ? t[k] : KEY_MAX;
+}
+
+/* ── S-tree (implicit static B-tree) ──────────────────────────────────────── */
+
+MEMBENCH_INLINE size_t stree_child(size_t k, size_t i) {
+    return k * (NODE_KEYS + 1) + i + 1;
+}
+
+static size_t stree_fill(search_t *s, size_t i, size_t k) {
+    if (k < s->nblocks) {
+        for (size_t j = 0; j < NODE_KEYS; j++) {
+            i = stree_fill(s, i, stree_child(k, j));
+            s->tree[k * NODE_KEYS + j] = i < s->n ? s->sorted[i++] : KEY_MAX;
+        }
+        i = stree_fill(s, i, stree_child(k, NODE_KEYS));
+    }
+    return i;
+}
+
+MEMBENCH_INLINE uint32_t search_stree(const search_t *s, uint32_t x) {
+    uint32_t res = KEY_MAX;
+    size_t k = 0;
+    while (k < s->nblocks) {
+        const uint32_t *node = &s->tree[k * NODE_KEYS];
+        unsigned i = rank16(node, x);
+        if (i < NODE_KEYS) res = node[i];
+        k = stree_child(k, i);
+    }
+    return res;
+}
+
+/* ── B+tree (static, leaves contiguous) ───────────────────────────────────── */
+
+/*
+ * Level 0 is the leaf level: the sorted keys padded to whole 16-key leaves
+ * plus one all-KEY_MAX leaf, so a rank of 16 in the last real leaf reads
+ * KEY_MAX instead of running off the end.  Level h>0 node j holds, for its
+ * children 1..16, the smallest key in that child's subtree (KEY_MAX when
+ * the child does not exist); descending picks the child whose subtree
+ * contains the lower bound of x.
+ */
+static int bplus_build(search_t *s) {
+    size_t count[MAX_LEVELS];
+    count[0] = (s->n + NODE_KEYS - 1) / NODE_KEYS;
+    size_t levels = 1;
+    while (count[levels - 1] > 1 && levels < MAX_LEVELS) {
+        count[levels] = (count[levels - 1] + NODE_KEYS) / (NODE_KEYS + 1);
+        levels++;
+    }
+    if (count[levels - 1] > 1) return -1;
+
+    size_t total = count[0] + 1;
+    for (size_t h = 1; h < levels; h++) total += count[h];
+
+    s->tree_bytes = total * NODE_KEYS * sizeof(uint32_t);
+    s->tree = (uint32_t *)membench_alloc(s->tree_bytes);
+    if (!s->tree) return -1;
+
+    /* Top-down storage: root first, leaves last */
+    size_t off = 0;
+    for (size_t h = levels; h-- > 1; ) {
+        s->level_off[h] = off;
+        off += count[h] * NODE_KEYS;
+    }
+    s->level_off[0] = off;
+    s->levels = levels;
+    s->nblocks = count[0];
+
+    uint32_t *leaves = &s->tree[s->level_off[0]];
+    for (size_t i = 0; i < (count[0] + 1) * NODE_KEYS; i++)
+        leaves[i] = i < s->n ? s->sorted[i] : KEY_MAX;
+
+    /* Smallest key under node j of level h is the smallest key of its
+     * leftmost leaf: leaf j * 17^h. */
+    size_t span = 1;
+    for (size_t h = 1; h < levels; h++) {
+        size_t child_span = span;
+        span *= NODE_KEYS + 1;
+        uint32_t *lvl = &s->tree[s->level_off[h]];
+        for (size_t j = 0; j < count[h]; j++) {
+            for (size_t c = 1; c <= NODE_KEYS; c++) {
+                size_t leaf = j * span + c * child_span;
+                lvl[j * NODE_KEYS + c - 1] =
+                    leaf < count[0] ? leaves[leaf * NODE_KEYS] : KEY_MAX;
+            }
+        }
+    }
+    return 0;
+}
+
+MEMBENCH_INLINE uint32_t search_bplus(const search_t *s, uint32_t x) {
+    size_t k = 0;
+    for (size_t h = s->levels - 1; h >= 1; h--) {
+        /* separators <= x, i.e. < x + 1 */
+        k = k * (NODE_KEYS + 1) +
+            rank16(&s->tree[s->level_off[h] + k * NODE_KEYS], x + 1);
+    }
+    const uint32_t *leaf = &s->tree[s->level_off[0] + k * NODE_KEYS];
+    return leaf[rank16(leaf, x)];
+}
+
+/* ── Timed loops ──────────────────────────────────────────────────────────── */
+
+#define DEFINE_TIMED_LOOPS(NAME, SEARCH)                                      \
+    static uint64_t NAME##_chain(const search_t *s, const uint32_t *q,        \
+                                 size_t nq, uint64_t n) {                     \
+        uint32_t r = 0;                                                       \
+        size_t i = 0;                                                         \
+        for (uint64_t k = 0; k < n; k++) {                                    \
+            r = SEARCH(s, q[i] ^ (r & s->dep_mask));                          \
+            if (++i == nq) i = 0;                                             \
+        }                                                                     \
+        return r;                                                             \
+    }                                                                         \
+    static uint64_t NAME##_indep(const search_t *s, const uint32_t *q,        \
+                                 size_t nq, uint64_t n) {                     \
+        uint64_t sum = 0;                                                     \
+        size_t i = 0;                                                         \
+        for (uint64_t k = 0; k < n; k++) {                                    \
+            sum += SEARCH(s, q[i]);                                           \
+            if (++i == nq) i = 0;                                             \
+        }                                                                     \
+        return sum;                                                           \
+    }
+
+DEFINE_TIMED_LOOPS(branchy,    search_branchy)
+DEFINE_TIMED_LOOPS(branchless, search_branchless)
+DEFINE_TIMED_LOOPS(eytzinger,  search_eytzinger)
+DEFINE_TIMED_LOOPS(stree,      search_stree)
+DEFINE_TIMED_LOOPS(bplus,      search_bplus)
+
+typedef uint64_t (*loop_fn)(const search_t *, const uint32_t *, size_t, uint64_t);
+typedef uint32_t (*search_fn)(const search_t *, uint32_t);
+
+static const loop_fn CHAIN_LOOPS[MEMBENCH_SEARCH_NUM_LAYOUTS] = {
+    branchy_chain, branchless_chain, eytzinger_chain, stree_chain, bplus_chain
+};
+static const loop_fn INDEP_LOOPS[MEMBENCH_SEARCH_NUM_LAYOUTS] = {
+    branchy_indep, branchless_indep, eytzinger_indep, stree_indep, bplus_indep
+};
+
+static uint32_t call_branchy(const search_t *s, uint32_t x)    { return search_branchy(s, x); }
+static uint32_t call_branchless(const search_t *s, uint32_t x) { return search_branchless(s, x); }
+static uint32_t call_eytzinger(const search_t *s, uint32_t x)  { return search_eytzinger(s, x); }
+static uint32_t call_stree(const search_t *s, uint32_t x)      { return search_stree(s, x); }
+static uint32_t call_bplus(const search_t *s, uint32_t x)      { return search_bplus(s, x); }
+
+static const search_fn SEARCHES[MEMBENCH_SEARCH_NUM_LAYOUTS] = {
+    call_branchy, call_branchless, call_eytzinger, call_stree, call_bplus
+};
+
+static double time_loop(loop_fn fn, const search_t *s, const uint32_t *q,
+                        size_t nq, uint64_t n) {
+    memory_fence();
+    uint64_t start = membench_timer_ns();
+    uint64_t r = fn(s, q, nq, n);
+    memory_fence();
+    uint64_t end = membench_timer_ns();
+
+    volatile uint64_t sink = r;
+    (void)sink;
+    return (double)(end - start);
+}
+
+/* ── Public API ───────────────────────────────────────────────────────────── */
+
+static int build_layout(membench_search_layout_t layout, search_t *s) {
+    switch (layout) {
+    case MEMBENCH_SEARCH_BRANCHY:
+    case MEMBENCH_SEARCH_BRANCHLESS:
+        return 0;
+    case MEMBENCH_SEARCH_EYTZINGER:
+        s->tree_bytes = (s->n + 1) * sizeof(uint32_t);
+        s->tree = (uint32_t *)membench_alloc(s->tree_bytes);
+        if (!s->tree) return -1;
+        eytzinger_fill(s->tree, s->n, s->sorted, 0, 1);
+        return 0;
+    case MEMBENCH_SEARCH_STREE:
+        s->nblocks = (s->n + NODE_KEYS - 1) / NODE_KEYS;
+        s->tree_bytes = s->nblocks * NODE_KEYS * sizeof(uint32_t);
+        s->tree = (uint32_t *)membench_alloc(s->tree_bytes);
+        if (!s->tree) return -1;
+        stree_fill(s, 0, 0);
+        return 0;
+    case MEMBENCH_SEARCH_BPLUS:
+        return bplus_build(s);
+    default:
+        return -1;
+    }
+}
+
+int membench_cpu_search_layout(membench_search_layout_t layout,
+                               size_t array_bytes, uint64_t lookups,
+                               membench_search_result_t *result) {
+    if (!result || (int)layout < 0 || layout >= MEMBENCH_SEARCH_NUM_LAYOUTS)
+        return -1;
+    if (lookups == 0) return -1;
+
+    size_t n = array_bytes / sizeof(uint32_t);
+    if (n < NODE_KEYS || n >= (size_t)KEY_MAX / 2) return -1;
+
+    size_t sorted_bytes = n * sizeof(uint32_t);
+    uint32_t *sorted = (uint32_t *)membench_alloc(sorted_bytes);
+    if (!sorted) return -1;
+    for (size_t i = 0; i < n; i++) sorted[i] = (uint32_t)(2 * i + 1);
+
+    search_t s;
+    memset(&s, 0, sizeof(s));
+    s.sorted = sorted;
+    s.n = n;
+    if (build_layout(layout, &s) != 0) {
+        membench_free(sorted, sorted_bytes);
+        return -1;
+    }
+
+    /* Query stream: capped so it stays small next to the structure */
+    size_t nq = n < (1u << 20) ? n : (1u << 20);
+    size_t q_bytes = nq * sizeof(uint32_t);
+    uint32_t *q = (uint32_t *)membench_alloc(q_bytes);
+    int rc = -1;
+    if (!q) goto cleanup;
+
+    uint64_t rng = 42;
+    for (size_t i = 0; i < nq; i++) q[i] = (uint32_t)rng_below(&rng, 2 * n + 1);
+
+    for (size_t i = 0; i < nq && i < CHECK_QUERIES; i++) {
+        if (SEARCHES[layout](&s, q[i]) != search_branchy(&s, q[i])) goto cleanup;
+    }
+
+    s.dep_mask = *(volatile uint32_t *)&s.dep_mask;
+
+    /* Warmup: one independent pass over the query stream */
+    {
+        volatile uint64_t sink = INDEP_LOOPS[layout](&s, q, nq, nq);
+        (void)sink;
+    }
+
+    double ns_chain = time_loop(CHAIN_LOOPS[layout], &s, q, nq, lookups);
+    double ns_indep = time_loop(INDEP_LOOPS[layout], &s, q, nq, lookups);
+
+    result->layout = layout;
+    result->array_bytes = sorted_bytes;
+    result->layout_bytes = s.tree ? s.tree_bytes : sorted_bytes;
+    result->num_keys = n;
+    result->latency_ns = ns_chain / (double)lookups;
+    result->mops = (double)lookups / (ns_indep / 1e3);
+    result->lookups = lookups;
+    rc = 0;
+
+cleanup:
+    membench_free(q, q_bytes);
+    membench_free(s.tree, s.tree_bytes);
+    membench_free(sorted, sorted_bytes);
+    return rc;
+}
@@ -0,0 +1,212 @@
+/**
+ * skewed.c — Skewed (Zipfian / hot-cold) access latency.
+ *
+ * The read-latency test chases a uniform random cycle, so every line of
+ * the buffer is equally likely and anything larger than a cache level
+ * misses it almost every time.  Real key-value traffic is skewed: a few
+ * hot keys take most accesses and stay cached.  This test draws line
+ * indices from
+ *
+ *   zipf      — P(rank r) ∝ 1 / (r+1)^s, s = 0 being uniform
+ *   hot/cold  — a fraction `hot_prob` of accesses go to the hottest
+ *               `hot_fraction` of lines, the rest uniformly to the others
+ *
+ * with ranks scattered over the buffer by a random permutation, and walks
+ * the sequence as a dependent chain (each address is offset by the previous
+ * load masked with a runtime zero), so every access pays its full latency.
+ *
+ * The average comes from one untimed-inside pass over the whole chain.
+ * Percentiles come from a second pass timed in groups of SAMPLE_GROUP
+ * accesses — a single access is too short for the OS timer — with the
+ * timer's own overhead subtracted, so they describe the latency spread at
+ * that granularity rather than of individual loads.
+ */
+#include "membench/bench_cpu.h"
+#include "membench/alloc.h"
+#include "membench/timer.h"
+#include "membench/platform.h"
+#include "cpu_internal.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SEQ_MAX        (1u << 20)   /* access sequence length, cycled */
+#define SAMPLE_GROUP   16           /* accesses per percentile sample */
+#define OVERHEAD_REPS  1024
+#define LINE_WORDS     8            /* 64-byte lines of uint64_t */
+
+/* Runtime zero for the dependency mask; volatile so it cannot be folded */
+static volatile uint64_t g_dep_mask = 0;
+
+static int cmp_double(const void *a, const void *b) {
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+/** Value at quantile q of sorted v[0..n). */
+static double quantile(const double *v, size_t n, double q) {
+    size_t i = (size_t)(q * (double)(n - 1) + 0.5);
+    return v[i < n ? i : n - 1];
+}
+
+/** Median cost of one back-to-back timer read pair. */
+static double timer_overhead_ns(void) {
+    double d[OVERHEAD_REPS];
+    for (int i = 0; i < OVERHEAD_REPS; i++) {
+        uint64_t a = membench_timer_ns();
+        uint64_t b = membench_timer_ns();
+        d[i] = (double)(b - a);
+    }
+    qsort(d, OVERHEAD_REPS, sizeof(double), cmp_double);
+    return d[OVERHEAD_REPS / 2];
+}
+
+/**
+ * Cumulative distribution over line ranks, hottest first.
+ * Returns NULL on allocation failure; caller frees.
+ */
+static double *build_cdf(const membench_skew_t *skew, size_t n) {
+    double *cdf = (double *)malloc(n * sizeof(double));
+    if (!cdf) return NULL;
+
+    if (skew->kind == MEMBENCH_SKEW_ZIPF) {
+        double acc = 0.0;
+        for (size_t r = 0; r < n; r++) {
+            acc += 1.0 / pow((double)(r + 1), skew->zipf_s);
+            cdf[r] = acc;
+        }
+    } else {
+        size_t hot = (size_t)(skew->hot_fraction * (double)n);
+        if (hot < 1) hot = 1;
+        if (hot > n) hot = n;
+        double p_hot = skew->hot_prob / (double)hot;
+        double p_cold = hot < n ? (1.0 - skew->hot_prob) / (double)(n - hot) : 0.0;
+        double acc = 0.0;
+        for (size_t r = 0; r < n; r++) {
+            acc += r < hot ? p_hot : p_cold;
+            cdf[r] = acc;
+        }
+    }
+
+    double total = cdf[n - 1];
+    for (size_t r = 0; r < n; r++) cdf[r] /= total;
+    cdf[n - 1] = 1.0;
+    return cdf;
+}
+
+/** First rank whose cumulative probability reaches u. */
+static size_t sample_rank(const double *cdf, size_t n, double u) {
+    size_t lo = 0, hi = n - 1;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (cdf[mid] < u) lo = mid + 1;
+        else hi = mid;
+    }
+    return lo;
+}
+
+static uint64_t chase(const uint64_t *buf, const uint32_t *seq, size_t nseq,
+                      uint64_t n, uint64_t dep_mask, size_t *pos) {
+    uint64_t v = 0;
+    size_t i = *pos;
+    for (uint64_t k = 0; k < n; k++) {
+        v = buf[(size_t)seq[i] * LINE_WORDS + (v & dep_mask)];
+        if (++i == nseq) i = 0;
+    }
+    *pos = i;
+    return v;
+}
+
+int membench_cpu_skewed_latency(const membench_skew_t *skew, size_t buffer_size,
+                                uint64_t accesses, membench_skew_result_t *result) {
+    if (!skew || !result || accesses < SAMPLE_GROUP) return -1;
+    if (skew->kind == MEMBENCH_SKEW_ZIPF && skew->zipf_s < 0.0) return -1;
+    if (skew->kind == MEMBENCH_SKEW_HOTCOLD &&
+        (skew->hot_fraction <= 0.0 || skew->hot_fraction > 1.0 ||
+         skew->hot_prob < 0.0 || skew->hot_prob > 1.0))
+        return -1;
+
+    size_t line = LINE_WORDS * sizeof(uint64_t);
+    size_t n = buffer_size / line;
+    if (n < 2 || n > UINT32_MAX) return -1;
+
+    double *cdf = build_cdf(skew, n);
+    if (!cdf) return -1;
+
+    /* Hottest lines covering 90% of accesses, to compare with cache sizes */
+    size_t hot90 = sample_rank(cdf, n, 0.90) + 1;
+
+    /* Scatter ranks over the buffer so hot lines are not adjacent */
+    uint32_t *perm = (uint32_t *)malloc(n * sizeof(uint32_t));
+    size_t nseq = accesses < SEQ_MAX ? (size_t)accesses : SEQ_MAX;
+    size_t seq_bytes = nseq * sizeof(uint32_t);
+    uint32_t *seq = (uint32_t *)membench_alloc(seq_bytes);
+    size_t buf_bytes = n * line;
+    uint64_t *buf = (uint64_t *)membench_alloc(buf_bytes);
+    size_t nsamples = (size_t)(accesses / SAMPLE_GROUP);
+    double *samples = (double *)malloc(nsamples * sizeof(double));
+    if (!perm || !seq || !buf || !samples) {
+        free(cdf);
+        free(perm);
+        free(samples);
+        if (seq) membench_free(seq, seq_bytes);
+        if (buf) membench_free(buf, buf_bytes);
+        return -1;
+    }
+
+    uint64_t rng = 42;
+    for (size_t i = 0; i < n; i++) perm[i] = (uint32_t)i;
+    for (size_t i = n - 1; i > 0; i--) {
+        size_t j = (size_t)rng_below(&rng, i + 1);
+        uint32_t t = perm[i]; perm[i] = perm[j]; perm[j] = t;
+    }
+    for (size_t i = 0; i < nseq; i++) {
+        double u = (double)(rng_next(&rng) >> 11) * (1.0 / 9007199254740992.0);
+        seq[i] = perm[sample_rank(cdf, n, u)];
+    }
+    free(perm);
+    free(cdf);
+
+    /* buf is zeroed, so every load returns 0 and the mask keeps it that way */
+    uint64_t dep_mask = g_dep_mask;
+    double overhead = timer_overhead_ns();
+    size_t pos = 0;
+
+    /* Warmup: one pass over the sequence settles the hot set in cache */
+    uint64_t v = chase(buf, seq, nseq, nseq, dep_mask, &pos);
+
+    memory_fence();
+    uint64_t start = membench_timer_ns();
+    v += chase(buf, seq, nseq, accesses, dep_mask, &pos);
+    memory_fence();
+    uint64_t end = membench_timer_ns();
+
+    for (size_t s = 0; s < nsamples; s++) {
+        uint64_t t0 = membench_timer_ns();
+        v += chase(buf, seq, nseq, SAMPLE_GROUP, dep_mask, &pos);
+        uint64_t t1 = membench_timer_ns();
+        double ns = ((double)(t1 - t0) - overhead) / SAMPLE_GROUP;
+        samples[s] = ns > 0.0 ? ns : 0.0;
+    }
+
+    volatile uint64_t sink = v;
+    (void)sink;
+
+    qsort(samples, nsamples, sizeof(double), cmp_double);
+
+    result->skew = *skew;
+    result->buffer_size = buf_bytes;
+    result->hot90_bytes = hot90 * line;
+    result->avg_latency_ns = (double)(end - start) / (double)accesses;
+    result->p50_ns = quantile(samples, nsamples, 0.50);
+    result->p90_ns = quantile(samples, nsamples, 0.90);
+    result->p99_ns = quantile(samples, nsamples, 0.99);
+    result->p999_ns = quantile(samples, nsamples, 0.999);
+    result->accesses = accesses;
+
+    free(samples);
+    membench_free(seq, seq_bytes);
+    membench_free(buf, buf_bytes);
+    return 0;
+}
@@ -0,0 +1,160 @@
+/**
+ * suite.c — Run a parsed job file through the benchmark registry.
+ *
+ * Every job expands to sizes x thread counts.  A point with N threads runs
+ * N independent copies of the benchmark, each with its own buffer of the
+ * job's size, started together by run_on_threads() (which pins workers to
+ * distinct CPUs on Linux).  Page and NUMA policies are applied around each
+ * point: pages process-wide, NUMA in every worker thread, since Linux
+ * memory policy is per thread.
+ *
+ * With a checkpoint, each finished point is recorded under
+ * "suite/<job>/<size>/<threads>" and found points are replayed.
+ */
+#include "membench/suite.h"
+#include "membench/sysinfo.h"
+#include "membench/bench_cpu.h"
+#include "membench/timer.h"
+#include "membench/timeline.h"
+#include "cpu_internal.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct {
+    const membench_job_t   *job;
+    const membench_bench_t *bench;
+    size_t                  size;
+    uint64_t                iterations;
+    int                     numa_arg;
+    membench_bench_result_t *results;    /* one per thread */
+    int                     *status;
+} point_t;
+
+static void point_worker(void *arg, int tid) {
+    point_t *pt = (point_t *)arg;
+    if (pt->job->numa != MEMBENCH_NUMA_DEFAULT &&
+        membench_numa_set_policy(pt->job->numa, pt->numa_arg) != 0) {
+        pt->status[tid] = -1;
+        return;
+    }
+    pt->status[tid] = membench_bench_run(pt->bench, pt->size, pt->iterations,
+                                         pt->job->repeat, &pt->results[tid]);
+    if (pt->job->numa != MEMBENCH_NUMA_DEFAULT)
+        membench_numa_set_policy(MEMBENCH_NUMA_DEFAULT, 0);
+}
+
+static void run_point(const membench_job_t *job, const membench_bench_t *bench,
+                      size_t size, int threads, int numa_nodes, membench_suite_row_t *row) {
+    row->status = -1;
+    membench_bench_result_t *res =
+        (membench_bench_result_t *)calloc((size_t)threads, sizeof(*res));
+    int *status = (int *)calloc((size_t)threads, sizeof(int));
+    if (!res || !status) { free(res); free(status); return; }
+
+    point_t pt;
+    pt.job = job;
+    pt.bench = bench;
+    pt.size = size;
+    pt.iterations = job->iterations ? job->iterations
+        : membench_cpu_auto_iterations(size, bench->kind == MEMBENCH_BENCH_LATENCY);
+    pt.numa_arg = job->numa == MEMBENCH_NUMA_INTERLEAVE ? numa_nodes : job->numa_node;
+    pt.results = res;
+    pt.status = status;
+
+    membench_page_policy_t old_pages = membench_alloc_set_pages(job->pages);
+    uint64_t wall = run_on_threads(threads, point_worker, &pt);
+    membench_alloc_set_pages(old_pages);
+
+    if (wall > 0) {
+        membench_bench_result_t *r = &row->result;
+        row->status = 0;
+        for (int t = 0; t < threads; t++) {
+            if (status[t] != 0) { row->status = -1; break; }
+            r->ops += res[t].ops;
+            r->bytes += res[t].bytes;
+            r->ns_per_op += res[t].ns_per_op / (double)threads;
+            r->bandwidth_gbps += res[t].bandwidth_gbps;
+            if (t == 0 || res[t].ns_per_op_min < r->ns_per_op_min)
+                r->ns_per_op_min = res[t].ns_per_op_min;
+            if (res[t].ns_per_op_max > r->ns_per_op_max)
+                r->ns_per_op_max = res[t].ns_per_op_max;
+        }
+        r->buffer_size = size;
+        r->iterations = pt.iterations;
+        r->reps = job->repeat;
+    }
+    free(res);
+    free(status);
+}
+
+static void point_key(const membench_job_t *job, size_t size, int threads,
+                      char *key, size_t len) {
+    snprintf(key, len, "suite/%s/%zu/%d", job->name, size, threads);
+    for (char *p = key; *p; p++)
+        if (*p == ' ' || *p == '\t') *p = '_';
+}
+
+/* Status followed by the packed bench result */
+#define POINT_VALUES (1 + MEMBENCH_BENCH_RESULT_VALUES)
+
+membench_suite_row_t *membench_suite_run(const membench_suite_t *suite,
+                                         membench_checkpoint_t *cp,
+                                         membench_suite_row_fn on_row, void *user,
+                                         size_t *num_rows) {
+    if (!suite || !num_rows) return NULL;
+    *num_rows = 0;
+
+    size_t total = 0;
+    for (size_t j = 0; j < suite->num_jobs; j++)
+        total += suite->jobs[j].num_sizes * suite->jobs[j].num_threads;
+    membench_suite_row_t *rows =
+        (membench_suite_row_t *)calloc(total ? total : 1, sizeof(*rows));
+    if (!rows) return NULL;
+
+    membench_sysinfo_t si = {0};
+    membench_sysinfo_get(&si);
+
+    size_t n = 0;
+    for (size_t j = 0; j < suite->num_jobs; j++) {
+        const membench_job_t *job = &suite->jobs[j];
+        const membench_bench_t *bench = membench_registry_find(job->bench);
+        for (size_t t = 0; t < job->num_threads; t++) {
+            for (size_t s = 0; s < job->num_sizes; s++) {
+                char key[MEMBENCH_CHECKPOINT_KEY_LEN];
+                point_key(job, job->sizes[s], job->threads[t], key, sizeof(key));
+                size_t nv = 0;
+                const double *saved = membench_checkpoint_find(cp, key, &nv);
+                if (!saved && membench_cancel_requested()) goto done;
+
+                membench_suite_row_t *row = &rows[n];
+                row->job = j;
+                row->threads = job->threads[t];
+                row->kind = bench ? bench->kind : MEMBENCH_BENCH_LATENCY;
+                row->result.buffer_size = job->sizes[s];
+                row->status = -1;
+                if (saved && nv == POINT_VALUES) {
+                    row->status = (int)saved[0];
+                    membench_bench_result_unpack(saved + 1, &row->result);
+                } else {
+                    uint64_t t0 = membench_timer_ns();
+                    if (bench && row->threads >= 1)
+                        run_point(job, bench, job->sizes[s], row->threads, si.numa_nodes, row);
+                    membench_timeline_span(job->name, t0, membench_timer_ns(), job->sizes[s]);
+                    /* A point cut short by a signal is not finished */
+                    if (row->status != 0 && membench_cancel_requested()) goto done;
+                    double v[POINT_VALUES];
+                    v[0] = row->status;
+                    membench_bench_result_pack(&row->result, v + 1);
+                    membench_checkpoint_record(cp, key, v, POINT_VALUES);
+                }
+                n++;
+                if (on_row) on_row(suite, row, user);
+            }
+        }
+    }
+done:
+    *num_rows = n;
+    return rows;
+}
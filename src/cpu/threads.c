@@ -0,0 +1,148 @@
+/**
+ * threads.c — Run one benchmark kernel on several threads at once.
+ *
+ * Workers are created first and spin on a start flag, so thread creation
+ * is not part of the timed region.  The wall time runs from releasing the
+ * flag to the last worker finishing.  On Linux worker i is pinned to the
+ * i-th CPU of the process's affinity mask, so an N-thread run uses N
+ * distinct cores (or hardware threads) instead of whatever the scheduler
+ * picks.
+ *
+ * With the timeline recorder on, each worker records how long it waited
+ * at the start flag and how long its kernel ran.
+ */
+#include "membench/timer.h"
+#include "membench/timeline.h"
+#include "membench/platform.h"
+#include "cpu_internal.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#if defined(MEMBENCH_PLATFORM_WINDOWS)
+    #define WIN32_LEAN_AND_MEAN
+    #include <windows.h>
+#else
+    #include <pthread.h>
+    #if defined(MEMBENCH_PLATFORM_LINUX)
+        #include <sched.h>  /* _GNU_SOURCE is set by the build */
+    #endif
+#endif
+
+typedef struct {
+    membench_thread_fn fn;
+    void              *arg;
+    int                tid;
+    volatile int       ready;
+    volatile const int *go;
+} worker_t;
+
+#if defined(MEMBENCH_PLATFORM_WINDOWS)
+static DWORD WINAPI worker_main(LPVOID p) {
+#else
+static void *worker_main(void *p) {
+#endif
+    worker_t *w = (worker_t *)p;
+    int traced = membench_timeline_enabled();
+    uint64_t t0 = 0, t1 = 0;
+    if (traced) {
+        char name[32];
+        snprintf(name, sizeof(name), "worker %d", w->tid);
+        membench_timeline_thread_name(name);
+        t0 = membench_timer_ns();
+    }
+    w->ready = 1;
+    while (!*w->go) { /* spin until released */ }
+    memory_fence();
+    if (traced) t1 = membench_timer_ns();
+    w->fn(w->arg, w->tid);
+    if (traced) {
+        membench_timeline_span("barrier", t0, t1, (uint64_t)w->tid);
+        membench_timeline_span("worker", t1, membench_timer_ns(), (uint64_t)w->tid);
+        membench_timeline_thread_exit();
+    }
+#if defined(MEMBENCH_PLATFORM_WINDOWS)
+    return 0;
+#else
+    return NULL;
+#endif
+}
+
+uint64_t run_on_threads(int nthreads, membench_thread_fn fn, void *arg) {
+    if (nthreads < 1 || !fn) return 0;
+
+    if (nthreads == 1) {
+        memory_fence();
+        uint64_t t0 = membench_timer_ns();
+        fn(arg, 0);
+        memory_fence();
+        return membench_timer_ns() - t0;
+    }
+
+    worker_t *w = (worker_t *)calloc((size_t)nthreads, sizeof(*w));
+#if defined(MEMBENCH_PLATFORM_WINDOWS)
+    HANDLE *h = (HANDLE *)calloc((size_t)nthreads, sizeof(*h));
+#else
+    pthread_t *h = (pthread_t *)calloc((size_t)nthreads, sizeof(*h));
+#endif
+    if (!w || !h) { free(w); free(h); return 0; }
+
+#if defined(MEMBENCH_PLATFORM_LINUX)
+    cpu_set_t allowed;
+    int have_mask = sched_getaffinity(0, sizeof(allowed), &allowed) == 0;
+    int cpu = -1;
+#endif
+
+    volatile int go = 0;
+    int started = 0;
+    for (int t = 0; t < nthreads; t++) {
+        w[t].fn = fn;
+        w[t].arg = arg;
+        w[t].tid = t;
+        w[t].go = &go;
+#if defined(MEMBENCH_PLATFORM_WINDOWS)
+        h[t] = CreateThread(NULL, 0, worker_main, &w[t], 0, NULL);
+        if (!h[t]) break;
+#else
+        pthread_attr_t attr;
+        pthread_attr_init(&attr);
+    #if defined(MEMBENCH_PLATFORM_LINUX)
+        if (have_mask) {
+            /* Next allowed CPU, wrapping when there are more threads */
+            for (int k = 0; k < CPU_SETSIZE; k++) {
+                cpu = (cpu + 1) % CPU_SETSIZE;
+                if (CPU_ISSET(cpu, &allowed)) break;
+            }
+            cpu_set_t one;
+            CPU_ZERO(&one);
+            CPU_SET(cpu, &one);
+            pthread_attr_setaffinity_np(&attr, sizeof(one), &one);
+        }
+    #endif
+        int rc = pthread_create(&h[t], &attr, worker_main, &w[t]);
+        pthread_attr_destroy(&attr);
+        if (rc != 0) break;
+#endif
+        started++;
+    }
+
+    for (int t = 0; t < started; t++)
+        while (!w[t].ready) { /* wait until every worker is spinning */ }
+
+    uint64_t t0 = membench_timer_ns();
+    memory_fence();
+    go = 1;
+    for (int t = 0; t < started; t++) {
+#if defined(MEMBENCH_PLATFORM_WINDOWS)
+        WaitForSingleObject(h[t], INFINITE);
+        CloseHandle(h[t]);
+#else
+        pthread_join(h[t], NULL);
+#endif
+    }
+    uint64_t elapsed = membench_timer_ns() - t0;
+
+    free(w);
+    free(h);
+    return started == nthreads ? elapsed : 0;
+}
@@ -0,0 +1,217 @@
+/**
+ * tiling.c — Cache-blocking tile-size search for transpose and matmul.
+ *
+ * Two kernels over n x n row-major double matrices:
+ *
+ *   transpose — B = A^T, walked in T x T tiles so a tile of A and the
+ *               matching tile of B stay resident while the columns of B
+ *               are written
+ *   matmul    — C += A * B, blocked in T on all three loops (i-k-j order
+ *               inside a block, so the inner loop streams a row of B and C)
+ *
+ * A tile of T = 0 runs the plain, unblocked loop as the baseline.
+ *
+ * Searching every T is slow, so candidates are seeded from the cache
+ * hierarchy: for each level, the T whose tile footprint (two T x T blocks
+ * for transpose, three for matmul) fills about half the level, plus a
+ * factor of two either side.  membench_cpu_tile_levels() builds that list
+ * from a cache-detect result.
+ */
+#include "membench/bench_cpu.h"
+#include "membench/alloc.h"
+#include "membench/timer.h"
+#include "membench/platform.h"
+#include "cpu_internal.h"
+
+#include <math.h>
+#include <string.h>
+
+#define TILE_ALIGN 8            /* candidate tiles are multiples of this */
+#define TILE_MIN   8
+
+/* ── Kernels ──────────────────────────────────────────────────────────────── */
+
+static void transpose_plain(const double *a, double *b, size_t n) {
+    for (size_t i = 0; i < n; i++)
+        for (size_t j = 0; j < n; j++)
+            b[j * n + i] = a[i * n + j];
+}
+
+static void transpose_tiled(const double *a, double *b, size_t n, size_t t) {
+    for (size_t ii = 0; ii < n; ii += t) {
+        size_t ie = ii + t < n ? ii + t : n;
+        for (size_t jj = 0; jj < n; jj += t) {
+            size_t je = jj + t < n ? jj + t : n;
+            for (size_t i = ii; i < ie; i++)
+                for (size_t j = jj; j < je; j++)
+                    b[j * n + i] = a[i * n + j];
+        }
+    }
+}
+
+static void matmul_plain(const double *a, const double *b, double *c, size_t n) {
+    for (size_t i = 0; i < n; i++)
+        for (size_t k = 0; k < n; k++) {
+            const double aik = a[i * n + k];
+            for (size_t j = 0; j < n; j++)
+                c[i * n + j] += aik * b[k * n + j];
+        }
+}
+
+static void matmul_tiled(const double *a, const double *b, double *c, size_t n, size_t t) {
+    for (size_t ii = 0; ii < n; ii += t) {
+        size_t ie = ii + t < n ? ii + t : n;
+        for (size_t kk = 0; kk < n; kk += t) {
+            size_t ke = kk + t < n ? kk + t : n;
+            for (size_t jj = 0; jj < n; jj += t) {
+                size_t je = jj + t < n ? jj + t : n;
+                for (size_t i = ii; i < ie; i++)
+                    for (size_t k = kk; k < ke; k++) {
+                        const double aik = a[i * n + k];
+                        double *ci = c + i * n;
+                        const double *bk = b + k * n;
+                        for (size_t j = jj; j < je; j++)
+                            ci[j] += aik * bk[j];
+                    }
+            }
+        }
+    }
+}
+
+/* Small integers keep every product and sum exact, so results can be
+ * checked bit for bit. */
+MEMBENCH_INLINE double fill_a(size_t i, size_t j) { return (double)((i * 7 + j * 3) % 5); }
+MEMBENCH_INLINE double fill_b(size_t i, size_t j) { return (double)((i * 3 + j * 5) % 7); }
+
+static int check_matmul(const double *c, size_t n, uint64_t reps) {
+    const size_t probes[4][2] = { { 0, 0 }, { n - 1, n - 1 }, { n / 2, n / 3 }, { n / 5, n - 1 } };
+    for (int p = 0; p < 4; p++) {
+        size_t i = probes[p][0], j = probes[p][1];
+        double want = 0.0;
+        for (size_t k = 0; k < n; k++) want += fill_a(i, k) * fill_b(k, j);
+        if (c[i * n + j] != want * (double)reps) return -1;
+    }
+    return 0;
+}
+
+/* ── Public API ───────────────────────────────────────────────────────────── */
+
+size_t membench_tile_footprint(membench_tile_kernel_t kernel, size_t tile) {
+    size_t blocks = (kernel == MEMBENCH_TILE_MATMUL) ? 3 : 2;
+    return blocks * tile * tile * sizeof(double);
+}
+
+int membench_cpu_tile(membench_tile_kernel_t kernel, size_t n, size_t tile,
+                      uint64_t reps, membench_tile_result_t *result) {
+    if (!result || n < 2 || reps == 0 || kernel >= MEMBENCH_TILE_NUM_KERNELS) return -1;
+    if (tile >= n) tile = 0;
+    memset(result, 0, sizeof(*result));
+
+    size_t bytes = n * n * sizeof(double);
+    size_t nmat = (kernel == MEMBENCH_TILE_MATMUL) ? 3 : 2;
+    double *m[3] = { NULL, NULL, NULL };
+    for (size_t k = 0; k < nmat; k++) {
+        m[k] = (double *)membench_alloc(bytes);
+        if (!m[k]) {
+            for (size_t f = 0; f < k; f++) membench_free(m[f], bytes);
+            return -1;
+        }
+    }
+    for (size_t i = 0; i < n; i++)
+        for (size_t j = 0; j < n; j++) {
+            m[0][i * n + j] = fill_a(i, j);
+            if (nmat == 3) m[1][i * n + j] = fill_b(i, j);
+        }
+
+    int rc = 0;
+    uint64_t start = 0, end = 0;
+    if (kernel == MEMBENCH_TILE_TRANSPOSE) {
+        transpose_plain(m[0], m[1], n);              /* warm-up, faults pages */
+        start = membench_timer_ns();
+        for (uint64_t r = 0; r < reps; r++) {
+            if (tile) transpose_tiled(m[0], m[1], n, tile);
+            else      transpose_plain(m[0], m[1], n);
+        }
+        end = membench_timer_ns();
+        if (m[1][(n - 1) * n] != m[0][n - 1] || m[1][1] != m[0][n]) rc = -1;
+    } else {
+        /* C starts zeroed (membench_alloc) and accumulates every rep */
+        start = membench_timer_ns();
+        for (uint64_t r = 0; r < reps; r++) {
+            if (tile) matmul_tiled(m[0], m[1], m[2], n, tile);
+            else      matmul_plain(m[0], m[1], m[2], n);
+        }
+        end = membench_timer_ns();
+        rc = check_matmul(m[2], n, reps);
+    }
+
+    for (size_t k = 0; k < nmat; k++) membench_free(m[k], bytes);
+    if (rc != 0) return -1;
+
+    double ns = (double)(end - start);
+    result->kernel = kernel;
+    result->n = n;
+    result->tile = tile;
+    result->tile_bytes = tile ? membench_tile_footprint(kernel, tile) : 0;
+    result->elapsed_ns = ns / (double)reps;
+    if (kernel == MEMBENCH_TILE_TRANSPOSE) {
+        /* one read and one write per element */
+        result->gbps = membench_gbps(2.0 * (double)bytes * (double)reps, ns);
+    } else {
+        result->gflops = 2.0 * (double)n * (double)n * (double)n * (double)reps / ns;
+    }
+    return 0;
+}
+
+size_t membench_cpu_tile_levels(const membench_cache_info_t *cache,
+                                membench_tile_kernel_t kernel, size_t n,
+                                membench_tile_level_t levels[MEMBENCH_TILE_MAX_LEVELS]) {
+    if (!cache || !levels) return 0;
+
+    const size_t sizes[MEMBENCH_TILE_MAX_LEVELS] = {
+        cache->l1_size_bytes, cache->l2_size_bytes, cache->l3_size_bytes
+    };
+    static const char *const names[MEMBENCH_TILE_MAX_LEVELS] = { "L1", "L2", "L3" };
+    static const double SPREAD[] = { 0.5, 0.7071, 1.0, 1.4142, 2.0 };
+    const size_t blocks = (kernel == MEMBENCH_TILE_MATMUL) ? 3 : 2;
+
+    size_t count = 0, largest = 0;
+    for (int l = 0; l < MEMBENCH_TILE_MAX_LEVELS; l++) {
+        if (sizes[l] == 0 || sizes[l] <= largest) continue;
+        largest = sizes[l];
+
+        membench_tile_level_t *lv = &levels[count];
+        memset(lv, 0, sizeof(*lv));
+        lv->name = names[l];
+        lv->level_bytes = sizes[l];
+
+        /* Footprint = half the level */
+        double fit = sqrt((double)sizes[l] / 2.0 / (double)(blocks * sizeof(double)));
+        for (size_t s = 0; s < sizeof(SPREAD) / sizeof(SPREAD[0]); s++) {
+            size_t t = (size_t)(fit * SPREAD[s]) / TILE_ALIGN * TILE_ALIGN;
+            if (t < TILE_MIN) t = TILE_MIN;
+            if (t >= n) break;
+            if (lv->num_tiles && lv->tiles[lv->num_tiles - 1] == t) continue;
+            lv->tiles[lv->num_tiles++] = t;
+        }
+        if (lv->num_tiles) count++;
+    }
+    return count;
+}
+
+void membench_tile_level_update(membench_tile_level_t *level,
+                                const membench_tile_result_t *r) {
+    if (!level || !r) return;
+    double score = r->kernel == MEMBENCH_TILE_MATMUL ? r->gflops : r->gbps;
+    double best = level->best.kernel == MEMBENCH_TILE_MATMUL ? level->best.gflops
+                                                             : level->best.gbps;
+    if (level->best.tile == 0 || score > best) level->best = *r;
+}
+
+const char *membench_tile_kernel_name(membench_tile_kernel_t kernel) {
+    switch (kernel) {
+    case MEMBENCH_TILE_TRANSPOSE: return "transpose";
+    case MEMBENCH_TILE_MATMUL:    return "matmul";
+    default:                      return "unknown";
+    }
+}
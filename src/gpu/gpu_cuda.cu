@@ -4,6 +4,7 @@
  * Pointer-chase for latency, streaming for bandwidth.
  */
 #include "membench/bench_gpu.h"
+#include "membench/timer.h"
 
 #include <cuda_runtime.h>
 #include <stdio.h>
@@ -42,9 +43,9 @@ int membench_gpu_get_info(int device_id, membench_gpu_info_t *info) {
         info->memory_clock_mhz = clock_khz / 1000;
     }
 
-    /* Theoretical BW: clock(MHz) * bus_width(bits) * 2 (DDR) / 8 (bits→bytes) / 1024^3 (→GB) */
-    double clock_ghz = info->memory_clock_mhz / 1000.0;
-    info->theoretical_bw_gbps = clock_ghz * (info->memory_bus_width / 8.0) * 2.0;
+    /* Theoretical BW: clock(MHz) * bus_width(bits) * 2 (DDR) / 8 (bits→bytes), per second */
+    double clock_hz = info->memory_clock_mhz * 1e6;
+    info->theoretical_bw_gbps = membench_gbps(clock_hz * (info->memory_bus_width / 8.0) * 2.0, 1e9);
 
     return 0;
 }
@@ -190,9 +191,8 @@ int membench_gpu_read_bandwidth(int device_id, size_t buffer_size,
     CUDA_CHECK(cudaEventElapsedTime(&ms, start, stop));
 
     uint64_t total_bytes = iterations * count * sizeof(uint64_t);
-    double elapsed_s = (double)ms / 1000.0;
     result->buffer_size = buffer_size;
-    result->bandwidth_gbps = ((double)total_bytes / (1024.0 * 1024.0 * 1024.0)) / elapsed_s;
+    result->bandwidth_gbps = membench_gbps((double)total_bytes, (double)ms * 1e6);
     result->bytes_moved = total_bytes;
 
     cudaEventDestroy(start);
@@ -249,9 +249,8 @@ int membench_gpu_write_bandwidth(int device_id, size_t buffer_size,
     CUDA_CHECK(cudaEventElapsedTime(&ms, start, stop));
 
     uint64_t total_bytes = iterations * count * sizeof(uint64_t);
-    double elapsed_s = (double)ms / 1000.0;
     result->buffer_size = buffer_size;
-    result->bandwidth_gbps = ((double)total_bytes / (1024.0 * 1024.0 * 1024.0)) / elapsed_s;
+    result->bandwidth_gbps = membench_gbps((double)total_bytes, (double)ms * 1e6);
     result->bytes_moved = total_bytes;
 
     cudaEventDestroy(start);
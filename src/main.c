@@ -7,9 +7,21 @@
 #include "membench/bench_cpu.h"
 #include "membench/bench_gpu.h"
 #include "membench/output.h"
+#include "membench/tuning.h"
+#include "membench/registry.h"
+#include "membench/suite.h"
+#include "membench/checkpoint.h"
+#include "membench/profile.h"
+#include "membench/timeline.h"
+#include "membench/health.h"
+#include "membench/energy.h"
+#include "membench/monitor.h"
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+#include <math.h>
 
 #if defined(MEMBENCH_PLATFORM_MACOS)
 #include <sys/sysctl.h>
@@ -97,119 +109,1001 @@ static size_t get_cache_line_size_main(void) {
     return 64;
 }
 
-static uint64_t auto_iter(size_t buffer_size, int is_latency) {
-    size_t elems = is_latency
-                   ? buffer_size / get_cache_line_size_main()
-                   : buffer_size / sizeof(void *);
-    if (elems == 0) elems = 1;
-    uint64_t target = is_latency ? 20000000ULL : 5000000ULL;
-    uint64_t iters = target / elems;
-    if (iters < 2) iters = 2;
-    return iters;
+/* --checkpoint / --resume: finished points, NULL when not checkpointing */
+static membench_checkpoint_t *g_checkpoint;
+
+/* --energy: readable RAPL domains, none when off or unavailable */
+static membench_energy_t g_energy;
+
+/* --monitor: points whose clock dropped past the threshold */
+static size_t g_throttled;
+
+/* Keep the first failure in `*rc`: later points still run but cannot mask it */
+static int keep_first_failure(int *rc, int r) {
+    if (r != 0 && *rc == 0) *rc = r;
+    return r;
 }
 
-/* ── Run CPU benchmarks ───────────────────────────────────────────────────── */
+/* Checkpointed sweeps are stored as l1, l2, l3, then (size, latency) pairs */
+static int detect_cache_resumed(const double *v, size_t n, membench_cache_info_t *info) {
+    if (n < 3 || (n - 3) % 2) return -1;
+    size_t num = (n - 3) / 2;
+    memset(info, 0, sizeof(*info));
+    info->sample_sizes = (size_t *)malloc((num ? num : 1) * sizeof(size_t));
+    info->sample_latencies = (double *)malloc((num ? num : 1) * sizeof(double));
+    if (!info->sample_sizes || !info->sample_latencies) {
+        membench_cache_info_free(info);
+        return -1;
+    }
+    info->l1_size_bytes = (size_t)v[0];
+    info->l2_size_bytes = (size_t)v[1];
+    info->l3_size_bytes = (size_t)v[2];
+    for (size_t i = 0; i < num; i++) {
+        info->sample_sizes[i] = (size_t)v[3 + 2 * i];
+        info->sample_latencies[i] = v[4 + 2 * i];
+    }
+    info->num_samples = num;
+    return 0;
+}
+
+static void detect_cache_record(const char *key, const membench_cache_info_t *info) {
+    size_t n = 3 + 2 * info->num_samples;
+    double *v = (double *)malloc(n * sizeof(double));
+    if (!v) return;
+    v[0] = (double)info->l1_size_bytes;
+    v[1] = (double)info->l2_size_bytes;
+    v[2] = (double)info->l3_size_bytes;
+    for (size_t i = 0; i < info->num_samples; i++) {
+        v[3 + 2 * i] = (double)info->sample_sizes[i];
+        v[4 + 2 * i] = info->sample_latencies[i];
+    }
+    membench_checkpoint_record(g_checkpoint, key, v, n);
+    free(v);
+}
+
+/*
+ * Cache detection prints nothing itself; say what the long sweep is doing.
+ * Several tests share the sweep, so a checkpointed one is reused by all.
+ */
+static int detect_cache(size_t max_bytes, uint64_t visits, membench_cache_info_t *info) {
+    char key[MEMBENCH_CHECKPOINT_KEY_LEN];
+    snprintf(key, sizeof(key), "cache-detect/%zu/%" PRIu64, max_bytes, visits);
+    size_t n = 0;
+    const double *saved = membench_checkpoint_find(g_checkpoint, key, &n);
+    if (saved && detect_cache_resumed(saved, n, info) == 0) return 0;
+
+    printf("  Sweeping buffer sizes from 1 KB to %zu MB...\n", max_bytes / (1024 * 1024));
+    fflush(stdout);
+    int rc = membench_cpu_detect_cache_range(max_bytes, visits, info);
+    if (rc == 0) detect_cache_record(key, info);
+    return rc;
+}
+
+/* Hash probe: one point per octave over the cache-detect sweep range */
+#define HASH_SWEEP_MIN      (4 * 1024)
+#define HASH_SWEEP_MAX      ((size_t)256 * 1024 * 1024)
+#define HASH_LOOKUPS        (1ULL << 20)
+
+static const double HASH_LOAD_FACTORS[] = { 0.50, 0.75, 0.90, 0.95 };
+#define NUM_HASH_LOAD_FACTORS \
+    (sizeof(HASH_LOAD_FACTORS) / sizeof(HASH_LOAD_FACTORS[0]))
 
-static int run_cpu(const membench_options_t *opts) {
+static int run_hash_probe(const membench_options_t *opts, size_t ram_limit) {
+    size_t single = opts->buffer_size;
+    size_t *sizes = &single;
+    size_t num = 1;
+    if (!opts->buffer_size) {
+        num = membench_cpu_generate_sizes(HASH_SWEEP_MIN, HASH_SWEEP_MAX, 1, &sizes);
+        if (num == 0) return -1;
+    }
+    uint64_t lookups = opts->iterations ? opts->iterations : HASH_LOOKUPS;
     int rc = 0;
 
-    if (opts->tests & MEMBENCH_TEST_LATENCY) {
-        printf("\n=== CPU Read Latency ===\n");
-        if (opts->buffer_size) {
-            membench_latency_result_t r = {0};
-            uint64_t iters = opts->iterations ? opts->iterations
-                             : auto_iter(opts->buffer_size, 1);
-            rc = membench_cpu_read_latency(opts->buffer_size, iters, &r);
-            if (rc == 0) membench_print_latency(&r, "Read Latency", opts->format);
-        } else {
-            for (size_t i = 0; i < NUM_DEFAULT_LATENCY_SIZES; i++) {
-                membench_latency_result_t r = {0};
-                uint64_t iters = auto_iter(DEFAULT_LATENCY_SIZES[i], 1);
-                rc = membench_cpu_read_latency(DEFAULT_LATENCY_SIZES[i], iters, &r);
-                if (rc == 0) membench_print_latency(&r, "Read Latency", opts->format);
+    for (int s = 0; s < MEMBENCH_HASH_NUM_SCHEMES; s++) {
+        for (size_t l = 0; l < NUM_HASH_LOAD_FACTORS; l++) {
+            for (size_t i = 0; i < num; i++) {
+                /* Table plus hit/miss key arrays are ~2× the table */
+                if (sizes[i] * 2 >= ram_limit) break;
+                membench_hash_result_t r = {0};
+                int pr = membench_cpu_hash_probe((membench_hash_scheme_t)s, sizes[i],
+                                                 HASH_LOAD_FACTORS[l], lookups, &r);
+                if (keep_first_failure(&rc, pr) == 0)
+                    membench_print_hash_probe(&r,
+                        membench_hash_scheme_name((membench_hash_scheme_t)s),
+                        opts->format);
             }
         }
+    }
 
-        printf("\n=== CPU Write Latency ===\n");
-        if (opts->buffer_size) {
-            membench_latency_result_t r = {0};
-            uint64_t iters = opts->iterations ? opts->iterations
-                             : auto_iter(opts->buffer_size, 1);
-            rc = membench_cpu_write_latency(opts->buffer_size, iters, &r);
-            if (rc == 0) membench_print_latency(&r, "Write Latency", opts->format);
-        } else {
-            for (size_t i = 0; i < NUM_DEFAULT_LATENCY_SIZES; i++) {
-                membench_latency_result_t r = {0};
-                uint64_t iters = auto_iter(DEFAULT_LATENCY_SIZES[i], 1);
-                rc = membench_cpu_write_latency(DEFAULT_LATENCY_SIZES[i], iters, &r);
-                if (rc == 0) membench_print_latency(&r, "Write Latency", opts->format);
+    if (sizes != &single) free(sizes);
+    return rc;
+}
+
+/* Search layouts: same octave sweep, L1 through DRAM */
+#define SEARCH_SWEEP_MIN    (4 * 1024)
+#define SEARCH_SWEEP_MAX    ((size_t)256 * 1024 * 1024)
+#define SEARCH_LOOKUPS      (1ULL << 20)
+
+static int run_search_layout(const membench_options_t *opts, size_t ram_limit) {
+    size_t single = opts->buffer_size;
+    size_t *sizes = &single;
+    size_t num = 1;
+    if (!opts->buffer_size) {
+        num = membench_cpu_generate_sizes(SEARCH_SWEEP_MIN, SEARCH_SWEEP_MAX, 1, &sizes);
+        if (num == 0) return -1;
+    }
+    uint64_t lookups = opts->iterations ? opts->iterations : SEARCH_LOOKUPS;
+    int rc = 0;
+
+    for (int l = 0; l < MEMBENCH_SEARCH_NUM_LAYOUTS; l++) {
+        for (size_t i = 0; i < num; i++) {
+            /* Sorted keys plus the layout copy */
+            if (sizes[i] * 2 >= ram_limit) break;
+            membench_search_result_t r = {0};
+            int pr = membench_cpu_search_layout((membench_search_layout_t)l, sizes[i],
+                                                lookups, &r);
+            if (keep_first_failure(&rc, pr) == 0)
+                membench_print_search(&r,
+                    membench_search_layout_name((membench_search_layout_t)l),
+                    opts->format);
+        }
+    }
+
+    if (sizes != &single) free(sizes);
+    return rc;
+}
+
+/* B+tree node sizes: 64 B .. 16 KB */
+#define BTREE_NODE_MIN      64
+#define BTREE_NODE_MAX      (16 * 1024)
+#define BTREE_LOOKUPS       (1ULL << 20)
+
+static int run_btree_sweep(const membench_options_t *opts,
+                           const membench_sysinfo_t *si, size_t ram_limit) {
+    membench_btree_tier_t tiers[MEMBENCH_BTREE_MAX_TIERS];
+    size_t ntiers;
+
+    if (opts->buffer_size) {
+        tiers[0].name = "user";
+        tiers[0].tree_bytes = opts->buffer_size;
+        tiers[0].best_lookup_node = tiers[0].best_scan_node = 0;
+        ntiers = 1;
+    } else {
+        /* Tier sizes come from the measured hierarchy; sysinfo fills in
+         * any level the latency sweep could not resolve. */
+        membench_cache_info_t cinfo = {0};
+        if (detect_cache(MEMBENCH_DETECT_MAX_BYTES, 0, &cinfo) != 0) return -1;
+        if (!cinfo.l1_size_bytes) cinfo.l1_size_bytes = si->l1_data_cache;
+        if (!cinfo.l2_size_bytes) cinfo.l2_size_bytes = si->l2_cache;
+        if (!cinfo.l3_size_bytes) cinfo.l3_size_bytes = si->l3_cache;
+        ntiers = membench_cpu_btree_tiers(&cinfo, tiers);
+        membench_cache_info_free(&cinfo);
+    }
+
+    uint64_t lookups = opts->iterations ? opts->iterations : BTREE_LOOKUPS;
+    for (size_t t = 0; t < ntiers; t++) {
+        if (tiers[t].tree_bytes * 2 >= ram_limit) {
+            printf("  (skipping %s tier — exceeds 25%% of RAM)\n", tiers[t].name);
+            ntiers = t;
+            break;
+        }
+        for (size_t node = BTREE_NODE_MIN; node <= BTREE_NODE_MAX; node *= 2) {
+            membench_btree_result_t r = {0};
+            if (membench_cpu_btree(node, tiers[t].tree_bytes, lookups, &r) != 0)
+                continue;
+            membench_print_btree(&r, tiers[t].name, opts->format);
+            membench_btree_tier_update(&tiers[t], &r);
+        }
+    }
+
+    if (opts->format == MEMBENCH_FMT_TABLE)
+        printf("\n  --- Recommended node size per tier ---\n");
+    for (size_t t = 0; t < ntiers; t++) {
+        if (tiers[t].best_lookup_node)
+            membench_print_btree_tier(&tiers[t], opts->format);
+    }
+    return 0;
+}
+
+/* Record layouts: same octave sweep; each scan moves ~RECORD_TARGET_BYTES */
+#define RECORD_SWEEP_MIN    (4 * 1024)
+#define RECORD_SWEEP_MAX    ((size_t)256 * 1024 * 1024)
+#define RECORD_TARGET_BYTES ((uint64_t)512 * 1024 * 1024)
+#define RECORD_MIN_PASSES   3
+
+static int run_record_layout(const membench_options_t *opts, size_t ram_limit) {
+    size_t single = opts->buffer_size;
+    size_t *sizes = &single;
+    size_t num = 1;
+    if (!opts->buffer_size) {
+        num = membench_cpu_generate_sizes(RECORD_SWEEP_MIN, RECORD_SWEEP_MAX, 1, &sizes);
+        if (num == 0) return -1;
+    }
+    int rc = 0;
+
+    for (int l = 0; l < MEMBENCH_RECORD_NUM_LAYOUTS; l++) {
+        for (int k = 0; k < MEMBENCH_NUM_SCAN_KERNELS; k++) {
+            for (size_t i = 0; i < num; i++) {
+                if (sizes[i] >= ram_limit) break;
+                uint64_t passes = opts->iterations ? opts->iterations
+                                                   : RECORD_TARGET_BYTES / sizes[i];
+                if (passes < RECORD_MIN_PASSES) passes = RECORD_MIN_PASSES;
+                membench_record_result_t r = {0};
+                int pr = membench_cpu_record_layout((membench_record_layout_t)l,
+                                                    (membench_scan_kernel_t)k,
+                                                    opts->record_fields, opts->field_bytes,
+                                                    opts->scan_fields, sizes[i], passes, &r);
+                if (keep_first_failure(&rc, pr) == 0)
+                    membench_print_record_layout(&r,
+                        membench_record_layout_name((membench_record_layout_t)l),
+                        membench_scan_kernel_name((membench_scan_kernel_t)k),
+                        opts->format);
             }
         }
     }
 
-    if (opts->tests & MEMBENCH_TEST_BANDWIDTH) {
-        /* Determine RAM limit: skip sizes >= 50% of physical RAM to avoid
-         * measuring swap performance instead of DRAM. */
-        membench_sysinfo_t si = {0};
-        membench_sysinfo_get(&si);
-        size_t ram_limit = si.total_ram > 0 ? si.total_ram / 2 : (size_t)-1;
+    if (sizes != &single) free(sizes);
+    return rc;
+}
+
+/* Linked structures: node sizes 32 B .. 256 B, L1 through DRAM */
+#define LINKED_SWEEP_MIN    (16 * 1024)
+#define LINKED_SWEEP_MAX    ((size_t)64 * 1024 * 1024)
+
+static const size_t LINKED_NODE_SIZES[] = { 32, 64, 128, 256 };
+#define NUM_LINKED_NODE_SIZES \
+    (sizeof(LINKED_NODE_SIZES) / sizeof(LINKED_NODE_SIZES[0]))
+
+static int run_linked(const membench_options_t *opts, size_t ram_limit) {
+    size_t single = opts->buffer_size;
+    size_t *sizes = &single;
+    size_t num = 1;
+    if (!opts->buffer_size) {
+        num = membench_cpu_generate_sizes(LINKED_SWEEP_MIN, LINKED_SWEEP_MAX, 1, &sizes);
+        if (num == 0) return -1;
+    }
+    int rc = 0, ran = 0;
+
+    for (int k = 0; k < MEMBENCH_LINKED_NUM_KINDS; k++) {
+        for (size_t ns = 0; ns < NUM_LINKED_NODE_SIZES; ns++) {
+            size_t node = LINKED_NODE_SIZES[ns];
+            for (size_t i = 0; i < num; i++) {
+                /* malloc'd nodes carry allocator headers: budget 2x */
+                if (sizes[i] * 2 >= ram_limit) break;
+                if (sizes[i] / node < 2) continue;     /* a structure needs 2 nodes */
+                ran = 1;
+                uint64_t passes = opts->iterations ? opts->iterations
+                                : membench_cpu_linked_auto_passes(node, sizes[i]);
+                membench_linked_result_t r[MEMBENCH_ALLOC_NUM_ORDERS];
+                int pr = membench_cpu_linked((membench_linked_kind_t)k, node, sizes[i],
+                                             passes, r);
+                if (keep_first_failure(&rc, pr) != 0) continue;
+                for (int o = 0; o < MEMBENCH_ALLOC_NUM_ORDERS; o++)
+                    membench_print_linked(&r[o],
+                        membench_linked_kind_name((membench_linked_kind_t)k),
+                        membench_alloc_order_name((membench_alloc_order_t)o),
+                        opts->format);
+            }
+        }
+    }
+    if (!ran)
+        printf("  Skipped — the buffer must hold at least two %zu-byte nodes\n",
+               LINKED_NODE_SIZES[0]);
+
+    if (sizes != &single) free(sizes);
+    return rc;
+}
+
+/* Skewed latency: Zipf exponents plus the classic 90/10 hot/cold split */
+#define SKEW_SWEEP_MIN      (16 * 1024)
+#define SKEW_SWEEP_MAX      ((size_t)256 * 1024 * 1024)
+#define SKEW_ACCESSES       (1ULL << 20)
+
+static const double SKEW_ZIPF_S[] = { 0.0, 0.6, 0.8, 0.99, 1.2 };
+#define NUM_SKEW_ZIPF_S (sizeof(SKEW_ZIPF_S) / sizeof(SKEW_ZIPF_S[0]))
+
+static int run_skewed(const membench_options_t *opts, size_t ram_limit) {
+    size_t single = opts->buffer_size;
+    size_t *sizes = &single;
+    size_t num = 1;
+    if (!opts->buffer_size) {
+        num = membench_cpu_generate_sizes(SKEW_SWEEP_MIN, SKEW_SWEEP_MAX, 1, &sizes);
+        if (num == 0) return -1;
+    }
+    uint64_t accesses = opts->iterations ? opts->iterations : SKEW_ACCESSES;
+
+    membench_skew_t dists[NUM_SKEW_ZIPF_S + 1];
+    size_t ndists = 0;
+    if (opts->zipf_s >= 0.0) {
+        dists[ndists++] = (membench_skew_t){ MEMBENCH_SKEW_ZIPF, opts->zipf_s, 0.0, 0.0 };
+    } else {
+        for (size_t z = 0; z < NUM_SKEW_ZIPF_S; z++)
+            dists[ndists++] = (membench_skew_t){ MEMBENCH_SKEW_ZIPF, SKEW_ZIPF_S[z], 0.0, 0.0 };
+        dists[ndists++] = (membench_skew_t){ MEMBENCH_SKEW_HOTCOLD, 0.0, 0.10, 0.90 };
+    }
+
+    int rc = 0;
+    for (size_t d = 0; d < ndists; d++) {
+        for (size_t i = 0; i < num; i++) {
+            if (sizes[i] * 2 >= ram_limit) break;
+            membench_skew_result_t r = {0};
+            int pr = membench_cpu_skewed_latency(&dists[d], sizes[i], accesses, &r);
+            if (keep_first_failure(&rc, pr) == 0)
+                membench_print_skewed(&r, opts->format);
+        }
+    }
+
+    if (sizes != &single) free(sizes);
+    return rc;
+}
+
+static int run_replay(const membench_options_t *opts, size_t ram_limit) {
+    static const char *const mode_names[MEMBENCH_REPLAY_NUM_MODES] = {
+        "dependent", "independent"
+    };
+    int rc = 0;
+
+    if (opts->format == MEMBENCH_FMT_TABLE)
+        printf("  Trace: %s\n", opts->trace_path);
+    for (int m = 0; m < MEMBENCH_REPLAY_NUM_MODES; m++) {
+        if (opts->replay_order >= 0 && opts->replay_order != m) continue;
+        membench_replay_result_t r;
+        rc = membench_cpu_replay(opts->trace_path, (membench_replay_mode_t)m,
+                                 ram_limit, &r);
+        if (rc != 0) {
+            fprintf(stderr, "Replay failed: '%s' is not a valid trace or its "
+                    "span exceeds 50%% of RAM\n", opts->trace_path);
+            return rc;
+        }
+        membench_print_replay(&r, mode_names[m], opts->format);
+        membench_replay_result_free(&r);
+    }
+    return rc;
+}
+
+static int run_cache_sim(const membench_options_t *opts, const membench_sysinfo_t *si) {
+    membench_cache_profile_t prof;
+
+    if (opts->profile_path) {
+        if (membench_cache_profile_load(opts->profile_path, &prof) != 0) {
+            fprintf(stderr, "Cannot read cache profile '%s'\n", opts->profile_path);
+            return -1;
+        }
+    } else {
+        membench_cache_info_t cinfo = {0};
+        if (detect_cache(MEMBENCH_DETECT_MAX_BYTES, 0, &cinfo) != 0) return -1;
+        int rc = membench_cache_profile_from_info(&cinfo, si, &prof);
+        membench_cache_info_free(&cinfo);
+        if (rc != 0) return -1;
+    }
+    if (opts->format == MEMBENCH_FMT_TABLE)
+        printf("  --- Cache profile ---\n");
+    membench_print_cache_profile(&prof, opts->format);
+
+    if (opts->save_profile) {
+        if (membench_cache_profile_save(opts->save_profile, &prof) != 0) {
+            fprintf(stderr, "Cannot write cache profile '%s'\n", opts->save_profile);
+            return -1;
+        }
+        if (opts->format == MEMBENCH_FMT_TABLE)
+            printf("  Profile saved to %s\n", opts->save_profile);
+    }
+    if (!opts->trace_path) return 0;
+
+    if (opts->format == MEMBENCH_FMT_TABLE)
+        printf("\n  --- Simulated: %s ---\n", opts->trace_path);
+    for (int p = 0; p < MEMBENCH_SIM_NUM_POLICIES; p++) {
+        if (opts->sim_policy >= 0 && opts->sim_policy != p) continue;
+        membench_sim_result_t r;
+        if (membench_cachesim_run_trace(opts->trace_path, &prof,
+                                        (membench_sim_policy_t)p, &r) != 0) {
+            fprintf(stderr, "Simulation failed: '%s' is not a valid trace or the "
+                    "profile is inconsistent\n", opts->trace_path);
+            return -1;
+        }
+        membench_print_cachesim(&r, &prof, opts->format);
+    }
+    return 0;
+}
+
+/* Tile search: matrix sizes in n (doubles per side) and the work per
+ * measurement, enough to average out a few timer ticks */
+static const size_t TILE_TRANSPOSE_N[] = { 1024, 2048, 4096 };
+static const size_t TILE_MATMUL_N[]    = { 256, 512, 1024 };
+#define TILE_TRANSPOSE_BYTES ((uint64_t)256 * 1024 * 1024)
+#define TILE_MATMUL_FLOPS    ((uint64_t)1 << 30)
 
-        printf("\n=== CPU Read Bandwidth ===\n");
+static int run_tile_tune(const membench_options_t *opts, const membench_sysinfo_t *si,
+                         size_t ram_limit) {
+    /* Candidates come from the measured hierarchy; sysinfo fills in any
+     * level the latency sweep could not resolve. */
+    membench_cache_info_t cinfo = {0};
+    if (detect_cache(MEMBENCH_DETECT_MAX_BYTES, 0, &cinfo) != 0) return -1;
+    if (!cinfo.l1_size_bytes) cinfo.l1_size_bytes = si->l1_data_cache;
+    if (!cinfo.l2_size_bytes) cinfo.l2_size_bytes = si->l2_cache;
+    if (!cinfo.l3_size_bytes) cinfo.l3_size_bytes = si->l3_cache;
+
+    for (int k = 0; k < MEMBENCH_TILE_NUM_KERNELS; k++) {
+        membench_tile_kernel_t kernel = (membench_tile_kernel_t)k;
+        const char *kname = membench_tile_kernel_name(kernel);
+        const size_t *ns = kernel == MEMBENCH_TILE_MATMUL ? TILE_MATMUL_N : TILE_TRANSPOSE_N;
+        size_t num_n = 3, user_n = 0;
+        size_t nmat = kernel == MEMBENCH_TILE_MATMUL ? 3 : 2;
         if (opts->buffer_size) {
-            membench_bandwidth_result_t r = {0};
-            uint64_t iters = opts->iterations ? opts->iterations
-                             : auto_iter(opts->buffer_size, 0);
-            rc = membench_cpu_read_bandwidth(opts->buffer_size, iters, &r);
-            if (rc == 0) membench_print_bandwidth(&r, "Read BW", opts->format);
-        } else {
-            for (size_t i = 0; i < NUM_DEFAULT_BW_SIZES; i++) {
-                if (DEFAULT_BW_SIZES[i] >= ram_limit) {
-                    printf("  (skipping %.1f GB+ — exceeds 50%% of %.1f GB RAM)\n",
-                           (double)DEFAULT_BW_SIZES[i] / (1024.0*1024.0*1024.0),
-                           (double)si.total_ram / (1024.0*1024.0*1024.0));
-                    break;
+            /* --size is the bytes of one matrix */
+            user_n = (size_t)sqrt((double)(opts->buffer_size / sizeof(double)));
+            ns = &user_n;
+            num_n = 1;
+        }
+
+        for (size_t i = 0; i < num_n; i++) {
+            size_t n = ns[i];
+            if (n < 16) continue;
+            if (n * n * sizeof(double) * nmat * 2 >= ram_limit) break;
+
+            uint64_t reps;
+            if (kernel == MEMBENCH_TILE_MATMUL)
+                reps = TILE_MATMUL_FLOPS / (2 * (uint64_t)n * n * n);
+            else
+                reps = TILE_TRANSPOSE_BYTES / (2 * (uint64_t)n * n * sizeof(double));
+            if (opts->iterations) reps = opts->iterations;
+            if (reps == 0) reps = 1;
+
+            if (opts->format == MEMBENCH_FMT_TABLE)
+                printf("\n  --- %s, n = %zu ---\n", kname, n);
+            membench_tile_result_t base;
+            if (membench_cpu_tile(kernel, n, 0, reps, &base) != 0) {
+                membench_cache_info_free(&cinfo);
+                return -1;
+            }
+            membench_print_tile(&base, kname, "-", opts->format);
+
+            membench_tile_level_t levels[MEMBENCH_TILE_MAX_LEVELS];
+            size_t nlev = membench_cpu_tile_levels(&cinfo, kernel, n, levels);
+            for (size_t l = 0; l < nlev; l++) {
+                for (size_t t = 0; t < levels[l].num_tiles; t++) {
+                    membench_tile_result_t r;
+                    if (membench_cpu_tile(kernel, n, levels[l].tiles[t], reps, &r) != 0)
+                        continue;
+                    membench_print_tile(&r, kname, levels[l].name, opts->format);
+                    membench_tile_level_update(&levels[l], &r);
                 }
-                membench_bandwidth_result_t r = {0};
-                uint64_t iters = auto_iter(DEFAULT_BW_SIZES[i], 0);
-                rc = membench_cpu_read_bandwidth(DEFAULT_BW_SIZES[i], iters, &r);
-                if (rc == 0) membench_print_bandwidth(&r, "Read BW", opts->format);
+            }
+            for (size_t l = 0; l < nlev; l++) {
+                if (levels[l].best.tile)
+                    membench_print_tile_best(&levels[l], &base, kname, opts->format);
             }
         }
+    }
 
-        printf("\n=== CPU Write Bandwidth ===\n");
-        if (opts->buffer_size) {
-            membench_bandwidth_result_t r = {0};
+    membench_cache_info_free(&cinfo);
+    return 0;
+}
+
+/* Multiply-adds per element of the intensity sweep: 1/8 .. 32 FLOP/byte */
+static const int ROOF_FMA_SWEEP[] = { 0, 1, 2, 4, 8, 16, 32, 64, 128 };
+#define NUM_ROOF_FMA (sizeof(ROOF_FMA_SWEEP) / sizeof(ROOF_FMA_SWEEP[0]))
+
+static int run_roofline(const membench_options_t *opts, const membench_sysinfo_t *si,
+                        size_t ram_limit) {
+    int threads = opts->threads;
+    if (threads < 1) threads = si->num_cores_physical > 0 ? si->num_cores_physical
+                                                          : si->num_cores_logical;
+    if (threads < 1) threads = 1;
+
+    /* Half of each cache keeps the working set resident; DRAM is well past
+     * the last level */
+    size_t dram = si->l3_cache * 8;
+    if (dram < (size_t)256 * 1024 * 1024) dram = (size_t)256 * 1024 * 1024;
+    while (dram * 2 >= ram_limit && dram > (size_t)16 * 1024 * 1024) dram /= 2;
+    size_t levels[MEMBENCH_ROOF_NUM_LEVELS] = {
+        si->l1_data_cache / 2, si->l2_cache / 2, si->l3_cache / 2, dram
+    };
+
+    membench_roofline_t roof;
+    if (membench_cpu_roofline(levels, threads, &roof) != 0) return -1;
+    membench_print_roofline(&roof, opts->format);
+
+    /* Kernel points: the DRAM working set unless --size is given */
+    size_t ws = opts->buffer_size ? opts->buffer_size : dram;
+    int fma_single = (int)(opts->intensity * 4.0 + 0.5);   /* 2f FLOPs / 8 B */
+    size_t nfma = opts->intensity > 0.0 ? 1 : NUM_ROOF_FMA;
+    int counts[2] = { 1, threads };
+    size_t npasses = threads > 1 ? 2 : 1;
+
+    membench_roofline_point_t *pts =
+        (membench_roofline_point_t *)calloc(nfma * npasses, sizeof(*pts));
+    if (!pts) return -1;
+    size_t n = 0;
+
+    if (opts->format == MEMBENCH_FMT_TABLE)
+        printf("\n  --- Intensity kernel ---\n");
+    for (size_t c = 0; c < npasses; c++) {
+        for (size_t k = 0; k < nfma; k++) {
+            int fma = opts->intensity > 0.0 ? fma_single : ROOF_FMA_SWEEP[k];
+            if (membench_cpu_roofline_kernel(ws, fma, counts[c], &pts[n]) != 0) {
+                free(pts);
+                return -1;
+            }
+            membench_print_roofline_point(&pts[n], opts->format);
+            n++;
+        }
+    }
+
+    if (opts->format == MEMBENCH_FMT_TABLE)
+        membench_print_roofline_chart(&roof, pts, n);
+    if (opts->svg_path) {
+        if (membench_write_roofline_svg(opts->svg_path, &roof, pts, n) != 0) {
+            fprintf(stderr, "Cannot write '%s'\n", opts->svg_path);
+            free(pts);
+            return -1;
+        }
+        if (opts->format == MEMBENCH_FMT_TABLE)
+            printf("  Chart written to %s\n", opts->svg_path);
+    }
+    free(pts);
+    return 0;
+}
+
+/* Vector license: bursts long enough to reach the lowered clock, and an L1
+ * working set so the vector units, not memory, set the pace */
+#define LICENSE_BURST_MS   20.0
+#define LICENSE_WINDOW_MS  10.0
+
+static int run_license(const membench_options_t *opts, const membench_sysinfo_t *si) {
+    size_t bytes = opts->buffer_size ? opts->buffer_size
+                 : si->l1_data_cache ? si->l1_data_cache / 2 : (size_t)16 * 1024;
+    double window = opts->license_ms > 0.0 ? opts->license_ms : LICENSE_WINDOW_MS;
+    membench_license_t r;
+    if (membench_cpu_vector_license(bytes, LICENSE_BURST_MS, window, &r) != 0) return -1;
+    membench_print_license(&r, opts->format);
+    return 0;
+}
+
+/* Instruction-side sweeps: lines to 4x L2, the uop cache to 256 KB (past any
+ * L1i), pages to 8K pages (4x a 2K-entry second-level TLB) */
+#define ICACHE_LINES_MIN   ((size_t)1024 * 1024)
+#define ICACHE_LINES_MAX   ((size_t)16 * 1024 * 1024)
+#define ICACHE_UOPS_MAX    ((size_t)256 * 1024)
+#define ICACHE_PAGES_MAX   ((size_t)8192 * (4096 + 64))
+
+static int run_icache(const membench_options_t *opts, const membench_sysinfo_t *si,
+                      size_t ram_limit) {
+    size_t lines = si->l2_cache * 4;
+    if (lines < ICACHE_LINES_MIN) lines = ICACHE_LINES_MIN;
+    if (lines > ICACHE_LINES_MAX) lines = ICACHE_LINES_MAX;
+    size_t pages = ICACHE_PAGES_MAX;
+    while (pages * 2 >= ram_limit && pages > ICACHE_LINES_MIN) pages /= 2;
+    const size_t max[MEMBENCH_ICACHE_NUM_SWEEPS] = { lines, ICACHE_UOPS_MAX, pages };
+
+    for (int s = 0; s < MEMBENCH_ICACHE_NUM_SWEEPS && !membench_cancel_requested(); s++) {
+        membench_icache_result_t r;
+        size_t footprint = opts->buffer_size ? opts->buffer_size : max[s];
+        int rc = membench_cpu_icache_sweep((membench_icache_sweep_t)s, footprint,
+                                           opts->iterations, &r);
+        if (rc == -2 && !membench_cancel_requested())
+            printf("  Skipped — cannot generate and run code here\n");
+        if (rc != 0) return -1;
+        if (s > 0 && opts->format == MEMBENCH_FMT_TABLE) printf("\n");
+        membench_print_icache(&r, opts->format);
+        membench_cache_info_free(&r.curve);
+    }
+    return 0;
+}
+
+/* Pointer-content prefetch: half of each cache, and DRAM well past the LLC */
+#define DMP_DRAM_MIN       ((size_t)64 * 1024 * 1024)
+
+static int run_dmp(const membench_options_t *opts, const membench_sysinfo_t *si,
+                   size_t ram_limit) {
+    size_t dram = si->l3_cache * 4;
+    if (dram < DMP_DRAM_MIN) dram = DMP_DRAM_MIN;
+    while (dram * 2 >= ram_limit && dram > (size_t)16 * 1024 * 1024) dram /= 2;
+    size_t levels[MEMBENCH_DMP_NUM_LEVELS] = {
+        si->l1_data_cache / 2, si->l2_cache / 2, si->l3_cache / 2, dram
+    };
+    if (opts->buffer_size) {
+        /* One working set, reported under the level it falls in */
+        int lv = MEMBENCH_DMP_DRAM;
+        for (int i = MEMBENCH_DMP_L3; i >= MEMBENCH_DMP_L1; i--)
+            if (levels[i] && opts->buffer_size <= levels[i] * 2) lv = i;
+        memset(levels, 0, sizeof(levels));
+        levels[lv] = opts->buffer_size;
+    }
+
+    membench_dmp_t r;
+    if (membench_cpu_dmp(levels, opts->iterations, &r) != 0) return -1;
+    membench_print_dmp(&r, opts->format);
+    return 0;
+}
+
+/* Tuning probes: a short cache sweep, then DRAM sizes well past the LLC */
+#define TUNE_DETECT_VISITS   20000000ULL
+#define TUNE_DRAM_MIN        ((size_t)64 * 1024 * 1024)
+#define TUNE_STORE_BYTES     ((uint64_t)1 << 30)
+
+static int run_emit_tuning(const membench_options_t *opts, const membench_sysinfo_t *si,
+                           size_t ram_limit) {
+    membench_tuning_t t = {0};
+    snprintf(t.cpu_model, sizeof(t.cpu_model), "%s", si->cpu_model);
+    t.cache_line = si->cache_line ? si->cache_line : get_cache_line_size_main();
+    t.numa_nodes = si->numa_nodes > 0 ? si->numa_nodes : 1;
+
+    /* L1 and L2 only need the sweep to run a few times past L2 */
+    size_t sweep_max = si->l2_cache ? si->l2_cache * 4 : (size_t)16 * 1024 * 1024;
+    membench_cache_info_t cinfo = {0};
+    if (detect_cache(sweep_max, TUNE_DETECT_VISITS, &cinfo) == 0) {
+        t.l1_bytes = cinfo.l1_size_bytes;
+        t.l2_bytes = cinfo.l2_size_bytes;
+        membench_cache_info_free(&cinfo);
+    }
+    if (!t.l1_bytes) t.l1_bytes = si->l1_data_cache;
+    if (!t.l2_bytes) t.l2_bytes = si->l2_cache;
+    t.l3_bytes = si->l3_cache;
+
+    size_t dram = t.l3_bytes * 4;
+    if (dram < TUNE_DRAM_MIN) dram = TUNE_DRAM_MIN;
+    while (dram * 2 >= ram_limit && dram > (size_t)16 * 1024 * 1024) dram /= 2;
+
+    membench_latency_result_t lat = {0};
+    if (membench_cpu_read_latency(dram, 2, &lat) == 0)
+        t.dram_latency_ns = lat.avg_latency_ns;
+
+    /* Bandwidth vs. threads: powers of two up to the core count */
+    int max_threads = opts->threads > 0 ? opts->threads : si->num_cores_logical;
+    if (max_threads < 1) max_threads = 1;
+    for (int n = 1; t.num_thread_points < MEMBENCH_TUNE_MAX_POINTS; n *= 2) {
+        if (n > max_threads) n = max_threads;
+        membench_roofline_point_t pt;
+        if (membench_cpu_roofline_kernel(dram, 0, n, &pt) == 0) {
+            t.bw_threads[t.num_thread_points] = n;
+            t.bw_gbps[t.num_thread_points] = pt.gbps;
+            t.num_thread_points++;
+        }
+        if (n == max_threads) break;
+    }
+
+    /* Normal vs. streaming stores, one octave at a time across the LLC */
+    size_t lo = t.l2_bytes ? t.l2_bytes / 2 : (size_t)256 * 1024;
+    size_t hi = t.l3_bytes ? t.l3_bytes * 4 : dram;
+    size_t s = 64 * 1024;
+    while (s * 2 <= lo) s *= 2;
+    for (; s <= hi && s * 2 < ram_limit && t.num_store_points < MEMBENCH_TUNE_MAX_POINTS;
+         s *= 2) {
+        uint64_t iters = TUNE_STORE_BYTES / s;
+        if (iters < 2) iters = 2;
+        membench_bandwidth_result_t st = {0}, nt = {0};
+        if (membench_cpu_write_bandwidth(s, iters, &st) != 0) continue;
+        membench_cpu_nt_write_bandwidth(s, iters, &nt);   /* 0 GB/s if unsupported */
+        t.store_bytes[t.num_store_points] = s;
+        t.store_gbps[t.num_store_points] = st.bandwidth_gbps;
+        t.nt_store_gbps[t.num_store_points] = nt.bandwidth_gbps;
+        t.num_store_points++;
+    }
+
+    membench_tuning_derive(&t);
+    membench_print_tuning(&t, opts->format);
+
+    if (opts->tuning_path) {
+        char path[1024];
+        snprintf(path, sizeof(path), "%s.h", opts->tuning_path);
+        if (membench_tuning_write_header(path, &t) != 0) {
+            fprintf(stderr, "Cannot write '%s'\n", path);
+            return -1;
+        }
+        snprintf(path, sizeof(path), "%s.json", opts->tuning_path);
+        if (membench_tuning_write_json(path, &t) != 0) {
+            fprintf(stderr, "Cannot write '%s'\n", path);
+            return -1;
+        }
+        if (opts->format == MEMBENCH_FMT_TABLE)
+            printf("  Written to %s.h and %s.json\n", opts->tuning_path, opts->tuning_path);
+    }
+    return 0;
+}
+
+/* Quick health check: one probe per level, DRAM well past the LLC but
+ * small enough to allocate and fault in quickly */
+#define QUICK_DRAM_MIN ((size_t)64 * 1024 * 1024)
+#define QUICK_DRAM_MAX ((size_t)512 * 1024 * 1024)
+
+static int run_quick(const membench_options_t *opts, const membench_sysinfo_t *si,
+                     size_t ram_limit) {
+    membench_quick_probe_t p;
+    memset(&p, 0, sizeof(p));
+    p.l1_bytes = (si->l1_data_cache ? si->l1_data_cache : 32 * 1024) / 2;
+    p.l2_bytes = (si->l2_cache ? si->l2_cache : 1024 * 1024) / 2;
+    /* Past L2 but well inside L3 (at most 4x L2): half of a 100 MB+ LLC
+     * would mostly measure TLB misses */
+    p.l3_bytes = si->l3_cache / 2;
+    if (p.l3_bytes > p.l2_bytes * 8) p.l3_bytes = p.l2_bytes * 8;
+    p.dram_bytes = si->l3_cache * 2;
+    if (p.dram_bytes < QUICK_DRAM_MIN) p.dram_bytes = QUICK_DRAM_MIN;
+    if (p.dram_bytes > QUICK_DRAM_MAX) p.dram_bytes = QUICK_DRAM_MAX;
+    while (p.dram_bytes * 2 >= ram_limit && p.dram_bytes > (size_t)16 * 1024 * 1024)
+        p.dram_bytes /= 2;
+    p.threads = opts->threads > 0 ? opts->threads : si->num_cores_logical;
+
+    if (membench_cpu_quick_probe(&p) != 0) return -1;
+
+    membench_health_report_t report;
+    membench_health_evaluate(&p, membench_health_expect_for(si->cpu_model), &report);
+    membench_print_health(&report, opts->format);
+    return report.overall == MEMBENCH_HEALTH_FAIL ? 2 : 0;
+}
+
+/*
+ * Job file suite: rows stream as they finish in table/CSV; JSON waits and
+ * prints one document for the whole matrix.
+ */
+static void print_suite_row(const membench_suite_t *suite, const membench_suite_row_t *row,
+                            void *user) {
+    const membench_options_t *opts = (const membench_options_t *)user;
+    if (opts->format != MEMBENCH_FMT_JSON)
+        membench_print_suite_row(suite, row, opts->format);
+    fflush(stdout);
+}
+
+static int run_suite(const membench_options_t *opts, const membench_sysinfo_t *si) {
+    static membench_suite_t suite;
+    char err[256];
+    if (membench_suite_load(opts->job_path, &suite, err, sizeof(err)) != 0) {
+        fprintf(stderr, "%s: %s\n", opts->job_path, err);
+        return -1;
+    }
+    for (size_t j = 0; j < suite.num_jobs; j++) {
+        if (!membench_registry_find(suite.jobs[j].bench)) {
+            fprintf(stderr, "%s: job [%s]: unknown bench '%s'\n",
+                    opts->job_path, suite.jobs[j].name, suite.jobs[j].bench);
+            return -1;
+        }
+    }
+
+    size_t n = 0;
+    membench_suite_row_t *rows = membench_suite_run(&suite, g_checkpoint, print_suite_row,
+                                                    (void *)opts, &n);
+    if (!rows) return -1;
+    if (opts->format == MEMBENCH_FMT_JSON)
+        membench_print_suite_json(&suite, rows, n, si);
+
+    int rc = 0;
+    for (size_t i = 0; i < n; i++)
+        if (rows[i].status != 0) rc = -1;
+    free(rows);
+    return rc;
+}
+
+/* ── Run CPU benchmarks ───────────────────────────────────────────────────── */
+
+/* Selected and not cancelled: after a signal the remaining tests are skipped */
+static bool want(const membench_options_t *opts, membench_test_flags_t test) {
+    return (opts->tests & test) && !membench_cancel_requested();
+}
+
+/*
+ * Run one registry benchmark over --size or the default sizes for its kind.
+ * Built-ins print in their historical format; plugins (`stats`) also show
+ * the spread over repetitions.
+ */
+#define PLUGIN_DEFAULT_REPS 5
+
+static int run_registered(const membench_options_t *opts, const membench_bench_t *b,
+                          bool stats, const membench_sysinfo_t *si, size_t ram_limit) {
+    int is_latency = b->kind == MEMBENCH_BENCH_LATENCY;
+    const size_t *sizes = is_latency ? DEFAULT_LATENCY_SIZES : DEFAULT_BW_SIZES;
+    size_t num_sizes = is_latency ? NUM_DEFAULT_LATENCY_SIZES : NUM_DEFAULT_BW_SIZES;
+    if (opts->buffer_size) {
+        sizes = &opts->buffer_size;
+        num_sizes = 1;
+    }
+    int reps = opts->repeat ? opts->repeat : (stats ? PLUGIN_DEFAULT_REPS : 1);
+
+    int rc = 0;
+    for (size_t i = 0; i < num_sizes; i++) {
+        if (!opts->buffer_size && sizes[i] >= ram_limit) {
+            printf("  (skipping %.1f GB+ — exceeds 50%% of %.1f GB RAM)\n",
+                   (double)sizes[i] / (1024.0*1024.0*1024.0),
+                   (double)si->total_ram / (1024.0*1024.0*1024.0));
+            break;
+        }
+        char key[MEMBENCH_CHECKPOINT_KEY_LEN];
+        snprintf(key, sizeof(key), "bench/%s/%zu", b->name, sizes[i]);
+        size_t nv = 0;
+        const double *saved = membench_checkpoint_find(g_checkpoint, key, &nv);
+
+        membench_bench_result_t r;
+        membench_energy_sample_t e0, e1;
+        membench_monitor_stats_t clock;
+        bool metered = false, monitored = false;
+        if (saved && nv == MEMBENCH_BENCH_RESULT_VALUES) {
+            membench_bench_result_unpack(saved, &r);
+        } else {
+            if (membench_cancel_requested()) break;
             uint64_t iters = opts->iterations ? opts->iterations
-                             : auto_iter(opts->buffer_size, 0);
-            rc = membench_cpu_write_bandwidth(opts->buffer_size, iters, &r);
-            if (rc == 0) membench_print_bandwidth(&r, "Write BW", opts->format);
+                             : membench_cpu_auto_iterations(sizes[i], is_latency);
+            metered = g_energy.num_domains > 0;
+            monitored = membench_monitor_source() != MEMBENCH_MONITOR_NONE;
+            if (monitored) membench_monitor_begin();
+            if (metered) membench_energy_sample(&g_energy, &e0);
+            int pr = membench_bench_run(b, sizes[i], iters, reps, &r);
+            if (metered) membench_energy_sample(&g_energy, &e1);
+            if (monitored) membench_monitor_end(&clock);
+            if (keep_first_failure(&rc, pr) != 0) continue;
+            double v[MEMBENCH_BENCH_RESULT_VALUES];
+            membench_bench_result_pack(&r, v);
+            membench_checkpoint_record(g_checkpoint, key, v, MEMBENCH_BENCH_RESULT_VALUES);
+        }
+
+        if (stats) {
+            membench_print_bench(b, &r, opts->format);
+        } else if (is_latency) {
+            membench_latency_result_t lr = { r.buffer_size, r.ns_per_op, r.ops,
+                                             membench_cpu_kernel_name(b->name,
+                                                                      r.buffer_size) };
+            membench_print_latency(&lr, b->label, opts->format);
         } else {
-            for (size_t i = 0; i < NUM_DEFAULT_BW_SIZES; i++) {
-                if (DEFAULT_BW_SIZES[i] >= ram_limit) {
-                    printf("  (skipping %.1f GB+ — exceeds 50%% of %.1f GB RAM)\n",
-                           (double)DEFAULT_BW_SIZES[i] / (1024.0*1024.0*1024.0),
-                           (double)si.total_ram / (1024.0*1024.0*1024.0));
-                    break;
-                }
-                membench_bandwidth_result_t r = {0};
-                uint64_t iters = auto_iter(DEFAULT_BW_SIZES[i], 0);
-                rc = membench_cpu_write_bandwidth(DEFAULT_BW_SIZES[i], iters, &r);
-                if (rc == 0) membench_print_bandwidth(&r, "Write BW", opts->format);
-            }
+            membench_bandwidth_result_t br = { r.buffer_size, r.bandwidth_gbps,
+                                               r.ns_per_op, r.bytes,
+                                               membench_cpu_kernel_name(b->name,
+                                                                        r.buffer_size) };
+            membench_print_bandwidth(&br, b->label, opts->format);
+        }
+        if (metered) {
+            membench_energy_result_t er;
+            uint64_t runs = (uint64_t)r.reps;
+            if (membench_energy_diff(&g_energy, &e0, &e1,
+                                     (uint64_t)(r.ns_per_op * (double)(r.ops * runs)),
+                                     r.bytes * runs, r.ops * runs, &er) == 0)
+                membench_print_energy(b->label, r.buffer_size, &er, opts->format);
+            else
+                fprintf(stderr, "  Energy: counter went backwards with no known wrap point; "
+                        "point not metered\n");
         }
+        if (monitored) {
+            membench_print_monitor(b->label, r.buffer_size, &clock, membench_monitor_source(),
+                                   opts->format);
+            if (clock.throttled) g_throttled++;
+        }
+        fflush(stdout);
+    }
+    return rc;
+}
+
+static int run_builtin(const membench_options_t *opts, const char *name,
+                       const char *title, const membench_sysinfo_t *si, size_t ram_limit) {
+    const membench_bench_t *b = membench_registry_find(name);
+    if (!b) return -1;
+    if (membench_cancel_requested()) return 0;
+    printf("\n=== %s ===\n", title);
+    return run_registered(opts, b, false, si, ram_limit);
+}
+
+/* ── Run CPU benchmarks ───────────────────────────────────────────────────── */
+
+static int run_cpu(const membench_options_t *opts, const membench_sysinfo_t *sinfo,
+                   size_t first_plugin) {
+    int rc = 0;
+
+    /* Determine RAM limit: skip sizes >= 50% of physical RAM to avoid
+     * measuring swap performance instead of DRAM. */
+    membench_sysinfo_t si = *sinfo;
+    size_t ram_limit = si.total_ram > 0 ? si.total_ram / 2 : (size_t)-1;
+
+    /* The health check runs first and its verdict is the exit status even
+     * when other tests follow */
+    int health = 0;
+    if (want(opts, MEMBENCH_TEST_QUICK)) {
+        printf("\n=== Quick Health Check ===\n");
+        health = run_quick(opts, &si, ram_limit);
+    }
+
+    if (want(opts, MEMBENCH_TEST_LATENCY)) {
+        keep_first_failure(&rc, run_builtin(opts, "read-latency", "CPU Read Latency",
+                                            &si, ram_limit));
+        keep_first_failure(&rc, run_builtin(opts, "write-latency", "CPU Write Latency",
+                                            &si, ram_limit));
+    }
+
+    if (want(opts, MEMBENCH_TEST_BANDWIDTH)) {
+        keep_first_failure(&rc, run_builtin(opts, "read-bw", "CPU Read Bandwidth",
+                                            &si, ram_limit));
+        keep_first_failure(&rc, run_builtin(opts, "write-bw", "CPU Write Bandwidth",
+                                            &si, ram_limit));
     }
 
-    if (opts->tests & MEMBENCH_TEST_CACHE_DETECT) {
+    if (want(opts, MEMBENCH_TEST_CACHE_DETECT)) {
         printf("\n=== Cache Hierarchy Detection ===\n");
         membench_cache_info_t cinfo = {0};
-        rc = membench_cpu_detect_cache(&cinfo);
-        if (rc == 0) {
+        if (keep_first_failure(&rc, detect_cache(MEMBENCH_DETECT_MAX_BYTES, 0, &cinfo)) == 0) {
             membench_print_cache_info(&cinfo, opts->format);
             membench_cache_info_free(&cinfo);
         }
     }
 
-    return rc;
+    if (want(opts, MEMBENCH_TEST_HASH_PROBE)) {
+        printf("\n=== Hash Table Probe ===\n");
+        keep_first_failure(&rc, run_hash_probe(opts, ram_limit));
+    }
+
+    if (want(opts, MEMBENCH_TEST_SEARCH)) {
+        printf("\n=== Search Layout ===\n");
+        keep_first_failure(&rc, run_search_layout(opts, ram_limit));
+    }
+
+    if (want(opts, MEMBENCH_TEST_BTREE)) {
+        printf("\n=== B+tree Node Size Sweep ===\n");
+        keep_first_failure(&rc, run_btree_sweep(opts, &si, ram_limit));
+    }
+
+    if (want(opts, MEMBENCH_TEST_RECORD_LAYOUT)) {
+        printf("\n=== Record Layout (AoS / SoA / AoSoA) ===\n");
+        keep_first_failure(&rc, run_record_layout(opts, ram_limit));
+    }
+
+    if (want(opts, MEMBENCH_TEST_LINKED)) {
+        printf("\n=== Linked Structure Traversal ===\n");
+        keep_first_failure(&rc, run_linked(opts, ram_limit));
+    }
+
+    if (want(opts, MEMBENCH_TEST_SKEWED)) {
+        printf("\n=== Skewed Access Latency ===\n");
+        keep_first_failure(&rc, run_skewed(opts, ram_limit));
+    }
+
+    if (want(opts, MEMBENCH_TEST_REPLAY)) {
+        printf("\n=== Trace Replay ===\n");
+        keep_first_failure(&rc, run_replay(opts, ram_limit));
+    }
+
+    if (want(opts, MEMBENCH_TEST_CACHE_SIM)) {
+        printf("\n=== Cache Simulation ===\n");
+        keep_first_failure(&rc, run_cache_sim(opts, &si));
+    }
+
+    if (want(opts, MEMBENCH_TEST_ROOFLINE)) {
+        printf("\n=== Roofline ===\n");
+        keep_first_failure(&rc, run_roofline(opts, &si, ram_limit));
+    }
+
+    if (want(opts, MEMBENCH_TEST_TILE_TUNE)) {
+        printf("\n=== Tile Size Search ===\n");
+        keep_first_failure(&rc, run_tile_tune(opts, &si, ram_limit));
+    }
+
+    if (want(opts, MEMBENCH_TEST_TUNING)) {
+        printf("\n=== Tuning Advisor ===\n");
+        keep_first_failure(&rc, run_emit_tuning(opts, &si, ram_limit));
+    }
+
+    if (want(opts, MEMBENCH_TEST_LICENSE)) {
+        printf("\n=== Vector Frequency License ===\n");
+        keep_first_failure(&rc, run_license(opts, &si));
+    }
+
+    if (want(opts, MEMBENCH_TEST_ICACHE)) {
+        printf("\n=== Instruction-Side Detection ===\n");
+        keep_first_failure(&rc, run_icache(opts, &si, ram_limit));
+    }
+
+    if (want(opts, MEMBENCH_TEST_DMP)) {
+        printf("\n=== Pointer-Content Prefetch ===\n");
+        keep_first_failure(&rc, run_dmp(opts, &si, ram_limit));
+    }
+
+    if (opts->job_path && !membench_cancel_requested()) {
+        printf("\n=== Suite: %s ===\n", opts->job_path);
+        keep_first_failure(&rc, run_suite(opts, &si));
+    }
+
+    /* With a job file, plugin benchmarks run only where the file names them */
+    for (size_t i = opts->job_path ? membench_registry_count() : first_plugin;
+         i < membench_registry_count() && !membench_cancel_requested(); i++) {
+        const membench_bench_t *b = membench_registry_get(i);
+        printf("\n=== %s (plugin) ===\n", b->label ? b->label : b->name);
+        keep_first_failure(&rc, run_registered(opts, b, true, &si, ram_limit));
+    }
+
+    return health ? health : rc;
 }
 
 /* ── Run GPU benchmarks ───────────────────────────────────────────────────── */
@@ -282,6 +1176,25 @@ static int run_gpu(const membench_options_t *opts) {
 
 /* ── Entry point ──────────────────────────────────────────────────────────── */
 
+/*
+ * A checkpoint belongs to one command line: the arguments minus the
+ * checkpoint options themselves, so --checkpoint f and --resume f match.
+ */
+static void checkpoint_config(int argc, char **argv, char *buf, size_t len) {
+    size_t used = 0;
+    buf[0] = '\0';
+    for (int i = 1; i < argc && used < len; i++) {
+        if ((strcmp(argv[i], "--checkpoint") == 0 || strcmp(argv[i], "--resume") == 0) &&
+            i + 1 < argc) {
+            i++;
+            continue;
+        }
+        int w = snprintf(buf + used, len - used, "%s%s", used ? " " : "", argv[i]);
+        if (w < 0) break;
+        used += (size_t)w;
+    }
+}
+
 int main(int argc, char **argv) {
     membench_options_t opts = {0};
 
@@ -300,19 +1213,64 @@ int main(int argc, char **argv) {
         }
     }
 
+    /* Built-in tests first, so plugin benchmarks cannot take their names */
+    membench_cpu_register_builtins();
+    size_t first_plugin = membench_registry_count();
+    if (opts.plugin_path && membench_plugin_load(opts.plugin_path) < 0)
+        return 1;
+
+    if (opts.checkpoint_path) {
+        char config[4096], err[256];
+        checkpoint_config(argc, argv, config, sizeof(config));
+        g_checkpoint = membench_checkpoint_open(opts.checkpoint_path, config, opts.resume,
+                                                err, sizeof(err));
+        if (!g_checkpoint) {
+            fprintf(stderr, "%s: %s\n", opts.checkpoint_path, err);
+            return 1;
+        }
+        if (membench_checkpoint_loaded(g_checkpoint))
+            fprintf(stderr, "Resuming: %zu finished points in %s\n",
+                    membench_checkpoint_loaded(g_checkpoint), opts.checkpoint_path);
+    }
+
+    /* SIGINT / SIGTERM / SIGHUP stop after the current point */
+    membench_cancel_install();
+
     /* Initialize timer */
     if (membench_timer_init() != 0) {
         fprintf(stderr, "Failed to initialize high-resolution timer\n");
         return 1;
     }
 
+    if (opts.energy) {
+        char err[128];
+        if (membench_energy_open(&g_energy, NULL, err, sizeof(err)) != 0)
+            fprintf(stderr, "Energy: not measured, %s\n", err);
+    }
+
+    if (opts.monitor_pct > 0.0) {
+        char err[128];
+        if (membench_monitor_start(0, opts.monitor_pct, err, sizeof(err)) != 0)
+            fprintf(stderr, "Clock monitor: not running, %s\n", err);
+    }
+
+    /* Everything after this point counts towards the harness profile */
+    uint64_t run_start = membench_timer_ns();
+    if (opts.timeline_path) {
+        membench_timeline_enable(0);
+        membench_timeline_thread_name("main");
+    }
+
     /* Warm up CPU to stabilize clock frequency before benchmarking */
     cpu_freq_warmup();
 
-    /* Print system info */
+    /* Print system info, with the environment checked once the clocks
+     * have settled */
     membench_sysinfo_t sinfo = {0};
     membench_sysinfo_get(&sinfo);
+    membench_env_measure_noise(&sinfo.env, 0);
     membench_sysinfo_print(&sinfo);
+    membench_print_environment(&sinfo, opts.format);
 
     if (opts.verbose) {
         printf("  Timer resolution: %.2f ns\n", membench_timer_resolution_ns());
@@ -323,12 +1281,56 @@ int main(int argc, char **argv) {
     int rc = 0;
 
     if (opts.target == MEMBENCH_TARGET_CPU || opts.target == MEMBENCH_TARGET_ALL) {
-        rc = run_cpu(&opts);
+        rc = run_cpu(&opts, &sinfo, first_plugin);
     }
-    if (opts.target == MEMBENCH_TARGET_GPU || opts.target == MEMBENCH_TARGET_ALL) {
+    if ((opts.target == MEMBENCH_TARGET_GPU || opts.target == MEMBENCH_TARGET_ALL) &&
+        !membench_cancel_requested()) {
         if (run_gpu(&opts) != 0 && rc == 0) rc = -1;
     }
 
+    membench_monitor_stop();
+    if (g_throttled)
+        fprintf(stderr, "Warning: %zu points ran while the clock fell more than %.0f%%; "
+                "their results mix throttled and unthrottled time\n",
+                g_throttled, opts.monitor_pct);
+
+    /* Where the run's own time went: verbose table, or a structured record */
+    if (opts.verbose || opts.format != MEMBENCH_FMT_TABLE) {
+        membench_phase_totals_t phases;
+        membench_phase_get(&phases);
+        printf("\n=== Harness Profile ===\n");
+        membench_print_profile(&phases, membench_timer_ns() - run_start, opts.format);
+    }
+
+    if (opts.timeline_path) {
+        membench_timeline_span("membench", run_start, membench_timer_ns(), 0);
+        if (membench_timeline_write(opts.timeline_path) != 0)
+            fprintf(stderr, "Cannot write timeline '%s'\n", opts.timeline_path);
+        else if (membench_timeline_lost_threads())
+            fprintf(stderr, "Timeline: %zu threads not recorded (all %d slots in use), "
+                    "%zu events dropped\n", membench_timeline_lost_threads(),
+                    MEMBENCH_TIMELINE_MAX_THREADS, membench_timeline_dropped());
+        else if (membench_timeline_dropped())
+            fprintf(stderr, "Timeline: %zu events dropped (buffers full)\n",
+                    membench_timeline_dropped());
+        membench_timeline_disable();
+    }
+
+    int sig = membench_cancel_requested();
+    if (sig) {
+        printf("\nInterrupted.\n");
+        fflush(stdout);
+        if (g_checkpoint)
+            fprintf(stderr, "Interrupted by signal %d: %zu finished points in %s; "
+                    "continue with --resume %s\n", sig, membench_checkpoint_count(g_checkpoint),
+                    opts.checkpoint_path, opts.checkpoint_path);
+        else
+            fprintf(stderr, "Interrupted by signal %d\n", sig);
+        membench_checkpoint_close(g_checkpoint);
+        return 128 + sig;
+    }
+
+    membench_checkpoint_close(g_checkpoint);
     printf("\nDone.\n");
     return rc;
 }
@@ -0,0 +1,118 @@
+/**
+ * test_cachesim.c — Verify the offline cache simulator and profiles.
+ */
+#include "membench/cachesim.h"
+#include "test_util.h"
+#include <stdio.h>
+#include <string.h>
+
+#define PROFILE_FILE "test_cachesim.prof"
+
+/* L1: 1 KB, 2-way, 64 B lines (8 sets). L2: 4 KB, 4-way (16 sets). */
+static membench_cache_profile_t small_profile(void) {
+    membench_cache_profile_t p;
+    memset(&p, 0, sizeof(p));
+    p.line_bytes = 64;
+    p.num_levels = 2;
+    p.level[0].size_bytes = 1024; p.level[0].ways = 2; p.level[0].latency_ns = 1.0;
+    p.level[1].size_bytes = 4096; p.level[1].ways = 4; p.level[1].latency_ns = 4.0;
+    p.memory_latency_ns = 100.0;
+    return p;
+}
+
+int main(void) {
+    printf("Test: Cache simulator\n");
+    int fails = 0;
+    membench_cache_profile_t p = small_profile();
+    membench_sim_result_t r;
+
+    /* 512 B swept 10 times: 8 compulsory misses, everything else hits L1 */
+    for (int pol = 0; pol < MEMBENCH_SIM_NUM_POLICIES; pol++) {
+        membench_cachesim_t *s = membench_cachesim_create(&p, (membench_sim_policy_t)pol);
+        if (!s) { fprintf(stderr, "FAIL: create\n"); return 1; }
+        for (int pass = 0; pass < 10; pass++)
+            for (uint64_t a = 0; a < 512; a += 8)
+                membench_cachesim_access(s, a, 8, 0);
+        membench_cachesim_result(s, &r);
+        membench_cachesim_destroy(s);
+        fails += check(r.accesses == 640, "sweep access count");
+        fails += check(r.level[0].hits == 632 && r.memory_reads == 8, "sweep hits");
+    }
+
+    /* Three lines in one 2-way L1 set, cycled: LRU thrashes L1, L2 holds them */
+    {
+        membench_cachesim_t *s = membench_cachesim_create(&p, MEMBENCH_SIM_LRU);
+        for (int i = 0; i < 30; i++)
+            membench_cachesim_access(s, (uint64_t)(i % 3) * 8 * 64, 4, 0);
+        membench_cachesim_result(s, &r);
+        membench_cachesim_destroy(s);
+        fails += check(r.level[0].hits == 0, "LRU conflict thrash in L1");
+        fails += check(r.level[1].hits == 27 && r.memory_reads == 3, "L2 absorbs conflicts");
+        fails += check(r.est_total_ns == 27 * 4.0 + 3 * 100.0, "latency estimate");
+    }
+
+    /* Accesses straddling a line boundary touch both lines */
+    {
+        membench_cachesim_t *s = membench_cachesim_create(&p, MEMBENCH_SIM_PLRU);
+        membench_cachesim_access(s, 60, 8, 0);
+        membench_cachesim_result(s, &r);
+        membench_cachesim_destroy(s);
+        fails += check(r.accesses == 2, "straddling access");
+    }
+
+    /* Writes: dirty lines evicted from the last level reach memory */
+    {
+        membench_cachesim_t *s = membench_cachesim_create(&p, MEMBENCH_SIM_LRU);
+        for (uint64_t a = 0; a < 16384; a += 64)
+            membench_cachesim_access(s, a, 8, 1);
+        membench_cachesim_result(s, &r);
+        membench_cachesim_destroy(s);
+        fails += check(r.memory_reads == 256, "write-allocate misses");
+        fails += check(r.memory_writes == 256 - 64, "write-backs to memory");
+    }
+
+    /* Profile save / load round trip */
+    if (membench_cache_profile_save(PROFILE_FILE, &p) != 0) {
+        fprintf(stderr, "FAIL: save profile\n");
+        return 1;
+    }
+    membench_cache_profile_t q;
+    fails += check(membench_cache_profile_load(PROFILE_FILE, &q) == 0, "load profile");
+    fails += check(q.line_bytes == 64 && q.num_levels == 2 &&
+                   q.level[1].size_bytes == 4096 && q.level[1].ways == 4 &&
+                   q.level[1].latency_ns == 4.0 && q.memory_latency_ns == 100.0,
+                   "profile round trip");
+
+    /* A level key without a field ("l1 = 5") is a bad profile, not a crash */
+    {
+        FILE *f = fopen(PROFILE_FILE, "w");
+        if (!f) {
+            fprintf(stderr, "FAIL: write bad profile\n");
+            return 1;
+        }
+        fputs("line_bytes = 64\nlevels = 1\nl1 = 5\n", f);
+        fclose(f);
+        fails += check(membench_cache_profile_load(PROFILE_FILE, &q) == -1,
+                       "level key without a field rejected");
+    }
+    remove(PROFILE_FILE);
+
+    /* Profile from a latency curve: plateaus per level */
+    {
+        size_t sizes[] = { 4096, 16384, 65536, 262144, 1048576, 4194304, 16777216 };
+        double lats[]  = { 1.0,  1.0,   3.0,   4.0,    4.0,     9.0,     80.0 };
+        membench_cache_info_t info = { 32768, 1048576, 0, 7, sizes, lats };
+        membench_sysinfo_t si;
+        memset(&si, 0, sizeof(si));
+        membench_cache_profile_t c;
+        fails += check(membench_cache_profile_from_info(&info, &si, &c) == 0, "from_info");
+        fails += check(c.num_levels == 2 && c.line_bytes == 64, "from_info levels");
+        fails += check(c.level[0].latency_ns == 1.0 && c.level[1].latency_ns == 4.0,
+                       "from_info plateaus");
+        fails += check(c.memory_latency_ns == 80.0, "from_info memory latency");
+    }
+
+    if (fails) return 1;
+    printf("  PASS\n");
+    return 0;
+}
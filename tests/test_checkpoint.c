@@ -0,0 +1,79 @@
+/**
+ * test_checkpoint.c — Verify cancellation and checkpoint round-trips.
+ */
+#include "membench/checkpoint.h"
+#include "test_util.h"
+#include <signal.h>
+#include <stdio.h>
+#include <string.h>
+
+#define CP_FILE "test_checkpoint.txt"
+
+int main(void) {
+    printf("Test: Checkpoint / cancellation\n");
+    int fails = 0;
+    char err[256] = "";
+
+    /* A delivered signal only sets the flag */
+    fails += check(membench_cancel_install() == 0, "install handlers");
+    fails += check(membench_cancel_requested() == 0, "not cancelled at start");
+    raise(SIGTERM);
+    fails += check(membench_cancel_requested() == SIGTERM, "SIGTERM requests cancel");
+    membench_cancel_reset();
+    fails += check(membench_cancel_requested() == 0, "reset");
+
+    /* Fresh file */
+    membench_checkpoint_t *cp = membench_checkpoint_open(CP_FILE, "--test latency", 0,
+                                                         err, sizeof(err));
+    fails += check(cp != NULL, "open fresh");
+    if (!cp) { fprintf(stderr, "  %s\n", err); return 1; }
+    const double a[] = { 4096, 1.0 / 3.0, 1e-300, 123456789012345.0 };
+    const double b[] = { 7 };
+    fails += check(membench_checkpoint_record(cp, "bench/read-latency/4096", a, 4) == 0,
+                   "record a");
+    fails += check(membench_checkpoint_record(cp, "cache-detect/0/0", b, 1) == 0, "record b");
+    fails += check(membench_checkpoint_record(cp, "has space", b, 1) != 0, "reject bad key");
+    fails += check(membench_checkpoint_count(cp) == 2, "count after record");
+    membench_checkpoint_close(cp);
+
+    /* Simulate a torn write at the moment of a kill */
+    FILE *f = fopen(CP_FILE, "a");
+    if (f) { fputs("bench/read-latency/8192 4 1 2", f); fclose(f); }
+
+    cp = membench_checkpoint_open(CP_FILE, "--test latency", 1, err, sizeof(err));
+    fails += check(cp != NULL, "resume");
+    if (!cp) { fprintf(stderr, "  %s\n", err); return 1; }
+    fails += check(membench_checkpoint_loaded(cp) == 2, "torn line ignored");
+    size_t n = 0;
+    const double *v = membench_checkpoint_find(cp, "bench/read-latency/4096", &n);
+    fails += check(v && n == 4 && memcmp(v, a, sizeof(a)) == 0, "values round-trip exactly");
+    fails += check(membench_checkpoint_find(cp, "bench/read-latency/8192", &n) == NULL,
+                   "torn point not found");
+
+    /* Re-recording a point replaces it */
+    const double c[] = { 8 };
+    membench_checkpoint_record(cp, "cache-detect/0/0", c, 1);
+    v = membench_checkpoint_find(cp, "cache-detect/0/0", &n);
+    fails += check(v && n == 1 && v[0] == 8.0, "later record wins");
+    membench_checkpoint_close(cp);
+
+    cp = membench_checkpoint_open(CP_FILE, "--test latency", 1, err, sizeof(err));
+    v = membench_checkpoint_find(cp, "cache-detect/0/0", &n);
+    fails += check(v && v[0] == 8.0, "later line wins on load");
+    membench_checkpoint_close(cp);
+
+    /* Different command line */
+    cp = membench_checkpoint_open(CP_FILE, "--test bandwidth", 1, err, sizeof(err));
+    fails += check(cp == NULL && strstr(err, "different command line") != NULL,
+                   "config mismatch refused");
+    membench_checkpoint_close(cp);
+
+    /* Without resume the file starts over */
+    cp = membench_checkpoint_open(CP_FILE, "--test bandwidth", 0, err, sizeof(err));
+    fails += check(cp && membench_checkpoint_count(cp) == 0, "fresh truncates");
+    membench_checkpoint_close(cp);
+
+    remove(CP_FILE);
+    if (fails == 0) printf("  PASS\n");
+    return fails ? 1 : 0;
+}
@@ -0,0 +1,96 @@
+/**
+ * test_context.c — Verify the reentrant context API of libmembench.
+ *
+ * Runs small probes on several threads at once, each with its own
+ * context, with stdout redirected to a file that must stay empty.
+ */
+#include "membench/membench.h"
+#include "test_util.h"
+#include <stdio.h>
+#include <string.h>
+
+#if defined(_WIN32)
+    #define WIN32_LEAN_AND_MEAN
+    #include <windows.h>
+#else
+    #include <pthread.h>
+#endif
+
+#define NUM_THREADS 4
+#define OUT_FILE    "test_context.out"
+
+typedef struct {
+    int    id;
+    int    fails;
+    membench_ctx_cache_t cache;
+} job_t;
+
+static void run_job(job_t *job) {
+    membench_ctx_config_t cfg = { (uint64_t)job->id + 1, 8 * 1024 * 1024 };
+    membench_ctx_t *ctx = membench_ctx_create(&cfg);
+    if (!ctx) { job->fails++; return; }
+
+    membench_latency_result_t lat;
+    membench_bandwidth_result_t bw;
+    job->fails += check(membench_ctx_read_latency(ctx, 64 * 1024, 4, &lat) == 0 &&
+                        lat.avg_latency_ns > 0.0 && lat.accesses == 4 * 1024,
+                        "read latency");
+    job->fails += check(membench_ctx_write_latency(ctx, 64 * 1024, 4, &lat) == 0 &&
+                        lat.avg_latency_ns > 0.0, "write latency");
+    job->fails += check(membench_ctx_read_bandwidth(ctx, 256 * 1024, 8, &bw) == 0 &&
+                        bw.bandwidth_gbps > 0.0, "read bandwidth");
+    job->fails += check(membench_ctx_write_bandwidth(ctx, 256 * 1024, 8, &bw) == 0 &&
+                        bw.bytes_moved == 8 * 256 * 1024, "write bandwidth");
+
+    /* Over the context's limit: refused with a message, not a crash */
+    job->fails += check(membench_ctx_read_latency(ctx, 64 * 1024 * 1024, 1, &lat) != 0 &&
+                        strstr(membench_ctx_error(ctx), "limit") != NULL, "buffer limit");
+
+    job->fails += check(membench_ctx_detect_cache(ctx, 256 * 1024, 20000, &job->cache) == 0 &&
+                        job->cache.num_samples > 0 &&
+                        job->cache.sample_sizes[job->cache.num_samples - 1] <= 256 * 1024,
+                        "detect cache");
+    membench_ctx_destroy(ctx);
+}
+
+#if defined(_WIN32)
+static DWORD WINAPI thread_main(LPVOID p) { run_job((job_t *)p); return 0; }
+#else
+static void *thread_main(void *p) { run_job((job_t *)p); return NULL; }
+#endif
+
+int main(void) {
+    fprintf(stderr, "Test: Library context API\n");
+    if (!freopen(OUT_FILE, "w", stdout)) return 1;
+
+    job_t jobs[NUM_THREADS];
+    memset(jobs, 0, sizeof(jobs));
+#if defined(_WIN32)
+    HANDLE th[NUM_THREADS];
+    for (int i = 0; i < NUM_THREADS; i++) {
+        jobs[i].id = i;
+        th[i] = CreateThread(NULL, 0, thread_main, &jobs[i], 0, NULL);
+    }
+    WaitForMultipleObjects(NUM_THREADS, th, TRUE, INFINITE);
+#else
+    pthread_t th[NUM_THREADS];
+    for (int i = 0; i < NUM_THREADS; i++) {
+        jobs[i].id = i;
+        pthread_create(&th[i], NULL, thread_main, &jobs[i]);
+    }
+    for (int i = 0; i < NUM_THREADS; i++) pthread_join(th[i], NULL);
+#endif
+
+    int fails = 0;
+    for (int i = 0; i < NUM_THREADS; i++) fails += jobs[i].fails;
+
+    fflush(stdout);
+    long printed = ftell(stdout);
+    fclose(stdout);
+    remove(OUT_FILE);
+    fails += check(printed == 0, "no stdout output");
+
+    if (fails) return 1;
+    fprintf(stderr, "  PASS\n");
+    return 0;
+}
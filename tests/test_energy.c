@@ -0,0 +1,110 @@
+/**
+ * test_energy.c — Verify RAPL domain discovery and energy arithmetic
+ * against a fake powercap tree.
+ */
+#include "membench/energy.h"
+#include "test_util.h"
+#include <stdio.h>
+#include <string.h>
+
+#if defined(__linux__)
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define ROOT "test_energy_root"
+
+static void put(const char *zone, const char *file, const char *text) {
+    char path[256];
+    snprintf(path, sizeof(path), ROOT "/%s", zone);
+    mkdir(path, 0755);
+    snprintf(path, sizeof(path), ROOT "/%s/%s", zone, file);
+    FILE *f = fopen(path, "w");
+    if (f) {
+        fputs(text, f);
+        fclose(f);
+    }
+}
+
+static void drop(const char *zone) {
+    const char *files[] = { "name", "energy_uj", "max_energy_range_uj" };
+    char path[256];
+    for (size_t i = 0; i < 3; i++) {
+        snprintf(path, sizeof(path), ROOT "/%s/%s", zone, files[i]);
+        remove(path);
+    }
+    snprintf(path, sizeof(path), ROOT "/%s", zone);
+    rmdir(path);
+}
+
+static void zone(const char *name, const char *kind, const char *uj) {
+    put(name, "name", kind);
+    put(name, "energy_uj", uj);
+    put(name, "max_energy_range_uj", "1000000000\n");
+}
+
+int main(void) {
+    printf("Test: Energy counters\n");
+    int fails = 0;
+    membench_energy_t e;
+    char err[128] = "";
+
+    mkdir(ROOT, 0755);
+    fails += check(membench_energy_open(&e, ROOT, err, sizeof(err)) != 0, "empty root fails");
+    fails += check(strstr(err, "package") != NULL, "empty root reason");
+    fails += check(membench_energy_open(&e, ROOT "/missing", err, sizeof(err)) != 0,
+                   "missing root fails");
+
+    /* Two sockets with DRAM; core and psys overlap the package and are skipped */
+    zone("intel-rapl:1", "package-1\n", "5000000\n");
+    zone("intel-rapl:0", "package-0\n", "1000000\n");
+    zone("intel-rapl:0:0", "core\n", "700000\n");
+    zone("intel-rapl:0:1", "dram\n", "300000\n");
+    zone("intel-rapl:2", "psys\n", "9000000\n");
+    fails += check(membench_energy_open(&e, ROOT, err, sizeof(err)) == 0, "open");
+    fails += check(e.num_domains == 3, "package, dram, package");
+    fails += check(e.domains[0].kind == MEMBENCH_ENERGY_PACKAGE &&
+                   e.domains[1].kind == MEMBENCH_ENERGY_DRAM &&
+                   e.domains[2].kind == MEMBENCH_ENERGY_PACKAGE, "domain order");
+    fails += check(e.domains[0].max_range_uj == 1000000000ULL, "wrap point read");
+
+    membench_energy_sample_t a, b;
+    membench_energy_sample(&e, &a);
+    fails += check(a.uj[0] == 1000000 && a.uj[1] == 300000 && a.uj[2] == 5000000, "sample");
+
+    /* 2 s: package 0 wraps (+3 J), DRAM +1 J, package 1 +5 J */
+    b = a;
+    b.t_ns = a.t_ns + 2000000000ULL;
+    a.uj[0] = 999000000ULL;
+    b.uj[0] = 2000000ULL;
+    b.uj[1] = 1300000ULL;
+    b.uj[2] = 10000000ULL;
+    membench_energy_result_t r;
+    fails += check(membench_energy_diff(&e, &a, &b, 1000000000ULL, 4000000000ULL, 0, &r) == 0,
+                   "diff");
+    fails += check(r.package_j > 7.999 && r.package_j < 8.001, "package joules, with wrap");
+    fails += check(r.has_dram && r.dram_j > 0.999 && r.dram_j < 1.001, "dram joules");
+    fails += check(r.watts > 4.499 && r.watts < 4.501, "average watts");
+    fails += check(r.timed_j > 4.499 && r.timed_j < 4.501, "energy of the timed second");
+    fails += check(r.nj_per_byte > 1.1249 && r.nj_per_byte < 1.1251, "nJ per byte");
+    fails += check(r.nj_per_op == 0.0, "no ops, no nJ per op");
+
+    /* A counter that goes backwards without a known wrap point is no reading */
+    e.domains[0].max_range_uj = 0;
+    fails += check(membench_energy_diff(&e, &a, &b, 1000000000ULL, 4000000000ULL, 0, &r) == -1 &&
+                   r.package_j == 0.0 && r.watts == 0.0, "unknown wrap rejected");
+
+    const char *zones[] = { "intel-rapl:0", "intel-rapl:1", "intel-rapl:0:0",
+                            "intel-rapl:0:1", "intel-rapl:2" };
+    for (size_t i = 0; i < 5; i++) drop(zones[i]);
+    rmdir(ROOT);
+
+    if (fails) return 1;
+    printf("  PASS\n");
+    return 0;
+}
+#else
+int main(void) {
+    printf("Test: Energy counters\n  SKIP (powercap is Linux-only)\n");
+    return 0;
+}
+#endif
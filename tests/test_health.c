@@ -0,0 +1,114 @@
+/**
+ * test_health.c — Verify the quick health check's ranges and verdicts.
+ */
+#include "membench/health.h"
+#include "test_util.h"
+#include <stdio.h>
+#include <string.h>
+
+static const membench_health_check_t *find(const membench_health_report_t *r,
+                                           const char *name) {
+    for (size_t i = 0; i < r->num_checks; i++)
+        if (strcmp(r->checks[i].name, name) == 0) return &r->checks[i];
+    return NULL;
+}
+
+static membench_health_status_t status_of(const membench_health_report_t *r,
+                                          const char *name) {
+    const membench_health_check_t *c = find(r, name);
+    return c ? c->status : (membench_health_status_t)-1;
+}
+
+/* A healthy four-core machine inside every generic range */
+static void healthy(membench_quick_probe_t *p) {
+    memset(p, 0, sizeof(*p));
+    p->l1_bytes = 16 * 1024;
+    p->l2_bytes = 512 * 1024;
+    p->l3_bytes = 4 * 1024 * 1024;
+    p->dram_bytes = 64 * 1024 * 1024;
+    p->l1_ns = 1.2;
+    p->l2_ns = 4.0;
+    p->l3_ns = 15.0;
+    p->dram_ns = 90.0;
+    p->bw_1core_gbps = 12.0;
+    p->bw_allcore_gbps = 30.0;
+    p->threads = 4;
+    p->num_cores = 4;
+    for (int i = 0; i < 4; i++) p->core_l2_ns[i] = 4.0 + 0.1 * i;
+}
+
+int main(void) {
+    printf("Test: Health check\n");
+    int fails = 0;
+
+    /* Family matching */
+    const membench_health_expect_t *generic = membench_health_expect_for("Unknown CPU");
+    fails += check(strcmp(generic->family, "generic") == 0, "unknown model is generic");
+    fails += check(membench_health_expect_for(NULL) == generic, "NULL model is generic");
+    fails += check(strcmp(membench_health_expect_for("AMD EPYC 7763 64-Core Processor")->family,
+                          "EPYC") == 0, "EPYC matched");
+    fails += check(strcmp(membench_health_expect_for("Apple M2 Pro")->family, "Apple M") == 0,
+                   "Apple matched");
+
+    membench_quick_probe_t p;
+    membench_health_report_t r;
+
+    healthy(&p);
+    membench_health_evaluate(&p, generic, &r);
+    fails += check(r.overall == MEMBENCH_HEALTH_PASS, "healthy machine passes");
+    fails += check(find(&r, "dram-bw-scaling") && find(&r, "dram-bw-scaling")->value == 2.5,
+                   "scaling is all-core / 1-core");
+
+    /* Slightly slow DRAM warns, a dead channel's worth fails */
+    healthy(&p);
+    p.dram_ns = generic->dram_ns[1] * 1.2;
+    membench_health_evaluate(&p, generic, &r);
+    fails += check(status_of(&r, "dram-latency") == MEMBENCH_HEALTH_WARN, "slow DRAM warns");
+    fails += check(r.overall == MEMBENCH_HEALTH_WARN, "warn is the overall verdict");
+
+    healthy(&p);
+    p.bw_1core_gbps = generic->bw_1core_gbps / 2.0;
+    membench_health_evaluate(&p, generic, &r);
+    fails += check(status_of(&r, "dram-bw-1core") == MEMBENCH_HEALTH_FAIL, "half bandwidth fails");
+    fails += check(r.overall == MEMBENCH_HEALTH_FAIL, "fail is the overall verdict");
+
+    /* One slow core */
+    healthy(&p);
+    p.core_l2_ns[2] = 8.0;
+    membench_health_evaluate(&p, generic, &r);
+    fails += check(status_of(&r, "core-spread") == MEMBENCH_HEALTH_FAIL, "slow core fails");
+    fails += check(strstr(find(&r, "core-spread")->note, "core 2") != NULL, "slow core named");
+
+    /* No scaling across cores */
+    healthy(&p);
+    p.bw_allcore_gbps = p.bw_1core_gbps;
+    membench_health_evaluate(&p, generic, &r);
+    fails += check(status_of(&r, "dram-bw-scaling") == MEMBENCH_HEALTH_WARN, "flat scaling warns");
+
+    /* Out-of-order levels: the sizes are wrong, not the hardware */
+    healthy(&p);
+    p.l3_ns = 3.0;
+    membench_health_evaluate(&p, generic, &r);
+    fails += check(status_of(&r, "hierarchy") == MEMBENCH_HEALTH_WARN, "inverted levels warn");
+
+    /* Single CPU, no L3: those checks are skipped and do not count */
+    healthy(&p);
+    p.threads = 1;
+    p.num_cores = 1;
+    p.bw_allcore_gbps = 0.0;
+    p.l3_bytes = 0;
+    membench_health_evaluate(&p, generic, &r);
+    fails += check(status_of(&r, "dram-bw-scaling") == MEMBENCH_HEALTH_SKIP, "1 CPU skips scaling");
+    fails += check(status_of(&r, "core-spread") == MEMBENCH_HEALTH_SKIP, "1 CPU skips spread");
+    fails += check(status_of(&r, "l3-latency") == MEMBENCH_HEALTH_SKIP, "no L3 skipped");
+    fails += check(r.overall == MEMBENCH_HEALTH_PASS, "skips do not fail");
+
+    /* Families without an L3 skip it */
+    healthy(&p);
+    membench_health_evaluate(&p, membench_health_expect_for("Apple M1"), &r);
+    fails += check(status_of(&r, "l3-latency") == MEMBENCH_HEALTH_SKIP, "Apple has no L3 range");
+
+    if (fails) return 1;
+    printf("  PASS\n");
+    return 0;
+}
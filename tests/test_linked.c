@@ -0,0 +1,28 @@
+/**
+ * test_linked.c — Verify linked-structure sizing at and below one node.
+ */
+#include "membench/bench_cpu.h"
+#include "test_util.h"
+#include <stdio.h>
+
+int main(void) {
+    printf("Test: Linked structures\n");
+    int fails = 0;
+
+    /* Working sets below one node used to divide by zero */
+    fails += check(membench_cpu_linked_auto_passes(256, 64) >= 1, "passes below one node");
+    fails += check(membench_cpu_linked_auto_passes(64, 0) >= 1, "passes for an empty set");
+    fails += check(membench_cpu_linked_auto_passes(0, 4096) >= 1, "passes for a zero node");
+    fails += check(membench_cpu_linked_auto_passes(64, 64 * 1024) == (4u << 20) / 1024,
+                   "passes for 1024 nodes");
+
+    membench_linked_result_t r[MEMBENCH_ALLOC_NUM_ORDERS];
+    fails += check(membench_cpu_linked(MEMBENCH_LINKED_LIST, 256, 64, 1, r) == -1,
+                   "set below one node is refused");
+    fails += check(membench_cpu_linked(MEMBENCH_LINKED_TREE, 64, 64 * 64,
+                                       membench_cpu_linked_auto_passes(64, 64 * 64), r) == 0,
+                   "small tree runs");
+
+    if (fails == 0) printf("  PASS\n");
+    return fails ? 1 : 0;
+}
@@ -0,0 +1,50 @@
+/**
+ * test_monitor.c — Verify the clock monitor samples and reports windows.
+ */
+#include "membench/monitor.h"
+#include "test_util.h"
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+int main(void) {
+    printf("test_monitor:\n");
+    int fails = 0;
+    char err[160] = "";
+    membench_monitor_stats_t s;
+
+    fails += check(membench_monitor_source() == MEMBENCH_MONITOR_NONE, "stopped at start");
+    fails += check(strcmp(membench_monitor_source_name(MEMBENCH_MONITOR_PROBE), "probe") == 0,
+                   "source name");
+
+#if defined(__linux__)
+    fails += check(membench_monitor_start(5, 10.0, err, sizeof(err)) == 0, "start");
+    fails += check(membench_monitor_source() != MEMBENCH_MONITOR_NONE, "source chosen");
+
+    membench_monitor_begin();
+    struct timespec nap = { 0, 50 * 1000 * 1000 };
+    nanosleep(&nap, NULL);
+    memset(&s, 0xff, sizeof(s));
+    membench_monitor_end(&s);
+    fails += check(s.samples >= 2, "begin and end both sample");
+    fails += check(s.freq_min_mhz > 0.0 && s.freq_min_mhz <= s.freq_max_mhz, "clock range");
+    fails += check(s.drop_pct >= 0.0 && s.drop_pct < 100.0, "drop in range");
+    fails += check(s.temp_min_c <= s.temp_max_c, "temperature range");
+
+    membench_monitor_stop();
+    fails += check(membench_monitor_source() == MEMBENCH_MONITOR_NONE, "stopped");
+#else
+    fails += check(membench_monitor_start(0, 10.0, err, sizeof(err)) != 0, "unsupported");
+    (void)s;
+#endif
+
+    /* Windows outside a started monitor are empty, not errors */
+    memset(&s, 0xff, sizeof(s));
+    membench_monitor_begin();
+    membench_monitor_end(&s);
+    fails += check(s.samples == 0 && !s.throttled, "empty window when stopped");
+
+    if (fails) return 1;
+    printf("  PASS\n");
+    return 0;
+}
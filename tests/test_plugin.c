@@ -0,0 +1,56 @@
+/**
+ * test_plugin.c — Minimal plugin loaded by test_registry.
+ *
+ * Also serves as the smallest working example of the plugin interface:
+ * one streaming-sum kernel over a buffer of doubles.
+ */
+#include "membench/registry.h"
+
+#include <stdlib.h>
+
+typedef struct {
+    double *data;
+    size_t  count;
+    volatile double sink;
+} sum_state_t;
+
+static int sum_setup(size_t buffer_size, void **state) {
+    sum_state_t *s = (sum_state_t *)calloc(1, sizeof(*s));
+    if (!s) return -1;
+    s->count = buffer_size / sizeof(double);
+    s->data = (double *)calloc(s->count ? s->count : 1, sizeof(double));
+    if (!s->data) { free(s); return -1; }
+    for (size_t i = 0; i < s->count; i++) s->data[i] = (double)i;
+    *state = s;
+    return 0;
+}
+
+static int sum_run(void *state, uint64_t iterations, membench_bench_metrics_t *m) {
+    sum_state_t *s = (sum_state_t *)state;
+    double acc = 0.0;
+    for (uint64_t it = 0; it < iterations; it++)
+        for (size_t i = 0; i < s->count; i++) acc += s->data[i];
+    s->sink = acc;
+    m->ops = iterations * s->count;
+    m->bytes = m->ops * sizeof(double);
+    return 0;
+}
+
+static void sum_teardown(void *state) {
+    sum_state_t *s = (sum_state_t *)state;
+    free(s->data);
+    free(s);
+}
+
+static const membench_bench_t SUM_BENCH = {
+    "test-sum", "Test Sum", MEMBENCH_BENCH_BANDWIDTH, 0,
+    sum_setup, sum_run, sum_teardown
+};
+
+#if defined(_WIN32)
+__declspec(dllexport)
+#endif
+int membench_plugin_init(int abi, membench_registry_add_fn add) {
+    if (abi != MEMBENCH_PLUGIN_ABI) return -1;
+    return add(&SUM_BENCH);
+}
@@ -0,0 +1,55 @@
+/**
+ * test_profile.c — Verify phase accounting and kernel instrumentation.
+ */
+#include "membench/profile.h"
+#include "membench/timer.h"
+#include "membench/bench_cpu.h"
+#include "test_util.h"
+#include <stdio.h>
+#include <string.h>
+
+int main(void) {
+    printf("Test: Harness profile\n");
+    int fails = 0;
+    if (membench_timer_init() != 0) return 1;
+
+    membench_phase_totals_t p;
+    membench_phase_get(&p);
+    fails += check(p.calls[MEMBENCH_PHASE_MEASURE] == 0, "starts empty");
+
+    membench_phase_add(MEMBENCH_PHASE_BUILD, 100);
+    membench_phase_add(MEMBENCH_PHASE_BUILD, 50);
+    membench_phase_add(MEMBENCH_PHASE_COUNT, 1);    /* ignored */
+    uint64_t t0 = membench_timer_ns();
+    uint64_t t1 = membench_phase_mark(MEMBENCH_PHASE_ANALYZE, t0);
+    membench_phase_get(&p);
+    fails += check(p.ns[MEMBENCH_PHASE_BUILD] == 150 && p.calls[MEMBENCH_PHASE_BUILD] == 2,
+                   "add accumulates");
+    fails += check(t1 >= t0 && p.ns[MEMBENCH_PHASE_ANALYZE] == t1 - t0, "mark charges elapsed");
+    fails += check(strcmp(membench_phase_name(MEMBENCH_PHASE_MEASURE), "measure") == 0,
+                   "phase name");
+
+    membench_phase_reset();
+    membench_phase_get(&p);
+    fails += check(p.ns[MEMBENCH_PHASE_BUILD] == 0 && p.calls[MEMBENCH_PHASE_BUILD] == 0,
+                   "reset");
+
+    /* One latency run charges every step once */
+    membench_latency_result_t lr;
+    fails += check(membench_cpu_read_latency(64 * 1024, 4, &lr) == 0, "read latency");
+    membench_phase_get(&p);
+    fails += check(p.calls[MEMBENCH_PHASE_ALLOC] == 1 && p.calls[MEMBENCH_PHASE_BUILD] == 1 &&
+                   p.calls[MEMBENCH_PHASE_WARMUP] == 1 && p.calls[MEMBENCH_PHASE_MEASURE] == 1 &&
+                   p.calls[MEMBENCH_PHASE_FREE] == 1, "latency phases");
+    fails += check(p.ns[MEMBENCH_PHASE_MEASURE] > 0, "measure time recorded");
+
+    membench_phase_reset();
+    membench_bandwidth_result_t br;
+    fails += check(membench_cpu_write_bandwidth(64 * 1024, 4, &br) == 0, "write bandwidth");
+    membench_phase_get(&p);
+    fails += check(p.calls[MEMBENCH_PHASE_ALLOC] == 1 && p.calls[MEMBENCH_PHASE_MEASURE] == 1 &&
+                   p.calls[MEMBENCH_PHASE_BUILD] == 0, "bandwidth phases");
+
+    if (fails == 0) printf("  PASS\n");
+    return fails ? 1 : 0;
+}
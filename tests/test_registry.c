@@ -0,0 +1,61 @@
+/**
+ * test_registry.c — Verify the benchmark registry, harness and plugin loader.
+ *
+ * Usage: test_registry <path to test_plugin module>
+ */
+#include "membench/registry.h"
+#include "test_util.h"
+#include <stdio.h>
+#include <string.h>
+
+/* Reports a fixed 1000 ns per call of 100 ops, without touching memory */
+static int g_runs;
+static int fixed_run(void *state, uint64_t iterations, membench_bench_metrics_t *m) {
+    (void)state;
+    g_runs++;
+    m->ops = 100 * iterations;
+    m->bytes = 800 * iterations;
+    m->elapsed_ns = 1000 * iterations + (uint64_t)(g_runs % 3) * 100;
+    return 0;
+}
+
+static const membench_bench_t FIXED = {
+    "fixed", "Fixed", MEMBENCH_BENCH_LATENCY, MEMBENCH_BENCH_SELF_TIMED,
+    NULL, fixed_run, NULL
+};
+
+int main(int argc, char **argv) {
+    printf("Test: Benchmark registry\n");
+    int fails = 0;
+
+    fails += check(membench_registry_add(&FIXED) == 0, "add");
+    fails += check(membench_registry_add(&FIXED) != 0, "duplicate name rejected");
+    fails += check(membench_registry_find("fixed") == &FIXED, "find");
+    fails += check(membench_registry_find("nope") == NULL, "find missing");
+
+    /* Self-timed: no warm-up call, three runs at 10.0/11.0/12.0 ns per op */
+    membench_bench_result_t r;
+    g_runs = 0;
+    fails += check(membench_bench_run(&FIXED, 4096, 1, 3, &r) == 0, "harness run");
+    fails += check(g_runs == 3, "self-timed skips warm-up");
+    fails += check(r.reps == 3 && r.ops == 100, "result counts");
+    fails += check(r.ns_per_op_min == 10.0 && r.ns_per_op_max == 12.0, "min/max");
+    fails += check(r.ns_per_op == 11.0, "median");
+
+    if (argc > 1) {
+        size_t before = membench_registry_count();
+        fails += check(membench_plugin_load(argv[1]) == 1, "plugin load");
+        const membench_bench_t *b = membench_registry_find("test-sum");
+        fails += check(b && membench_registry_get(before) == b, "plugin registered");
+        if (b) {
+            fails += check(membench_bench_run(b, 64 * 1024, 4, 2, &r) == 0, "plugin run");
+            fails += check(r.bytes == 4 * 64 * 1024 && r.bandwidth_gbps > 0.0,
+                           "plugin metrics");
+        }
+    }
+    fails += check(membench_plugin_load("does-not-exist.so") < 0, "missing plugin");
+
+    if (fails) return 1;
+    printf("  PASS\n");
+    return 0;
+}
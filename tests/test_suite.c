@@ -0,0 +1,120 @@
+/**
+ * test_suite.c — Verify the size-list syntax and job-file parsing.
+ */
+#include "membench/suite.h"
+#include "test_util.h"
+#include <stdio.h>
+#include <string.h>
+
+static int parse_fails(const char *text, const char *expect) {
+    static membench_suite_t s;
+    char err[128] = "";
+    if (membench_suite_parse(text, &s, err, sizeof(err)) == 0) return 0;
+    if (strstr(err, expect) == NULL) {
+        fprintf(stderr, "  got \"%s\", expected \"%s\"\n", err, expect);
+        return 0;
+    }
+    return 1;
+}
+
+static const char JOBS[] =
+    "; qualification suite\n"
+    "[global]\n"
+    "repeat = 3\n"
+    "\n"
+    "[lat]\n"
+    "bench   = read-latency   # chase\n"
+    "size    = 4K:1G:x2\n"
+    "threads = 1,2,4\n"
+    "\n"
+    "[bw]\n"
+    "bench = read-bw\n"
+    "size  = 1M:4M:+1M, 64M\n"
+    "pages = huge\n"
+    "numa  = bind:1\n"
+    "repeat = 1\n"
+    "\n"
+    "[global]\n"
+    "iterations = 100\n"
+    "\n"
+    "[late]\n"
+    "test = write-bw\n"
+    "size = 8K\n"
+    "numa = interleave\n";
+
+int main(void) {
+    printf("Test: Job files\n");
+    int fails = 0;
+    size_t v[64];
+
+    fails += check(membench_parse_size_list("4K:1G:x2", v, 64) == 19, "4K:1G:x2 count");
+    fails += check(v[0] == 4096 && v[18] == (size_t)1 << 30, "4K:1G:x2 ends");
+    fails += check(membench_parse_size_list("1K:4K", v, 64) == 3 && v[1] == 2048,
+                   "default doubling");
+    fails += check(membench_parse_size_list("1K:64K:x4", v, 64) == 4 && v[3] == 65536,
+                   "x4 factor");
+    fails += check(membench_parse_size_list("1M:3M:+1M", v, 64) == 3 && v[2] == 3 << 20,
+                   "linear step");
+    fails += check(membench_parse_size_list(" 64 , 2K ", v, 64) == 2 && v[1] == 2048,
+                   "plain list");
+    fails += check(membench_parse_size_list("4K:1K", v, 64) == -1, "empty range");
+    fails += check(membench_parse_size_list("1K:2K:x1", v, 64) == -1, "factor <= 1");
+    fails += check(membench_parse_size_list("1K,,2K", v, 64) == -1, "empty item");
+    fails += check(membench_parse_size_list("1:1M:+1", v, 64) == -1, "too many values");
+    fails += check(membench_parse_size_list("1K:4K:x2abc", v, 64) == -1 &&
+                   membench_parse_size_list("1K:4K:x", v, 64) == -1, "malformed factor");
+    fails += check(membench_parse_size_list("1K:4K:x1.0000000000000002", v, 64) == -1,
+                   "factor too close to 1");
+    fails += check(membench_parse_size_list("1:100:x1.5", v, 64) == 11, "small factor");
+
+    static membench_suite_t s;
+    char err[128] = "";
+    int rc = membench_suite_parse(JOBS, &s, err, sizeof(err));
+    fails += check(rc == 0, "parse suite");
+    if (rc != 0) fprintf(stderr, "  %s\n", err);
+    fails += check(s.num_jobs == 3, "three jobs");
+
+    const membench_job_t *lat = &s.jobs[0], *bw = &s.jobs[1], *late = &s.jobs[2];
+    fails += check(strcmp(lat->name, "lat") == 0 && strcmp(lat->bench, "read-latency") == 0,
+                   "job name and bench");
+    fails += check(lat->num_sizes == 19 && lat->repeat == 3, "global repeat inherited");
+    fails += check(lat->num_threads == 3 && lat->threads[2] == 4, "thread list");
+    fails += check(lat->iterations == 0 && lat->pages == MEMBENCH_PAGES_DEFAULT,
+                   "defaults");
+    fails += check(bw->num_sizes == 5 && bw->sizes[4] == (size_t)64 << 20, "mixed list");
+    fails += check(bw->repeat == 1 && bw->pages == MEMBENCH_PAGES_HUGE, "job overrides");
+    fails += check(bw->numa == MEMBENCH_NUMA_BIND && bw->numa_node == 1, "numa bind");
+    fails += check(bw->num_threads == 1 && bw->threads[0] == 1, "default one thread");
+    fails += check(late->iterations == 100 && late->repeat == 3, "second [global]");
+    fails += check(strcmp(late->bench, "write-bw") == 0, "test alias");
+    fails += check(late->numa == MEMBENCH_NUMA_INTERLEAVE, "numa interleave");
+
+    fails += check(parse_fails("[a]\nbench = x\n", "line 1: job [a] has no 'size'"),
+                   "missing size");
+    fails += check(parse_fails("[a]\nsize = 4K\n\n[b]\n", "line 1: job [a] has no 'bench'"),
+                   "missing bench");
+    fails += check(parse_fails("[a]\nbench = x\nsize = 4K\ncolour = red\n",
+                               "line 4: unknown key 'colour'"), "unknown key");
+    fails += check(parse_fails("[a]\nbench = x\nsize = 4K:1K\n", "line 3: bad value"),
+                   "bad size");
+    fails += check(parse_fails("[a]\nbench = x\nsize = 4K\nnuma = bind:\n", "line 4"),
+                   "bad numa");
+    fails += check(parse_fails("[a]\nbench = x\nsize = 4K\nthreads = 1K\n", "line 4"),
+                   "threads take no suffix");
+    fails += check(parse_fails("[a]\nbench = x\nsize = 4K\nthreads = 2,0\n", "line 4") &&
+                   parse_fails("[a]\nbench = x\nsize = 4K\nthreads = 99999999999\n", "line 4"),
+                   "threads out of range");
+    fails += check(parse_fails("[a]\nbench = x\nsize = 4K\nrepeat = 3abc\n", "line 4") &&
+                   parse_fails("[a]\nbench = x\nsize = 4K\nrepeat = 4294967297\n", "line 4"),
+                   "bad repeat");
+    fails += check(parse_fails("[a]\nbench = x\nsize = 4K\niterations = -1\n", "line 4") &&
+                   parse_fails("[a]\nbench = x\nsize = 4K\niterations = 0\n", "line 4"),
+                   "bad iterations");
+    fails += check(parse_fails("[a\n", "line 1: bad section header"), "bad header");
+    fails += check(parse_fails("bench = x\nsize\n", "line 2: expected key = value"),
+                   "missing '='");
+    fails += check(parse_fails("[global]\nrepeat = 2\n", "no jobs"), "no jobs");
+
+    if (fails == 0) printf("  PASS\n");
+    return fails ? 1 : 0;
+}
@@ -2,6 +2,7 @@
  * test_sysinfo.c — Verify system info detection.
  */
 #include "membench/sysinfo.h"
+#include "membench/timer.h"
 #include <stdio.h>
 #include <string.h>
 
@@ -32,6 +33,50 @@ int main(void) {
         return 1;
     }
 
+    /* Noise measurement fills its fields */
+    if (membench_timer_init() != 0 || membench_env_measure_noise(&info.env, 20000000ULL) != 0 ||
+        info.env.noise_samples == 0 || info.env.noise_p99_ratio < 1.0) {
+        fprintf(stderr, "FAIL: noise measurement\n");
+        return 1;
+    }
+
+    /* A clean environment has no warnings; each noise source adds one */
+    membench_sysinfo_t quiet = info;
+    memset(&quiet.env, 0, sizeof(quiet.env));
+    snprintf(quiet.env.governor, sizeof(quiet.env.governor), "performance");
+    quiet.env.virtualized = 0;
+    quiet.env.perf_paranoid = MEMBENCH_ENV_UNKNOWN;
+    char msgs[16][MEMBENCH_ENV_MSG_LEN];
+    if (membench_env_warnings(&quiet, msgs, 16) != 0) {
+        fprintf(stderr, "FAIL: warnings for a quiet environment: %s\n", msgs[0]);
+        return 1;
+    }
+    membench_sysinfo_t noisy = quiet;
+    noisy.num_cores_logical = 4;
+    snprintf(noisy.env.governor, sizeof(noisy.env.governor), "powersave");
+    noisy.env.turbo = 1;
+    noisy.env.swap_used = 1024 * 1024;
+    noisy.env.loadavg = 3.0;
+    if (membench_env_warnings(&noisy, msgs, 16) != 4 || !strstr(msgs[0], "powersave") ||
+        membench_env_warnings(&noisy, msgs, 2) != 2) {
+        fprintf(stderr, "FAIL: warnings for a noisy environment\n");
+        return 1;
+    }
+
+    /* Load is judged against the CPU count: 3 busy tasks on 64 CPUs is quiet */
+    membench_sysinfo_t loaded = quiet;
+    loaded.env.loadavg = 3.0;
+    loaded.num_cores_logical = 64;
+    if (membench_env_warnings(&loaded, msgs, 16) != 0) {
+        fprintf(stderr, "FAIL: load warning on a mostly idle machine\n");
+        return 1;
+    }
+    loaded.num_cores_logical = 8;
+    if (membench_env_warnings(&loaded, msgs, 16) != 1 || !strstr(msgs[0], "on 8 CPUs")) {
+        fprintf(stderr, "FAIL: load warning scaled by CPUs\n");
+        return 1;
+    }
+
     /* Print it out */
     membench_sysinfo_print(&info);
 
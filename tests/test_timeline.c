@@ -0,0 +1,80 @@
+/**
+ * test_timeline.c — Verify timeline recording and the trace-event output.
+ */
+#include "membench/timeline.h"
+#include "membench/timer.h"
+#include "membench/profile.h"
+#include "test_util.h"
+#include <stdio.h>
+#include <string.h>
+
+#define TRACE_FILE "test_timeline.json"
+
+static int count_in_file(const char *path, const char *needle) {
+    static char buf[1 << 16];
+    FILE *f = fopen(path, "r");
+    if (!f) return -1;
+    size_t n = fread(buf, 1, sizeof(buf) - 1, f);
+    fclose(f);
+    buf[n] = '\0';
+    int count = 0;
+    for (const char *p = buf; (p = strstr(p, needle)) != NULL; p += strlen(needle)) count++;
+    return count;
+}
+
+int main(void) {
+    printf("Test: Timeline recorder\n");
+    int fails = 0;
+    if (membench_timer_init() != 0) return 1;
+
+    /* Disabled: nothing is recorded */
+    membench_timeline_span("ignored", 0, 10, 0);
+    fails += check(!membench_timeline_enabled(), "off by default");
+
+    fails += check(membench_timeline_enable(8) == 0, "enable");
+    membench_timeline_thread_name("tester \"main\"");
+    uint64_t t0 = membench_timer_ns();
+    membench_timeline_span("setup", t0, t0 + 1500, 4096);
+    membench_timeline_instant("marker", 7);
+    membench_phase_span(MEMBENCH_PHASE_MEASURE, t0 + 2000, t0 + 5000);
+    fails += check(membench_timeline_dropped() == 0, "nothing dropped");
+
+    /* The per-thread cap is 8: these are counted, not stored */
+    for (int i = 0; i < 10; i++) membench_timeline_span("fill", t0, t0, (uint64_t)i);
+    fails += check(membench_timeline_dropped() == 5, "overflow counted");
+
+    fails += check(membench_timeline_write(TRACE_FILE) == 0, "write");
+    fails += check(count_in_file(TRACE_FILE, "\"traceEvents\"") == 1, "trace-event document");
+    fails += check(count_in_file(TRACE_FILE, "\"name\":\"setup\"") == 1, "span written");
+    fails += check(count_in_file(TRACE_FILE, "\"dur\":1.500") == 1, "duration in us");
+    fails += check(count_in_file(TRACE_FILE, "\"args\":{\"arg\":4096}") == 1, "span argument");
+    fails += check(count_in_file(TRACE_FILE, "\"ph\":\"i\"") == 1, "instant written");
+    fails += check(count_in_file(TRACE_FILE, "\"name\":\"measure\"") == 1, "phase recorded");
+    fails += check(count_in_file(TRACE_FILE, "\"name\":\"fill\"") == 5, "capped at 8 events");
+    fails += check(count_in_file(TRACE_FILE, "tester \\\"main\\\"") == 1, "thread name escaped");
+    fails += check(count_in_file(TRACE_FILE, "ignored") == 0, "disabled span not kept");
+
+    membench_timeline_disable();
+    fails += check(!membench_timeline_enabled() && membench_timeline_dropped() == 0,
+                   "disable clears");
+
+    /* Threads that release their slot on exit hand it to the next thread
+     * of the same name; one thread stands in for successive worker pools */
+    fails += check(membench_timeline_enable(8) == 0, "re-enable");
+    membench_timeline_thread_exit();
+    for (int pool = 0; pool < 2 * MEMBENCH_TIMELINE_MAX_THREADS; pool++) {
+        membench_timeline_thread_name(pool % 2 ? "worker 1" : "worker 0");
+        membench_timeline_instant("point", (uint64_t)pool);
+        membench_timeline_thread_exit();
+    }
+    fails += check(membench_timeline_lost_threads() == 0, "released slots reused");
+    fails += check(membench_timeline_write(TRACE_FILE) == 0, "write reused");
+    fails += check(count_in_file(TRACE_FILE, "\"name\":\"worker 0\"") == 1 &&
+                   count_in_file(TRACE_FILE, "\"name\":\"worker 1\"") == 1,
+                   "one track per worker name");
+    membench_timeline_disable();
+
+    remove(TRACE_FILE);
+    if (fails == 0) printf("  PASS\n");
+    return fails ? 1 : 0;
+}
@@ -0,0 +1,90 @@
+/**
+ * test_trace.c — Verify the binary trace writer and streaming reader.
+ */
+#include "membench/trace.h"
+#include <stdio.h>
+#include <stdint.h>
+
+#define TRACE_FILE "test_trace.mbt"
+#define NUM_RECS   100000
+
+static uint64_t expected(size_t i) {
+    return membench_trace_encode((uint64_t)i * 24, (uint32_t)(i % 64) + 1,
+                                 i % 3 == 0, i % 1000 == 0);
+}
+
+int main(void) {
+    printf("Test: Trace format\n");
+
+    /* Encode/decode round trip at the field limits */
+    uint64_t rec = membench_trace_encode(MEMBENCH_TRACE_MAX_OFFSET,
+                                         MEMBENCH_TRACE_MAX_SIZE, 1, 1);
+    if (membench_trace_offset(rec) != MEMBENCH_TRACE_MAX_OFFSET ||
+        membench_trace_size(rec) != MEMBENCH_TRACE_MAX_SIZE ||
+        !membench_trace_is_write(rec) || !membench_trace_new_phase(rec)) {
+        fprintf(stderr, "FAIL: encode/decode round trip\n");
+        return 1;
+    }
+
+    membench_trace_writer_t *w = membench_trace_create(TRACE_FILE);
+    if (!w) {
+        fprintf(stderr, "FAIL: cannot create %s\n", TRACE_FILE);
+        return 1;
+    }
+    if (membench_trace_append(w, 0, 0, 0, 0) == 0 ||
+        membench_trace_append(w, 0, MEMBENCH_TRACE_MAX_SIZE + 1, 0, 0) == 0) {
+        fprintf(stderr, "FAIL: invalid sizes accepted\n");
+        return 1;
+    }
+    for (size_t i = 0; i < NUM_RECS; i++) {
+        uint64_t e = expected(i);
+        if (membench_trace_append(w, membench_trace_offset(e), membench_trace_size(e),
+                                  membench_trace_is_write(e),
+                                  membench_trace_new_phase(e)) != 0) {
+            fprintf(stderr, "FAIL: append %zu\n", i);
+            return 1;
+        }
+    }
+    if (membench_trace_finish(w) != 0) {
+        fprintf(stderr, "FAIL: finish\n");
+        return 1;
+    }
+
+    membench_trace_reader_t *r = membench_trace_open(TRACE_FILE);
+    if (!r) {
+        fprintf(stderr, "FAIL: cannot open %s\n", TRACE_FILE);
+        return 1;
+    }
+    const membench_trace_header_t *h = membench_trace_info(r);
+    uint64_t span = (uint64_t)(NUM_RECS - 1) * 24 + ((NUM_RECS - 1) % 64) + 1;
+    if (h->num_records != NUM_RECS || h->span_bytes != span) {
+        fprintf(stderr, "FAIL: header records=%llu span=%llu\n",
+                (unsigned long long)h->num_records, (unsigned long long)h->span_bytes);
+        return 1;
+    }
+
+    /* Read twice to cover rewind */
+    for (int pass = 0; pass < 2; pass++) {
+        const uint64_t *recs;
+        size_t n, seen = 0;
+        while ((n = membench_trace_next(r, &recs)) > 0) {
+            for (size_t i = 0; i < n; i++, seen++) {
+                if (recs[i] != expected(seen)) {
+                    fprintf(stderr, "FAIL: record %zu mismatch\n", seen);
+                    return 1;
+                }
+            }
+        }
+        if (seen != NUM_RECS) {
+            fprintf(stderr, "FAIL: read %zu of %d records\n", seen, NUM_RECS);
+            return 1;
+        }
+        membench_trace_rewind(r);
+    }
+    membench_trace_close(r);
+    printf("  %d records written and streamed back\n", NUM_RECS);
+
+    remove(TRACE_FILE);
+    printf("  PASS\n");
+    return 0;
+}
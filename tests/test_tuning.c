@@ -0,0 +1,85 @@
+/**
+ * test_tuning.c — Verify tuning-parameter derivation and file output.
+ */
+#include "membench/tuning.h"
+#include "test_util.h"
+#include <stdio.h>
+#include <string.h>
+
+#define HEADER_FILE "test_tuning.h"
+#define JSON_FILE   "test_tuning.json"
+
+static int file_contains(const char *path, const char *needle) {
+    FILE *f = fopen(path, "r");
+    if (!f) return 0;
+    char buf[4096];
+    size_t n = fread(buf, 1, sizeof(buf) - 1, f);
+    fclose(f);
+    buf[n] = '\0';
+    return strstr(buf, needle) != NULL;
+}
+
+int main(void) {
+    printf("Test: Tuning advisor\n");
+    int fails = 0;
+    membench_tuning_t t;
+
+    /* Nothing measured: conservative defaults */
+    memset(&t, 0, sizeof(t));
+    membench_tuning_derive(&t);
+    fails += check(t.pad_bytes == 64, "default padding");
+    fails += check(t.bw_max_threads == 1, "default threads");
+    fails += check(t.nt_store_threshold == 0, "default NT threshold");
+    fails += check(strcmp(t.numa_policy, "none") == 0, "default NUMA policy");
+
+    memset(&t, 0, sizeof(t));
+    snprintf(t.cpu_model, sizeof(t.cpu_model), "Test \"CPU\"");
+    t.cache_line = 64;
+    t.l1_bytes = 32 * 1024;
+    t.l2_bytes = 1024 * 1024;
+    t.dram_latency_ns = 80.0;
+    t.numa_nodes = 2;
+
+    /* 10 GB/s at one thread: 80 ns x 10 B/ns = 800 B = 12.5 lines -> 13 */
+    const int threads[] = { 1, 2, 4, 8 };
+    const double bw[] = { 10.0, 19.0, 28.0, 30.0 };
+    for (size_t i = 0; i < 4; i++) {
+        t.bw_threads[i] = threads[i];
+        t.bw_gbps[i] = bw[i];
+    }
+    t.num_thread_points = 4;
+
+    /* NT ahead at 4 MB, behind at 8 MB, ahead from 16 MB on */
+    const double st[] = { 40.0, 20.0, 10.0, 8.0, 8.0 };
+    const double nt[] = { 12.0, 12.0, 9.0, 11.0, 12.0 };
+    for (size_t i = 0; i < 5; i++) {
+        t.store_bytes[i] = (size_t)(2u << i) * 1024 * 1024;
+        t.store_gbps[i] = st[i];
+        t.nt_store_gbps[i] = nt[i];
+    }
+    t.num_store_points = 5;
+
+    membench_tuning_derive(&t);
+    fails += check(t.l1_block_bytes == 16 * 1024, "L1 block");
+    fails += check(t.l2_block_bytes == 512 * 1024, "L2 block");
+    fails += check(t.prefetch_distance == 13, "prefetch distance");
+    fails += check(t.bw_max_threads == 4, "bandwidth threads");
+    fails += check(strcmp(t.numa_policy, "interleave") == 0, "NUMA policy");
+    fails += check(t.nt_store_threshold == 16u * 1024 * 1024, "NT threshold");
+
+    fails += check(membench_tuning_write_header(HEADER_FILE, &t) == 0, "write header");
+    fails += check(file_contains(HEADER_FILE, "#define MEMBENCH_TUNE_PREFETCH_DISTANCE   13"),
+                   "header prefetch macro");
+    fails += check(file_contains(HEADER_FILE, "#endif /* MEMBENCH_TUNE_H */"), "header guard");
+
+    fails += check(membench_tuning_write_json(JSON_FILE, &t) == 0, "write json");
+    fails += check(file_contains(JSON_FILE, "\"cpu\": \"Test \\\"CPU\\\"\""), "json escaping");
+    fails += check(file_contains(JSON_FILE, "\"nt_store_threshold\": 16777216"), "json threshold");
+
+    remove(HEADER_FILE);
+    remove(JSON_FILE);
+
+    if (fails) return 1;
+    printf("  PASS\n");
+    return 0;
+}
@@ -0,0 +1,15 @@
+/**
+ * test_util.h — Helpers shared by the standalone test programs.
+ */
+#ifndef MEMBENCH_TEST_UTIL_H
+#define MEMBENCH_TEST_UTIL_H
+
+#include <stdio.h>
+
+/** Report a failed condition; returns 1 on failure so callers can sum them. */
+static inline int check(int cond, const char *what) {
+    if (!cond) fprintf(stderr, "FAIL: %s\n", what);
+    return cond ? 0 : 1;
+}
+
+#endif /* MEMBENCH_TEST_UTIL_H */